@@ -600,6 +600,7 @@
         'src/core/lib/profiling/basic_timers.cc',
         'src/core/lib/profiling/stap_timers.cc',
         'src/core/lib/support/alloc.cc',
+        'src/core/lib/support/alloc_tags.cc',
         'src/core/lib/support/arena.cc',
         'src/core/lib/support/atm.cc',
         'src/core/lib/support/avl.cc',
@@ -615,11 +616,13 @@
         'src/core/lib/support/host_port.cc',
         'src/core/lib/support/log.cc',
         'src/core/lib/support/log_android.cc',
+        'src/core/lib/support/log_async.cc',
         'src/core/lib/support/log_linux.cc',
         'src/core/lib/support/log_posix.cc',
         'src/core/lib/support/log_windows.cc',
         'src/core/lib/support/mpscq.cc',
         'src/core/lib/support/murmur_hash.cc',
+        'src/core/lib/support/obj_cache.cc',
         'src/core/lib/support/stack_lockfree.cc',
         'src/core/lib/support/string.cc',
         'src/core/lib/support/string_posix.cc',
@@ -881,6 +884,8 @@
         'src/core/ext/transport/chttp2/client/insecure/channel_create_posix.cc',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
+        'src/core/ext/transport/shm/shm_endpoint.cc',
+        'src/core/ext/transport/shm/shm_transport.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/client_load_reporting_filter.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_channel_secure.cc',
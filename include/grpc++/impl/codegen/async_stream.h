@@ -238,6 +238,7 @@ class ClientAsyncReader final : public ClientAsyncReaderInterface<R> {
                     bool start, void* tag)
       : context_(context), call_(call), started_(start) {
     // TODO(ctiller): don't assert
+    init_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(init_ops_.SendMessage(request).ok());
     init_ops_.ClientSendClose();
     if (start) {
@@ -335,6 +336,7 @@ class ClientAsyncWriter final : public ClientAsyncWriterInterface<W> {
     assert(started_);
     write_ops_.set_output_tag(tag);
     // TODO(ctiller): don't assert
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg).ok());
     call_.PerformOps(&write_ops_);
   }
@@ -347,6 +349,7 @@ class ClientAsyncWriter final : public ClientAsyncWriterInterface<W> {
       write_ops_.ClientSendClose();
     }
     // TODO(ctiller): don't assert
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg, options).ok());
     call_.PerformOps(&write_ops_);
   }
@@ -494,6 +497,7 @@ class ClientAsyncReaderWriter final
     assert(started_);
     write_ops_.set_output_tag(tag);
     // TODO(ctiller): don't assert
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg).ok());
     call_.PerformOps(&write_ops_);
   }
@@ -506,6 +510,7 @@ class ClientAsyncReaderWriter final
       write_ops_.ClientSendClose();
     }
     // TODO(ctiller): don't assert
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg, options).ok());
     call_.PerformOps(&write_ops_);
   }
@@ -662,6 +667,7 @@ class ServerAsyncReader final : public ServerAsyncReaderInterface<W, R> {
     }
     // The response is dropped if the status is not OK.
     if (status.ok()) {
+      finish_ops_.set_pass_message_objects(call_.passes_message_objects());
       finish_ops_.ServerSendStatus(ctx_->trailing_metadata_,
                                    finish_ops_.SendMessage(msg));
     } else {
@@ -774,6 +780,7 @@ class ServerAsyncWriter final : public ServerAsyncWriterInterface<W> {
     write_ops_.set_output_tag(tag);
     EnsureInitialMetadataSent(&write_ops_);
     // TODO(ctiller): don't assert
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg).ok());
     call_.PerformOps(&write_ops_);
   }
@@ -786,6 +793,7 @@ class ServerAsyncWriter final : public ServerAsyncWriterInterface<W> {
 
     EnsureInitialMetadataSent(&write_ops_);
     // TODO(ctiller): don't assert
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg, options).ok());
     call_.PerformOps(&write_ops_);
   }
@@ -802,6 +810,7 @@ class ServerAsyncWriter final : public ServerAsyncWriterInterface<W> {
     write_ops_.set_output_tag(tag);
     EnsureInitialMetadataSent(&write_ops_);
     options.set_buffer_hint();
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg, options).ok());
     write_ops_.ServerSendStatus(ctx_->trailing_metadata_, status);
     call_.PerformOps(&write_ops_);
@@ -929,6 +938,7 @@ class ServerAsyncReaderWriter final
     write_ops_.set_output_tag(tag);
     EnsureInitialMetadataSent(&write_ops_);
     // TODO(ctiller): don't assert
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg).ok());
     call_.PerformOps(&write_ops_);
   }
@@ -939,6 +949,7 @@ class ServerAsyncReaderWriter final
       options.set_buffer_hint();
     }
     EnsureInitialMetadataSent(&write_ops_);
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg, options).ok());
     call_.PerformOps(&write_ops_);
   }
@@ -956,6 +967,7 @@ class ServerAsyncReaderWriter final
     write_ops_.set_output_tag(tag);
     EnsureInitialMetadataSent(&write_ops_);
     options.set_buffer_hint();
+    write_ops_.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg, options).ok());
     write_ops_.ServerSendStatus(ctx_->trailing_metadata_, status);
     call_.PerformOps(&write_ops_);
@@ -147,6 +147,7 @@ class ClientAsyncResponseReader final
       : context_(context), call_(call), started_(start) {
     // Bind the metadata at time of StartCallInternal but set up the rest here
     // TODO(ctiller): don't assert
+    init_buf.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(init_buf.SendMessage(request).ok());
     init_buf.ClientSendClose();
     if (start) StartCallInternal();
@@ -226,6 +227,7 @@ class ServerAsyncResponseWriter final : public ServerAsyncStreamingInterface {
     }
     // The response is dropped if the status is not OK.
     if (status.ok()) {
+      finish_buf_.set_pass_message_objects(call_.passes_message_objects());
       finish_buf_.ServerSendStatus(ctx_->trailing_metadata_,
                                    finish_buf_.SendMessage(msg));
     } else {
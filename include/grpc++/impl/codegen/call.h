@@ -280,7 +280,7 @@ class CallOpSendInitialMetadata {
 
 class CallOpSendMessage {
  public:
-  CallOpSendMessage() : send_buf_() {}
+  CallOpSendMessage() : send_buf_(), pass_message_objects_(false) {}
 
   /// Send \a message using \a options for the write. The \a options are cleared
   /// after use.
@@ -291,6 +291,10 @@ class CallOpSendMessage {
   template <class M>
   Status SendMessage(const M& message) GRPC_MUST_USE_RESULT;
 
+  /// Send messages as unserialized objects where MessageObjectTraits allows
+  /// it. Only set this for calls whose Call::passes_message_objects() is true.
+  void set_pass_message_objects(bool pass) { pass_message_objects_ = pass; }
+
  protected:
   void AddOp(grpc_op* ops, size_t* nops) {
     if (!send_buf_.Valid()) return;
@@ -307,6 +311,7 @@ class CallOpSendMessage {
  private:
   ByteBuffer send_buf_;
   WriteOptions write_options_;
+  bool pass_message_objects_;
 };
 
 namespace internal {
@@ -317,6 +322,10 @@ T Example();
 template <class M>
 Status CallOpSendMessage::SendMessage(const M& message, WriteOptions options) {
   write_options_ = options;
+  if (pass_message_objects_ &&
+      MessageObjectTraits<M>::Wrap(message, send_buf_.bbuf_ptr())) {
+    return g_core_codegen_interface->ok();
+  }
   bool own_buf;
   // TODO(vjpai): Remove the void below when possible
   // The void in the template parameter below should not be needed
@@ -365,6 +374,7 @@ class CallOpRecvMessage {
     if (recv_buf_.Valid()) {
       if (*status) {
         got_message = *status =
+            MessageObjectTraits<R>::Unwrap(recv_buf_.c_buffer(), message_) ||
             SerializationTraits<R>::Deserialize(recv_buf_.bbuf_ptr(), message_)
                 .ok();
         recv_buf_.Release();
@@ -399,6 +409,9 @@ class DeserializeFuncType final : public DeserializeFunc {
  public:
   DeserializeFuncType(R* message) : message_(message) {}
   Status Deserialize(ByteBuffer* buf) override {
+    if (MessageObjectTraits<R>::Unwrap(buf->c_buffer(), message_)) {
+      return g_core_codegen_interface->ok();
+    }
     return SerializationTraits<R>::Deserialize(buf->bbuf_ptr(), message_);
   }
 
@@ -706,6 +719,13 @@ class Call final {
   grpc_call* call() const { return call_; }
   CompletionQueue* cq() const { return cq_; }
 
+  /// True if messages on this call can be sent as unserialized objects
+  /// (see GRPC_ARG_INPROC_MESSAGE_OBJECTS)
+  bool passes_message_objects() const {
+    return call_ != nullptr &&
+           g_core_codegen_interface->grpc_call_passes_message_objects(call_);
+  }
+
   int max_receive_message_size() const { return max_receive_message_size_; }
 
  private:
@@ -45,6 +45,7 @@ Status BlockingUnaryCall(ChannelInterface* channel, const RpcMethod& method,
             CallOpRecvInitialMetadata, CallOpRecvMessage<OutputMessage>,
             CallOpClientSendClose, CallOpClientRecvStatus>
       ops;
+  ops.set_pass_message_objects(call.passes_message_objects());
   Status status = ops.SendMessage(request);
   if (!status.ok()) {
     return status;
@@ -67,6 +67,7 @@ class CoreCodegen final : public CoreCodegenInterface {
   void grpc_call_ref(grpc_call* call) override;
   void grpc_call_unref(grpc_call* call) override;
   virtual void* grpc_call_arena_alloc(grpc_call* call, size_t length) override;
+  bool grpc_call_passes_message_objects(grpc_call* call) override;
 
   grpc_byte_buffer* grpc_byte_buffer_copy(grpc_byte_buffer* bb) override;
   void grpc_byte_buffer_destroy(grpc_byte_buffer* bb) override;
@@ -80,6 +81,11 @@ class CoreCodegen final : public CoreCodegenInterface {
 
   grpc_byte_buffer* grpc_raw_byte_buffer_create(grpc_slice* slice,
                                                 size_t nslices) override;
+  grpc_byte_buffer* grpc_message_object_byte_buffer_create(
+      const grpc_message_object_vtable* vtable, void* object,
+      size_t length) override;
+  void* grpc_byte_buffer_take_message_object(
+      grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable) override;
   grpc_slice grpc_slice_new_with_user_data(void* p, size_t len,
                                            void (*destroy)(void*),
                                            void* user_data) override;
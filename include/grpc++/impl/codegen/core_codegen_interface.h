@@ -87,6 +87,11 @@ class CoreCodegenInterface {
 
   virtual grpc_byte_buffer* grpc_raw_byte_buffer_create(grpc_slice* slice,
                                                         size_t nslices) = 0;
+  virtual grpc_byte_buffer* grpc_message_object_byte_buffer_create(
+      const grpc_message_object_vtable* vtable, void* object,
+      size_t length) = 0;
+  virtual void* grpc_byte_buffer_take_message_object(
+      grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable) = 0;
   virtual grpc_slice grpc_slice_new_with_user_data(void* p, size_t len,
                                                    void (*destroy)(void*),
                                                    void* user_data) = 0;
@@ -97,6 +102,7 @@ class CoreCodegenInterface {
   virtual void grpc_call_ref(grpc_call* call) = 0;
   virtual void grpc_call_unref(grpc_call* call) = 0;
   virtual void* grpc_call_arena_alloc(grpc_call* call, size_t length) = 0;
+  virtual bool grpc_call_passes_message_objects(grpc_call* call) = 0;
   virtual grpc_slice grpc_empty_slice() = 0;
   virtual grpc_slice grpc_slice_malloc(size_t length) = 0;
   virtual void grpc_slice_unref(grpc_slice slice) = 0;
@@ -38,8 +38,11 @@ class RpcMethodHandler : public MethodHandler {
 
   void RunHandler(const HandlerParameter& param) final {
     RequestType req;
-    Status status = SerializationTraits<RequestType>::Deserialize(
-        param.request.bbuf_ptr(), &req);
+    Status status =
+        MessageObjectTraits<RequestType>::Unwrap(param.request.bbuf_ptr(), &req)
+            ? g_core_codegen_interface->ok()
+            : SerializationTraits<RequestType>::Deserialize(
+                  param.request.bbuf_ptr(), &req);
     ResponseType rsp;
     if (status.ok()) {
       status = func_(service_, param.server_context, &req, &rsp);
@@ -55,6 +58,7 @@ class RpcMethodHandler : public MethodHandler {
       ops.set_compression_level(param.server_context->compression_level());
     }
     if (status.ok()) {
+      ops.set_pass_message_objects(param.call->passes_message_objects());
       status = ops.SendMessage(rsp);
     }
     ops.ServerSendStatus(param.server_context->trailing_metadata_, status);
@@ -97,6 +101,7 @@ class ClientStreamingHandler : public MethodHandler {
       ops.set_compression_level(param.server_context->compression_level());
     }
     if (status.ok()) {
+      ops.set_pass_message_objects(param.call->passes_message_objects());
       status = ops.SendMessage(rsp);
     }
     ops.ServerSendStatus(param.server_context->trailing_metadata_, status);
@@ -124,8 +129,11 @@ class ServerStreamingHandler : public MethodHandler {
 
   void RunHandler(const HandlerParameter& param) final {
     RequestType req;
-    Status status = SerializationTraits<RequestType>::Deserialize(
-        param.request.bbuf_ptr(), &req);
+    Status status =
+        MessageObjectTraits<RequestType>::Unwrap(param.request.bbuf_ptr(), &req)
+            ? g_core_codegen_interface->ok()
+            : SerializationTraits<RequestType>::Deserialize(
+                  param.request.bbuf_ptr(), &req);
 
     if (status.ok()) {
       ServerWriter<ResponseType> writer(param.call, param.server_context);
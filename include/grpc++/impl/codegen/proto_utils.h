@@ -220,6 +220,54 @@ class SerializationTraits<T, typename std::enable_if<std::is_base_of<
   }
 };
 
+// Protobuf messages are passed as heap allocated copies; the receiving end
+// swaps the contents into its own message.
+template <class T>
+class MessageObjectTraits<T, typename std::enable_if<std::is_base_of<
+                                 grpc::protobuf::Message, T>::value>::type> {
+ public:
+  static bool Wrap(const T& msg, grpc_byte_buffer** bp) {
+    T* copy = new T(msg);
+    *bp = g_core_codegen_interface->grpc_message_object_byte_buffer_create(
+        vtable(), copy, copy->ByteSize());
+    return true;
+  }
+
+  static bool Unwrap(grpc_byte_buffer* buffer, T* msg) {
+    if (buffer == nullptr || buffer->type != GRPC_BB_OBJECT) return false;
+    T* object = static_cast<T*>(
+        g_core_codegen_interface->grpc_byte_buffer_take_message_object(
+            buffer, vtable()));
+    if (object == nullptr) return false;
+    msg->Swap(object);
+    delete object;
+    g_core_codegen_interface->grpc_byte_buffer_destroy(buffer);
+    return true;
+  }
+
+ private:
+  // The address of the vtable tags objects of type T
+  static const grpc_message_object_vtable* vtable() {
+    static const grpc_message_object_vtable vtable = {SerializeObject,
+                                                      DestroyObject};
+    return &vtable;
+  }
+
+  static grpc_byte_buffer* SerializeObject(void* object) {
+    grpc_byte_buffer* bp = nullptr;
+    bool own_buffer;
+    if (!SerializationTraits<T>::Serialize(*static_cast<T*>(object), &bp,
+                                           &own_buffer)
+             .ok()) {
+      g_core_codegen_interface->grpc_byte_buffer_destroy(bp);
+      return nullptr;
+    }
+    return bp;
+  }
+
+  static void DestroyObject(void* object) { delete static_cast<T*>(object); }
+};
+
 }  // namespace grpc
 
 #endif  // GRPCXX_IMPL_CODEGEN_PROTO_UTILS_H
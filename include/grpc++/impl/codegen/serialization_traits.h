@@ -19,6 +19,8 @@
 #ifndef GRPCXX_IMPL_CODEGEN_SERIALIZATION_TRAITS_H
 #define GRPCXX_IMPL_CODEGEN_SERIALIZATION_TRAITS_H
 
+#include <grpc/impl/codegen/grpc_types.h>
+
 namespace grpc {
 
 /// Defines how to serialize and deserialize some type.
@@ -57,6 +59,29 @@ template <class Message,
           class UnusedButHereForPartialTemplateSpecialization = void>
 class SerializationTraits;
 
+/// Defines how to pass some type between the two ends of an in-process call
+/// as an object, without serializing it (see GRPC_ARG_INPROC_MESSAGE_OBJECTS).
+///
+/// 1.  static bool Wrap(const Message& msg, grpc_byte_buffer** buffer);
+///     Stores a copy of msg into a new GRPC_BB_OBJECT byte buffer returned
+///     through *buffer, or returns false to have msg serialized instead.
+///
+/// 2.  static bool Unwrap(grpc_byte_buffer* buffer, Message* msg);
+///     If buffer holds a Message object, moves it into msg, destroys buffer
+///     and returns true. Otherwise leaves buffer alone and returns false, and
+///     buffer is deserialized with SerializationTraits.
+///
+/// The default passes no types as objects.
+template <class Message,
+          class UnusedButHereForPartialTemplateSpecialization = void>
+class MessageObjectTraits {
+ public:
+  static bool Wrap(const Message& msg, grpc_byte_buffer** buffer) {
+    return false;
+  }
+  static bool Unwrap(grpc_byte_buffer* buffer, Message* msg) { return false; }
+};
+
 }  // namespace grpc
 
 #endif  // GRPCXX_IMPL_CODEGEN_SERIALIZATION_TRAITS_H
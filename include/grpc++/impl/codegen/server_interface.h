@@ -189,8 +189,9 @@ class ServerInterface : public CallHook {
     bool FinalizeResult(void** tag, bool* status) override {
       if (*status) {
         if (payload_ == nullptr ||
-            !SerializationTraits<Message>::Deserialize(payload_, request_)
-                 .ok()) {
+            (!MessageObjectTraits<Message>::Unwrap(payload_, request_) &&
+             !SerializationTraits<Message>::Deserialize(payload_, request_)
+                  .ok())) {
           // If deserialization fails, we cancel the call and instantiate
           // a new instance of ourselves to request another call.  We then
           // return false, which prevents the call from being returned to
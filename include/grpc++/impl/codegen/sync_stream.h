@@ -176,6 +176,7 @@ class ClientReader final : public ClientReaderInterface<R> {
     ops.SendInitialMetadata(context->send_initial_metadata_,
                             context->initial_metadata_flags());
     // TODO(ctiller): don't assert
+    ops.set_pass_message_objects(call_.passes_message_objects());
     GPR_CODEGEN_ASSERT(ops.SendMessage(request).ok());
     ops.ClientSendClose();
     call_.PerformOps(&ops);
@@ -319,6 +320,7 @@ class ClientWriter : public ClientWriterInterface<W> {
                               context_->initial_metadata_flags());
       context_->set_initial_metadata_corked(false);
     }
+    ops.set_pass_message_objects(call_.passes_message_objects());
     if (!ops.SendMessage(msg, options).ok()) {
       return false;
     }
@@ -463,6 +465,7 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
                               context_->initial_metadata_flags());
       context_->set_initial_metadata_corked(false);
     }
+    ops.set_pass_message_objects(call_.passes_message_objects());
     if (!ops.SendMessage(msg, options).ok()) {
       return false;
     }
@@ -589,6 +592,8 @@ class ServerWriter final : public ServerWriterInterface<W> {
     if (options.is_last_message()) {
       options.set_buffer_hint();
     }
+    ctx_->pending_ops_.set_pass_message_objects(
+        call_->passes_message_objects());
     if (!ctx_->pending_ops_.SendMessage(msg, options).ok()) {
       return false;
     }
@@ -661,6 +666,8 @@ class ServerReaderWriterBody final {
     if (options.is_last_message()) {
       options.set_buffer_hint();
     }
+    ctx_->pending_ops_.set_pass_message_objects(
+        call_->passes_message_objects());
     if (!ctx_->pending_ops_.SendMessage(msg, options).ok()) {
       return false;
     }
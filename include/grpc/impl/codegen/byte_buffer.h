@@ -41,10 +41,24 @@ GRPCAPI grpc_byte_buffer *grpc_raw_byte_buffer_create(grpc_slice *slices,
 GRPCAPI grpc_byte_buffer *grpc_raw_compressed_byte_buffer_create(
     grpc_slice *slices, size_t nslices, grpc_compression_algorithm compression);
 
+/** Returns a GRPC_BB_OBJECT byte buffer holding \a object, which serializes
+ * to \a length bytes. The byte buffer takes ownership of \a object.
+ * EXPERIMENTAL. */
+GRPCAPI grpc_byte_buffer *grpc_message_object_byte_buffer_create(
+    const grpc_message_object_vtable *vtable, void *object, size_t length);
+
+/** If \a bb holds a message object of the type tagged by \a vtable, returns
+ * the object and passes its ownership to the caller. Returns NULL otherwise.
+ * EXPERIMENTAL. */
+GRPCAPI void *grpc_byte_buffer_take_message_object(
+    grpc_byte_buffer *bb, const grpc_message_object_vtable *vtable);
+
 /** Copies input byte buffer \a bb.
  *
  * Increases the reference count of all the source slices. The user is
- * responsible for calling grpc_byte_buffer_destroy over the returned copy. */
+ * responsible for calling grpc_byte_buffer_destroy over the returned copy.
+ * A GRPC_BB_OBJECT \a bb is serialized in place first; NULL is returned if
+ * that fails. */
 GRPCAPI grpc_byte_buffer *grpc_byte_buffer_copy(grpc_byte_buffer *bb);
 
 /** Returns the size of the given byte buffer, in bytes. */
@@ -57,7 +71,8 @@ GRPCAPI void grpc_byte_buffer_destroy(grpc_byte_buffer *byte_buffer);
 struct grpc_byte_buffer_reader;
 typedef struct grpc_byte_buffer_reader grpc_byte_buffer_reader;
 
-/** Initialize \a reader to read over \a buffer.
+/** Initialize \a reader to read over \a buffer. A GRPC_BB_OBJECT \a buffer is
+ * first serialized in place, turning it into a RAW buffer.
  * Returns 1 upon success, 0 otherwise. */
 GRPCAPI int grpc_byte_buffer_reader_init(grpc_byte_buffer_reader *reader,
                                          grpc_byte_buffer *buffer);
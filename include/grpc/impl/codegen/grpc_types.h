@@ -34,10 +34,23 @@ extern "C" {
 #endif
 
 typedef enum {
-  GRPC_BB_RAW
+  GRPC_BB_RAW,
+  /** An unserialized message object, see grpc_message_object_vtable */
+  GRPC_BB_OBJECT
   /** Future types may include GRPC_BB_PROTOBUF, etc. */
 } grpc_byte_buffer_type;
 
+/** Operations on the message object held by a GRPC_BB_OBJECT byte buffer.
+    Each message type has a single vtable, so the vtable address also tags the
+    type of the object. EXPERIMENTAL. */
+typedef struct grpc_message_object_vtable {
+  /** Serialize \a object into a new RAW byte buffer, or return NULL on
+      failure. Does not consume \a object. */
+  struct grpc_byte_buffer *(*serialize)(void *object);
+  /** Destroy \a object */
+  void (*destroy)(void *object);
+} grpc_message_object_vtable;
+
 typedef struct grpc_byte_buffer {
   void *reserved;
   grpc_byte_buffer_type type;
@@ -49,6 +62,13 @@ typedef struct grpc_byte_buffer {
       grpc_compression_algorithm compression;
       grpc_slice_buffer slice_buffer;
     } raw;
+    struct grpc_message_object_buffer {
+      const grpc_message_object_vtable *vtable;
+      /** NULL once the object has been taken */
+      void *object;
+      /** serialized size of the object */
+      size_t length;
+    } object;
   } data;
 } grpc_byte_buffer;
 
@@ -168,6 +188,13 @@ typedef struct {
 /** Enable/disable support for deadline checking. Defaults to 1, unless
     GRPC_ARG_MINIMAL_STACK is enabled, in which case it defaults to 0 */
 #define GRPC_ARG_ENABLE_DEADLINE_CHECKS "grpc.enable_deadline_checking"
+/** Call deadlines further away than this many milliseconds are not given a
+    timer when the call starts: the channel keeps them on a coarse list
+    instead, and only arms a timer once they come within this horizon. Most
+    calls finish well before their deadline, which saves arming and
+    cancelling a timer for each of them. 0 gives every deadline a timer
+    immediately. Int valued, defaults to 10000. */
+#define GRPC_ARG_DEADLINE_TIMER_HORIZON_MS "grpc.deadline_timer_horizon_ms"
 /** Initial stream ID for http2 transports. Int valued. */
 #define GRPC_ARG_HTTP2_INITIAL_SEQUENCE_NUMBER \
   "grpc.http2.initial_sequence_number"
@@ -286,6 +313,26 @@ typedef struct {
   "grpc.experimental.tcp_min_read_chunk_size"
 #define GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE \
   "grpc.experimental.tcp_max_read_chunk_size"
+/** If non-zero, client TCP connections use TCP Fast Open where the platform
+    supports it (TCP_FASTOPEN_CONNECT on Linux): once the kernel has a fast
+    open cookie for the server, connect() completes immediately and the first
+    write (the HTTP/2 preface or the TLS ClientHello) is sent in the SYN.
+    Connection errors then surface on that write rather than on connect().
+    Requires bit 0 of net.ipv4.tcp_fastopen. EXPERIMENTAL. */
+#define GRPC_ARG_TCP_FASTOPEN_CONNECT "grpc.experimental.tcp_fastopen_connect"
+/** Integer: if positive, TCP listeners of a server accept TCP Fast Open
+    where the platform supports it, with at most this many fast open
+    connections that have not completed their handshake (TCP_FASTOPEN on
+    Linux). Requires bit 1 of net.ipv4.tcp_fastopen. EXPERIMENTAL. */
+#define GRPC_ARG_TCP_FASTOPEN_QUEUE_LENGTH \
+  "grpc.experimental.tcp_fastopen_queue_length"
+/** Integer: if positive, TCP connections keep at most about this many bytes
+    queued in the kernel that have not been sent yet (TCP_NOTSENT_LOWAT on
+    Linux), and the HTTP/2 transport frames at most this many bytes per
+    write. Frames queued later (such as small responses, WINDOW_UPDATEs and
+    PING acks) then wait behind this much bulk data rather than a full socket
+    send buffer. Small values cost more writes. EXPERIMENTAL. */
+#define GRPC_ARG_TCP_NOTSENT_LOWAT "grpc.experimental.tcp_notsent_lowat"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -304,6 +351,11 @@ typedef struct {
     Defaults to "blend". In the current implementation "blend" is equivalent to
     "latency". */
 #define GRPC_ARG_OPTIMIZATION_TARGET "grpc.optimization_target"
+/** If non-zero on both an in-process channel and its server, messages sent
+    between them are passed as GRPC_BB_OBJECT byte buffers instead of being
+    serialized, and are only serialized if something needs their bytes.
+    Used by the C++ API for protobuf messages. EXPERIMENTAL. */
+#define GRPC_ARG_INPROC_MESSAGE_OBJECTS "grpc.inproc.message_objects"
 /** \} */
 
 /** Result of a grpc call. If the caller satisfies the prerequisites of a
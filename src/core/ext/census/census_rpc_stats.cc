@@ -19,8 +19,11 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
+#include <grpc/support/useful.h>
 #include "src/core/ext/census/census_interface.h"
 #include "src/core/ext/census/census_rpc_stats.h"
 #include "src/core/ext/census/census_tracing.h"
@@ -37,17 +40,50 @@
 /* for easier typing */
 typedef census_per_method_rpc_stats per_method_stats;
 
-/* Ensure mu is only initialized once. */
-static gpr_once g_stats_store_mu_init = GPR_ONCE_INIT;
-/* Guards two stats stores. */
-static gpr_mu g_mu;
-static census_ht *g_client_stats_store = NULL;
-static census_ht *g_server_stats_store = NULL;
+/* Stats are recorded into the shard of the CPU the caller is running on, so
+   that concurrent RPCs on different CPUs do not serialize on one lock. Each
+   shard keeps its own window_stats per method; readers merge the per-interval
+   sums of all shards, which add up to what a single store would have. CPUs
+   beyond MAX_SHARDS share shards. */
+#define MAX_SHARDS 32
 
-static void init_mutex(void) { gpr_mu_init(&g_mu); }
+typedef struct stats_shard {
+  /* Guards the shard's two stats stores. */
+  gpr_mu mu;
+  census_ht *client_stats_store;
+  census_ht *server_stats_store;
+} stats_shard;
 
-static void init_mutex_once(void) {
-  gpr_once_init(&g_stats_store_mu_init, init_mutex);
+typedef union {
+  stats_shard shard;
+  /* keep shards for different CPUs off each other's cache lines */
+  char padding[GPR_CACHELINE_SIZE *
+               ((sizeof(stats_shard) + GPR_CACHELINE_SIZE - 1) /
+                GPR_CACHELINE_SIZE)];
+} padded_stats_shard;
+
+/* Ensure shards are only created once. They are never freed, so recording
+   needs no global lock to find its shard. */
+static gpr_once g_shards_init = GPR_ONCE_INIT;
+static padded_stats_shard *g_shards;
+static size_t g_num_shards;
+
+static void init_shards(void) {
+  g_num_shards = GPR_CLAMP(gpr_cpu_num_cores(), 1, MAX_SHARDS);
+  g_shards = (padded_stats_shard *)gpr_zalloc(sizeof(padded_stats_shard) *
+                                              g_num_shards);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    gpr_mu_init(&g_shards[i].shard.mu);
+  }
+}
+
+static void init_shards_once(void) {
+  gpr_once_init(&g_shards_init, init_shards);
+}
+
+static stats_shard *current_shard(void) {
+  init_shards_once();
+  return &g_shards[gpr_cpu_current_cpu() % g_num_shards].shard;
 }
 
 static int cmp_str_keys(const void *k1, const void *k2) {
@@ -56,7 +92,7 @@ static int cmp_str_keys(const void *k1, const void *k2) {
 
 /* TODO(hongyu): replace it with cityhash64 */
 static uint64_t simple_hash(const void *k) {
-  size_t len = strlen(k);
+  size_t len = strlen((const char *)k);
   uint64_t higher = gpr_murmur_hash3((const char *)k, len / 2, 0);
   return higher << 32 |
          gpr_murmur_hash3((const char *)k + len / 2, len - len / 2, 0);
@@ -74,6 +110,14 @@ static const census_ht_option ht_opt = {
     delete_stats /* data deleter */,  delete_key /* key deleter */
 };
 
+/* Maps method names to their index in the stats being merged; the names are
+   owned by the merged stats */
+static const census_ht_option merge_ht_opt = {
+    CENSUS_HT_POINTER /* key type */, 1999 /* n_of_buckets */,
+    simple_hash /* hash function */,  cmp_str_keys /* key comparator */,
+    NULL /* data deleter */,          NULL /* key deleter */
+};
+
 static void init_rpc_stats(void *stats) {
   memset(stats, 0, sizeof(census_rpc_stats));
 }
@@ -122,117 +166,152 @@ void census_aggregated_rpc_stats_set_empty(census_aggregated_rpc_stats *data) {
   data->stats = NULL;
 }
 
-static void record_stats(census_ht *store, census_op_id op_id,
+static census_ht *shard_store(stats_shard *shard, bool server) {
+  return server ? shard->server_stats_store : shard->client_stats_store;
+}
+
+static void record_stats(bool server, census_op_id op_id,
                          const census_rpc_stats *stats) {
-  gpr_mu_lock(&g_mu);
+  stats_shard *shard = current_shard();
+  gpr_mu_lock(&shard->mu);
+  census_ht *store = shard_store(shard, server);
   if (store != NULL) {
     census_trace_obj *trace = NULL;
+    struct census_window_stats *window_stats = NULL;
     census_internal_lock_trace_store();
     trace = census_get_trace_obj_locked(op_id);
     if (trace != NULL) {
-      const char *method_name = census_get_trace_method_name(trace);
-      struct census_window_stats *window_stats = NULL;
       census_ht_key key;
-      key.ptr = (void *)method_name;
-      window_stats = census_ht_find(store, key);
-      census_internal_unlock_trace_store();
+      key.ptr = (void *)census_get_trace_method_name(trace);
+      window_stats = (struct census_window_stats *)census_ht_find(store, key);
       if (window_stats == NULL) {
         window_stats = census_window_stats_create(3, min_hour_total_intervals,
                                                   30, &window_stats_settings);
-        key.ptr = gpr_strdup(key.ptr);
+        /* copy the name while the trace object is still locked */
+        key.ptr = gpr_strdup((const char *)key.ptr);
         census_ht_insert(store, key, (void *)window_stats);
       }
+    }
+    census_internal_unlock_trace_store();
+    if (window_stats != NULL) {
       census_window_stats_add(window_stats, gpr_now(GPR_CLOCK_REALTIME), stats);
-    } else {
-      census_internal_unlock_trace_store();
     }
   }
-  gpr_mu_unlock(&g_mu);
+  gpr_mu_unlock(&shard->mu);
 }
 
 void census_record_rpc_client_stats(census_op_id op_id,
                                     const census_rpc_stats *stats) {
-  record_stats(g_client_stats_store, op_id, stats);
+  record_stats(false, op_id, stats);
 }
 
 void census_record_rpc_server_stats(census_op_id op_id,
                                     const census_rpc_stats *stats) {
-  record_stats(g_server_stats_store, op_id, stats);
+  record_stats(true, op_id, stats);
 }
 
-/* Get stats from input stats store */
-static void get_stats(census_ht *store, census_aggregated_rpc_stats *data) {
+/* Adds the stats one shard keeps for each method into data, appending methods
+   not seen in earlier shards. methods maps the method names in data to their
+   index + 1. */
+static void merge_shard_stats(census_ht *store, gpr_timespec now,
+                              census_ht *methods, size_t *capacity,
+                              census_aggregated_rpc_stats *data) {
+  size_t n;
+  census_ht_kv *kv = census_ht_get_all_elements(store, &n);
+  if (kv == NULL) return;
+  for (size_t i = 0; i < n; i++) {
+    intptr_t index = (intptr_t)census_ht_find(methods, kv[i].k) - 1;
+    if (index < 0) {
+      if ((size_t)data->num_entries == *capacity) {
+        *capacity = GPR_MAX(2 * *capacity, 8);
+        data->stats = (per_method_stats *)gpr_realloc(
+            data->stats, sizeof(per_method_stats) * *capacity);
+      }
+      index = data->num_entries++;
+      memset(&data->stats[index], 0, sizeof(per_method_stats));
+      data->stats[index].method = gpr_strdup((const char *)kv[i].k.ptr);
+      census_ht_key key;
+      key.ptr = (void *)data->stats[index].method;
+      census_ht_insert(methods, key, (void *)(index + 1));
+    }
+    census_rpc_stats sum_stats[NUM_INTERVALS];
+    census_window_stats_sums sums[NUM_INTERVALS];
+    for (size_t j = 0; j < NUM_INTERVALS; j++) {
+      init_rpc_stats(&sum_stats[j]);
+      sums[j].statistic = &sum_stats[j];
+    }
+    census_window_stats_get_sums((struct census_window_stats *)kv[i].v, now,
+                                 sums);
+    stat_add(&data->stats[index].minute_stats, &sum_stats[MINUTE_INTERVAL]);
+    stat_add(&data->stats[index].hour_stats, &sum_stats[HOUR_INTERVAL]);
+    stat_add(&data->stats[index].total_stats, &sum_stats[TOTAL_INTERVAL]);
+  }
+  gpr_free(kv);
+}
+
+/* Get stats from the client or server stats stores of all shards */
+static void get_stats(bool server, census_aggregated_rpc_stats *data) {
   GPR_ASSERT(data != NULL);
   if (data->num_entries != 0) {
     census_aggregated_rpc_stats_set_empty(data);
   }
-  gpr_mu_lock(&g_mu);
-  if (store != NULL) {
-    size_t n;
-    unsigned i, j;
-    gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
-    census_ht_kv *kv = census_ht_get_all_elements(store, &n);
-    if (kv != NULL) {
-      data->num_entries = n;
-      data->stats =
-          (per_method_stats *)gpr_malloc(sizeof(per_method_stats) * n);
-      for (i = 0; i < n; i++) {
-        census_window_stats_sums sums[NUM_INTERVALS];
-        for (j = 0; j < NUM_INTERVALS; j++) {
-          sums[j].statistic = (void *)census_rpc_stats_create_empty();
-        }
-        data->stats[i].method = gpr_strdup(kv[i].k.ptr);
-        census_window_stats_get_sums(kv[i].v, now, sums);
-        data->stats[i].minute_stats =
-            *(census_rpc_stats *)sums[MINUTE_INTERVAL].statistic;
-        data->stats[i].hour_stats =
-            *(census_rpc_stats *)sums[HOUR_INTERVAL].statistic;
-        data->stats[i].total_stats =
-            *(census_rpc_stats *)sums[TOTAL_INTERVAL].statistic;
-        for (j = 0; j < NUM_INTERVALS; j++) {
-          gpr_free(sums[j].statistic);
-        }
-      }
-      gpr_free(kv);
+  init_shards_once();
+  census_ht *methods = census_ht_create(&merge_ht_opt);
+  size_t capacity = 0;
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    stats_shard *shard = &g_shards[i].shard;
+    gpr_mu_lock(&shard->mu);
+    census_ht *store = shard_store(shard, server);
+    if (store != NULL) {
+      merge_shard_stats(store, now, methods, &capacity, data);
     }
+    gpr_mu_unlock(&shard->mu);
   }
-  gpr_mu_unlock(&g_mu);
+  census_ht_destroy(methods);
 }
 
 void census_get_client_stats(census_aggregated_rpc_stats *data) {
-  get_stats(g_client_stats_store, data);
+  get_stats(false, data);
 }
 
 void census_get_server_stats(census_aggregated_rpc_stats *data) {
-  get_stats(g_server_stats_store, data);
+  get_stats(true, data);
 }
 
 void census_stats_store_init(void) {
-  init_mutex_once();
-  gpr_mu_lock(&g_mu);
-  if (g_client_stats_store == NULL && g_server_stats_store == NULL) {
-    g_client_stats_store = census_ht_create(&ht_opt);
-    g_server_stats_store = census_ht_create(&ht_opt);
-  } else {
-    gpr_log(GPR_ERROR, "Census stats store already initialized.");
+  init_shards_once();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    stats_shard *shard = &g_shards[i].shard;
+    gpr_mu_lock(&shard->mu);
+    if (shard->client_stats_store == NULL &&
+        shard->server_stats_store == NULL) {
+      shard->client_stats_store = census_ht_create(&ht_opt);
+      shard->server_stats_store = census_ht_create(&ht_opt);
+    } else if (i == 0) {
+      gpr_log(GPR_ERROR, "Census stats store already initialized.");
+    }
+    gpr_mu_unlock(&shard->mu);
   }
-  gpr_mu_unlock(&g_mu);
 }
 
 void census_stats_store_shutdown(void) {
-  init_mutex_once();
-  gpr_mu_lock(&g_mu);
-  if (g_client_stats_store != NULL) {
-    census_ht_destroy(g_client_stats_store);
-    g_client_stats_store = NULL;
-  } else {
-    gpr_log(GPR_ERROR, "Census server stats store not initialized.");
-  }
-  if (g_server_stats_store != NULL) {
-    census_ht_destroy(g_server_stats_store);
-    g_server_stats_store = NULL;
-  } else {
-    gpr_log(GPR_ERROR, "Census client stats store not initialized.");
+  init_shards_once();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    stats_shard *shard = &g_shards[i].shard;
+    gpr_mu_lock(&shard->mu);
+    if (shard->client_stats_store != NULL) {
+      census_ht_destroy(shard->client_stats_store);
+      shard->client_stats_store = NULL;
+    } else if (i == 0) {
+      gpr_log(GPR_ERROR, "Census server stats store not initialized.");
+    }
+    if (shard->server_stats_store != NULL) {
+      census_ht_destroy(shard->server_stats_store);
+      shard->server_stats_store = NULL;
+    } else if (i == 0) {
+      gpr_log(GPR_ERROR, "Census client stats store not initialized.");
+    }
+    gpr_mu_unlock(&shard->mu);
   }
-  gpr_mu_unlock(&g_mu);
 }
@@ -29,15 +29,31 @@
 
 #include "src/core/ext/census/census_interface.h"
 #include "src/core/ext/census/census_rpc_stats.h"
+#include "src/core/ext/census/trace_context.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/transport/static_metadata.h"
 
+/* What a server call publishes in GRPC_CONTEXT_CENSUS_TRACE once it has
+   received a sampled trace context */
+typedef struct census_trace_propagation {
+  google_trace_TraceContext trace_ctxt;
+  /* the received grpc-trace-bin element, sent unchanged on child calls */
+  grpc_mdelem md;
+} census_trace_propagation;
+
 typedef struct call_data {
   census_op_id op_id;
   census_context *ctxt;
   gpr_timespec start_ts;
   int error;
+  grpc_call_context_element *context;
+  grpc_call_combiner *call_combiner;
+
+  /* server: the trace context received with the call, if sampled */
+  census_trace_propagation trace;
+  /* client: storage for grpc-trace-bin taken from the parent call */
+  grpc_linked_mdelem trace_storage;
 
   /* recv callback */
   grpc_metadata_batch *recv_initial_metadata;
@@ -58,23 +74,67 @@ static void extract_and_annotate_method_tag(grpc_metadata_batch *md,
   }
 }
 
-static void client_mutate_op(grpc_call_element *elem,
-                             grpc_transport_stream_op_batch *op) {
+/* Sends the trace context of a sampled parent call on to the server, reusing
+   the parent's encoded element. */
+static grpc_error *propagate_trace_context(grpc_exec_ctx *exec_ctx,
+                                          grpc_metadata_batch *md,
+                                          call_data *calld) {
+  if (calld->context == NULL || md->idx.named.grpc_trace_bin != NULL) {
+    return GRPC_ERROR_NONE;
+  }
+  census_trace_propagation *parent =
+      (census_trace_propagation *)calld->context[GRPC_CONTEXT_CENSUS_TRACE]
+          .value;
+  if (parent == NULL) return GRPC_ERROR_NONE;
+  return grpc_metadata_batch_add_tail(exec_ctx, md, &calld->trace_storage,
+                                      GRPC_MDELEM_REF(parent->md));
+}
+
+static grpc_error *client_mutate_op(grpc_exec_ctx *exec_ctx,
+                                    grpc_call_element *elem,
+                                    grpc_transport_stream_op_batch *op) {
   call_data *calld = (call_data *)elem->call_data;
   channel_data *chand = (channel_data *)elem->channel_data;
   if (op->send_initial_metadata) {
-    extract_and_annotate_method_tag(
-        op->payload->send_initial_metadata.send_initial_metadata, calld, chand);
+    grpc_metadata_batch *md =
+        op->payload->send_initial_metadata.send_initial_metadata;
+    extract_and_annotate_method_tag(md, calld, chand);
+    return propagate_trace_context(exec_ctx, md, calld);
   }
+  return GRPC_ERROR_NONE;
 }
 
 static void client_start_transport_op(grpc_exec_ctx *exec_ctx,
                                       grpc_call_element *elem,
                                       grpc_transport_stream_op_batch *op) {
-  client_mutate_op(elem, op);
+  grpc_error *error = client_mutate_op(exec_ctx, elem, op);
+  if (error != GRPC_ERROR_NONE) {
+    call_data *calld = (call_data *)elem->call_data;
+    grpc_transport_stream_op_batch_finish_with_failure(exec_ctx, op, error,
+                                                       calld->call_combiner);
+    return;
+  }
   grpc_call_next_op(exec_ctx, elem, op);
 }
 
+/* Decodes the trace context sent by the client straight from the metadata
+   value. Only a sampled context is kept, and published for child calls;
+   unsampled calls allocate nothing. */
+static void extract_trace_context(grpc_metadata_batch *md, call_data *calld) {
+  grpc_linked_mdelem *trace_md = md->idx.named.grpc_trace_bin;
+  if (trace_md == NULL || calld->context == NULL) return;
+  grpc_slice value = GRPC_MDVALUE(trace_md->md);
+  if (!decode_trace_context_fast(&calld->trace.trace_ctxt,
+                                 GRPC_SLICE_START_PTR(value),
+                                 GRPC_SLICE_LENGTH(value)) ||
+      !calld->trace.trace_ctxt.has_span_options ||
+      (calld->trace.trace_ctxt.span_options & SPAN_OPTIONS_IS_SAMPLED) == 0) {
+    return;
+  }
+  calld->trace.md = GRPC_MDELEM_REF(trace_md->md);
+  calld->context[GRPC_CONTEXT_CENSUS_TRACE].value = &calld->trace;
+}
+
 static void server_on_done_recv(grpc_exec_ctx *exec_ctx, void *ptr,
                                 grpc_error *error) {
   GPR_TIMER_BEGIN("census-server:server_on_done_recv", 0);
@@ -83,6 +143,7 @@ static void server_on_done_recv(grpc_exec_ctx *exec_ctx, void *ptr,
   channel_data *chand = (channel_data *)elem->channel_data;
   if (error == GRPC_ERROR_NONE) {
     extract_and_annotate_method_tag(calld->recv_initial_metadata, calld, chand);
+    extract_trace_context(calld->recv_initial_metadata, calld);
   }
   calld->on_done_recv->cb(exec_ctx, calld->on_done_recv->cb_arg, error);
   GPR_TIMER_END("census-server:server_on_done_recv", 0);
@@ -121,6 +182,8 @@ static grpc_error *client_init_call_elem(grpc_exec_ctx *exec_ctx,
   GPR_ASSERT(d != NULL);
   memset(d, 0, sizeof(*d));
   d->start_ts = args->start_time;
+  d->context = args->context;
+  d->call_combiner = args->call_combiner;
   return GRPC_ERROR_NONE;
 }
 
@@ -140,6 +203,9 @@ static grpc_error *server_init_call_elem(grpc_exec_ctx *exec_ctx,
   GPR_ASSERT(d != NULL);
   memset(d, 0, sizeof(*d));
   d->start_ts = args->start_time;
+  d->context = args->context;
+  d->call_combiner = args->call_combiner;
+  d->trace.md = GRPC_MDNULL;
   /* TODO(hongyu): call census_tracing_start_op here. */
   GRPC_CLOSURE_INIT(&d->finish_recv, server_on_done_recv, elem,
                     grpc_schedule_on_exec_ctx);
@@ -153,6 +219,7 @@ static void server_destroy_call_elem(grpc_exec_ctx *exec_ctx,
   call_data *d = (call_data *)elem->call_data;
   GPR_ASSERT(d != NULL);
   /* TODO(hongyu): record rpc server stats and census_tracing_end_op here */
+  GRPC_MDELEM_UNREF(exec_ctx, d->trace.md);
 }
 
 static grpc_error *init_channel_elem(grpc_exec_ctx *exec_ctx,
@@ -69,3 +69,44 @@ bool decode_trace_context(google_trace_TraceContext *ctxt, uint8_t *buffer,
 
   return true;
 }
+
+/* Field keys of the fixed-layout encoding: (field number << 3) | wire type,
+   with wire type 1 for fixed64 and 5 for fixed32. */
+#define TRACE_ID_HI_KEY ((google_trace_TraceContext_trace_id_hi_tag << 3) | 1)
+#define TRACE_ID_LO_KEY ((google_trace_TraceContext_trace_id_lo_tag << 3) | 1)
+#define SPAN_ID_KEY ((google_trace_TraceContext_span_id_tag << 3) | 1)
+#define SPAN_OPTIONS_KEY ((google_trace_TraceContext_span_options_tag << 3) | 5)
+#define FIXED_IDS_SIZE (3 * (1 + 8))
+#define FIXED_OPTIONS_SIZE (1 + 4)
+
+static uint64_t load_fixed64(const uint8_t *p) {
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+  return v;
+}
+
+static uint32_t load_fixed32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+bool decode_trace_context_fast(google_trace_TraceContext *ctxt,
+                               const uint8_t *buffer, const size_t nbytes) {
+  if ((nbytes == FIXED_IDS_SIZE ||
+       (nbytes == FIXED_IDS_SIZE + FIXED_OPTIONS_SIZE &&
+        buffer[FIXED_IDS_SIZE] == SPAN_OPTIONS_KEY)) &&
+      buffer[0] == TRACE_ID_HI_KEY && buffer[9] == TRACE_ID_LO_KEY &&
+      buffer[18] == SPAN_ID_KEY) {
+    ctxt->has_trace_id_hi = true;
+    ctxt->trace_id_hi = load_fixed64(buffer + 1);
+    ctxt->has_trace_id_lo = true;
+    ctxt->trace_id_lo = load_fixed64(buffer + 10);
+    ctxt->has_span_id = true;
+    ctxt->span_id = load_fixed64(buffer + 19);
+    ctxt->has_span_options = nbytes > FIXED_IDS_SIZE;
+    ctxt->span_options =
+        ctxt->has_span_options ? load_fixed32(buffer + FIXED_IDS_SIZE + 1) : 0;
+    return true;
+  }
+  return decode_trace_context(ctxt, (uint8_t *)buffer, nbytes);
+}
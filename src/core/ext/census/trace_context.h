@@ -57,6 +57,14 @@ of these do not exist. On success, returns true and false otherwise. */
 bool decode_trace_context(google_trace_TraceContext *ctxt, uint8_t *buffer,
                           const size_t nbytes);
 
+/* As decode_trace_context(), but reads the layout encode_trace_context()
+writes - trace_id_hi, trace_id_lo and span_id, optionally followed by
+span_options, in field order - at fixed offsets without going through nanopb
+or logging. Any other encoding falls back to decode_trace_context(). Neither
+path allocates. */
+bool decode_trace_context_fast(google_trace_TraceContext *ctxt,
+                               const uint8_t *buffer, const size_t nbytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -197,6 +197,8 @@ typedef struct client_channel_channel_data {
   bool exit_idle_when_lb_policy_arrives;
   /** owning stack */
   grpc_channel_stack *owning_stack;
+  /** far away call deadlines, not yet given a timer */
+  grpc_deadline_list deadline_list;
   /** interested parties (owned) */
   grpc_pollset_set *interested_parties;
 
@@ -706,6 +708,8 @@ static grpc_error *cc_init_channel_elem(grpc_exec_ctx *exec_ctx,
   gpr_mu_unlock(&chand->external_connectivity_watcher_list_mu);
 
   chand->owning_stack = args->channel_stack;
+  grpc_deadline_list_init(&chand->deadline_list, args->channel_stack,
+                          args->channel_args);
   GRPC_CLOSURE_INIT(&chand->on_resolver_result_changed,
                     on_resolver_result_changed_locked, chand,
                     grpc_combiner_scheduler(chand->combiner));
@@ -795,6 +799,7 @@ static void cc_destroy_channel_elem(grpc_exec_ctx *exec_ctx,
   GRPC_COMBINER_UNREF(exec_ctx, chand->combiner, "client_channel");
   gpr_mu_destroy(&chand->info_mu);
   gpr_mu_destroy(&chand->external_connectivity_watcher_list_mu);
+  grpc_deadline_list_destroy(&chand->deadline_list);
 }
 
 /*************************************************************************
@@ -1430,7 +1435,8 @@ static grpc_error *cc_init_call_elem(grpc_exec_ctx *exec_ctx,
   calld->call_combiner = args->call_combiner;
   if (chand->deadline_checking_enabled) {
     grpc_deadline_state_init(exec_ctx, elem, args->call_stack,
-                             args->call_combiner, calld->deadline);
+                             args->call_combiner, &chand->deadline_list,
+                             calld->deadline);
   }
   return GRPC_ERROR_NONE;
 }
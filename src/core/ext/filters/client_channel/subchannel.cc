@@ -478,7 +478,10 @@ static void maybe_start_connecting_locked(grpc_exec_ctx *exec_ctx,
       gpr_log(GPR_INFO, "Retry in %" PRIdPTR " milliseconds", time_til_next);
     }
     GRPC_CLOSURE_INIT(&c->on_alarm, on_alarm, c, grpc_schedule_on_exec_ctx);
-    grpc_timer_init(exec_ctx, &c->alarm, c->next_attempt, &c->on_alarm);
+    /* the backoff is jittered already: a little more does not matter */
+    grpc_timer_init_with_slack(exec_ctx, &c->alarm, c->next_attempt,
+                               GRPC_TIMER_SLACK_FOR_INTERVAL(time_til_next),
+                               &c->on_alarm);
   }
 }
 
@@ -36,55 +36,58 @@ static gpr_mu g_mu;
 
 static gpr_refcount g_refcount;
 
+// Keys are immutable and shared between the copies of the index, so
+// copying one is only a ref.
 struct grpc_subchannel_key {
-  grpc_subchannel_args args;
+  gpr_refcount refs;
+  size_t filter_count;
+  const grpc_channel_filter **filters;
+  grpc_preprocessed_channel_args *args;
 };
 
 static bool g_force_creation = false;
 
-static grpc_subchannel_key *create_key(
-    const grpc_subchannel_args *args,
-    grpc_channel_args *(*copy_channel_args)(const grpc_channel_args *args)) {
+grpc_subchannel_key *grpc_subchannel_key_create(
+    const grpc_subchannel_args *args) {
   grpc_subchannel_key *k = (grpc_subchannel_key *)gpr_malloc(sizeof(*k));
-  k->args.filter_count = args->filter_count;
-  if (k->args.filter_count > 0) {
-    k->args.filters = (const grpc_channel_filter **)gpr_malloc(
-        sizeof(*k->args.filters) * k->args.filter_count);
-    memcpy((grpc_channel_filter *)k->args.filters, args->filters,
-           sizeof(*k->args.filters) * k->args.filter_count);
+  gpr_ref_init(&k->refs, 1);
+  k->filter_count = args->filter_count;
+  if (k->filter_count > 0) {
+    k->filters = (const grpc_channel_filter **)gpr_malloc(
+        sizeof(*k->filters) * k->filter_count);
+    memcpy((grpc_channel_filter *)k->filters, args->filters,
+           sizeof(*k->filters) * k->filter_count);
   } else {
-    k->args.filters = NULL;
+    k->filters = NULL;
   }
-  k->args.args = copy_channel_args(args->args);
+  k->args = grpc_preprocessed_channel_args_create(args->args);
   return k;
 }
 
-grpc_subchannel_key *grpc_subchannel_key_create(
-    const grpc_subchannel_args *args) {
-  return create_key(args, grpc_channel_args_normalize);
-}
-
-static grpc_subchannel_key *subchannel_key_copy(grpc_subchannel_key *k) {
-  return create_key(&k->args, grpc_channel_args_copy);
+static grpc_subchannel_key *subchannel_key_ref(grpc_subchannel_key *k) {
+  gpr_ref_non_zero(&k->refs);
+  return k;
 }
 
 int grpc_subchannel_key_compare(const grpc_subchannel_key *a,
                                 const grpc_subchannel_key *b) {
   if (g_force_creation) return false;
-  int c = GPR_ICMP(a->args.filter_count, b->args.filter_count);
+  if (a == b) return 0;
+  int c = GPR_ICMP(a->filter_count, b->filter_count);
   if (c != 0) return c;
-  if (a->args.filter_count > 0) {
-    c = memcmp(a->args.filters, b->args.filters,
-               a->args.filter_count * sizeof(*a->args.filters));
+  if (a->filter_count > 0) {
+    c = memcmp(a->filters, b->filters,
+               a->filter_count * sizeof(*a->filters));
     if (c != 0) return c;
   }
-  return grpc_channel_args_compare(a->args.args, b->args.args);
+  return grpc_preprocessed_channel_args_compare(a->args, b->args);
 }
 
 void grpc_subchannel_key_destroy(grpc_exec_ctx *exec_ctx,
                                  grpc_subchannel_key *k) {
-  gpr_free((grpc_channel_args *)k->args.filters);
-  grpc_channel_args_destroy(exec_ctx, (grpc_channel_args *)k->args.args);
+  if (!gpr_unref(&k->refs)) return;
+  gpr_free((grpc_channel_filter **)k->filters);
+  grpc_preprocessed_channel_args_unref(exec_ctx, k->args);
   gpr_free(k);
 }
 
@@ -94,7 +97,7 @@ static void sck_avl_destroy(void *p, void *user_data) {
 }
 
 static void *sck_avl_copy(void *p, void *unused) {
-  return subchannel_key_copy((grpc_subchannel_key *)p);
+  return subchannel_key_ref((grpc_subchannel_key *)p);
 }
 
 static long sck_avl_compare(void *a, void *b, void *unused) {
@@ -186,7 +189,7 @@ grpc_subchannel *grpc_subchannel_index_register(grpc_exec_ctx *exec_ctx,
     } else {
       // no -> update the avl and compare/swap
       gpr_avl updated = gpr_avl_add(
-          gpr_avl_ref(index, exec_ctx), subchannel_key_copy(key),
+          gpr_avl_ref(index, exec_ctx), subchannel_key_ref(key),
           GRPC_SUBCHANNEL_WEAK_REF(constructed, "index_register"), exec_ctx);
 
       // it may happen (but it's expected to be unlikely)
@@ -16,6 +16,7 @@
 
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 
+#include <limits.h>
 #include <stdbool.h>
 #include <string.h>
 
@@ -23,13 +24,294 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
+#include <grpc/support/useful.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/channel_init.h"
 
+//
+// grpc_deadline_list
+//
+
+#define DEADLINE_LIST_BUCKETS 64
+#define DEADLINE_LIST_SHARDS 8
+
+// One shard of a grpc_deadline_list.  Calls are spread over the shards by
+// the address of their deadline state, so that parking and cancelling
+// deadlines does not serialize every call on the channel.
+typedef struct deadline_list_shard {
+  gpr_mu mu;
+  // Guarded by mu.
+  grpc_deadline_state* buckets[DEADLINE_LIST_BUCKETS];
+  // Every parked deadline before this has been moved to a timer.
+  grpc_millis checked_until;
+} deadline_list_shard;
+
+// The part of a grpc_deadline_list allocated by the first park: deadlines
+// are hashed into buckets by tick, and while any are parked a single timer
+// ticks every quarter horizon and moves the deadlines that came within the
+// horizon to timers of their own.
+typedef struct grpc_deadline_list_shards {
+  grpc_deadline_list* list;
+  deadline_list_shard shards[DEADLINE_LIST_SHARDS];
+  // Deadlines parked on all shards; only changed under a shard's mu.
+  gpr_atm count;
+  gpr_mu timer_mu;
+  // Set while the timer (and its channel stack ref) is held.  The timer is
+  // cancelled once the list becomes empty.  Guarded by timer_mu.
+  bool timer_armed;
+  grpc_timer timer;
+  grpc_closure on_timer;
+} grpc_deadline_list_shards;
+
+static void deadline_list_on_timer(grpc_exec_ctx* exec_ctx, void* arg,
+                                   grpc_error* error);
+
+static grpc_deadline_list_shards* deadline_list_shards(
+    grpc_deadline_list* list) {
+  return (grpc_deadline_list_shards*)gpr_atm_acq_load(&list->shards);
+}
+
+static grpc_deadline_list_shards* deadline_list_shards_get_or_create(
+    grpc_deadline_list* list) {
+  grpc_deadline_list_shards* shards = deadline_list_shards(list);
+  if (shards != NULL) return shards;
+  shards = (grpc_deadline_list_shards*)gpr_zalloc(sizeof(*shards));
+  shards->list = list;
+  for (size_t i = 0; i < DEADLINE_LIST_SHARDS; i++) {
+    gpr_mu_init(&shards->shards[i].mu);
+  }
+  gpr_mu_init(&shards->timer_mu);
+  GRPC_CLOSURE_INIT(&shards->on_timer, deadline_list_on_timer, shards,
+                    grpc_schedule_on_exec_ctx);
+  if (!gpr_atm_rel_cas(&list->shards, 0, (gpr_atm)shards)) {
+    // Another call parked the first deadline at the same time.
+    for (size_t i = 0; i < DEADLINE_LIST_SHARDS; i++) {
+      gpr_mu_destroy(&shards->shards[i].mu);
+    }
+    gpr_mu_destroy(&shards->timer_mu);
+    gpr_free(shards);
+    shards = deadline_list_shards(list);
+  }
+  return shards;
+}
+
+static deadline_list_shard* deadline_list_shard_for(
+    grpc_deadline_list_shards* shards, grpc_deadline_state* deadline_state) {
+  return &shards->shards[GPR_HASH_POINTER(deadline_state,
+                                          DEADLINE_LIST_SHARDS)];
+}
+
+static size_t deadline_list_bucket(grpc_deadline_list* list,
+                                   grpc_millis deadline) {
+  return (size_t)(deadline / list->tick) % DEADLINE_LIST_BUCKETS;
+}
+
+static void deadline_list_add_locked(grpc_deadline_list_shards* shards,
+                                     deadline_list_shard* shard,
+                                     grpc_deadline_state* deadline_state) {
+  grpc_deadline_state** head = &shard->buckets[deadline_list_bucket(
+      shards->list, deadline_state->deadline)];
+  deadline_state->prev_parked = NULL;
+  deadline_state->next_parked = *head;
+  if (*head != NULL) (*head)->prev_parked = deadline_state;
+  *head = deadline_state;
+  gpr_atm_full_fetch_add(&shards->count, 1);
+}
+
+// Returns the number of deadlines left parked on the list.
+static gpr_atm deadline_list_remove_locked(
+    grpc_deadline_list_shards* shards, deadline_list_shard* shard,
+    grpc_deadline_state* deadline_state) {
+  if (deadline_state->prev_parked != NULL) {
+    deadline_state->prev_parked->next_parked = deadline_state->next_parked;
+  } else {
+    shard->buckets[deadline_list_bucket(shards->list,
+                                        deadline_state->deadline)] =
+        deadline_state->next_parked;
+  }
+  if (deadline_state->next_parked != NULL) {
+    deadline_state->next_parked->prev_parked = deadline_state->prev_parked;
+  }
+  return gpr_atm_full_fetch_add(&shards->count, -1) - 1;
+}
+
+// Moves every parked deadline before check_until to a timer of its own.
+static void deadline_list_promote_locked(grpc_exec_ctx* exec_ctx,
+                                         grpc_deadline_list_shards* shards,
+                                         deadline_list_shard* shard,
+                                         grpc_millis check_until) {
+  grpc_millis tick = shards->list->tick;
+  if (check_until <= shard->checked_until) return;
+  grpc_millis first = shard->checked_until / tick;
+  grpc_millis last = check_until / tick;
+  if (last - first >= DEADLINE_LIST_BUCKETS) {
+    first = last - DEADLINE_LIST_BUCKETS + 1;
+  }
+  for (grpc_millis t = first; t <= last; t++) {
+    grpc_deadline_state* deadline_state =
+        shard->buckets[t % DEADLINE_LIST_BUCKETS];
+    while (deadline_state != NULL) {
+      grpc_deadline_state* next = deadline_state->next_parked;
+      if (deadline_state->deadline < check_until) {
+        deadline_list_remove_locked(shards, shard, deadline_state);
+        deadline_state->timer_state = GRPC_DEADLINE_STATE_PENDING;
+        grpc_timer_init(exec_ctx, &deadline_state->timer,
+                        deadline_state->deadline,
+                        deadline_state->parked_closure);
+        GRPC_STATS_INC_DEADLINES_PROMOTED(exec_ctx);
+      }
+      deadline_state = next;
+    }
+  }
+  shard->checked_until = check_until;
+}
+
+// Runs the closure of every parked deadline with error, as the timer list
+// does for pending timers when it shuts down.
+static void deadline_list_flush_locked(grpc_exec_ctx* exec_ctx,
+                                       grpc_deadline_list_shards* shards,
+                                       deadline_list_shard* shard,
+                                       grpc_error* error) {
+  for (size_t i = 0; i < DEADLINE_LIST_BUCKETS; i++) {
+    while (shard->buckets[i] != NULL) {
+      grpc_deadline_state* deadline_state = shard->buckets[i];
+      deadline_list_remove_locked(shards, shard, deadline_state);
+      deadline_state->timer_state = GRPC_DEADLINE_STATE_PENDING;
+      // Nothing to cancel if the call completes later.
+      grpc_timer_init_unset(&deadline_state->timer);
+      GRPC_CLOSURE_SCHED(exec_ctx, deadline_state->parked_closure,
+                         GRPC_ERROR_REF(error));
+    }
+  }
+}
+
+static void deadline_list_on_timer(grpc_exec_ctx* exec_ctx, void* arg,
+                                   grpc_error* error) {
+  grpc_deadline_list_shards* shards = (grpc_deadline_list_shards*)arg;
+  grpc_deadline_list* list = shards->list;
+  grpc_channel_stack* channel_stack = list->channel_stack;
+  grpc_millis now = grpc_exec_ctx_now(exec_ctx);
+  if (error != GRPC_ERROR_CANCELLED) {
+    for (size_t i = 0; i < DEADLINE_LIST_SHARDS; i++) {
+      deadline_list_shard* shard = &shards->shards[i];
+      gpr_mu_lock(&shard->mu);
+      if (error == GRPC_ERROR_NONE) {
+        deadline_list_promote_locked(exec_ctx, shards, shard,
+                                     now + list->horizon);
+      } else {
+        // The timer list is shutting down and will not tick again.
+        deadline_list_flush_locked(exec_ctx, shards, shard, error);
+      }
+      gpr_mu_unlock(&shard->mu);
+    }
+  }
+  // Deadlines are counted before their park looks at timer_armed, so one
+  // that raced with a cancellation or this tick is seen here.
+  gpr_mu_lock(&shards->timer_mu);
+  bool rearm = gpr_atm_no_barrier_load(&shards->count) > 0;
+  if (rearm) {
+    grpc_timer_init(exec_ctx, &shards->timer, now + list->tick,
+                    &shards->on_timer);
+  } else {
+    shards->timer_armed = false;
+  }
+  gpr_mu_unlock(&shards->timer_mu);
+  if (!rearm) {
+    GRPC_CHANNEL_STACK_UNREF(exec_ctx, channel_stack, "deadline_list");
+  }
+}
+
+// Puts deadline_state on the list if its deadline is beyond the horizon.
+// On success the list takes over the call stack ref and the closure taken
+// for the timer.
+static bool deadline_list_park(grpc_exec_ctx* exec_ctx,
+                               grpc_deadline_list* list,
+                               grpc_deadline_state* deadline_state) {
+  grpc_millis now = grpc_exec_ctx_now(exec_ctx);
+  if (deadline_state->deadline - now < list->horizon) return false;
+  grpc_deadline_list_shards* shards = deadline_list_shards_get_or_create(list);
+  deadline_list_shard* shard = deadline_list_shard_for(shards, deadline_state);
+  gpr_mu_lock(&shard->mu);
+  // Buckets before checked_until will not be looked at again until the
+  // list wraps around.
+  if (deadline_state->deadline < shard->checked_until) {
+    gpr_mu_unlock(&shard->mu);
+    return false;
+  }
+  deadline_state->timer_state = GRPC_DEADLINE_STATE_PARKED;
+  deadline_list_add_locked(shards, shard, deadline_state);
+  gpr_mu_unlock(&shard->mu);
+  gpr_mu_lock(&shards->timer_mu);
+  if (!shards->timer_armed) {
+    shards->timer_armed = true;
+    GRPC_CHANNEL_STACK_REF(list->channel_stack, "deadline_list");
+    grpc_timer_init(exec_ctx, &shards->timer, now + list->tick,
+                    &shards->on_timer);
+  }
+  gpr_mu_unlock(&shards->timer_mu);
+  GRPC_STATS_INC_DEADLINES_DEFERRED(exec_ctx);
+  return true;
+}
+
+// Takes deadline_state off the list if it is still parked there.  Returns
+// false if it was already moved to a timer.
+static bool deadline_list_unpark(grpc_exec_ctx* exec_ctx,
+                                 grpc_deadline_list* list,
+                                 grpc_deadline_state* deadline_state) {
+  // Only called after a successful park, so the shards exist.
+  grpc_deadline_list_shards* shards = deadline_list_shards(list);
+  deadline_list_shard* shard = deadline_list_shard_for(shards, deadline_state);
+  gpr_mu_lock(&shard->mu);
+  bool was_parked = deadline_state->timer_state == GRPC_DEADLINE_STATE_PARKED;
+  bool now_empty = false;
+  if (was_parked) {
+    now_empty =
+        deadline_list_remove_locked(shards, shard, deadline_state) == 0;
+  }
+  deadline_state->timer_state = GRPC_DEADLINE_STATE_FINISHED;
+  gpr_mu_unlock(&shard->mu);
+  if (now_empty) {
+    // Let go of the channel stack once nothing is left to watch; on_timer
+    // re-arms if another deadline is parked before it runs.
+    gpr_mu_lock(&shards->timer_mu);
+    if (shards->timer_armed) {
+      grpc_timer_cancel(exec_ctx, &shards->timer);
+    }
+    gpr_mu_unlock(&shards->timer_mu);
+  }
+  return was_parked;
+}
+
+void grpc_deadline_list_init(grpc_deadline_list* list,
+                             grpc_channel_stack* channel_stack,
+                             const grpc_channel_args* args) {
+  list->channel_stack = channel_stack;
+  list->horizon = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args, GRPC_ARG_DEADLINE_TIMER_HORIZON_MS),
+      {GRPC_DEADLINE_TIMER_DEFAULT_HORIZON_MS, 0, INT_MAX});
+  list->tick = GPR_MAX(list->horizon / 4, 1);
+  gpr_atm_no_barrier_store(&list->shards, 0);
+}
+
+void grpc_deadline_list_destroy(grpc_deadline_list* list) {
+  grpc_deadline_list_shards* shards = deadline_list_shards(list);
+  if (shards == NULL) return;
+  // The timer holds a ref to the channel stack, so cannot still be armed.
+  GPR_ASSERT(!shards->timer_armed);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&shards->count) == 0);
+  for (size_t i = 0; i < DEADLINE_LIST_SHARDS; i++) {
+    gpr_mu_destroy(&shards->shards[i].mu);
+  }
+  gpr_mu_destroy(&shards->timer_mu);
+  gpr_free(shards);
+}
+
 //
 // grpc_deadline_state
 //
@@ -91,6 +373,11 @@ static void start_timer_if_needed(grpc_exec_ctx* exec_ctx,
     return;
   }
   grpc_deadline_state* deadline_state = (grpc_deadline_state*)elem->call_data;
+  if (deadline_state->parked) {
+    // Note: We do not start the timer if the deadline is already parked (or
+    // was moved from the list to a timer)
+    return;
+  }
   grpc_closure* closure = NULL;
   switch (deadline_state->timer_state) {
     case GRPC_DEADLINE_STATE_PENDING:
@@ -110,9 +397,20 @@ static void start_timer_if_needed(grpc_exec_ctx* exec_ctx,
           GRPC_CLOSURE_INIT(&deadline_state->timer_callback, timer_callback,
                             elem, grpc_schedule_on_exec_ctx);
       break;
+    case GRPC_DEADLINE_STATE_PARKED:
+      GPR_UNREACHABLE_CODE(return );
   }
   GPR_ASSERT(closure != NULL);
   GRPC_CALL_STACK_REF(deadline_state->call_stack, "deadline_timer");
+  if (deadline_state->deadline_list != NULL) {
+    deadline_state->deadline = deadline;
+    deadline_state->parked_closure = closure;
+    if (deadline_list_park(exec_ctx, deadline_state->deadline_list,
+                           deadline_state)) {
+      deadline_state->parked = true;
+      return;
+    }
+  }
   grpc_timer_init(exec_ctx, &deadline_state->timer, deadline, closure);
 }
 
@@ -121,7 +419,17 @@ static void start_timer_if_needed(grpc_exec_ctx* exec_ctx,
 // synchronized.
 static void cancel_timer_if_needed(grpc_exec_ctx* exec_ctx,
                                    grpc_deadline_state* deadline_state) {
-  if (deadline_state->timer_state == GRPC_DEADLINE_STATE_PENDING) {
+  if (deadline_state->parked) {
+    deadline_state->parked = false;
+    if (deadline_list_unpark(exec_ctx, deadline_state->deadline_list,
+                             deadline_state)) {
+      // No timer was armed: finish as if a timer had been cancelled.
+      GRPC_CLOSURE_SCHED(exec_ctx, deadline_state->parked_closure,
+                         GRPC_ERROR_CANCELLED);
+    } else {
+      grpc_timer_cancel(exec_ctx, &deadline_state->timer);
+    }
+  } else if (deadline_state->timer_state == GRPC_DEADLINE_STATE_PENDING) {
     deadline_state->timer_state = GRPC_DEADLINE_STATE_FINISHED;
     grpc_timer_cancel(exec_ctx, &deadline_state->timer);
   } else {
@@ -180,10 +488,14 @@ static void start_timer_after_init(grpc_exec_ctx* exec_ctx, void* arg,
 void grpc_deadline_state_init(grpc_exec_ctx* exec_ctx, grpc_call_element* elem,
                               grpc_call_stack* call_stack,
                               grpc_call_combiner* call_combiner,
+                              grpc_deadline_list* deadline_list,
                               grpc_millis deadline) {
   grpc_deadline_state* deadline_state = (grpc_deadline_state*)elem->call_data;
   deadline_state->call_stack = call_stack;
   deadline_state->call_combiner = call_combiner;
+  if (deadline_list != NULL && deadline_list->horizon > 0) {
+    deadline_state->deadline_list = deadline_list;
+  }
   // Deadline will always be infinite on servers, so the timer will only be
   // set on clients with a finite deadline.
   if (deadline != GRPC_MILLIS_INF_FUTURE) {
@@ -236,17 +548,28 @@ void grpc_deadline_state_client_start_transport_stream_op_batch(
 // filter code
 //
 
+// Channel data used for both client and server filter.
+typedef struct channel_data {
+  grpc_deadline_list deadline_list;
+} channel_data;
+
 // Constructor for channel_data.  Used for both client and server filters.
 static grpc_error* init_channel_elem(grpc_exec_ctx* exec_ctx,
                                      grpc_channel_element* elem,
                                      grpc_channel_element_args* args) {
   GPR_ASSERT(!args->is_last);
+  channel_data* chand = (channel_data*)elem->channel_data;
+  grpc_deadline_list_init(&chand->deadline_list, args->channel_stack,
+                          args->channel_args);
   return GRPC_ERROR_NONE;
 }
 
 // Destructor for channel_data.  Used for both client and server filters.
 static void destroy_channel_elem(grpc_exec_ctx* exec_ctx,
-                                 grpc_channel_element* elem) {}
+                                 grpc_channel_element* elem) {
+  channel_data* chand = (channel_data*)elem->channel_data;
+  grpc_deadline_list_destroy(&chand->deadline_list);
+}
 
 // Call data used for both client and server filter.
 typedef struct base_call_data {
@@ -269,8 +592,10 @@ typedef struct server_call_data {
 static grpc_error* init_call_elem(grpc_exec_ctx* exec_ctx,
                                   grpc_call_element* elem,
                                   const grpc_call_element_args* args) {
+  channel_data* chand = (channel_data*)elem->channel_data;
   grpc_deadline_state_init(exec_ctx, elem, args->call_stack,
-                           args->call_combiner, args->deadline);
+                           args->call_combiner, &chand->deadline_list,
+                           args->deadline);
   return GRPC_ERROR_NONE;
 }
 
@@ -345,7 +670,7 @@ const grpc_channel_filter grpc_client_deadline_filter = {
     init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     init_channel_elem,
     destroy_channel_elem,
     grpc_channel_next_get_info,
@@ -359,7 +684,7 @@ const grpc_channel_filter grpc_server_deadline_filter = {
     init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     init_channel_elem,
     destroy_channel_elem,
     grpc_channel_next_get_info,
@@ -372,23 +697,24 @@ bool grpc_deadline_checking_enabled(const grpc_channel_args* channel_args) {
       !grpc_channel_args_want_minimal_stack(channel_args));
 }
 
-static bool maybe_add_deadline_filter(grpc_exec_ctx* exec_ctx,
-                                      grpc_channel_stack_builder* builder,
-                                      void* arg) {
-  return grpc_deadline_checking_enabled(
-             grpc_channel_stack_builder_get_channel_arguments(builder))
-             ? grpc_channel_stack_builder_prepend_filter(
-                   builder, (const grpc_channel_filter*)arg, NULL, NULL)
-             : true;
+static bool add_deadline_filter(grpc_exec_ctx* exec_ctx,
+                                grpc_channel_stack_builder* builder,
+                                void* arg) {
+  return grpc_channel_stack_builder_prepend_filter(
+      builder, (const grpc_channel_filter*)arg, NULL, NULL);
 }
 
 extern "C" void grpc_deadline_filter_init(void) {
+  grpc_channel_init_register_filter_activity(&grpc_client_deadline_filter,
+                                             grpc_deadline_checking_enabled);
+  grpc_channel_init_register_filter_activity(&grpc_server_deadline_filter,
+                                             grpc_deadline_checking_enabled);
   grpc_channel_init_register_stage(
       GRPC_CLIENT_DIRECT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
-      maybe_add_deadline_filter, (void*)&grpc_client_deadline_filter);
+      add_deadline_filter, (void*)&grpc_client_deadline_filter);
   grpc_channel_init_register_stage(
       GRPC_SERVER_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
-      maybe_add_deadline_filter, (void*)&grpc_server_deadline_filter);
+      add_deadline_filter, (void*)&grpc_server_deadline_filter);
 }
 
 extern "C" void grpc_deadline_filter_shutdown(void) {}
@@ -17,6 +17,8 @@
 #ifndef GRPC_CORE_EXT_FILTERS_DEADLINE_DEADLINE_FILTER_H
 #define GRPC_CORE_EXT_FILTERS_DEADLINE_DEADLINE_FILTER_H
 
+#include <grpc/support/atm.h>
+
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/iomgr/timer.h"
 
@@ -24,21 +26,47 @@
 extern "C" {
 #endif
 
+#define GRPC_DEADLINE_TIMER_DEFAULT_HORIZON_MS 10000
+
 typedef enum grpc_deadline_timer_state {
   GRPC_DEADLINE_STATE_INITIAL,
+  GRPC_DEADLINE_STATE_PARKED,
   GRPC_DEADLINE_STATE_PENDING,
   GRPC_DEADLINE_STATE_FINISHED
 } grpc_deadline_timer_state;
 
+// Coarse per-channel list of call deadlines that are beyond the horizon set
+// by GRPC_ARG_DEADLINE_TIMER_HORIZON_MS.  Only the settings live in the
+// channel: the shards holding parked deadlines, and the timer that moves
+// them to timers of their own as they come within the horizon, are
+// allocated by the first deadline parked on the channel.
+typedef struct grpc_deadline_list {
+  grpc_channel_stack* channel_stack;
+  grpc_millis horizon;
+  grpc_millis tick;
+  gpr_atm shards;  // struct grpc_deadline_list_shards*, or 0
+} grpc_deadline_list;
+
 // State used for filters that enforce call deadlines.
 // Must be the first field in the filter's call_data.
 typedef struct grpc_deadline_state {
   // We take a reference to the call stack for the timer callback.
   grpc_call_stack* call_stack;
   grpc_call_combiner* call_combiner;
+  // The channel's list of far away deadlines, or NULL.
+  grpc_deadline_list* deadline_list;
+  // Set while the deadline may be on deadline_list.  Only accessed under the
+  // call combiner; timer_state is guarded by the shard's mu while set.
+  bool parked;
   grpc_deadline_timer_state timer_state;
   grpc_timer timer;
   grpc_closure timer_callback;
+  // The deadline and timer closure of a parked deadline, and its links in
+  // the deadline_list bucket.
+  grpc_millis deadline;
+  grpc_closure* parked_closure;
+  struct grpc_deadline_state* next_parked;
+  struct grpc_deadline_state* prev_parked;
   // Closure to invoke when the call is complete.
   // We use this to cancel the timer.
   grpc_closure on_complete;
@@ -47,15 +75,24 @@ typedef struct grpc_deadline_state {
   grpc_closure* next_on_complete;
 } grpc_deadline_state;
 
+void grpc_deadline_list_init(grpc_deadline_list* list,
+                             grpc_channel_stack* channel_stack,
+                             const grpc_channel_args* args);
+
+// Must only be called once no call uses the list.
+void grpc_deadline_list_destroy(grpc_deadline_list* list);
+
 //
 // NOTE: All of these functions require that the first field in
 // elem->call_data is a grpc_deadline_state.
 //
 
 // assumes elem->call_data is zero'd
+// deadline_list may be NULL, in which case every deadline gets a timer.
 void grpc_deadline_state_init(grpc_exec_ctx* exec_ctx, grpc_call_element* elem,
                               grpc_call_stack* call_stack,
                               grpc_call_combiner* call_combiner,
+                              grpc_deadline_list* deadline_list,
                               grpc_millis deadline);
 
 void grpc_deadline_state_destroy(grpc_exec_ctx* exec_ctx,
@@ -99,9 +99,11 @@ static void increase_call_count(grpc_exec_ctx* exec_ctx, channel_data* chand) {
 static void decrease_call_count(grpc_exec_ctx* exec_ctx, channel_data* chand) {
   if (gpr_atm_full_fetch_add(&chand->call_count, -1) == 1) {
     GRPC_CHANNEL_STACK_REF(chand->channel_stack, "max_age max_idle_timer");
-    grpc_timer_init(exec_ctx, &chand->max_idle_timer,
-                    grpc_exec_ctx_now(exec_ctx) + chand->max_connection_idle,
-                    &chand->close_max_idle_channel);
+    grpc_timer_init_with_slack(
+        exec_ctx, &chand->max_idle_timer,
+        grpc_exec_ctx_now_coarse(exec_ctx) + chand->max_connection_idle,
+        GRPC_TIMER_SLACK_FOR_INTERVAL(chand->max_connection_idle),
+        &chand->close_max_idle_channel);
   }
 }
 
@@ -122,9 +124,11 @@ static void start_max_age_timer_after_init(grpc_exec_ctx* exec_ctx, void* arg,
   gpr_mu_lock(&chand->max_age_timer_mu);
   chand->max_age_timer_pending = true;
   GRPC_CHANNEL_STACK_REF(chand->channel_stack, "max_age max_age_timer");
-  grpc_timer_init(exec_ctx, &chand->max_age_timer,
-                  grpc_exec_ctx_now(exec_ctx) + chand->max_connection_age,
-                  &chand->close_max_age_channel);
+  grpc_timer_init_with_slack(
+      exec_ctx, &chand->max_age_timer,
+      grpc_exec_ctx_now_coarse(exec_ctx) + chand->max_connection_age,
+      GRPC_TIMER_SLACK_FOR_INTERVAL(chand->max_connection_age),
+      &chand->close_max_age_channel);
   gpr_mu_unlock(&chand->max_age_timer_mu);
   grpc_transport_op* op = grpc_make_transport_op(NULL);
   op->on_connectivity_state_change = &chand->channel_connectivity_changed,
@@ -142,11 +146,13 @@ static void start_max_age_grace_timer_after_goaway_op(grpc_exec_ctx* exec_ctx,
   gpr_mu_lock(&chand->max_age_timer_mu);
   chand->max_age_grace_timer_pending = true;
   GRPC_CHANNEL_STACK_REF(chand->channel_stack, "max_age max_age_grace_timer");
-  grpc_timer_init(
+  grpc_timer_init_with_slack(
       exec_ctx, &chand->max_age_grace_timer,
       chand->max_connection_age_grace == GRPC_MILLIS_INF_FUTURE
           ? GRPC_MILLIS_INF_FUTURE
-          : grpc_exec_ctx_now(exec_ctx) + chand->max_connection_age_grace,
+          : grpc_exec_ctx_now_coarse(exec_ctx) +
+                chand->max_connection_age_grace,
+      GRPC_TIMER_SLACK_FOR_INTERVAL(chand->max_connection_age_grace),
       &chand->force_close_max_age_channel);
   gpr_mu_unlock(&chand->max_age_timer_mu);
   GRPC_CHANNEL_STACK_UNREF(exec_ctx, chand->channel_stack,
@@ -384,30 +390,30 @@ const grpc_channel_filter grpc_max_age_filter = {
     grpc_channel_next_get_info,
     "max_age"};
 
-static bool maybe_add_max_age_filter(grpc_exec_ctx* exec_ctx,
-                                     grpc_channel_stack_builder* builder,
-                                     void* arg) {
-  const grpc_channel_args* channel_args =
-      grpc_channel_stack_builder_get_channel_arguments(builder);
-  bool enable =
-      grpc_channel_arg_get_integer(
-          grpc_channel_args_find(channel_args, GRPC_ARG_MAX_CONNECTION_AGE_MS),
-          MAX_CONNECTION_AGE_INTEGER_OPTIONS) != INT_MAX ||
-      grpc_channel_arg_get_integer(
-          grpc_channel_args_find(channel_args, GRPC_ARG_MAX_CONNECTION_IDLE_MS),
-          MAX_CONNECTION_IDLE_INTEGER_OPTIONS) != INT_MAX;
-  if (enable) {
-    return grpc_channel_stack_builder_prepend_filter(
-        builder, &grpc_max_age_filter, NULL, NULL);
-  } else {
-    return true;
-  }
+static bool max_age_filter_is_active(const grpc_channel_args* channel_args) {
+  return grpc_channel_arg_get_integer(
+             grpc_channel_args_find(channel_args,
+                                    GRPC_ARG_MAX_CONNECTION_AGE_MS),
+             MAX_CONNECTION_AGE_INTEGER_OPTIONS) != INT_MAX ||
+         grpc_channel_arg_get_integer(
+             grpc_channel_args_find(channel_args,
+                                    GRPC_ARG_MAX_CONNECTION_IDLE_MS),
+             MAX_CONNECTION_IDLE_INTEGER_OPTIONS) != INT_MAX;
+}
+
+static bool add_max_age_filter(grpc_exec_ctx* exec_ctx,
+                               grpc_channel_stack_builder* builder,
+                               void* arg) {
+  return grpc_channel_stack_builder_prepend_filter(
+      builder, &grpc_max_age_filter, NULL, NULL);
 }
 
 extern "C" void grpc_max_age_filter_init(void) {
+  grpc_channel_init_register_filter_activity(&grpc_max_age_filter,
+                                             max_age_filter_is_active);
   grpc_channel_init_register_stage(GRPC_SERVER_CHANNEL,
                                    GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
-                                   maybe_add_max_age_filter, NULL);
+                                   add_max_age_filter, NULL);
 }
 
 extern "C" void grpc_max_age_filter_shutdown(void) {}
@@ -265,39 +265,32 @@ const grpc_channel_filter grpc_message_size_filter = {
     grpc_channel_next_get_info,
     "message_size"};
 
-static bool maybe_add_message_size_filter(grpc_exec_ctx* exec_ctx,
-                                          grpc_channel_stack_builder* builder,
-                                          void* arg) {
-  const grpc_channel_args* channel_args =
-      grpc_channel_stack_builder_get_channel_arguments(builder);
-  bool enable = false;
+static bool message_size_filter_is_active(
+    const grpc_channel_args* channel_args) {
   message_size_limits lim = get_message_size_limits(channel_args);
-  if (lim.max_send_size != -1 || lim.max_recv_size != -1) {
-    enable = true;
-  }
-  const grpc_arg* a =
-      grpc_channel_args_find(channel_args, GRPC_ARG_SERVICE_CONFIG);
-  if (a != NULL) {
-    enable = true;
-  }
-  if (enable) {
-    return grpc_channel_stack_builder_prepend_filter(
-        builder, &grpc_message_size_filter, NULL, NULL);
-  } else {
-    return true;
-  }
+  return lim.max_send_size != -1 || lim.max_recv_size != -1 ||
+         grpc_channel_args_find(channel_args, GRPC_ARG_SERVICE_CONFIG) != NULL;
+}
+
+static bool add_message_size_filter(grpc_exec_ctx* exec_ctx,
+                                    grpc_channel_stack_builder* builder,
+                                    void* arg) {
+  return grpc_channel_stack_builder_prepend_filter(
+      builder, &grpc_message_size_filter, NULL, NULL);
 }
 
 extern "C" void grpc_message_size_filter_init(void) {
+  grpc_channel_init_register_filter_activity(&grpc_message_size_filter,
+                                             message_size_filter_is_active);
   grpc_channel_init_register_stage(GRPC_CLIENT_SUBCHANNEL,
                                    GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
-                                   maybe_add_message_size_filter, NULL);
+                                   add_message_size_filter, NULL);
   grpc_channel_init_register_stage(GRPC_CLIENT_DIRECT_CHANNEL,
                                    GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
-                                   maybe_add_message_size_filter, NULL);
+                                   add_message_size_filter, NULL);
   grpc_channel_init_register_stage(GRPC_SERVER_CHANNEL,
                                    GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
-                                   maybe_add_message_size_filter, NULL);
+                                   add_message_size_filter, NULL);
 }
 
 extern "C" void grpc_message_size_filter_shutdown(void) {}
@@ -27,6 +27,9 @@ extern "C" void grpc_chttp2_plugin_init(void) {
 #ifndef NDEBUG
   grpc_register_tracer(&grpc_trace_chttp2_refcount);
 #endif
+  grpc_chttp2_transport_cache_init();
 }
 
-extern "C" void grpc_chttp2_plugin_shutdown(void) {}
+extern "C" void grpc_chttp2_plugin_shutdown(void) {
+  grpc_chttp2_transport_cache_shutdown();
+}
@@ -44,7 +44,9 @@
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
+#include "src/core/lib/support/alloc_tags.h"
 #include "src/core/lib/support/env.h"
+#include "src/core/lib/support/obj_cache.h"
 #include "src/core/lib/support/string.h"
 #include "src/core/lib/transport/error_utils.h"
 #include "src/core/lib/transport/http2_errors.h"
@@ -57,6 +59,7 @@
 #define DEFAULT_CONNECTION_WINDOW_TARGET (1024 * 1024)
 #define MAX_WINDOW 0x7fffffffu
 #define MAX_WRITE_BUFFER_SIZE (64 * 1024 * 1024)
+#define DEFAULT_TARGET_WRITE_SIZE (1024 * 1024)
 #define DEFAULT_MAX_HEADER_LIST_SIZE (8 * 1024)
 
 #define DEFAULT_CLIENT_KEEPALIVE_TIME_MS INT_MAX
@@ -140,9 +143,13 @@ static void benign_reclaimer_locked(grpc_exec_ctx *exec_ctx, void *t,
                                     grpc_error *error);
 static void destructive_reclaimer_locked(grpc_exec_ctx *exec_ctx, void *t,
                                          grpc_error *error);
+static void cache_reclaimer_locked(grpc_exec_ctx *exec_ctx, void *t,
+                                   grpc_error *error);
 
 static void post_benign_reclaimer(grpc_exec_ctx *exec_ctx,
                                   grpc_chttp2_transport *t);
+static void post_cache_reclaimer(grpc_exec_ctx *exec_ctx,
+                                 grpc_chttp2_transport *t);
 static void post_destructive_reclaimer(grpc_exec_ctx *exec_ctx,
                                        grpc_chttp2_transport *t);
 
@@ -185,6 +192,27 @@ static void reset_byte_stream(grpc_exec_ctx *exec_ctx, void *arg,
  * CONSTRUCTION/DESTRUCTION/REFCOUNTING
  */
 
+/* Freed transports, reused by connections created later on. Cached
+   transports still count as live against GPR_ALLOC_TAG_TRANSPORT.
+   The cache outlives grpc_shutdown, since transports can be destroyed after
+   the plugin shuts down: shutdown only frees the transports it holds. */
+#define MAX_CACHED_TRANSPORTS 256
+static gpr_obj_cache *g_transport_cache;
+
+static void free_transport(void *t) {
+  gpr_free_tagged(t, sizeof(grpc_chttp2_transport), GPR_ALLOC_TAG_TRANSPORT);
+}
+
+void grpc_chttp2_transport_cache_init(void) {
+  if (g_transport_cache == NULL) {
+    g_transport_cache = gpr_obj_cache_create(MAX_CACHED_TRANSPORTS);
+  }
+}
+
+void grpc_chttp2_transport_cache_shutdown(void) {
+  gpr_obj_cache_drain(g_transport_cache, free_transport);
+}
+
 static void destruct_transport(grpc_exec_ctx *exec_ctx,
                                grpc_chttp2_transport *t) {
   size_t i;
@@ -226,7 +254,9 @@ static void destruct_transport(grpc_exec_ctx *exec_ctx,
   GRPC_ERROR_UNREF(t->closed_with_error);
   gpr_free(t->ping_acks);
   gpr_free(t->peer_string);
-  gpr_free(t);
+  if (!gpr_obj_cache_put(g_transport_cache, t)) {
+    free_transport(t);
+  }
 }
 
 #ifndef NDEBUG
@@ -299,6 +329,8 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
   GRPC_CLOSURE_INIT(&t->destructive_reclaimer_locked,
                     destructive_reclaimer_locked, t,
                     grpc_combiner_scheduler(t->combiner));
+  GRPC_CLOSURE_INIT(&t->cache_reclaimer_locked, cache_reclaimer_locked, t,
+                    grpc_combiner_scheduler(t->combiner));
   GRPC_CLOSURE_INIT(&t->retry_initiate_ping_locked, retry_initiate_ping_locked,
                     t, grpc_combiner_scheduler(t->combiner));
   GRPC_CLOSURE_INIT(&t->start_bdp_ping_locked, start_bdp_ping_locked, t,
@@ -344,6 +376,7 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
   t->force_send_settings = 1 << GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE;
   t->sent_local_settings = 0;
   t->write_buffer_size = grpc_core::chttp2::kDefaultWindow;
+  t->target_write_size = DEFAULT_TARGET_WRITE_SIZE;
 
   if (is_client) {
     grpc_slice_buffer_add(&t->outbuf, grpc_slice_from_copied_string(
@@ -448,6 +481,14 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
                              GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
         t->write_buffer_size = (uint32_t)grpc_channel_arg_get_integer(
             &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE});
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_NOTSENT_LOWAT)) {
+        /* the endpoint takes only this much unsent data at a time: frame no
+           more than that per write, so that frames queued in the meantime
+           are prioritized here rather than behind the kernel buffer */
+        const int value = grpc_channel_arg_get_integer(
+            &channel_args->args[i], {0, 0, INT_MAX});
+        if (value > 0) t->target_write_size = (uint32_t)value;
       } else if (0 ==
                  strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
         enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
@@ -558,9 +599,11 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
   if (t->keepalive_time != GRPC_MILLIS_INF_FUTURE) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
     GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    grpc_timer_init(exec_ctx, &t->keepalive_ping_timer,
-                    grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    grpc_timer_init_with_slack(
+        exec_ctx, &t->keepalive_ping_timer,
+        grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
+        GRPC_TIMER_SLACK_FOR_INTERVAL(t->keepalive_time),
+        &t->init_keepalive_ping_locked);
   } else {
     /* Use GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED to indicate there are no
        inflight keeaplive timers */
@@ -1059,6 +1102,9 @@ static void write_action_end_locked(grpc_exec_ctx *exec_ctx, void *tp,
     close_transport_locked(exec_ctx, t, GRPC_ERROR_REF(error));
   }
 
+  /* writes may have grown the hpack table */
+  post_cache_reclaimer(exec_ctx, t);
+
   if (t->sent_goaway_state == GRPC_CHTTP2_GOAWAY_SEND_SCHEDULED) {
     t->sent_goaway_state = GRPC_CHTTP2_GOAWAY_SENT;
     if (grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
@@ -2698,16 +2744,20 @@ static void init_keepalive_ping_locked(grpc_exec_ctx *exec_ctx, void *arg,
                                  GRPC_CHTTP2_INITIATE_WRITE_KEEPALIVE_PING);
     } else {
       GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      grpc_timer_init(exec_ctx, &t->keepalive_ping_timer,
-                      grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      grpc_timer_init_with_slack(
+          exec_ctx, &t->keepalive_ping_timer,
+          grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
+          GRPC_TIMER_SLACK_FOR_INTERVAL(t->keepalive_time),
+          &t->init_keepalive_ping_locked);
     }
   } else if (error == GRPC_ERROR_CANCELLED) {
     /* The keepalive ping timer may be cancelled by bdp */
     GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    grpc_timer_init(exec_ctx, &t->keepalive_ping_timer,
-                    grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    grpc_timer_init_with_slack(
+        exec_ctx, &t->keepalive_ping_timer,
+        grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
+        GRPC_TIMER_SLACK_FOR_INTERVAL(t->keepalive_time),
+        &t->init_keepalive_ping_locked);
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(exec_ctx, t, "init keepalive ping");
 }
@@ -2716,9 +2766,10 @@ static void start_keepalive_ping_locked(grpc_exec_ctx *exec_ctx, void *arg,
                                         grpc_error *error) {
   grpc_chttp2_transport *t = (grpc_chttp2_transport *)arg;
   GRPC_CHTTP2_REF_TRANSPORT(t, "keepalive watchdog");
-  grpc_timer_init(exec_ctx, &t->keepalive_watchdog_timer,
-                  grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
-                  &t->keepalive_watchdog_fired_locked);
+  grpc_timer_init_with_slack(exec_ctx, &t->keepalive_watchdog_timer,
+                             grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
+                             GRPC_TIMER_SLACK_FOR_INTERVAL(t->keepalive_time),
+                             &t->keepalive_watchdog_fired_locked);
 }
 
 static void finish_keepalive_ping_locked(grpc_exec_ctx *exec_ctx, void *arg,
@@ -2729,9 +2780,11 @@ static void finish_keepalive_ping_locked(grpc_exec_ctx *exec_ctx, void *arg,
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
       grpc_timer_cancel(exec_ctx, &t->keepalive_watchdog_timer);
       GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      grpc_timer_init(exec_ctx, &t->keepalive_ping_timer,
-                      grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      grpc_timer_init_with_slack(
+          exec_ctx, &t->keepalive_ping_timer,
+          grpc_exec_ctx_now(exec_ctx) + t->keepalive_time,
+          GRPC_TIMER_SLACK_FOR_INTERVAL(t->keepalive_time),
+          &t->init_keepalive_ping_locked);
     }
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(exec_ctx, t, "keepalive ping end");
@@ -3086,6 +3139,78 @@ static void post_destructive_reclaimer(grpc_exec_ctx *exec_ctx,
   }
 }
 
+static void post_cache_reclaimer(grpc_exec_ctx *exec_ctx,
+                                 grpc_chttp2_transport *t) {
+  if (!t->cache_reclaimer_registered) {
+    t->cache_reclaimer_registered = true;
+    GRPC_CHTTP2_REF_TRANSPORT(t, "cache_reclaimer");
+    grpc_resource_user_post_cache_reclaimer(
+        exec_ctx, grpc_endpoint_get_resource_user(t->ep),
+        &t->cache_reclaimer_locked);
+  }
+}
+
+typedef struct {
+  grpc_exec_ctx *exec_ctx;
+  grpc_chttp2_transport *t;
+} compact_stream_cb_args;
+
+/* Copy bytes buffered for a stream into one slice of their exact size, so
+   that they no longer pin the (possibly much larger) read buffers they were
+   sliced from. A single slice is left alone unless its allocation is known to
+   be larger than its data: copying it would release nothing. */
+static void compact_incoming_buffer(grpc_exec_ctx *exec_ctx,
+                                    grpc_chttp2_transport *t,
+                                    grpc_slice_buffer *buffer) {
+  if (buffer->count == 0) return;
+  if (buffer->count == 1 &&
+      grpc_resource_user_slice_allocation_size(buffer->slices[0]) <=
+          GRPC_SLICE_LENGTH(buffer->slices[0])) {
+    return;
+  }
+  size_t length = buffer->length;
+  grpc_slice compacted = grpc_resource_user_slice_malloc(
+      exec_ctx, grpc_endpoint_get_resource_user(t->ep), length);
+  grpc_slice_buffer_move_first_into_buffer(exec_ctx, buffer, length,
+                                           GRPC_SLICE_START_PTR(compacted));
+  grpc_slice_buffer_add(buffer, compacted);
+}
+
+static void compact_stream_cb(void *user_data, uint32_t key, void *stream) {
+  compact_stream_cb_args *args = (compact_stream_cb_args *)user_data;
+  grpc_chttp2_stream *s = (grpc_chttp2_stream *)stream;
+  compact_incoming_buffer(args->exec_ctx, args->t, &s->frame_storage);
+  /* otherwise the application owns it */
+  if (!s->pending_byte_stream) {
+    compact_incoming_buffer(args->exec_ctx, args->t,
+                            &s->unprocessed_incoming_frames_buffer);
+  }
+}
+
+/* Drops what the transport keeps only to go faster, cheapest first: the
+   compression table, then slack in buffered incoming data */
+static void cache_reclaimer_locked(grpc_exec_ctx *exec_ctx, void *arg,
+                                   grpc_error *error) {
+  grpc_chttp2_transport *t = (grpc_chttp2_transport *)arg;
+  t->cache_reclaimer_registered = false;
+  if (error == GRPC_ERROR_NONE) {
+    if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
+      gpr_log(GPR_DEBUG,
+              "HTTP2: %s - forget hpack table and compact %" PRIdPTR
+              " streams",
+              t->peer_string, grpc_chttp2_stream_map_size(&t->stream_map));
+    }
+    grpc_chttp2_hpack_compressor_forget_entries(exec_ctx, &t->hpack_compressor);
+    compact_stream_cb_args args = {exec_ctx, t};
+    grpc_chttp2_stream_map_for_each(&t->stream_map, compact_stream_cb, &args);
+  }
+  if (error != GRPC_ERROR_CANCELLED) {
+    grpc_resource_user_finish_reclamation(
+        exec_ctx, grpc_endpoint_get_resource_user(t->ep));
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(exec_ctx, t, "cache_reclaimer");
+}
+
 static void benign_reclaimer_locked(grpc_exec_ctx *exec_ctx, void *arg,
                                     grpc_error *error) {
   grpc_chttp2_transport *t = (grpc_chttp2_transport *)arg;
@@ -3221,7 +3346,13 @@ grpc_transport *grpc_create_chttp2_transport(
     grpc_exec_ctx *exec_ctx, const grpc_channel_args *channel_args,
     grpc_endpoint *ep, int is_client) {
   grpc_chttp2_transport *t =
-      (grpc_chttp2_transport *)gpr_zalloc(sizeof(grpc_chttp2_transport));
+      (grpc_chttp2_transport *)gpr_obj_cache_get(g_transport_cache);
+  if (t != NULL) {
+    memset((void *)t, 0, sizeof(*t));
+  } else {
+    t = (grpc_chttp2_transport *)gpr_zalloc_tagged(
+        sizeof(grpc_chttp2_transport), GPR_ALLOC_TAG_TRANSPORT);
+  }
   init_transport(exec_ctx, t, channel_args, ep, is_client != 0);
   return &t->base;
 }
@@ -35,6 +35,11 @@ extern grpc_tracer_flag grpc_trace_http2_stream_state;
 extern grpc_tracer_flag grpc_trace_chttp2_refcount;
 #endif
 
+/* Set up and empty the cache of freed transports, at plugin init and
+   shutdown */
+void grpc_chttp2_transport_cache_init(void);
+void grpc_chttp2_transport_cache_shutdown(void);
+
 grpc_transport *grpc_create_chttp2_transport(
     grpc_exec_ctx *exec_ctx, const grpc_channel_args *channel_args,
     grpc_endpoint *ep, int is_client);
@@ -36,6 +36,7 @@
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
+#include "src/core/lib/support/alloc_tags.h"
 #include "src/core/lib/transport/metadata.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "src/core/lib/transport/timeout_encoding.h"
@@ -603,8 +604,8 @@ void grpc_chttp2_hpack_compressor_init(grpc_chttp2_hpack_compressor *c) {
   c->cap_table_elems = elems_for_bytes(c->max_table_size);
   c->max_table_elems = c->cap_table_elems;
   c->max_usable_size = GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE;
-  c->table_elem_size =
-      (uint16_t *)gpr_malloc(sizeof(*c->table_elem_size) * c->cap_table_elems);
+  c->table_elem_size = (uint16_t *)gpr_malloc_tagged(
+      sizeof(*c->table_elem_size) * c->cap_table_elems, GPR_ALLOC_TAG_HPACK);
   memset(c->table_elem_size, 0,
          sizeof(*c->table_elem_size) * c->cap_table_elems);
   for (size_t i = 0; i < GPR_ARRAY_SIZE(c->entries_keys); i++) {
@@ -621,7 +622,9 @@ void grpc_chttp2_hpack_compressor_destroy(grpc_exec_ctx *exec_ctx,
     }
     GRPC_MDELEM_UNREF(exec_ctx, c->entries_elems[i]);
   }
-  gpr_free(c->table_elem_size);
+  gpr_free_tagged(c->table_elem_size,
+                  sizeof(*c->table_elem_size) * c->cap_table_elems,
+                  GPR_ALLOC_TAG_HPACK);
 }
 
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
@@ -631,9 +634,29 @@ void grpc_chttp2_hpack_compressor_set_max_usable_size(
       c, GPR_MIN(c->max_table_size, max_table_size));
 }
 
+void grpc_chttp2_hpack_compressor_forget_entries(
+    grpc_exec_ctx *exec_ctx, grpc_chttp2_hpack_compressor *c) {
+  /* indices at or below the tail are never emitted again; new entries are
+     sized against an empty table, and the peer evicting our forgotten entries
+     first keeps them within its table too */
+  c->tail_remote_index += c->table_elems;
+  c->table_elems = 0;
+  c->table_size = 0;
+  for (size_t i = 0; i < GRPC_CHTTP2_HPACKC_NUM_VALUES; i++) {
+    if (c->entries_keys[i].refcount != &terminal_slice_refcount) {
+      grpc_slice_unref_internal(exec_ctx, c->entries_keys[i]);
+      c->entries_keys[i] = terminal_slice;
+    }
+    GRPC_MDELEM_UNREF(exec_ctx, c->entries_elems[i]);
+    c->entries_elems[i] = GRPC_MDNULL;
+    c->indices_keys[i] = 0;
+    c->indices_elems[i] = 0;
+  }
+}
+
 static void rebuild_elems(grpc_chttp2_hpack_compressor *c, uint32_t new_cap) {
-  uint16_t *table_elem_size =
-      (uint16_t *)gpr_malloc(sizeof(*table_elem_size) * new_cap);
+  uint16_t *table_elem_size = (uint16_t *)gpr_malloc_tagged(
+      sizeof(*table_elem_size) * new_cap, GPR_ALLOC_TAG_HPACK);
   uint32_t i;
 
   memset(table_elem_size, 0, sizeof(*table_elem_size) * new_cap);
@@ -645,8 +668,10 @@ static void rebuild_elems(grpc_chttp2_hpack_compressor *c, uint32_t new_cap) {
         c->table_elem_size[ofs % c->cap_table_elems];
   }
 
+  gpr_free_tagged(c->table_elem_size,
+                  sizeof(*c->table_elem_size) * c->cap_table_elems,
+                  GPR_ALLOC_TAG_HPACK);
   c->cap_table_elems = new_cap;
-  gpr_free(c->table_elem_size);
   c->table_elem_size = table_elem_size;
 }
 
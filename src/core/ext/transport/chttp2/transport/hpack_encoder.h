@@ -78,6 +78,11 @@ void grpc_chttp2_hpack_compressor_set_max_table_size(
     grpc_chttp2_hpack_compressor *c, uint32_t max_table_size);
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
     grpc_chttp2_hpack_compressor *c, uint32_t max_table_size);
+/* Stop referencing the entries of the remote table, releasing the metadata
+   they hold. The peer is not told: it keeps the entries until later additions
+   evict them, and we just stop using them. */
+void grpc_chttp2_hpack_compressor_forget_entries(
+    grpc_exec_ctx *exec_ctx, grpc_chttp2_hpack_compressor *c);
 
 typedef struct {
   uint32_t stream_id;
@@ -26,6 +26,7 @@
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/support/alloc_tags.h"
 #include "src/core/lib/support/murmur_hash.h"
 
 extern "C" grpc_tracer_flag grpc_http_trace;
@@ -173,7 +174,8 @@ void grpc_chttp2_hptbl_init(grpc_exec_ctx *exec_ctx, grpc_chttp2_hptbl *tbl) {
       GRPC_CHTTP2_INITIAL_HPACK_TABLE_SIZE;
   tbl->max_entries = tbl->cap_entries =
       entries_for_bytes(tbl->current_table_bytes);
-  tbl->ents = (grpc_mdelem *)gpr_malloc(sizeof(*tbl->ents) * tbl->cap_entries);
+  tbl->ents = (grpc_mdelem *)gpr_malloc_tagged(
+      sizeof(*tbl->ents) * tbl->cap_entries, GPR_ALLOC_TAG_HPACK);
   memset(tbl->ents, 0, sizeof(*tbl->ents) * tbl->cap_entries);
   for (i = 1; i <= GRPC_CHTTP2_LAST_STATIC_ENTRY; i++) {
     tbl->static_ents[i - 1] = grpc_mdelem_from_slices(
@@ -194,7 +196,8 @@ void grpc_chttp2_hptbl_destroy(grpc_exec_ctx *exec_ctx,
     GRPC_MDELEM_UNREF(exec_ctx,
                       tbl->ents[(tbl->first_ent + i) % tbl->cap_entries]);
   }
-  gpr_free(tbl->ents);
+  gpr_free_tagged(tbl->ents, sizeof(*tbl->ents) * tbl->cap_entries,
+                  GPR_ALLOC_TAG_HPACK);
 }
 
 grpc_mdelem grpc_chttp2_hptbl_lookup(const grpc_chttp2_hptbl *tbl,
@@ -228,13 +231,15 @@ static void evict1(grpc_exec_ctx *exec_ctx, grpc_chttp2_hptbl *tbl) {
 }
 
 static void rebuild_ents(grpc_chttp2_hptbl *tbl, uint32_t new_cap) {
-  grpc_mdelem *ents = (grpc_mdelem *)gpr_malloc(sizeof(*ents) * new_cap);
+  grpc_mdelem *ents = (grpc_mdelem *)gpr_malloc_tagged(sizeof(*ents) * new_cap,
+                                                       GPR_ALLOC_TAG_HPACK);
   uint32_t i;
 
   for (i = 0; i < tbl->num_ents; i++) {
     ents[i] = tbl->ents[(tbl->first_ent + i) % tbl->cap_entries];
   }
-  gpr_free(tbl->ents);
+  gpr_free_tagged(tbl->ents, sizeof(*tbl->ents) * tbl->cap_entries,
+                  GPR_ALLOC_TAG_HPACK);
   tbl->ents = ents;
   tbl->cap_entries = new_cap;
   tbl->first_ent = 0;
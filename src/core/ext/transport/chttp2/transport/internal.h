@@ -305,6 +305,8 @@ struct grpc_chttp2_transport {
   /** how much data are we willing to buffer when the WRITE_BUFFER_HINT is set?
    */
   uint32_t write_buffer_size;
+  /** how many bytes would we like to put on the wire in a single write */
+  uint32_t target_write_size;
 
   /** have we seen a goaway */
   bool seen_goaway;
@@ -404,6 +406,10 @@ struct grpc_chttp2_transport {
   grpc_closure benign_reclaimer_locked;
   /** destructive cleanup closure */
   grpc_closure destructive_reclaimer_locked;
+  /** have we scheduled a cache cleanup? */
+  bool cache_reclaimer_registered;
+  /** cache cleanup closure */
+  grpc_closure cache_reclaimer_locked;
 
   /* next bdp ping timer */
   bool have_next_bdp_ping_timer;
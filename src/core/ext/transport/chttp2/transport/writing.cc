@@ -166,7 +166,7 @@ static bool stream_ref_if_not_destroyed(gpr_refcount *r) {
 
 /* How many bytes would we like to put on the wire during a single syscall */
 static uint32_t target_write_size(grpc_chttp2_transport *t) {
-  return 1024 * 1024;
+  return t->target_write_size;
 }
 
 // Returns true if initial_metadata contains only default headers.
@@ -481,6 +481,9 @@ class StreamWriteContext {
            data_send_context.max_outgoing() > 0) {
       if (s_->compressed_data_buffer.length > 0) {
         data_send_context.FlushCompressedBytes();
+        /* leave the rest for later writes (the stream is requeued below),
+           so other streams and control frames get a turn in between */
+        if (t_->outbuf.length >= target_write_size(t_)) break;
       } else {
         data_send_context.CompressMoreBytes();
       }
@@ -43,6 +43,10 @@ static grpc_slice g_fake_path_value;
 static grpc_slice g_fake_auth_key;
 static grpc_slice g_fake_auth_value;
 
+// A lock shared by the two sides of a transport (guarding the transport
+// level state) or by the two sides of a stream (guarding everything else).
+// Streams never take the transport lock except to leave the stream list, so
+// calls on one transport only contend with their own other side.
 typedef struct {
   gpr_mu mu;
   gpr_refcount refs;
@@ -57,13 +61,15 @@ typedef struct inproc_transport {
   void (*accept_stream_cb)(grpc_exec_ctx *exec_ctx, void *user_data,
                            grpc_transport *transport, const void *server_data);
   void *accept_stream_data;
-  bool is_closed;
+  // Written under mu, read by streams without it
+  gpr_atm is_closed;
   struct inproc_transport *other_side;
   struct inproc_stream *stream_list;
 } inproc_transport;
 
 typedef struct inproc_stream {
   inproc_transport *t;
+  shared_mu *mu;
   grpc_metadata_batch to_read_initial_md;
   uint32_t to_read_initial_md_flags;
   bool to_read_initial_md_filled;
@@ -98,6 +104,7 @@ typedef struct inproc_stream {
 
   grpc_slice_buffer recv_message;
   grpc_slice_buffer_stream recv_stream;
+  grpc_message_object_stream recv_object_stream;
   bool recv_inited;
 
   bool initial_md_sent;
@@ -123,6 +130,22 @@ static bool cancel_stream_locked(grpc_exec_ctx *exec_ctx, inproc_stream *s,
 static void op_state_machine(grpc_exec_ctx *exec_ctx, void *arg,
                              grpc_error *error);
 
+static shared_mu *shared_mu_create(void) {
+  shared_mu *mu = (shared_mu *)gpr_malloc(sizeof(*mu));
+  gpr_mu_init(&mu->mu);
+  gpr_ref_init(&mu->refs, 1);
+  return mu;
+}
+
+static void shared_mu_ref(shared_mu *mu) { gpr_ref(&mu->refs); }
+
+static void shared_mu_unref(shared_mu *mu) {
+  if (gpr_unref(&mu->refs)) {
+    gpr_mu_destroy(&mu->mu);
+    gpr_free(mu);
+  }
+}
+
 static void ref_transport(inproc_transport *t) {
   INPROC_LOG(GPR_DEBUG, "ref_transport %p", t);
   gpr_ref(&t->refs);
@@ -132,9 +155,7 @@ static void really_destroy_transport(grpc_exec_ctx *exec_ctx,
                                      inproc_transport *t) {
   INPROC_LOG(GPR_DEBUG, "really_destroy_transport %p", t);
   grpc_connectivity_state_destroy(exec_ctx, &t->connectivity);
-  if (gpr_unref(&t->mu->refs)) {
-    gpr_free(t->mu);
-  }
+  shared_mu_unref(t->mu);
   gpr_free(t);
 }
 
@@ -175,6 +196,7 @@ static void really_destroy_stream(grpc_exec_ctx *exec_ctx, inproc_stream *s) {
     grpc_slice_buffer_destroy_internal(exec_ctx, &s->recv_message);
   }
 
+  shared_mu_unref(s->mu);
   unref_transport(exec_ctx, s->t);
 
   if (s->closure_at_destroy) {
@@ -264,6 +286,14 @@ static int init_stream(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
   s->deadline = GRPC_MILLIS_INF_FUTURE;
   s->write_buffer_deadline = GRPC_MILLIS_INF_FUTURE;
 
+  if (!server_data) {
+    s->mu = shared_mu_create();
+  } else {
+    // The server side shares the lock of the client side
+    s->mu = ((inproc_stream *)server_data)->mu;
+    shared_mu_ref(s->mu);
+  }
+
   s->stream_list_prev = NULL;
   gpr_mu_lock(&t->mu->mu);
   s->listed = true;
@@ -294,9 +324,9 @@ static int init_stream(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
     // Ref the server-side stream on behalf of the client now
     ref_stream(s, "inproc_init_stream:srv");
 
-    // Now we are about to affect the other side, so lock the transport
-    // to make sure that it doesn't get destroyed
-    gpr_mu_lock(&s->t->mu->mu);
+    // Now we are about to affect the other side, so take the lock of the
+    // stream pair
+    gpr_mu_lock(&s->mu->mu);
     cs->other_side = s;
     // Now transfer from the other side's write_buffer if any to the to_read
     // buffer
@@ -321,7 +351,7 @@ static int init_stream(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
       cs->write_buffer_cancel_error = GRPC_ERROR_NONE;
     }
 
-    gpr_mu_unlock(&s->t->mu->mu);
+    gpr_mu_unlock(&s->mu->mu);
   }
   return 0;  // return value is not important
 }
@@ -333,6 +363,8 @@ static void close_stream_locked(grpc_exec_ctx *exec_ctx, inproc_stream *s) {
     grpc_metadata_batch_destroy(exec_ctx, &s->write_buffer_trailing_md);
 
     if (s->listed) {
+      // Lock order is stream before transport
+      gpr_mu_lock(&s->t->mu->mu);
       inproc_stream *p = s->stream_list_prev;
       inproc_stream *n = s->stream_list_next;
       if (p != NULL) {
@@ -343,6 +375,7 @@ static void close_stream_locked(grpc_exec_ctx *exec_ctx, inproc_stream *s) {
       if (n != NULL) {
         n->stream_list_prev = p;
       }
+      gpr_mu_unlock(&s->t->mu->mu);
       s->listed = false;
       unref_stream(exec_ctx, s, "close_stream:list");
     }
@@ -387,6 +420,18 @@ static void complete_if_batch_end_locked(grpc_exec_ctx *exec_ctx,
   }
 }
 
+// Completes s's send_message op. Like the other transports, this one owns
+// the op's byte stream once it has accepted the op, so it destroys it here
+// whether or not the receiver got to read from it.
+static void finish_send_message_locked(grpc_exec_ctx *exec_ctx,
+                                       inproc_stream *s, grpc_error *error,
+                                       const char *msg) {
+  complete_if_batch_end_locked(exec_ctx, s, error, s->send_message_op, msg);
+  grpc_byte_stream_destroy(
+      exec_ctx, s->send_message_op->payload->send_message.send_message);
+  s->send_message_op = NULL;
+}
+
 static void maybe_schedule_op_closure_locked(grpc_exec_ctx *exec_ctx,
                                              inproc_stream *s,
                                              grpc_error *error) {
@@ -483,10 +528,8 @@ static void fail_helper_locked(grpc_exec_ctx *exec_ctx, inproc_stream *s,
     s->recv_message_op = NULL;
   }
   if (s->send_message_op) {
-    complete_if_batch_end_locked(
-        exec_ctx, s, error, s->send_message_op,
-        "fail_helper scheduling send-message-on-complete");
-    s->send_message_op = NULL;
+    finish_send_message_locked(
+        exec_ctx, s, error, "fail_helper scheduling send-message-on-complete");
   }
   if (s->send_trailing_md_op) {
     complete_if_batch_end_locked(
@@ -512,6 +555,33 @@ static void fail_helper_locked(grpc_exec_ctx *exec_ctx, inproc_stream *s,
 static void message_transfer_locked(grpc_exec_ctx *exec_ctx,
                                     inproc_stream *sender,
                                     inproc_stream *receiver) {
+  // Hand over an unserialized message object if the sender has one
+  grpc_byte_buffer *message_object = grpc_byte_stream_take_message_object(
+      sender->send_message_op->payload->send_message.send_message);
+  if (message_object != NULL) {
+    grpc_message_object_stream_init(
+        &receiver->recv_object_stream, message_object, true,
+        sender->send_message_op->payload->send_message.send_message->flags);
+    *receiver->recv_message_op->payload->recv_message.recv_message =
+        &receiver->recv_object_stream.base;
+    INPROC_LOG(GPR_DEBUG,
+               "message_transfer_locked %p scheduling message-ready (object)",
+               receiver);
+    GRPC_CLOSURE_SCHED(
+        exec_ctx,
+        receiver->recv_message_op->payload->recv_message.recv_message_ready,
+        GRPC_ERROR_NONE);
+    finish_send_message_locked(
+        exec_ctx, sender, GRPC_ERROR_NONE,
+        "message_transfer scheduling sender on_complete");
+    complete_if_batch_end_locked(
+        exec_ctx, receiver, GRPC_ERROR_NONE, receiver->recv_message_op,
+        "message_transfer scheduling receiver on_complete");
+
+    receiver->recv_message_op = NULL;
+    return;
+  }
+
   size_t remaining =
       sender->send_message_op->payload->send_message.send_message->length;
   if (receiver->recv_inited) {
@@ -547,15 +617,13 @@ static void message_transfer_locked(grpc_exec_ctx *exec_ctx,
       exec_ctx,
       receiver->recv_message_op->payload->recv_message.recv_message_ready,
       GRPC_ERROR_NONE);
-  complete_if_batch_end_locked(
-      exec_ctx, sender, GRPC_ERROR_NONE, sender->send_message_op,
-      "message_transfer scheduling sender on_complete");
+  finish_send_message_locked(exec_ctx, sender, GRPC_ERROR_NONE,
+                             "message_transfer scheduling sender on_complete");
   complete_if_batch_end_locked(
       exec_ctx, receiver, GRPC_ERROR_NONE, receiver->recv_message_op,
       "message_transfer scheduling receiver on_complete");
 
   receiver->recv_message_op = NULL;
-  sender->send_message_op = NULL;
 }
 
 static void op_state_machine(grpc_exec_ctx *exec_ctx, void *arg,
@@ -573,7 +641,7 @@ static void op_state_machine(grpc_exec_ctx *exec_ctx, void *arg,
 
   INPROC_LOG(GPR_DEBUG, "op_state_machine %p", arg);
   inproc_stream *s = (inproc_stream *)arg;
-  gpr_mu *mu = &s->t->mu->mu;  // keep aside in case s gets closed
+  gpr_mu *mu = &s->mu->mu;  // keep aside in case s gets closed
   gpr_mu_lock(mu);
   s->op_closure_scheduled = false;
   // cancellation takes precedence
@@ -598,10 +666,9 @@ static void op_state_machine(grpc_exec_ctx *exec_ctx, void *arg,
                (s->trailing_md_sent || other->recv_trailing_md_op)) {
       // A server send will never be matched if the client is waiting
       // for trailing metadata already
-      complete_if_batch_end_locked(
-          exec_ctx, s, GRPC_ERROR_NONE, s->send_message_op,
+      finish_send_message_locked(
+          exec_ctx, s, GRPC_ERROR_NONE,
           "op_state_machine scheduling send-message-on-complete");
-      s->send_message_op = NULL;
     }
   }
   // Pause a send trailing metadata if there is still an outstanding
@@ -729,10 +796,9 @@ static void op_state_machine(grpc_exec_ctx *exec_ctx, void *arg,
     if ((s->trailing_md_sent || s->t->is_client) && s->send_message_op) {
       // Nothing further will try to receive from this stream, so finish off
       // any outstanding send_message op
-      complete_if_batch_end_locked(
-          exec_ctx, s, new_err, s->send_message_op,
+      finish_send_message_locked(
+          exec_ctx, s, new_err,
           "op_state_machine scheduling send-message-on-complete");
-      s->send_message_op = NULL;
     }
     if (s->recv_trailing_md_op != NULL) {
       // We wanted trailing metadata and we got it
@@ -786,10 +852,9 @@ static void op_state_machine(grpc_exec_ctx *exec_ctx, void *arg,
       s->send_message_op) {
     // Nothing further will try to receive from this stream, so finish off
     // any outstanding send_message op
-    complete_if_batch_end_locked(
-        exec_ctx, s, new_err, s->send_message_op,
+    finish_send_message_locked(
+        exec_ctx, s, new_err,
         "op_state_machine scheduling send-message-on-complete");
-    s->send_message_op = NULL;
   }
   if (s->send_message_op || s->send_trailing_md_op || s->recv_initial_md_op ||
       s->recv_message_op || s->recv_trailing_md_op) {
@@ -867,7 +932,7 @@ static void perform_stream_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
                               grpc_transport_stream_op_batch *op) {
   INPROC_LOG(GPR_DEBUG, "perform_stream_op %p %p %p", gt, gs, op);
   inproc_stream *s = (inproc_stream *)gs;
-  gpr_mu *mu = &s->t->mu->mu;  // save aside in case s gets closed
+  gpr_mu *mu = &s->mu->mu;  // save aside in case s gets closed
   gpr_mu_lock(mu);
 
   if (GRPC_TRACER_ON(grpc_inproc_trace)) {
@@ -910,7 +975,7 @@ static void perform_stream_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
   inproc_stream *other = s->other_side;
   if (error == GRPC_ERROR_NONE &&
       (op->send_initial_metadata || op->send_trailing_metadata)) {
-    if (s->t->is_closed) {
+    if (gpr_atm_acq_load(&s->t->is_closed)) {
       error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint already shutdown");
     }
     if (error == GRPC_ERROR_NONE && op->send_initial_metadata) {
@@ -1008,6 +1073,10 @@ static void perform_stream_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
                            GRPC_ERROR_REF(error));
       }
     }
+    if (op->send_message) {
+      grpc_byte_stream_destroy(exec_ctx,
+                               op->payload->send_message.send_message);
+    }
     INPROC_LOG(GPR_DEBUG, "perform_stream_op %p scheduling on_complete %p", s,
                error);
     GRPC_CLOSURE_SCHED(exec_ctx, on_complete, GRPC_ERROR_REF(error));
@@ -1020,25 +1089,52 @@ static void perform_stream_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
   GRPC_ERROR_UNREF(error);
 }
 
-static void close_transport_locked(grpc_exec_ctx *exec_ctx,
-                                   inproc_transport *t) {
-  INPROC_LOG(GPR_DEBUG, "close_transport %p %d", t, t->is_closed);
+// Must be called without holding t->mu
+static void close_transport(grpc_exec_ctx *exec_ctx, inproc_transport *t) {
+  gpr_mu_lock(&t->mu->mu);
+  INPROC_LOG(GPR_DEBUG, "close_transport %p %d", t,
+             (int)gpr_atm_no_barrier_load(&t->is_closed));
   grpc_connectivity_state_set(
       exec_ctx, &t->connectivity, GRPC_CHANNEL_SHUTDOWN,
       GRPC_ERROR_CREATE_FROM_STATIC_STRING("Closing transport."),
       "close transport");
-  if (!t->is_closed) {
-    t->is_closed = true;
-    /* Also end all streams on this transport */
-    while (t->stream_list != NULL) {
+  if (gpr_atm_no_barrier_load(&t->is_closed)) {
+    gpr_mu_unlock(&t->mu->mu);
+    return;
+  }
+  gpr_atm_rel_store(&t->is_closed, 1);
+  // Streams are canceled under their own locks, which must be taken before
+  // the transport lock, so collect (and ref) them first
+  size_t nstreams = 0;
+  for (inproc_stream *s = t->stream_list; s != NULL; s = s->stream_list_next) {
+    nstreams++;
+  }
+  inproc_stream **streams =
+      (inproc_stream **)gpr_malloc(nstreams * sizeof(*streams));
+  nstreams = 0;
+  for (inproc_stream *s = t->stream_list; s != NULL; s = s->stream_list_next) {
+    ref_stream(s, "close_transport");
+    streams[nstreams++] = s;
+  }
+  gpr_mu_unlock(&t->mu->mu);
+
+  /* Also end all streams on this transport */
+  for (size_t i = 0; i < nstreams; i++) {
+    inproc_stream *s = streams[i];
+    gpr_mu *mu = &s->mu->mu;
+    gpr_mu_lock(mu);
+    if (!s->closed) {
       // cancel_stream_locked also adjusts stream list
       cancel_stream_locked(
-          exec_ctx, t->stream_list,
+          exec_ctx, s,
           grpc_error_set_int(
               GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport closed"),
               GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
     }
+    gpr_mu_unlock(mu);
+    unref_stream(exec_ctx, s, "close_transport");
   }
+  gpr_free(streams);
 }
 
 static void perform_transport_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
@@ -1069,10 +1165,11 @@ static void perform_transport_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
     GRPC_ERROR_UNREF(op->disconnect_with_error);
   }
 
+  gpr_mu_unlock(&t->mu->mu);
+
   if (do_close) {
-    close_transport_locked(exec_ctx, t);
+    close_transport(exec_ctx, t);
   }
-  gpr_mu_unlock(&t->mu->mu);
 }
 
 static void destroy_stream(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
@@ -1087,9 +1184,7 @@ static void destroy_stream(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
 static void destroy_transport(grpc_exec_ctx *exec_ctx, grpc_transport *gt) {
   inproc_transport *t = (inproc_transport *)gt;
   INPROC_LOG(GPR_DEBUG, "destroy_transport %p", t);
-  gpr_mu_lock(&t->mu->mu);
-  close_transport_locked(exec_ctx, t);
-  gpr_mu_unlock(&t->mu->mu);
+  close_transport(exec_ctx, t);
   unref_transport(exec_ctx, t->other_side);
   unref_transport(exec_ctx, t);
 }
@@ -1155,9 +1250,8 @@ static void inproc_transports_create(grpc_exec_ctx *exec_ctx,
   inproc_transport *st = (inproc_transport *)gpr_zalloc(sizeof(*st));
   inproc_transport *ct = (inproc_transport *)gpr_zalloc(sizeof(*ct));
   // Share one lock between both sides since both sides get affected
-  st->mu = ct->mu = (shared_mu *)gpr_malloc(sizeof(*st->mu));
-  gpr_mu_init(&st->mu->mu);
-  gpr_ref_init(&st->mu->refs, 2);
+  st->mu = ct->mu = shared_mu_create();
+  shared_mu_ref(st->mu);
   st->base.vtable = &inproc_vtable;
   ct->base.vtable = &inproc_vtable;
   // Start each side of transport with 2 refs since they each have a ref
@@ -1197,18 +1291,40 @@ grpc_channel *grpc_inproc_channel_create(grpc_server *server,
   grpc_channel_args *client_args =
       grpc_channel_args_copy_and_add(args, &default_authority_arg, 1);
 
+  // Message objects are only passed if both ends asked for them
+  grpc_channel_args *server_channel_args =
+      grpc_channel_args_copy(server_args);
+  if (grpc_channel_arg_get_bool(
+          grpc_channel_args_find(args, GRPC_ARG_INPROC_MESSAGE_OBJECTS),
+          false) &&
+      grpc_channel_arg_get_bool(
+          grpc_channel_args_find(server_args, GRPC_ARG_INPROC_MESSAGE_OBJECTS),
+          false)) {
+    grpc_arg pass_message_objects_arg = grpc_channel_arg_integer_create(
+        (char *)GRPC_ARG_PASS_MESSAGE_OBJECTS, 1);
+    grpc_channel_args *tmp = client_args;
+    client_args =
+        grpc_channel_args_copy_and_add(tmp, &pass_message_objects_arg, 1);
+    grpc_channel_args_destroy(&exec_ctx, tmp);
+    tmp = server_channel_args;
+    server_channel_args =
+        grpc_channel_args_copy_and_add(tmp, &pass_message_objects_arg, 1);
+    grpc_channel_args_destroy(&exec_ctx, tmp);
+  }
+
   grpc_transport *server_transport;
   grpc_transport *client_transport;
-  inproc_transports_create(&exec_ctx, &server_transport, server_args,
+  inproc_transports_create(&exec_ctx, &server_transport, server_channel_args,
                            &client_transport, client_args);
 
   grpc_server_setup_transport(&exec_ctx, server, server_transport, NULL,
-                              server_args);
+                              server_channel_args);
   grpc_channel *channel =
       grpc_channel_create(&exec_ctx, "inproc", client_args,
                           GRPC_CLIENT_DIRECT_CHANNEL, client_transport);
 
   // Free up created channel args
+  grpc_channel_args_destroy(&exec_ctx, server_channel_args);
   grpc_channel_args_destroy(&exec_ctx, client_args);
 
   // Now finish scheduled operations
@@ -0,0 +1,692 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/port.h"
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#ifdef GRPC_LINUX_EVENTFD
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/useful.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/resource_quota.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+#define SHM_MAGIC 0x67727063736d3031ull /* "grpcsm01" */
+#define SHM_CACHELINE 64
+#define SHM_MIN_RING_SIZE 4096
+#define SHM_MAX_RING_SIZE (64 * 1024 * 1024)
+
+/* memfd sealing, for C libraries that predate it */
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#endif
+#ifndef F_SEAL_SHRINK
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+/* the peer must not be able to resize the region under our mapping */
+#define SHM_REQUIRED_SEALS (F_SEAL_SHRINK | F_SEAL_GROW)
+
+typedef struct {
+  gpr_atm value;
+  char padding[SHM_CACHELINE - sizeof(gpr_atm)];
+} shm_padded_atm;
+
+/* Start of the shared region; the data of ring 0 and then of ring 1
+   follows. Ring positions count bytes since the connection started, so
+   tail - head is the number of unread bytes in a ring. */
+typedef struct {
+  uint64_t magic;
+  uint64_t ring_size;
+  char padding[SHM_CACHELINE - 2 * sizeof(uint64_t)];
+  /* set by a side (indexed by grpc_shm_side) before it sleeps on its wakeup
+     fd; the peer clears it and signals the fd */
+  shm_padded_atm waiting[2];
+  struct {
+    shm_padded_atm head; /* advanced by the reader */
+    shm_padded_atm tail; /* advanced by the writer */
+  } rings[2];
+} shm_header;
+
+typedef struct {
+  gpr_atm *head;
+  gpr_atm *tail;
+  uint8_t *data;
+} shm_ring;
+
+typedef struct {
+  grpc_endpoint base;
+  gpr_refcount refs;
+  gpr_mu mu;
+
+  void *region;
+  size_t region_size;
+  size_t ring_size;
+  shm_ring tx;
+  shm_ring rx;
+  gpr_atm *waiting;
+  gpr_atm *peer_waiting;
+
+  grpc_fd *wakeup_fd;
+  int peer_wakeup_fd;
+  bool wakeup_armed;
+  grpc_closure on_wakeup;
+
+  grpc_fd *control_fd;
+  grpc_closure on_control_readable;
+  bool peer_closed;
+  grpc_error *shutdown_error;
+
+  grpc_slice_buffer *read_buffer;
+  grpc_closure *read_cb;
+  grpc_slice_buffer *write_buffer;
+  size_t write_slice;
+  size_t write_offset;
+  grpc_closure *write_cb;
+
+  grpc_resource_user *resource_user;
+  char *peer_string;
+} shm_endpoint;
+
+static size_t region_size(size_t ring_size) {
+  return sizeof(shm_header) + 2 * ring_size;
+}
+
+size_t grpc_shm_ring_size_from_channel_args(const grpc_channel_args *args) {
+  const grpc_arg *arg = grpc_channel_args_find(args, GRPC_ARG_SHM_RING_SIZE);
+  const grpc_integer_options options = {GRPC_SHM_DEFAULT_RING_SIZE,
+                                        SHM_MIN_RING_SIZE, SHM_MAX_RING_SIZE};
+  size_t requested = (size_t)grpc_channel_arg_get_integer(arg, options);
+  size_t ring_size = SHM_MIN_RING_SIZE;
+  while (ring_size < requested) ring_size <<= 1;
+  return ring_size;
+}
+
+void grpc_shm_fds_close(grpc_shm_fds *fds) {
+  if (fds->memfd >= 0) close(fds->memfd);
+  if (fds->wakeup_fds[0] >= 0) close(fds->wakeup_fds[0]);
+  if (fds->wakeup_fds[1] >= 0) close(fds->wakeup_fds[1]);
+  fds->memfd = fds->wakeup_fds[0] = fds->wakeup_fds[1] = -1;
+}
+
+grpc_error *grpc_shm_fds_create(size_t ring_size, grpc_shm_fds *fds) {
+  GPR_ASSERT((ring_size & (ring_size - 1)) == 0);
+  fds->memfd = fds->wakeup_fds[0] = fds->wakeup_fds[1] = -1;
+  fds->memfd = (int)syscall(SYS_memfd_create, "grpc_shm",
+                            1u /* CLOEXEC */ | 2u /* ALLOW_SEALING */);
+  if (fds->memfd < 0) {
+    return GRPC_OS_ERROR(errno, "memfd_create");
+  }
+  /* ftruncate zero fills, which is the initial state of all ring indices */
+  if (ftruncate(fds->memfd, (off_t)region_size(ring_size)) != 0) {
+    grpc_error *error = GRPC_OS_ERROR(errno, "ftruncate");
+    grpc_shm_fds_close(fds);
+    return error;
+  }
+  shm_header *header =
+      (shm_header *)mmap(NULL, sizeof(shm_header), PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fds->memfd, 0);
+  if (header == MAP_FAILED) {
+    grpc_error *error = GRPC_OS_ERROR(errno, "mmap");
+    grpc_shm_fds_close(fds);
+    return error;
+  }
+  header->ring_size = ring_size;
+  header->magic = SHM_MAGIC;
+  munmap(header, sizeof(shm_header));
+  if (fcntl(fds->memfd, F_ADD_SEALS, SHM_REQUIRED_SEALS) != 0) {
+    grpc_error *error = GRPC_OS_ERROR(errno, "fcntl(F_ADD_SEALS)");
+    grpc_shm_fds_close(fds);
+    return error;
+  }
+  for (int i = 0; i < 2; i++) {
+    fds->wakeup_fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fds->wakeup_fds[i] < 0) {
+      grpc_error *error = GRPC_OS_ERROR(errno, "eventfd");
+      grpc_shm_fds_close(fds);
+      return error;
+    }
+  }
+  return GRPC_ERROR_NONE;
+}
+
+/*******************************************************************************
+ * RING TRANSFERS
+ */
+
+/* Ring indices live in memory the peer can write: callers must treat a result
+   above ring_size as a corrupted ring */
+static size_t rx_available(shm_endpoint *ep) {
+  return (size_t)(gpr_atm_acq_load(ep->rx.tail) -
+                  gpr_atm_no_barrier_load(ep->rx.head));
+}
+
+static size_t tx_space(shm_endpoint *ep) {
+  return ep->ring_size - (size_t)(gpr_atm_no_barrier_load(ep->tx.tail) -
+                                  gpr_atm_acq_load(ep->tx.head));
+}
+
+/* Tell the peer that a ring index moved, if it is (about to be) asleep */
+static void wakeup_peer(shm_endpoint *ep) {
+  gpr_atm_full_barrier();
+  if (gpr_atm_no_barrier_load(ep->peer_waiting) != 0 &&
+      gpr_atm_full_xchg(ep->peer_waiting, 0) != 0) {
+    int err;
+    do {
+      err = eventfd_write(ep->peer_wakeup_fd, 1);
+    } while (err < 0 && errno == EINTR);
+  }
+}
+
+static void finish_read_locked(grpc_exec_ctx *exec_ctx, shm_endpoint *ep,
+                               grpc_error *error) {
+  grpc_closure *cb = ep->read_cb;
+  ep->read_cb = NULL;
+  ep->read_buffer = NULL;
+  GRPC_CLOSURE_SCHED(exec_ctx, cb, error);
+}
+
+static void finish_write_locked(grpc_exec_ctx *exec_ctx, shm_endpoint *ep,
+                                grpc_error *error) {
+  grpc_closure *cb = ep->write_cb;
+  ep->write_cb = NULL;
+  ep->write_buffer = NULL;
+  GRPC_CLOSURE_SCHED(exec_ctx, cb, error);
+}
+
+/* Shut the endpoint down; fd shutdowns only schedule closures, so this is
+   safe under ep->mu */
+static void shutdown_locked(grpc_exec_ctx *exec_ctx, shm_endpoint *ep,
+                            grpc_error *why) {
+  if (ep->shutdown_error != GRPC_ERROR_NONE) {
+    GRPC_ERROR_UNREF(why);
+    return;
+  }
+  ep->shutdown_error = why;
+  grpc_fd_shutdown(exec_ctx, ep->wakeup_fd, GRPC_ERROR_REF(why));
+  grpc_fd_shutdown(exec_ctx, ep->control_fd, GRPC_ERROR_REF(why));
+  grpc_resource_user_shutdown(exec_ctx, ep->resource_user);
+}
+
+static grpc_error *corrupted_ring_error(void) {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Shared memory ring indices corrupted by the peer");
+}
+
+static void try_read_locked(grpc_exec_ctx *exec_ctx, shm_endpoint *ep) {
+  size_t available = rx_available(ep);
+  if (available > ep->ring_size) {
+    shutdown_locked(exec_ctx, ep, corrupted_ring_error());
+  }
+  if (ep->shutdown_error != GRPC_ERROR_NONE) {
+    finish_read_locked(exec_ctx, ep,
+                       GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                           "Endpoint shutdown", &ep->shutdown_error, 1));
+    return;
+  }
+  if (available == 0) {
+    if (ep->peer_closed) {
+      finish_read_locked(exec_ctx, ep,
+                         GRPC_ERROR_CREATE_FROM_STATIC_STRING("EOF"));
+    }
+    return;
+  }
+  size_t head = (size_t)gpr_atm_no_barrier_load(ep->rx.head);
+  size_t offset = head & (ep->ring_size - 1);
+  size_t first = GPR_MIN(available, ep->ring_size - offset);
+  grpc_slice slice =
+      grpc_resource_user_slice_malloc(exec_ctx, ep->resource_user, available);
+  memcpy(GRPC_SLICE_START_PTR(slice), ep->rx.data + offset, first);
+  memcpy(GRPC_SLICE_START_PTR(slice) + first, ep->rx.data, available - first);
+  gpr_atm_rel_store(ep->rx.head, (gpr_atm)(head + available));
+  wakeup_peer(ep);
+  grpc_slice_buffer_add(ep->read_buffer, slice);
+  finish_read_locked(exec_ctx, ep, GRPC_ERROR_NONE);
+}
+
+static void try_write_locked(grpc_exec_ctx *exec_ctx, shm_endpoint *ep) {
+  size_t tail = (size_t)gpr_atm_no_barrier_load(ep->tx.tail);
+  size_t space = tx_space(ep);
+  if (space > ep->ring_size) {
+    shutdown_locked(exec_ctx, ep, corrupted_ring_error());
+  }
+  if (ep->shutdown_error != GRPC_ERROR_NONE || ep->peer_closed) {
+    finish_write_locked(
+        exec_ctx, ep,
+        ep->shutdown_error != GRPC_ERROR_NONE
+            ? GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                  "Endpoint shutdown", &ep->shutdown_error, 1)
+            : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Peer closed"));
+    return;
+  }
+  bool wrote = false;
+  while (space > 0 && ep->write_slice < ep->write_buffer->count) {
+    grpc_slice slice = ep->write_buffer->slices[ep->write_slice];
+    size_t n = GPR_MIN(space, GRPC_SLICE_LENGTH(slice) - ep->write_offset);
+    size_t offset = tail & (ep->ring_size - 1);
+    size_t first = GPR_MIN(n, ep->ring_size - offset);
+    const uint8_t *src = GRPC_SLICE_START_PTR(slice) + ep->write_offset;
+    memcpy(ep->tx.data + offset, src, first);
+    memcpy(ep->tx.data, src + first, n - first);
+    tail += n;
+    space -= n;
+    wrote = true;
+    ep->write_offset += n;
+    if (ep->write_offset == GRPC_SLICE_LENGTH(slice)) {
+      ep->write_slice++;
+      ep->write_offset = 0;
+    }
+  }
+  if (wrote) {
+    gpr_atm_rel_store(ep->tx.tail, (gpr_atm)tail);
+    wakeup_peer(ep);
+  }
+  if (ep->write_slice == ep->write_buffer->count) {
+    finish_write_locked(exec_ctx, ep, GRPC_ERROR_NONE);
+  }
+}
+
+static bool can_progress_locked(shm_endpoint *ep) {
+  bool done = ep->shutdown_error != GRPC_ERROR_NONE || ep->peer_closed;
+  return (ep->read_cb != NULL && (done || rx_available(ep) > 0)) ||
+         (ep->write_cb != NULL && (done || tx_space(ep) > 0));
+}
+
+static void shm_unref(grpc_exec_ctx *exec_ctx, shm_endpoint *ep);
+
+/* Move bytes for the pending read and write until both are complete or the
+   rings are stuck, then sleep on the wakeup fd */
+static void progress_locked(grpc_exec_ctx *exec_ctx, shm_endpoint *ep) {
+  for (;;) {
+    if (ep->read_cb != NULL) try_read_locked(exec_ctx, ep);
+    if (ep->write_cb != NULL) try_write_locked(exec_ctx, ep);
+    if (ep->read_cb == NULL && ep->write_cb == NULL) return;
+    /* an armed wakeup is either still announced to the peer or signalled */
+    if (ep->wakeup_armed || ep->shutdown_error != GRPC_ERROR_NONE) return;
+    gpr_atm_no_barrier_store(ep->waiting, 1);
+    gpr_atm_full_barrier();
+    if (can_progress_locked(ep)) {
+      gpr_atm_no_barrier_store(ep->waiting, 0);
+      continue;
+    }
+    ep->wakeup_armed = true;
+    gpr_ref(&ep->refs);
+    grpc_fd_notify_on_read(exec_ctx, ep->wakeup_fd, &ep->on_wakeup);
+    return;
+  }
+}
+
+static void on_wakeup(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
+  shm_endpoint *ep = (shm_endpoint *)arg;
+  eventfd_t value;
+  eventfd_read(grpc_fd_wrapped_fd(ep->wakeup_fd), &value);
+  gpr_mu_lock(&ep->mu);
+  ep->wakeup_armed = false;
+  if (error != GRPC_ERROR_NONE && ep->shutdown_error == GRPC_ERROR_NONE) {
+    ep->shutdown_error = GRPC_ERROR_REF(error);
+  }
+  progress_locked(exec_ctx, ep);
+  gpr_mu_unlock(&ep->mu);
+  shm_unref(exec_ctx, ep);
+}
+
+/* The peer never writes to the control socket, so it only becomes readable
+   once the peer went away */
+static void on_control_readable(grpc_exec_ctx *exec_ctx, void *arg,
+                                grpc_error *error) {
+  shm_endpoint *ep = (shm_endpoint *)arg;
+  if (error == GRPC_ERROR_NONE) {
+    char buf[64];
+    ssize_t n;
+    do {
+      n = recv(grpc_fd_wrapped_fd(ep->control_fd), buf, sizeof(buf), 0);
+    } while (n < 0 && errno == EINTR);
+    if (n > 0 || (n < 0 && errno == EAGAIN)) {
+      grpc_fd_notify_on_read(exec_ctx, ep->control_fd,
+                             &ep->on_control_readable);
+      return;
+    }
+  }
+  gpr_mu_lock(&ep->mu);
+  ep->peer_closed = true;
+  progress_locked(exec_ctx, ep);
+  gpr_mu_unlock(&ep->mu);
+  shm_unref(exec_ctx, ep);
+}
+
+/*******************************************************************************
+ * ENDPOINT VTABLE
+ */
+
+static void shm_read(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep_base,
+                     grpc_slice_buffer *slices, grpc_closure *cb) {
+  shm_endpoint *ep = (shm_endpoint *)ep_base;
+  grpc_slice_buffer_reset_and_unref_internal(exec_ctx, slices);
+  gpr_mu_lock(&ep->mu);
+  GPR_ASSERT(ep->read_cb == NULL);
+  ep->read_cb = cb;
+  ep->read_buffer = slices;
+  progress_locked(exec_ctx, ep);
+  gpr_mu_unlock(&ep->mu);
+}
+
+static void shm_write(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep_base,
+                      grpc_slice_buffer *slices, grpc_closure *cb) {
+  shm_endpoint *ep = (shm_endpoint *)ep_base;
+  gpr_mu_lock(&ep->mu);
+  GPR_ASSERT(ep->write_cb == NULL);
+  ep->write_cb = cb;
+  ep->write_buffer = slices;
+  ep->write_slice = 0;
+  ep->write_offset = 0;
+  progress_locked(exec_ctx, ep);
+  gpr_mu_unlock(&ep->mu);
+}
+
+static void shm_add_to_pollset(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep_base,
+                               grpc_pollset *pollset) {
+  shm_endpoint *ep = (shm_endpoint *)ep_base;
+  grpc_pollset_add_fd(exec_ctx, pollset, ep->wakeup_fd);
+  grpc_pollset_add_fd(exec_ctx, pollset, ep->control_fd);
+}
+
+static void shm_add_to_pollset_set(grpc_exec_ctx *exec_ctx,
+                                   grpc_endpoint *ep_base,
+                                   grpc_pollset_set *pollset_set) {
+  shm_endpoint *ep = (shm_endpoint *)ep_base;
+  grpc_pollset_set_add_fd(exec_ctx, pollset_set, ep->wakeup_fd);
+  grpc_pollset_set_add_fd(exec_ctx, pollset_set, ep->control_fd);
+}
+
+static void shm_shutdown(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep_base,
+                         grpc_error *why) {
+  shm_endpoint *ep = (shm_endpoint *)ep_base;
+  gpr_mu_lock(&ep->mu);
+  shutdown_locked(
+      exec_ctx, ep,
+      why != GRPC_ERROR_NONE
+          ? why
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint shutdown"));
+  progress_locked(exec_ctx, ep);
+  gpr_mu_unlock(&ep->mu);
+}
+
+static void shm_unref(grpc_exec_ctx *exec_ctx, shm_endpoint *ep) {
+  if (!gpr_unref(&ep->refs)) return;
+  grpc_fd_orphan(exec_ctx, ep->wakeup_fd, NULL, NULL, false, "shm_endpoint");
+  close(ep->peer_wakeup_fd);
+  grpc_fd_orphan(exec_ctx, ep->control_fd, NULL, NULL, false, "shm_control");
+  munmap(ep->region, ep->region_size);
+  grpc_resource_user_unref(exec_ctx, ep->resource_user);
+  GRPC_ERROR_UNREF(ep->shutdown_error);
+  gpr_mu_destroy(&ep->mu);
+  gpr_free(ep->peer_string);
+  gpr_free(ep);
+}
+
+static void shm_destroy(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep_base) {
+  shm_endpoint *ep = (shm_endpoint *)ep_base;
+  /* releases the references held by the wakeup and control reads */
+  shm_shutdown(exec_ctx, ep_base,
+               GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint destroyed"));
+  shm_unref(exec_ctx, ep);
+}
+
+static grpc_resource_user *shm_get_resource_user(grpc_endpoint *ep_base) {
+  shm_endpoint *ep = (shm_endpoint *)ep_base;
+  return ep->resource_user;
+}
+
+static char *shm_get_peer(grpc_endpoint *ep_base) {
+  shm_endpoint *ep = (shm_endpoint *)ep_base;
+  return gpr_strdup(ep->peer_string);
+}
+
+static int shm_get_fd(grpc_endpoint *ep) { return -1; }
+
+static const grpc_endpoint_vtable vtable = {shm_read,
+                                            shm_write,
+                                            shm_add_to_pollset,
+                                            shm_add_to_pollset_set,
+                                            shm_shutdown,
+                                            shm_destroy,
+                                            shm_get_resource_user,
+                                            shm_get_peer,
+                                            shm_get_fd};
+
+/*******************************************************************************
+ * CREATION
+ */
+
+static grpc_error *map_region(int memfd, void **region, size_t *size,
+                              size_t *ring_size) {
+  int seals = fcntl(memfd, F_GET_SEALS);
+  if (seals < 0) {
+    return GRPC_OS_ERROR(errno, "fcntl(F_GET_SEALS)");
+  }
+  if ((seals & SHM_REQUIRED_SEALS) != SHM_REQUIRED_SEALS) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Shared memory is not sealed against resizing");
+  }
+  struct stat st;
+  if (fstat(memfd, &st) != 0) {
+    return GRPC_OS_ERROR(errno, "fstat");
+  }
+  if ((size_t)st.st_size < sizeof(shm_header)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory too small");
+  }
+  void *p = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 memfd, 0);
+  if (p == MAP_FAILED) {
+    return GRPC_OS_ERROR(errno, "mmap");
+  }
+  shm_header *header = (shm_header *)p;
+  size_t rs = (size_t)header->ring_size;
+  if (header->magic != SHM_MAGIC || rs < SHM_MIN_RING_SIZE ||
+      rs > SHM_MAX_RING_SIZE || (rs & (rs - 1)) != 0 ||
+      region_size(rs) != (size_t)st.st_size) {
+    munmap(p, (size_t)st.st_size);
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Bad shared memory header");
+  }
+  *region = p;
+  *size = (size_t)st.st_size;
+  *ring_size = rs;
+  return GRPC_ERROR_NONE;
+}
+
+grpc_endpoint *grpc_shm_endpoint_create(grpc_exec_ctx *exec_ctx,
+                                        grpc_shm_fds *fds, grpc_shm_side side,
+                                        struct grpc_fd *control_fd,
+                                        const grpc_channel_args *args,
+                                        const char *peer_string,
+                                        grpc_error **error) {
+  void *region = NULL;
+  size_t size = 0;
+  size_t ring_size = 0;
+  *error = map_region(fds->memfd, &region, &size, &ring_size);
+  if (*error != GRPC_ERROR_NONE) {
+    grpc_shm_fds_close(fds);
+    grpc_fd_orphan(exec_ctx, control_fd, NULL, NULL, false, "shm_control");
+    return NULL;
+  }
+  shm_header *header = (shm_header *)region;
+  uint8_t *data = (uint8_t *)region + sizeof(shm_header);
+  const int peer = 1 - side;
+
+  shm_endpoint *ep = (shm_endpoint *)gpr_zalloc(sizeof(*ep));
+  ep->base.vtable = &vtable;
+  gpr_ref_init(&ep->refs, 1);
+  gpr_mu_init(&ep->mu);
+  ep->region = region;
+  ep->region_size = size;
+  ep->ring_size = ring_size;
+  ep->tx.head = &header->rings[side].head.value;
+  ep->tx.tail = &header->rings[side].tail.value;
+  ep->tx.data = data + side * ring_size;
+  ep->rx.head = &header->rings[peer].head.value;
+  ep->rx.tail = &header->rings[peer].tail.value;
+  ep->rx.data = data + peer * ring_size;
+  ep->waiting = &header->waiting[side].value;
+  ep->peer_waiting = &header->waiting[peer].value;
+  char *name;
+  gpr_asprintf(&name, "shm-wakeup:%s", peer_string);
+  ep->wakeup_fd = grpc_fd_create(fds->wakeup_fds[side], name);
+  gpr_free(name);
+  ep->peer_wakeup_fd = fds->wakeup_fds[peer];
+  close(fds->memfd);
+  fds->memfd = fds->wakeup_fds[0] = fds->wakeup_fds[1] = -1;
+  GRPC_CLOSURE_INIT(&ep->on_wakeup, on_wakeup, ep, grpc_schedule_on_exec_ctx);
+  ep->control_fd = control_fd;
+  GRPC_CLOSURE_INIT(&ep->on_control_readable, on_control_readable, ep,
+                    grpc_schedule_on_exec_ctx);
+  ep->shutdown_error = GRPC_ERROR_NONE;
+  grpc_resource_quota *resource_quota =
+      grpc_resource_quota_from_channel_args(args);
+  ep->resource_user = grpc_resource_user_create(resource_quota, peer_string);
+  grpc_resource_quota_unref_internal(exec_ctx, resource_quota);
+  ep->peer_string = gpr_strdup(peer_string);
+
+  gpr_ref(&ep->refs);
+  grpc_fd_notify_on_read(exec_ctx, ep->control_fd, &ep->on_control_readable);
+  return &ep->base;
+}
+
+grpc_error *grpc_shm_endpoint_pair_create(const char *name,
+                                          grpc_channel_args *args,
+                                          grpc_endpoint_pair *pair) {
+  pair->client = pair->server = NULL;
+  int sv[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+    return GRPC_OS_ERROR(errno, "socketpair");
+  }
+  grpc_error *error = grpc_set_socket_nonblocking(sv[0], 1);
+  if (error == GRPC_ERROR_NONE) error = grpc_set_socket_nonblocking(sv[1], 1);
+  grpc_shm_fds client_fds;
+  grpc_shm_fds server_fds;
+  if (error == GRPC_ERROR_NONE) {
+    error = grpc_shm_fds_create(grpc_shm_ring_size_from_channel_args(args),
+                                &client_fds);
+  }
+  if (error != GRPC_ERROR_NONE) {
+    close(sv[0]);
+    close(sv[1]);
+    return error;
+  }
+  server_fds.memfd = dup(client_fds.memfd);
+  server_fds.wakeup_fds[0] = dup(client_fds.wakeup_fds[0]);
+  server_fds.wakeup_fds[1] = dup(client_fds.wakeup_fds[1]);
+  if (server_fds.memfd < 0 || server_fds.wakeup_fds[0] < 0 ||
+      server_fds.wakeup_fds[1] < 0) {
+    error = GRPC_OS_ERROR(errno, "dup");
+    grpc_shm_fds_close(&client_fds);
+    grpc_shm_fds_close(&server_fds);
+    close(sv[0]);
+    close(sv[1]);
+    return error;
+  }
+
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  char *peer;
+  grpc_error *server_error;
+  gpr_asprintf(&peer, "shm:%s:server", name);
+  pair->client = grpc_shm_endpoint_create(&exec_ctx, &client_fds,
+                                          GRPC_SHM_CLIENT,
+                                          grpc_fd_create(sv[0], peer), args,
+                                          peer, &error);
+  gpr_free(peer);
+  gpr_asprintf(&peer, "shm:%s:client", name);
+  pair->server = grpc_shm_endpoint_create(&exec_ctx, &server_fds,
+                                          GRPC_SHM_SERVER,
+                                          grpc_fd_create(sv[1], peer), args,
+                                          peer, &server_error);
+  gpr_free(peer);
+  if (error == GRPC_ERROR_NONE) {
+    error = server_error;
+  } else {
+    GRPC_ERROR_UNREF(server_error);
+  }
+  if (error != GRPC_ERROR_NONE) {
+    if (pair->client != NULL) grpc_endpoint_destroy(&exec_ctx, pair->client);
+    if (pair->server != NULL) grpc_endpoint_destroy(&exec_ctx, pair->server);
+    pair->client = pair->server = NULL;
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  return error;
+}
+
+#else /* GRPC_LINUX_EVENTFD */
+
+#ifdef GRPC_POSIX_SOCKET
+#include "src/core/lib/iomgr/ev_posix.h"
+#endif
+
+size_t grpc_shm_ring_size_from_channel_args(const grpc_channel_args *args) {
+  return GRPC_SHM_DEFAULT_RING_SIZE;
+}
+
+grpc_error *grpc_shm_fds_create(size_t ring_size, grpc_shm_fds *fds) {
+  fds->memfd = fds->wakeup_fds[0] = fds->wakeup_fds[1] = -1;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Shared memory transport is not supported on this platform");
+}
+
+void grpc_shm_fds_close(grpc_shm_fds *fds) {}
+
+grpc_endpoint *grpc_shm_endpoint_create(grpc_exec_ctx *exec_ctx,
+                                        grpc_shm_fds *fds, grpc_shm_side side,
+                                        struct grpc_fd *control_fd,
+                                        const grpc_channel_args *args,
+                                        const char *peer_string,
+                                        grpc_error **error) {
+  *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Shared memory transport is not supported on this platform");
+#ifdef GRPC_POSIX_SOCKET
+  grpc_fd_orphan(exec_ctx, control_fd, NULL, NULL, false, "shm_control");
+#endif
+  return NULL;
+}
+
+grpc_error *grpc_shm_endpoint_pair_create(const char *name,
+                                          grpc_channel_args *args,
+                                          grpc_endpoint_pair *pair) {
+  pair->client = pair->server = NULL;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Shared memory transport is not supported on this platform");
+}
+
+#endif /* GRPC_LINUX_EVENTFD */
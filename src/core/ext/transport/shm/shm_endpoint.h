@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+
+/* An endpoint between two processes on the same host that moves bytes
+   through a pair of single producer/single consumer rings in a memfd backed
+   shared memory region: ring 0 carries client to server bytes, ring 1
+   server to client bytes. Each side sleeps on its own eventfd, which the
+   peer only signals when the side announced (in the shared region) that it
+   is about to wait, so a busy connection makes no syscalls per message.
+
+   Peer liveness is tracked through a control socket (the Unix socket the
+   descriptors were passed over): once the peer closes it the remaining ring
+   contents are delivered and reads then fail. */
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size in bytes of each of the two rings of a shared memory connection,
+    rounded up to a power of two; only read by the connecting side */
+#define GRPC_ARG_SHM_RING_SIZE "grpc.shm.ring_size"
+
+#define GRPC_SHM_DEFAULT_RING_SIZE (1024 * 1024)
+
+struct grpc_fd;
+
+typedef enum { GRPC_SHM_CLIENT = 0, GRPC_SHM_SERVER = 1 } grpc_shm_side;
+
+/* The descriptors that make up one shared memory connection */
+typedef struct {
+  int memfd;
+  int wakeup_fds[2]; /* indexed by grpc_shm_side */
+} grpc_shm_fds;
+
+/* Ring size requested by args, clamped and rounded to a power of two */
+size_t grpc_shm_ring_size_from_channel_args(const grpc_channel_args *args);
+
+/* Create and initialize the shared memory and wakeup descriptors for a new
+   connection. On error no descriptors are left open. */
+grpc_error *grpc_shm_fds_create(size_t ring_size, grpc_shm_fds *fds);
+
+/* Close all descriptors in fds */
+void grpc_shm_fds_close(grpc_shm_fds *fds);
+
+/* Create one side of a connection. Takes ownership of fds and of
+   control_fd (also on failure, when NULL is returned and *error is set). */
+grpc_endpoint *grpc_shm_endpoint_create(grpc_exec_ctx *exec_ctx,
+                                        grpc_shm_fds *fds, grpc_shm_side side,
+                                        struct grpc_fd *control_fd,
+                                        const grpc_channel_args *args,
+                                        const char *peer_string,
+                                        grpc_error **error);
+
+/* Both sides of a connection within this process; the client side is
+   returned as pair->client. On error both sides are NULL. */
+grpc_error *grpc_shm_endpoint_pair_create(const char *name,
+                                          grpc_channel_args *args,
+                                          grpc_endpoint_pair *pair);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H */
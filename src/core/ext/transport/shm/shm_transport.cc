@@ -0,0 +1,625 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/port.h"
+
+#include "src/core/ext/transport/shm/shm_transport.h"
+
+#include <grpc/support/log.h>
+
+#ifdef GRPC_LINUX_EVENTFD
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/iomgr/tcp_server.h"
+#include "src/core/lib/iomgr/unix_sockets_posix.h"
+#include "src/core/lib/surface/api_trace.h"
+#include "src/core/lib/surface/channel.h"
+#include "src/core/lib/surface/server.h"
+#include "src/core/lib/transport/transport.h"
+
+#define SHM_BOOTSTRAP_FD_COUNT 3
+
+typedef union {
+  struct cmsghdr align;
+  char buf[CMSG_SPACE(SHM_BOOTSTRAP_FD_COUNT * sizeof(int))];
+} bootstrap_control;
+
+static grpc_error *send_fds(int sock, const grpc_shm_fds *fds) {
+  char byte = 0;
+  struct iovec iov = {&byte, 1};
+  bootstrap_control control;
+  struct msghdr msg;
+  memset(&control, 0, sizeof(control));
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(SHM_BOOTSTRAP_FD_COUNT * sizeof(int));
+  const int fd_list[SHM_BOOTSTRAP_FD_COUNT] = {
+      fds->memfd, fds->wakeup_fds[0], fds->wakeup_fds[1]};
+  memcpy(CMSG_DATA(cmsg), fd_list, sizeof(fd_list));
+  ssize_t sent;
+  do {
+    sent = sendmsg(sock, &msg, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  if (sent != 1) {
+    return GRPC_OS_ERROR(errno, "sendmsg");
+  }
+  return GRPC_ERROR_NONE;
+}
+
+/* Sets *would_block instead of failing when nothing has arrived yet */
+static grpc_error *recv_fds(int sock, grpc_shm_fds *fds, bool *would_block) {
+  char byte;
+  struct iovec iov = {&byte, 1};
+  bootstrap_control control;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  fds->memfd = fds->wakeup_fds[0] = fds->wakeup_fds[1] = -1;
+  *would_block = false;
+  ssize_t received;
+  do {
+    received = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0) {
+    if (errno == EAGAIN) {
+      *would_block = true;
+      return GRPC_ERROR_NONE;
+    }
+    return GRPC_OS_ERROR(errno, "recvmsg");
+  }
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  if (received != 1 || cmsg == NULL || cmsg->cmsg_level != SOL_SOCKET ||
+      cmsg->cmsg_type != SCM_RIGHTS) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "No shared memory descriptors received");
+  }
+  int fd_list[SHM_BOOTSTRAP_FD_COUNT];
+  size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+  if (count != SHM_BOOTSTRAP_FD_COUNT) {
+    int *received_fds = (int *)CMSG_DATA(cmsg);
+    for (size_t i = 0; i < count; i++) close(received_fds[i]);
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Wrong number of shared memory descriptors received");
+  }
+  memcpy(fd_list, CMSG_DATA(cmsg), sizeof(fd_list));
+  fds->memfd = fd_list[0];
+  fds->wakeup_fds[0] = fd_list[1];
+  fds->wakeup_fds[1] = fd_list[2];
+  return GRPC_ERROR_NONE;
+}
+
+/*******************************************************************************
+ * CLIENT
+ */
+
+static grpc_error *connect_socket(const char *path, int *sock) {
+  struct sockaddr_un un;
+  if (strlen(path) >= sizeof(un.sun_path)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket path too long");
+  }
+  *sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (*sock < 0) {
+    return GRPC_OS_ERROR(errno, "socket");
+  }
+  memset(&un, 0, sizeof(un));
+  un.sun_family = AF_UNIX;
+  strcpy(un.sun_path, path);
+  int err;
+  do {
+    err = connect(*sock, (struct sockaddr *)&un, sizeof(un));
+  } while (err < 0 && errno == EINTR);
+  if (err < 0) {
+    grpc_error *error = GRPC_OS_ERROR(errno, "connect");
+    close(*sock);
+    *sock = -1;
+    return error;
+  }
+  return GRPC_ERROR_NONE;
+}
+
+/* Create a connection, hand its descriptors to the server over sock and
+   wrap our side in an endpoint that keeps sock as its control socket.
+   Takes ownership of sock. */
+static grpc_error *client_bootstrap(grpc_exec_ctx *exec_ctx, int sock,
+                                    const grpc_channel_args *args,
+                                    const char *peer, grpc_endpoint **ep) {
+  *ep = NULL;
+  grpc_shm_fds fds;
+  grpc_error *error =
+      grpc_shm_fds_create(grpc_shm_ring_size_from_channel_args(args), &fds);
+  if (error == GRPC_ERROR_NONE) {
+    error = send_fds(sock, &fds);
+    if (error != GRPC_ERROR_NONE) grpc_shm_fds_close(&fds);
+  }
+  if (error == GRPC_ERROR_NONE) {
+    error = grpc_set_socket_nonblocking(sock, 1);
+    if (error != GRPC_ERROR_NONE) grpc_shm_fds_close(&fds);
+  }
+  if (error != GRPC_ERROR_NONE) {
+    close(sock);
+    return error;
+  }
+  *ep = grpc_shm_endpoint_create(exec_ctx, &fds, GRPC_SHM_CLIENT,
+                                 grpc_fd_create(sock, peer), args, peer,
+                                 &error);
+  return error;
+}
+
+/* sock < 0 means connecting already failed */
+static grpc_channel *client_channel_create(const char *target, int sock,
+                                           const grpc_channel_args *args) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_arg default_authority_arg = grpc_channel_arg_string_create(
+      (char *)GRPC_ARG_DEFAULT_AUTHORITY, (char *)"localhost");
+  grpc_channel_args *final_args =
+      grpc_channel_args_copy_and_add(args, &default_authority_arg, 1);
+
+  grpc_channel *channel = NULL;
+  if (sock >= 0) {
+    grpc_endpoint *ep;
+    grpc_error *error =
+        client_bootstrap(&exec_ctx, sock, final_args, target, &ep);
+    if (error == GRPC_ERROR_NONE) {
+      grpc_transport *transport =
+          grpc_create_chttp2_transport(&exec_ctx, final_args, ep, 1);
+      GPR_ASSERT(transport);
+      channel = grpc_channel_create(&exec_ctx, target, final_args,
+                                    GRPC_CLIENT_DIRECT_CHANNEL, transport);
+      grpc_chttp2_transport_start_reading(&exec_ctx, transport, NULL);
+    } else {
+      gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+      GRPC_ERROR_UNREF(error);
+    }
+  }
+  grpc_channel_args_destroy(&exec_ctx, final_args);
+  grpc_exec_ctx_finish(&exec_ctx);
+
+  return channel != NULL ? channel : grpc_lame_client_channel_create(
+                                         target, GRPC_STATUS_UNAVAILABLE,
+                                         "Failed to create shm channel");
+}
+
+grpc_channel *grpc_shm_channel_create(const char *path,
+                                      const grpc_channel_args *args) {
+  GRPC_API_TRACE("grpc_shm_channel_create(path=%s, args=%p)", 2,
+                 (path, args));
+  int sock = -1;
+  grpc_error *error = connect_socket(path, &sock);
+  if (error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+    GRPC_ERROR_UNREF(error);
+  }
+  char *target;
+  gpr_asprintf(&target, "shm:%s", path);
+  grpc_channel *channel = client_channel_create(target, sock, args);
+  gpr_free(target);
+  return channel;
+}
+
+grpc_channel *grpc_shm_channel_create_from_fd(const char *target, int fd,
+                                              const grpc_channel_args *args) {
+  GRPC_API_TRACE(
+      "grpc_shm_channel_create_from_fd(target=%s, fd=%d, args=%p)", 3,
+      (target, fd, args));
+  return client_channel_create(target, fd, args);
+}
+
+/*******************************************************************************
+ * SERVER
+ */
+
+typedef struct server_handshake server_handshake;
+
+/* A listener: either a listening Unix socket, or (with a NULL tcp_server)
+   the connections added to a running server from descriptors */
+typedef struct server_state {
+  grpc_server *server;
+  grpc_tcp_server *tcp_server;
+  grpc_channel_args *args;
+  gpr_mu mu;
+  bool shutdown;
+  /* connections still waiting for their descriptors */
+  server_handshake *pending;
+  /* held by the tcp server, by the registration with the server and by each
+     pending connection */
+  gpr_refcount refs;
+  grpc_closure tcp_server_shutdown_complete;
+  grpc_closure *server_destroy_listener_done;
+  /* the descriptor listener of a server is shared by all its connections
+     added from descriptors, and linked into g_fd_listeners until destroyed */
+  bool from_fd;
+  struct server_state *next_fd_listener;
+} server_state;
+
+static gpr_once g_fd_listeners_once = GPR_ONCE_INIT;
+static gpr_mu g_fd_listeners_mu;
+static server_state *g_fd_listeners;
+
+static void init_fd_listeners(void) { gpr_mu_init(&g_fd_listeners_mu); }
+
+/* A control socket the client has not sent the connection descriptors over
+   yet. Waiting is done through the poller so that a slow (or not yet
+   running) client never blocks the server. */
+struct server_handshake {
+  server_state *state;
+  /* NULL for connections added with grpc_server_add_shm_channel_from_fd */
+  grpc_pollset *accepting_pollset;
+  char *peer;
+  int raw_fd;
+  grpc_fd *fd;
+  grpc_closure on_released;
+  grpc_closure on_readable;
+  server_handshake *next;
+  server_handshake *prev;
+};
+
+static void server_state_unref(grpc_exec_ctx *exec_ctx, server_state *state) {
+  if (!gpr_unref(&state->refs)) return;
+  /* ensure all threads have unlocked */
+  gpr_mu_lock(&state->mu);
+  grpc_closure *destroy_done = state->server_destroy_listener_done;
+  GPR_ASSERT(state->pending == NULL);
+  gpr_mu_unlock(&state->mu);
+  if (destroy_done != NULL) {
+    destroy_done->cb(exec_ctx, destroy_done->cb_arg, GRPC_ERROR_NONE);
+    grpc_exec_ctx_flush(exec_ctx);
+  }
+  grpc_channel_args_destroy(exec_ctx, state->args);
+  gpr_mu_destroy(&state->mu);
+  gpr_free(state);
+}
+
+static void handshake_remove_locked(server_handshake *hs) {
+  server_state *state = hs->state;
+  if (hs->prev != NULL) {
+    hs->prev->next = hs->next;
+  } else {
+    state->pending = hs->next;
+  }
+  if (hs->next != NULL) hs->next->prev = hs->prev;
+}
+
+static void handshake_done(grpc_exec_ctx *exec_ctx, server_handshake *hs,
+                           grpc_error *error, grpc_shm_fds *fds) {
+  server_state *state = hs->state;
+  gpr_mu_lock(&state->mu);
+  handshake_remove_locked(hs);
+  if (error == GRPC_ERROR_NONE && state->shutdown) {
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server shutdown");
+  }
+  gpr_mu_unlock(&state->mu);
+  grpc_endpoint *ep = NULL;
+  if (error == GRPC_ERROR_NONE) {
+    ep = grpc_shm_endpoint_create(exec_ctx, fds, GRPC_SHM_SERVER, hs->fd,
+                                  state->args, hs->peer, &error);
+  } else {
+    if (fds != NULL) grpc_shm_fds_close(fds);
+    grpc_fd_orphan(exec_ctx, hs->fd, NULL, NULL, false,
+                   "shm_handshake_failed");
+  }
+  if (ep != NULL) {
+    grpc_transport *transport =
+        grpc_create_chttp2_transport(exec_ctx, state->args, ep, 0);
+    if (hs->accepting_pollset == NULL) {
+      grpc_pollset **pollsets;
+      size_t num_pollsets = 0;
+      grpc_server_get_pollsets(state->server, &pollsets, &num_pollsets);
+      for (size_t i = 0; i < num_pollsets; i++) {
+        grpc_endpoint_add_to_pollset(exec_ctx, ep, pollsets[i]);
+      }
+    }
+    grpc_server_setup_transport(exec_ctx, state->server, transport,
+                                hs->accepting_pollset, state->args);
+    grpc_chttp2_transport_start_reading(exec_ctx, transport, NULL);
+  } else {
+    gpr_log(GPR_DEBUG, "Shared memory bootstrap failed: %s",
+            grpc_error_string(error));
+    GRPC_ERROR_UNREF(error);
+  }
+  gpr_free(hs->peer);
+  gpr_free(hs);
+  server_state_unref(exec_ctx, state);
+}
+
+static void handshake_on_readable(grpc_exec_ctx *exec_ctx, void *arg,
+                                  grpc_error *error) {
+  server_handshake *hs = (server_handshake *)arg;
+  if (error != GRPC_ERROR_NONE) {
+    handshake_done(exec_ctx, hs, GRPC_ERROR_REF(error), NULL);
+    return;
+  }
+  grpc_shm_fds fds;
+  bool would_block;
+  error = recv_fds(grpc_fd_wrapped_fd(hs->fd), &fds, &would_block);
+  if (would_block) {
+    grpc_fd_notify_on_read(exec_ctx, hs->fd, &hs->on_readable);
+    return;
+  }
+  handshake_done(exec_ctx, hs, error, &fds);
+}
+
+/* Consumes the state reference taken for the handshake */
+static void handshake_start(grpc_exec_ctx *exec_ctx, server_handshake *hs) {
+  server_state *state = hs->state;
+  GRPC_CLOSURE_INIT(&hs->on_readable, handshake_on_readable, hs,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(&state->mu);
+  bool shutdown = state->shutdown;
+  hs->prev = NULL;
+  hs->next = state->pending;
+  if (state->pending != NULL) state->pending->prev = hs;
+  state->pending = hs;
+  gpr_mu_unlock(&state->mu);
+  if (shutdown) {
+    handshake_done(exec_ctx, hs,
+                   GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server shutdown"),
+                   NULL);
+    return;
+  }
+  grpc_fd_notify_on_read(exec_ctx, hs->fd, &hs->on_readable);
+}
+
+static void handshake_on_released(grpc_exec_ctx *exec_ctx, void *arg,
+                                  grpc_error *error) {
+  server_handshake *hs = (server_handshake *)arg;
+  hs->fd = grpc_fd_create(hs->raw_fd, hs->peer);
+  grpc_pollset_add_fd(exec_ctx, hs->accepting_pollset, hs->fd);
+  handshake_start(exec_ctx, hs);
+}
+
+static void on_accept(grpc_exec_ctx *exec_ctx, void *arg, grpc_endpoint *tcp,
+                      grpc_pollset *accepting_pollset,
+                      grpc_tcp_server_acceptor *acceptor) {
+  server_state *state = (server_state *)arg;
+  gpr_free(acceptor);
+  gpr_mu_lock(&state->mu);
+  if (state->shutdown) {
+    gpr_mu_unlock(&state->mu);
+    grpc_endpoint_shutdown(exec_ctx, tcp, GRPC_ERROR_NONE);
+    grpc_endpoint_destroy(exec_ctx, tcp);
+    return;
+  }
+  gpr_ref(&state->refs);
+  gpr_mu_unlock(&state->mu);
+  /* The descriptors are passed as ancillary data, which the tcp endpoint
+     would discard: take the socket back and read it ourselves */
+  server_handshake *hs = (server_handshake *)gpr_zalloc(sizeof(*hs));
+  hs->state = state;
+  hs->accepting_pollset = accepting_pollset;
+  hs->peer = grpc_endpoint_get_peer(tcp);
+  GRPC_CLOSURE_INIT(&hs->on_released, handshake_on_released, hs,
+                    grpc_schedule_on_exec_ctx);
+  grpc_tcp_destroy_and_release_fd(exec_ctx, tcp, &hs->raw_fd,
+                                  &hs->on_released);
+}
+
+/* Server callback: start listening on our ports */
+static void server_start_listener(grpc_exec_ctx *exec_ctx, grpc_server *server,
+                                  void *arg, grpc_pollset **pollsets,
+                                  size_t pollset_count) {
+  server_state *state = (server_state *)arg;
+  gpr_mu_lock(&state->mu);
+  state->shutdown = false;
+  gpr_mu_unlock(&state->mu);
+  if (state->tcp_server != NULL) {
+    grpc_tcp_server_start(exec_ctx, state->tcp_server, pollsets,
+                          pollset_count, on_accept, state);
+  }
+}
+
+static void tcp_server_shutdown_complete(grpc_exec_ctx *exec_ctx, void *arg,
+                                         grpc_error *error) {
+  server_state_unref(exec_ctx, (server_state *)arg);
+}
+
+/* Server callback: destroy the listener (so we don't generate further
+   callbacks) */
+static void server_destroy_listener(grpc_exec_ctx *exec_ctx,
+                                    grpc_server *server, void *arg,
+                                    grpc_closure *destroy_done) {
+  server_state *state = (server_state *)arg;
+  if (state->from_fd) {
+    gpr_mu_lock(&g_fd_listeners_mu);
+    server_state **p = &g_fd_listeners;
+    while (*p != state) p = &(*p)->next_fd_listener;
+    *p = state->next_fd_listener;
+    gpr_mu_unlock(&g_fd_listeners_mu);
+  }
+  gpr_mu_lock(&state->mu);
+  state->shutdown = true;
+  state->server_destroy_listener_done = destroy_done;
+  grpc_tcp_server *tcp_server = state->tcp_server;
+  for (server_handshake *hs = state->pending; hs != NULL; hs = hs->next) {
+    grpc_fd_shutdown(exec_ctx, hs->fd,
+                     GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server shutdown"));
+  }
+  gpr_mu_unlock(&state->mu);
+  if (tcp_server != NULL) {
+    grpc_tcp_server_shutdown_listeners(exec_ctx, tcp_server);
+    grpc_tcp_server_unref(exec_ctx, tcp_server);
+  }
+  server_state_unref(exec_ctx, state);
+}
+
+static server_state *server_state_create(grpc_server *server,
+                                         grpc_channel_args *args) {
+  server_state *state = (server_state *)gpr_zalloc(sizeof(*state));
+  state->server = server;
+  state->args = args;
+  state->shutdown = true;
+  gpr_mu_init(&state->mu);
+  gpr_ref_init(&state->refs, 1);
+  GRPC_CLOSURE_INIT(&state->tcp_server_shutdown_complete,
+                    tcp_server_shutdown_complete, state,
+                    grpc_schedule_on_exec_ctx);
+  return state;
+}
+
+static grpc_error *add_port(grpc_exec_ctx *exec_ctx, grpc_server *server,
+                            const char *path, grpc_channel_args *args) {
+  grpc_resolved_addresses *resolved = NULL;
+  grpc_error *err = grpc_resolve_unix_domain_address(path, &resolved);
+  if (err != GRPC_ERROR_NONE) {
+    grpc_channel_args_destroy(exec_ctx, args);
+    return err;
+  }
+  /* the initial state reference belongs to the tcp server */
+  server_state *state = server_state_create(server, args);
+  err = grpc_tcp_server_create(exec_ctx, &state->tcp_server_shutdown_complete,
+                               args, &state->tcp_server);
+  if (err != GRPC_ERROR_NONE) {
+    grpc_resolved_addresses_destroy(resolved);
+    server_state_unref(exec_ctx, state);
+    return err;
+  }
+  int port;
+  err = grpc_tcp_server_add_port(state->tcp_server, &resolved->addrs[0],
+                                 &port);
+  grpc_resolved_addresses_destroy(resolved);
+  if (err != GRPC_ERROR_NONE) {
+    grpc_tcp_server_unref(exec_ctx, state->tcp_server);
+    return err;
+  }
+  /* Register with the server only upon success */
+  gpr_ref(&state->refs);
+  grpc_server_add_listener(exec_ctx, server, state, server_start_listener,
+                           server_destroy_listener);
+  return GRPC_ERROR_NONE;
+}
+
+int grpc_server_add_shm_port(grpc_server *server, const char *path) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  GRPC_API_TRACE("grpc_server_add_shm_port(server=%p, path=%s)", 2,
+                 (server, path));
+  grpc_error *err = add_port(
+      &exec_ctx, server, path,
+      grpc_channel_args_copy(grpc_server_get_channel_args(server)));
+  int result = 1;
+  if (err != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "%s", grpc_error_string(err));
+    GRPC_ERROR_UNREF(err);
+    result = 0;
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  return result;
+}
+
+void grpc_server_add_shm_channel_from_fd(grpc_server *server, int fd) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  GRPC_API_TRACE("grpc_server_add_shm_channel_from_fd(server=%p, fd=%d)", 2,
+                 (server, fd));
+  grpc_error *error = grpc_set_socket_nonblocking(fd, 1);
+  if (error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+    GRPC_ERROR_UNREF(error);
+    close(fd);
+    grpc_exec_ctx_finish(&exec_ctx);
+    return;
+  }
+  /* A listener (that is never started) is registered once per server so
+     that server shutdown cancels, and waits for, connections still
+     bootstrapping */
+  gpr_once_init(&g_fd_listeners_once, init_fd_listeners);
+  gpr_mu_lock(&g_fd_listeners_mu);
+  server_state *state = g_fd_listeners;
+  while (state != NULL && state->server != server) {
+    state = state->next_fd_listener;
+  }
+  bool created = state == NULL;
+  if (created) {
+    /* the initial reference belongs to the registration with the server */
+    state = server_state_create(
+        server, grpc_channel_args_copy(grpc_server_get_channel_args(server)));
+    state->shutdown = false;
+    state->from_fd = true;
+    state->next_fd_listener = g_fd_listeners;
+    g_fd_listeners = state;
+  }
+  gpr_ref(&state->refs);
+  gpr_mu_unlock(&g_fd_listeners_mu);
+  if (created) {
+    grpc_server_add_listener(&exec_ctx, server, state, server_start_listener,
+                             server_destroy_listener);
+  }
+  server_handshake *hs = (server_handshake *)gpr_zalloc(sizeof(*hs));
+  hs->state = state;
+  gpr_asprintf(&hs->peer, "shm-fd:%d", fd);
+  hs->fd = grpc_fd_create(fd, hs->peer);
+  grpc_pollset **pollsets;
+  size_t num_pollsets = 0;
+  grpc_server_get_pollsets(server, &pollsets, &num_pollsets);
+  for (size_t i = 0; i < num_pollsets; i++) {
+    grpc_pollset_add_fd(&exec_ctx, pollsets[i], hs->fd);
+  }
+  handshake_start(&exec_ctx, hs);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+#else /* GRPC_LINUX_EVENTFD */
+
+grpc_channel *grpc_shm_channel_create(const char *path,
+                                      const grpc_channel_args *args) {
+  return grpc_lame_client_channel_create(
+      path, GRPC_STATUS_UNIMPLEMENTED,
+      "Shared memory transport is not supported on this platform");
+}
+
+grpc_channel *grpc_shm_channel_create_from_fd(const char *target, int fd,
+                                              const grpc_channel_args *args) {
+  return grpc_lame_client_channel_create(
+      target, GRPC_STATUS_UNIMPLEMENTED,
+      "Shared memory transport is not supported on this platform");
+}
+
+int grpc_server_add_shm_port(grpc_server *server, const char *path) {
+  gpr_log(GPR_ERROR,
+          "Shared memory transport is not supported on this platform");
+  return 0;
+}
+
+void grpc_server_add_shm_channel_from_fd(grpc_server *server, int fd) {
+  GPR_ASSERT(0);
+}
+
+#endif /* GRPC_LINUX_EVENTFD */
@@ -0,0 +1,59 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
+
+/* Shared memory connections between processes on one host. The server
+   listens on a Unix socket; a connecting client creates the shared memory
+   and wakeup descriptors (see shm_endpoint.h) and passes them over the
+   socket, which then only serves to detect the peer going away. Calls are
+   carried by the chttp2 transport on top of the shared memory endpoint, so
+   stream op batches behave exactly as over TCP. */
+
+#include <grpc/grpc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Create a client channel connected to a server listening on the Unix
+   socket at path. Returns a lame channel if the connection fails. */
+grpc_channel *grpc_shm_channel_create(const char *path,
+                                      const grpc_channel_args *args);
+
+/* Create a client channel over fd, a connected Unix stream socket whose
+   other end is passed to grpc_server_add_shm_channel_from_fd. Takes
+   ownership of fd. */
+grpc_channel *grpc_shm_channel_create_from_fd(const char *target, int fd,
+                                              const grpc_channel_args *args);
+
+/* Accept shared memory connections on the Unix socket at path.
+   Returns 1 on success, 0 on failure. */
+int grpc_server_add_shm_port(grpc_server *server, const char *path);
+
+/* Serve the connection set up by a client over fd (see
+   grpc_shm_channel_create_from_fd). Must be called after grpc_server_start.
+   Takes ownership of fd. */
+void grpc_server_add_shm_channel_from_fd(grpc_server *server, int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H */
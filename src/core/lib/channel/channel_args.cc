@@ -26,9 +26,11 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 #include <grpc/support/useful.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/support/murmur_hash.h"
 #include "src/core/lib/support/string.h"
 
 static grpc_arg copy_arg(const grpc_arg *src) {
@@ -499,3 +501,133 @@ grpc_arg grpc_channel_arg_pointer_create(
   arg.value.pointer.vtable = vtable;
   return arg;
 }
+
+typedef struct {
+  uint32_t key_hash;
+  const grpc_arg *arg;  // NULL for an empty slot
+} preprocessed_slot;
+
+struct grpc_preprocessed_channel_args {
+  gpr_refcount refs;
+  grpc_channel_args *args;
+  uint32_t hash;
+  // Open addressing table of the first arg for each key, sized to a power of
+  // two of at least twice the number of args.
+  size_t slot_mask;
+  preprocessed_slot *slots;
+};
+
+static uint32_t hash_key(const char *key) {
+  return gpr_murmur_hash3(key, strlen(key), 0);
+}
+
+// Consistent with cmp_arg: pointer args that compare equal may point to
+// different objects (or have different vtables), so only their keys are
+// hashed.
+static uint32_t hash_arg(const grpc_arg *arg, uint32_t key_hash) {
+  uint32_t h = key_hash ^ (uint32_t)arg->type;
+  switch (arg->type) {
+    case GRPC_ARG_STRING:
+      return gpr_murmur_hash3(arg->value.string, strlen(arg->value.string),
+                              h);
+    case GRPC_ARG_INTEGER:
+      return gpr_murmur_hash3(&arg->value.integer, sizeof(arg->value.integer),
+                              h);
+    case GRPC_ARG_POINTER:
+      return h;
+  }
+  GPR_UNREACHABLE_CODE(return h);
+}
+
+grpc_preprocessed_channel_args *grpc_preprocessed_channel_args_create(
+    const grpc_channel_args *args) {
+  grpc_preprocessed_channel_args *p =
+      (grpc_preprocessed_channel_args *)gpr_malloc(sizeof(*p));
+  gpr_ref_init(&p->refs, 1);
+  if (args == NULL) {
+    p->args = (grpc_channel_args *)gpr_zalloc(sizeof(*p->args));
+  } else {
+    p->args = grpc_channel_args_normalize(args);
+  }
+  size_t num_slots = 2;
+  while (num_slots < 2 * p->args->num_args) num_slots *= 2;
+  p->slot_mask = num_slots - 1;
+  p->slots = (preprocessed_slot *)gpr_zalloc(sizeof(*p->slots) * num_slots);
+  p->hash = (uint32_t)p->args->num_args;
+  for (size_t i = 0; i < p->args->num_args; i++) {
+    const grpc_arg *arg = &p->args->args[i];
+    uint32_t key_hash = hash_key(arg->key);
+    p->hash = p->hash * 31 + hash_arg(arg, key_hash);
+    size_t slot = key_hash & p->slot_mask;
+    for (;;) {
+      preprocessed_slot *s = &p->slots[slot];
+      if (s->arg == NULL) {
+        s->key_hash = key_hash;
+        s->arg = arg;
+        break;
+      }
+      // Keep the first arg with a given key, as grpc_channel_args_find does.
+      if (s->key_hash == key_hash && strcmp(s->arg->key, arg->key) == 0) {
+        break;
+      }
+      slot = (slot + 1) & p->slot_mask;
+    }
+  }
+  return p;
+}
+
+grpc_preprocessed_channel_args *grpc_preprocessed_channel_args_ref(
+    grpc_preprocessed_channel_args *args) {
+  gpr_ref_non_zero(&args->refs);
+  return args;
+}
+
+void grpc_preprocessed_channel_args_unref(
+    grpc_exec_ctx *exec_ctx, grpc_preprocessed_channel_args *args) {
+  if (gpr_unref(&args->refs)) {
+    grpc_channel_args_destroy(exec_ctx, args->args);
+    gpr_free(args->slots);
+    gpr_free(args);
+  }
+}
+
+const grpc_channel_args *grpc_preprocessed_channel_args_get(
+    const grpc_preprocessed_channel_args *args) {
+  return args->args;
+}
+
+const grpc_arg *grpc_preprocessed_channel_args_find(
+    const grpc_preprocessed_channel_args *args, const char *name) {
+  uint32_t key_hash = hash_key(name);
+  for (size_t slot = key_hash & args->slot_mask;;
+       slot = (slot + 1) & args->slot_mask) {
+    const preprocessed_slot *s = &args->slots[slot];
+    if (s->arg == NULL) return NULL;
+    if (s->key_hash == key_hash && strcmp(s->arg->key, name) == 0) {
+      return s->arg;
+    }
+  }
+}
+
+int grpc_preprocessed_channel_args_get_integer(
+    const grpc_preprocessed_channel_args *args, const char *name,
+    const grpc_integer_options options) {
+  return grpc_channel_arg_get_integer(
+      grpc_preprocessed_channel_args_find(args, name), options);
+}
+
+bool grpc_preprocessed_channel_args_get_bool(
+    const grpc_preprocessed_channel_args *args, const char *name,
+    bool default_value) {
+  return grpc_channel_arg_get_bool(
+      grpc_preprocessed_channel_args_find(args, name), default_value);
+}
+
+int grpc_preprocessed_channel_args_compare(
+    const grpc_preprocessed_channel_args *a,
+    const grpc_preprocessed_channel_args *b) {
+  if (a == b) return 0;
+  int c = GPR_ICMP(a->hash, b->hash);
+  if (c != 0) return c;
+  return grpc_channel_args_compare(a->args, b->args);
+}
@@ -147,6 +147,44 @@ int grpc_channel_arg_get_integer(const grpc_arg *arg,
 
 bool grpc_channel_arg_get_bool(const grpc_arg *arg, bool default_value);
 
+/** An immutable, refcounted and normalized copy of a set of channel args,
+    preprocessed for repeated use: keys are hashed into a lookup table so that
+    finding an arg does not scan and strcmp the whole set, and the set as a
+    whole carries a hash so that comparing two sets is usually a single
+    integer comparison. */
+typedef struct grpc_preprocessed_channel_args grpc_preprocessed_channel_args;
+
+/** Normalize and preprocess a copy of \a args (which may be NULL) */
+grpc_preprocessed_channel_args *grpc_preprocessed_channel_args_create(
+    const grpc_channel_args *args);
+
+grpc_preprocessed_channel_args *grpc_preprocessed_channel_args_ref(
+    grpc_preprocessed_channel_args *args);
+void grpc_preprocessed_channel_args_unref(grpc_exec_ctx *exec_ctx,
+                                          grpc_preprocessed_channel_args *args);
+
+/** The normalized args; valid for as long as a ref to \a args is held */
+const grpc_channel_args *grpc_preprocessed_channel_args_get(
+    const grpc_preprocessed_channel_args *args);
+
+/** Same as grpc_channel_args_find on the normalized args */
+const grpc_arg *grpc_preprocessed_channel_args_find(
+    const grpc_preprocessed_channel_args *args, const char *name);
+
+int grpc_preprocessed_channel_args_get_integer(
+    const grpc_preprocessed_channel_args *args, const char *name,
+    const grpc_integer_options options);
+
+bool grpc_preprocessed_channel_args_get_bool(
+    const grpc_preprocessed_channel_args *args, const char *name,
+    bool default_value);
+
+/** Orders sets by hash first: the order is consistent, but unlike
+    grpc_channel_args_compare it is not lexicographic */
+int grpc_preprocessed_channel_args_compare(
+    const grpc_preprocessed_channel_args *a,
+    const grpc_preprocessed_channel_args *b);
+
 // Helpers for creating channel args.
 grpc_arg grpc_channel_arg_string_create(char *name, char *value);
 grpc_arg grpc_channel_arg_integer_create(char *name, int value);
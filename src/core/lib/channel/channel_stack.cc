@@ -230,9 +230,18 @@ void grpc_call_stack_destroy(grpc_exec_ctx *exec_ctx, grpc_call_stack *stack,
   }
 }
 
+/* The next_* helpers below hop directly over elements that would only call
+   the same helper again: most filters pass most kinds of operation through,
+   and a pointer comparison is much cheaper than an indirect call. The last
+   element of a stack never passes an operation on. */
+
 void grpc_call_next_op(grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
                        grpc_transport_stream_op_batch *op) {
   grpc_call_element *next_elem = elem + 1;
+  while (next_elem->filter->start_transport_stream_op_batch ==
+         grpc_call_next_op) {
+    next_elem++;
+  }
   GRPC_CALL_LOG_OP(GPR_INFO, next_elem, op);
   next_elem->filter->start_transport_stream_op_batch(exec_ctx, next_elem, op);
 }
@@ -241,12 +250,18 @@ void grpc_channel_next_get_info(grpc_exec_ctx *exec_ctx,
                                 grpc_channel_element *elem,
                                 const grpc_channel_info *channel_info) {
   grpc_channel_element *next_elem = elem + 1;
+  while (next_elem->filter->get_channel_info == grpc_channel_next_get_info) {
+    next_elem++;
+  }
   next_elem->filter->get_channel_info(exec_ctx, next_elem, channel_info);
 }
 
 void grpc_channel_next_op(grpc_exec_ctx *exec_ctx, grpc_channel_element *elem,
                           grpc_transport_op *op) {
   grpc_channel_element *next_elem = elem + 1;
+  while (next_elem->filter->start_transport_op == grpc_channel_next_op) {
+    next_elem++;
+  }
   next_elem->filter->start_transport_op(exec_ctx, next_elem, op);
 }
 
@@ -21,6 +21,7 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
 grpc_tracer_flag grpc_trace_channel_stack_builder =
@@ -200,6 +201,26 @@ bool grpc_channel_stack_builder_remove_filter(
   return true;
 }
 
+void grpc_channel_stack_builder_remove_inactive_filters(
+    grpc_channel_stack_builder *builder,
+    bool (*is_active)(const grpc_channel_filter *filter,
+                      const grpc_channel_args *args)) {
+  filter_node *p = builder->begin.next;
+  while (p != &builder->end) {
+    filter_node *next = p->next;
+    if (!is_active(p->filter, builder->args)) {
+      if (GRPC_TRACER_ON(grpc_trace_channel_stack_builder)) {
+        gpr_log(GPR_DEBUG, "%s: dropping inactive filter %s", builder->name,
+                p->filter->name);
+      }
+      p->prev->next = next;
+      next->prev = p->prev;
+      gpr_free(p);
+    }
+    p = next;
+  }
+}
+
 bool grpc_channel_stack_builder_prepend_filter(
     grpc_channel_stack_builder *builder, const grpc_channel_filter *filter,
     grpc_post_filter_create_init_func post_init_func, void *user_data) {
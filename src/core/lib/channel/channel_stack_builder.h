@@ -142,6 +142,13 @@ bool grpc_channel_stack_builder_append_filter(
 bool grpc_channel_stack_builder_remove_filter(
     grpc_channel_stack_builder *builder, const char *filter_name);
 
+/// Remove every filter for which \a is_active returns false given the
+/// builder's channel arguments
+void grpc_channel_stack_builder_remove_inactive_filters(
+    grpc_channel_stack_builder *builder,
+    bool (*is_active)(const grpc_channel_filter *filter,
+                      const grpc_channel_args *args));
+
 /// Terminate iteration and destroy \a iterator
 void grpc_channel_stack_builder_iterator_destroy(
     grpc_channel_stack_builder_iterator *iterator);
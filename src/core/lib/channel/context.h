@@ -38,6 +38,11 @@ typedef enum {
   /// Value is a \a grpc_grpclb_client_stats.
   GRPC_GRPCLB_CLIENT_STATS,
 
+  /// Value is the trace context a server call received, owned by the census
+  /// server filter and propagated to child calls along with
+  /// \a GRPC_CONTEXT_TRACING.
+  GRPC_CONTEXT_CENSUS_TRACE,
+
   GRPC_CONTEXT_COUNT
 } grpc_context_index;
 
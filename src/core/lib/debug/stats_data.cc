@@ -37,6 +37,10 @@ const char *grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "pollset_kick_wakeup_fd",
     "pollset_kick_wakeup_cv",
     "pollset_kick_own_thread",
+    "pollset_kick_coalesced",
+    "fd_affinity_hits",
+    "fd_affinity_handoffs",
+    "fd_affinity_misses",
     "histogram_slow_lookups",
     "syscall_write",
     "syscall_read",
@@ -100,10 +104,18 @@ const char *grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "hpack_send_huffman",
     "hpack_send_binary",
     "hpack_send_binary_base64",
+    "timers_armed",
+    "timers_cancelled",
+    "timers_slack_rounded",
+    "timer_manager_wakeups",
+    "deadlines_deferred",
+    "deadlines_promoted",
     "combiner_locks_initiated",
     "combiner_locks_scheduled_items",
     "combiner_locks_scheduled_final_items",
     "combiner_locks_offloaded",
+    "combiner_offloads_exec_ctx_finished",
+    "combiner_offloads_queue_busy",
     "call_combiner_locks_initiated",
     "call_combiner_locks_scheduled_items",
     "call_combiner_set_notify_on_cancel",
@@ -119,6 +131,8 @@ const char *grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "cq_ev_queue_trylock_failures",
     "cq_ev_queue_trylock_successes",
     "cq_ev_queue_transient_pop_failures",
+    "cq_kicks_coalesced",
+    "cq_kicks_skipped",
 };
 const char *grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
@@ -139,6 +153,18 @@ const char *grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "polling wakeup (only valid for epoll1 right now)",
     "How many times could a polling wakeup be satisfied by keeping the waking "
     "thread awake? (only valid for epoll1 right now)",
+    "How many times was an eventfd write skipped because a previous wakeup "
+    "had not been consumed by the poller yet (only valid for epoll1 right "
+    "now)",
+    "How many times was an fd's read readiness processed in the neighborhood "
+    "that processed it last (only valid for epoll1 with "
+    "GRPC_EPOLL1_FD_AFFINITY)",
+    "How many times was an fd's read readiness handed off to an idle worker of "
+    "the neighborhood that processed it last (only valid for epoll1 with "
+    "GRPC_EPOLL1_FD_AFFINITY)",
+    "How many times was an fd's read readiness processed away from the "
+    "neighborhood that processed it last, for lack of an idle worker there "
+    "(only valid for epoll1 with GRPC_EPOLL1_FD_AFFINITY)",
     "Number of times histogram increments went through the slow (binary "
     "search) path",
     "Number of write syscalls (or equivalent - eg sendmsg) made by this "
@@ -212,11 +238,23 @@ const char *grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of huffman encoded strings sent in metadata",
     "Number of binary strings received in metadata",
     "Number of binary strings received encoded in base64 in metadata",
+    "Number of timers armed (grpc_timer_init calls)",
+    "Number of armed timers cancelled before they fired",
+    "Number of timers armed with slack whose deadline was moved later to "
+    "share a wakeup with other timers",
+    "Number of times a timer manager thread woke up to check timers",
+    "Number of call deadlines put on a channel's coarse deadline list instead "
+    "of being given a timer",
+    "Number of deferred call deadlines given a timer as they came near",
     "Number of combiner lock entries by process (first items queued to a "
     "combiner)",
     "Number of items scheduled against combiner locks",
     "Number of final items scheduled against combiner locks",
     "Number of combiner locks offloaded to different threads",
+    "Number of combiner offloads because the executing exec_ctx was ready to "
+    "finish while other threads were queueing work",
+    "Number of combiner offloads because the combiner queue was in an "
+    "inconsistent (mid-push) state",
     "Number of call combiner lock entries by process (first items queued to a "
     "call combiner)",
     "Number of items scheduled against call combiner locks",
@@ -240,6 +278,10 @@ const char *grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "queue.",
     "Number of times NULL was popped out of completion queue's event queue "
     "even though the event queue was not empty",
+    "Number of completions whose pollset kick was folded into a kick already "
+    "scheduled on the same exec_ctx",
+    "Number of scheduled completion queue kicks dropped because the queued "
+    "completions had already been taken off the queue",
 };
 const char *grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "call_initial_size",
@@ -254,6 +296,11 @@ const char *grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_message_per_write",
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
+    "combiner_final_list_length",
+    "combiner_queue_delay_us",
+    "combiner_closure_run_us",
+    "executor_queue_delay_us",
+    "executor_closure_run_us",
     "server_cqs_checked",
 };
 const char *grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
@@ -269,6 +316,15 @@ const char *grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of streams whose payload was written per TCP write",
     "Number of streams terminated per TCP write",
     "Number of flow control updates written per TCP write",
+    "Number of closures run each time a combiner executes its final list",
+    "Microseconds a closure waited between being queued on a combiner and "
+    "starting to run (only collected with GRPC_CLOSURE_LATENCY_STATS)",
+    "Microseconds spent running each closure queued on a combiner (only "
+    "collected with GRPC_CLOSURE_LATENCY_STATS)",
+    "Microseconds a closure waited between being pushed to the executor and "
+    "starting to run (only collected with GRPC_CLOSURE_LATENCY_STATS)",
+    "Microseconds spent running each closure on an executor thread (only "
+    "collected with GRPC_CLOSURE_LATENCY_STATS)",
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
 };
@@ -337,8 +393,26 @@ const uint8_t grpc_stats_table_7[102] = {
     23, 24, 24, 24, 25, 26, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32,
     32, 33, 33, 34, 35, 35, 36, 37, 37, 38, 38, 39, 39, 40, 40, 41, 41,
     42, 42, 43, 44, 44, 45, 46, 46, 47, 48, 48, 49, 49, 50, 50, 51, 51};
-const int grpc_stats_table_8[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
-const uint8_t grpc_stats_table_9[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
+const int grpc_stats_table_8[65] = {
+    0,      1,      2,      3,      4,      5,      7,      9,      12,
+    15,     19,     24,     30,     37,     46,     57,     70,     86,
+    105,    129,    158,    193,    236,    288,    352,    430,    525,
+    641,    782,    954,    1164,   1420,   1733,   2114,   2579,   3146,
+    3838,   4682,   5711,   6967,   8499,   10367,  12646,  15426,  18816,
+    22951,  27995,  34148,  41653,  50807,  61972,  75591,  92203,  112465,
+    137180, 167326, 204096, 248947, 303653, 370381, 451772, 551049, 672141,
+    819843, 1000000};
+const uint8_t grpc_stats_table_9[139] = {
+    0,  0,  0,  1,  1,  1,  2,  2,  2,  3,  3,  3,  4,  4,  5,  5,  5,  6,
+    6,  6,  7,  7,  8,  8,  9,  9,  9,  10, 10, 11, 11, 12, 12, 12, 13, 13,
+    13, 14, 15, 15, 15, 16, 16, 17, 17, 17, 18, 18, 19, 19, 20, 20, 20, 21,
+    21, 22, 22, 23, 23, 24, 24, 24, 25, 25, 26, 26, 27, 27, 27, 28, 28, 29,
+    29, 30, 30, 31, 31, 31, 32, 32, 33, 33, 34, 34, 34, 35, 35, 36, 36, 37,
+    37, 37, 38, 38, 39, 39, 40, 40, 41, 41, 41, 42, 42, 43, 43, 44, 44, 44,
+    45, 45, 46, 46, 47, 47, 48, 48, 48, 49, 49, 50, 50, 51, 51, 51, 52, 52,
+    53, 53, 54, 54, 55, 55, 55, 56, 56, 57, 57, 58, 58};
+const int grpc_stats_table_10[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
+const uint8_t grpc_stats_table_11[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
 void grpc_stats_inc_call_initial_size(grpc_exec_ctx *exec_ctx, int value) {
   value = GPR_CLAMP(value, 0, 262144);
   if (value < 6) {
@@ -656,6 +730,141 @@ void grpc_stats_inc_http2_send_flowctl_per_write(grpc_exec_ctx *exec_ctx,
                            grpc_stats_histo_find_bucket_slow(
                                (exec_ctx), value, grpc_stats_table_6, 64));
 }
+void grpc_stats_inc_combiner_final_list_length(grpc_exec_ctx *exec_ctx,
+                                               int value) {
+  value = GPR_CLAMP(value, 0, 1024);
+  if (value < 13) {
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_COMBINER_FINAL_LIST_LENGTH, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4637863191261478912ull) {
+    int bucket =
+        grpc_stats_table_7[((_val.uint - 4623507967449235456ull) >> 48)] + 13;
+    _bkt.dbl = grpc_stats_table_6[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_COMBINER_FINAL_LIST_LENGTH, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx),
+                           GRPC_STATS_HISTOGRAM_COMBINER_FINAL_LIST_LENGTH,
+                           grpc_stats_histo_find_bucket_slow(
+                               (exec_ctx), value, grpc_stats_table_6, 64));
+}
+void grpc_stats_inc_combiner_queue_delay_us(grpc_exec_ctx *exec_ctx,
+                                            int value) {
+  value = GPR_CLAMP(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DELAY_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_9[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_8[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DELAY_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx),
+                           GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DELAY_US,
+                           grpc_stats_histo_find_bucket_slow(
+                               (exec_ctx), value, grpc_stats_table_8, 64));
+}
+void grpc_stats_inc_combiner_closure_run_us(grpc_exec_ctx *exec_ctx,
+                                            int value) {
+  value = GPR_CLAMP(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_COMBINER_CLOSURE_RUN_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_9[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_8[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_COMBINER_CLOSURE_RUN_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx),
+                           GRPC_STATS_HISTOGRAM_COMBINER_CLOSURE_RUN_US,
+                           grpc_stats_histo_find_bucket_slow(
+                               (exec_ctx), value, grpc_stats_table_8, 64));
+}
+void grpc_stats_inc_executor_queue_delay_us(grpc_exec_ctx *exec_ctx,
+                                            int value) {
+  value = GPR_CLAMP(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_9[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_8[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx),
+                           GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_US,
+                           grpc_stats_histo_find_bucket_slow(
+                               (exec_ctx), value, grpc_stats_table_8, 64));
+}
+void grpc_stats_inc_executor_closure_run_us(grpc_exec_ctx *exec_ctx,
+                                            int value) {
+  value = GPR_CLAMP(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_EXECUTOR_CLOSURE_RUN_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_9[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_8[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(
+        (exec_ctx), GRPC_STATS_HISTOGRAM_EXECUTOR_CLOSURE_RUN_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM((exec_ctx),
+                           GRPC_STATS_HISTOGRAM_EXECUTOR_CLOSURE_RUN_US,
+                           grpc_stats_histo_find_bucket_slow(
+                               (exec_ctx), value, grpc_stats_table_8, 64));
+}
 void grpc_stats_inc_server_cqs_checked(grpc_exec_ctx *exec_ctx, int value) {
   value = GPR_CLAMP(value, 0, 64);
   if (value < 3) {
@@ -670,8 +879,8 @@ void grpc_stats_inc_server_cqs_checked(grpc_exec_ctx *exec_ctx, int value) {
   _val.dbl = value;
   if (_val.uint < 4625196817309499392ull) {
     int bucket =
-        grpc_stats_table_9[((_val.uint - 4613937818241073152ull) >> 51)] + 3;
-    _bkt.dbl = grpc_stats_table_8[bucket];
+        grpc_stats_table_11[((_val.uint - 4613937818241073152ull) >> 51)] + 3;
+    _bkt.dbl = grpc_stats_table_10[bucket];
     bucket -= (_val.uint < _bkt.uint);
     GRPC_STATS_INC_HISTOGRAM((exec_ctx),
                              GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED, bucket);
@@ -679,19 +888,21 @@ void grpc_stats_inc_server_cqs_checked(grpc_exec_ctx *exec_ctx, int value) {
   }
   GRPC_STATS_INC_HISTOGRAM((exec_ctx), GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
                            grpc_stats_histo_find_bucket_slow(
-                               (exec_ctx), value, grpc_stats_table_8, 8));
+                               (exec_ctx), value, grpc_stats_table_10, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int *const grpc_stats_histo_bucket_boundaries[13] = {
+const int grpc_stats_histo_buckets[18] = {64, 128, 64, 64, 64, 64, 64, 64, 64,
+                                          64, 64,  64, 64, 64, 64, 64, 64, 8};
+const int grpc_stats_histo_start[18] = {0,   64,  192, 256,  320,  384,
+                                        448, 512, 576, 640,  704,  768,
+                                        832, 896, 960, 1024, 1088, 1152};
+const int *const grpc_stats_histo_bucket_boundaries[18] = {
     grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
     grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
     grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
     grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
-    grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(grpc_exec_ctx *exec_ctx, int x) = {
+    grpc_stats_table_6, grpc_stats_table_8, grpc_stats_table_8,
+    grpc_stats_table_8, grpc_stats_table_8, grpc_stats_table_10};
+void (*const grpc_stats_inc_histogram[18])(grpc_exec_ctx *exec_ctx, int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
     grpc_stats_inc_tcp_write_size,
@@ -704,4 +915,9 @@ void (*const grpc_stats_inc_histogram[13])(grpc_exec_ctx *exec_ctx, int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
+    grpc_stats_inc_combiner_final_list_length,
+    grpc_stats_inc_combiner_queue_delay_us,
+    grpc_stats_inc_combiner_closure_run_us,
+    grpc_stats_inc_executor_queue_delay_us,
+    grpc_stats_inc_executor_closure_run_us,
     grpc_stats_inc_server_cqs_checked};
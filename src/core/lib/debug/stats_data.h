@@ -43,6 +43,10 @@ typedef enum {
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD,
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV,
   GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD,
+  GRPC_STATS_COUNTER_POLLSET_KICK_COALESCED,
+  GRPC_STATS_COUNTER_FD_AFFINITY_HITS,
+  GRPC_STATS_COUNTER_FD_AFFINITY_HANDOFFS,
+  GRPC_STATS_COUNTER_FD_AFFINITY_MISSES,
   GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS,
   GRPC_STATS_COUNTER_SYSCALL_WRITE,
   GRPC_STATS_COUNTER_SYSCALL_READ,
@@ -106,10 +110,18 @@ typedef enum {
   GRPC_STATS_COUNTER_HPACK_SEND_HUFFMAN,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64,
+  GRPC_STATS_COUNTER_TIMERS_ARMED,
+  GRPC_STATS_COUNTER_TIMERS_CANCELLED,
+  GRPC_STATS_COUNTER_TIMERS_SLACK_ROUNDED,
+  GRPC_STATS_COUNTER_TIMER_MANAGER_WAKEUPS,
+  GRPC_STATS_COUNTER_DEADLINES_DEFERRED,
+  GRPC_STATS_COUNTER_DEADLINES_PROMOTED,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED,
+  GRPC_STATS_COUNTER_COMBINER_OFFLOADS_EXEC_CTX_FINISHED,
+  GRPC_STATS_COUNTER_COMBINER_OFFLOADS_QUEUE_BUSY,
   GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_INITIATED,
   GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_CALL_COMBINER_SET_NOTIFY_ON_CANCEL,
@@ -125,6 +137,8 @@ typedef enum {
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
+  GRPC_STATS_COUNTER_CQ_KICKS_COALESCED,
+  GRPC_STATS_COUNTER_CQ_KICKS_SKIPPED,
   GRPC_STATS_COUNTER_COUNT
 } grpc_stats_counters;
 extern const char *grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT];
@@ -142,6 +156,11 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_COMBINER_FINAL_LIST_LENGTH,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DELAY_US,
+  GRPC_STATS_HISTOGRAM_COMBINER_CLOSURE_RUN_US,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_US,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_CLOSURE_RUN_US,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
@@ -172,9 +191,19 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 768,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_COMBINER_FINAL_LIST_LENGTH_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_COMBINER_FINAL_LIST_LENGTH_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DELAY_US_FIRST_SLOT = 896,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DELAY_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_CLOSURE_RUN_US_FIRST_SLOT = 960,
+  GRPC_STATS_HISTOGRAM_COMBINER_CLOSURE_RUN_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_US_FIRST_SLOT = 1024,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_CLOSURE_RUN_US_FIRST_SLOT = 1088,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_CLOSURE_RUN_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 1152,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_BUCKETS = 1160
 } grpc_stats_histogram_constants;
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED(exec_ctx) \
   GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED)
@@ -206,6 +235,14 @@ typedef enum {
   GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV)
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD(exec_ctx) \
   GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD)
+#define GRPC_STATS_INC_POLLSET_KICK_COALESCED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_POLLSET_KICK_COALESCED)
+#define GRPC_STATS_INC_FD_AFFINITY_HITS(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_FD_AFFINITY_HITS)
+#define GRPC_STATS_INC_FD_AFFINITY_HANDOFFS(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_FD_AFFINITY_HANDOFFS)
+#define GRPC_STATS_INC_FD_AFFINITY_MISSES(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_FD_AFFINITY_MISSES)
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS(exec_ctx) \
   GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS)
 #define GRPC_STATS_INC_SYSCALL_WRITE(exec_ctx) \
@@ -399,6 +436,18 @@ typedef enum {
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64(exec_ctx) \
   GRPC_STATS_INC_COUNTER((exec_ctx),                      \
                          GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64)
+#define GRPC_STATS_INC_TIMERS_ARMED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_TIMERS_ARMED)
+#define GRPC_STATS_INC_TIMERS_CANCELLED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_TIMERS_CANCELLED)
+#define GRPC_STATS_INC_TIMERS_SLACK_ROUNDED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_TIMERS_SLACK_ROUNDED)
+#define GRPC_STATS_INC_TIMER_MANAGER_WAKEUPS(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_TIMER_MANAGER_WAKEUPS)
+#define GRPC_STATS_INC_DEADLINES_DEFERRED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_DEADLINES_DEFERRED)
+#define GRPC_STATS_INC_DEADLINES_PROMOTED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_DEADLINES_PROMOTED)
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED(exec_ctx) \
   GRPC_STATS_INC_COUNTER((exec_ctx),                      \
                          GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED)
@@ -411,6 +460,12 @@ typedef enum {
 #define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED(exec_ctx) \
   GRPC_STATS_INC_COUNTER((exec_ctx),                      \
                          GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED)
+#define GRPC_STATS_INC_COMBINER_OFFLOADS_EXEC_CTX_FINISHED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER(                                            \
+      (exec_ctx), GRPC_STATS_COUNTER_COMBINER_OFFLOADS_EXEC_CTX_FINISHED)
+#define GRPC_STATS_INC_COMBINER_OFFLOADS_QUEUE_BUSY(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx),                          \
+                         GRPC_STATS_COUNTER_COMBINER_OFFLOADS_QUEUE_BUSY)
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_INITIATED(exec_ctx) \
   GRPC_STATS_INC_COUNTER((exec_ctx),                           \
                          GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_INITIATED)
@@ -452,6 +507,10 @@ typedef enum {
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES(exec_ctx) \
   GRPC_STATS_INC_COUNTER(                                           \
       (exec_ctx), GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES)
+#define GRPC_STATS_INC_CQ_KICKS_COALESCED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_CQ_KICKS_COALESCED)
+#define GRPC_STATS_INC_CQ_KICKS_SKIPPED(exec_ctx) \
+  GRPC_STATS_INC_COUNTER((exec_ctx), GRPC_STATS_COUNTER_CQ_KICKS_SKIPPED)
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(exec_ctx, value) \
   grpc_stats_inc_call_initial_size((exec_ctx), (int)(value))
 void grpc_stats_inc_call_initial_size(grpc_exec_ctx *exec_ctx, int x);
@@ -493,13 +552,28 @@ void grpc_stats_inc_http2_send_trailing_metadata_per_write(
   grpc_stats_inc_http2_send_flowctl_per_write((exec_ctx), (int)(value))
 void grpc_stats_inc_http2_send_flowctl_per_write(grpc_exec_ctx *exec_ctx,
                                                  int x);
+#define GRPC_STATS_INC_COMBINER_FINAL_LIST_LENGTH(exec_ctx, value) \
+  grpc_stats_inc_combiner_final_list_length((exec_ctx), (int)(value))
+void grpc_stats_inc_combiner_final_list_length(grpc_exec_ctx *exec_ctx, int x);
+#define GRPC_STATS_INC_COMBINER_QUEUE_DELAY_US(exec_ctx, value) \
+  grpc_stats_inc_combiner_queue_delay_us((exec_ctx), (int)(value))
+void grpc_stats_inc_combiner_queue_delay_us(grpc_exec_ctx *exec_ctx, int x);
+#define GRPC_STATS_INC_COMBINER_CLOSURE_RUN_US(exec_ctx, value) \
+  grpc_stats_inc_combiner_closure_run_us((exec_ctx), (int)(value))
+void grpc_stats_inc_combiner_closure_run_us(grpc_exec_ctx *exec_ctx, int x);
+#define GRPC_STATS_INC_EXECUTOR_QUEUE_DELAY_US(exec_ctx, value) \
+  grpc_stats_inc_executor_queue_delay_us((exec_ctx), (int)(value))
+void grpc_stats_inc_executor_queue_delay_us(grpc_exec_ctx *exec_ctx, int x);
+#define GRPC_STATS_INC_EXECUTOR_CLOSURE_RUN_US(exec_ctx, value) \
+  grpc_stats_inc_executor_closure_run_us((exec_ctx), (int)(value))
+void grpc_stats_inc_executor_closure_run_us(grpc_exec_ctx *exec_ctx, int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(exec_ctx, value) \
   grpc_stats_inc_server_cqs_checked((exec_ctx), (int)(value))
 void grpc_stats_inc_server_cqs_checked(grpc_exec_ctx *exec_ctx, int x);
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int *const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(grpc_exec_ctx *exec_ctx,
+extern const int grpc_stats_histo_buckets[18];
+extern const int grpc_stats_histo_start[18];
+extern const int *const grpc_stats_histo_bucket_boundaries[18];
+extern void (*const grpc_stats_inc_histogram[18])(grpc_exec_ctx *exec_ctx,
                                                   int x);
 
 #ifdef __cplusplus
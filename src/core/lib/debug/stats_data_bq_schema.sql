@@ -12,6 +12,10 @@ pollset_kicked_again_per_iteration:FLOAT,
 pollset_kick_wakeup_fd_per_iteration:FLOAT,
 pollset_kick_wakeup_cv_per_iteration:FLOAT,
 pollset_kick_own_thread_per_iteration:FLOAT,
+pollset_kick_coalesced_per_iteration:FLOAT,
+fd_affinity_hits_per_iteration:FLOAT,
+fd_affinity_handoffs_per_iteration:FLOAT,
+fd_affinity_misses_per_iteration:FLOAT,
 histogram_slow_lookups_per_iteration:FLOAT,
 syscall_write_per_iteration:FLOAT,
 syscall_read_per_iteration:FLOAT,
@@ -75,10 +79,18 @@ hpack_send_uncompressed_per_iteration:FLOAT,
 hpack_send_huffman_per_iteration:FLOAT,
 hpack_send_binary_per_iteration:FLOAT,
 hpack_send_binary_base64_per_iteration:FLOAT,
+timers_armed_per_iteration:FLOAT,
+timers_cancelled_per_iteration:FLOAT,
+timers_slack_rounded_per_iteration:FLOAT,
+timer_manager_wakeups_per_iteration:FLOAT,
+deadlines_deferred_per_iteration:FLOAT,
+deadlines_promoted_per_iteration:FLOAT,
 combiner_locks_initiated_per_iteration:FLOAT,
 combiner_locks_scheduled_items_per_iteration:FLOAT,
 combiner_locks_scheduled_final_items_per_iteration:FLOAT,
 combiner_locks_offloaded_per_iteration:FLOAT,
+combiner_offloads_exec_ctx_finished_per_iteration:FLOAT,
+combiner_offloads_queue_busy_per_iteration:FLOAT,
 call_combiner_locks_initiated_per_iteration:FLOAT,
 call_combiner_locks_scheduled_items_per_iteration:FLOAT,
 call_combiner_set_notify_on_cancel_per_iteration:FLOAT,
@@ -93,4 +105,6 @@ server_requested_calls_per_iteration:FLOAT,
 server_slowpath_requests_queued_per_iteration:FLOAT,
 cq_ev_queue_trylock_failures_per_iteration:FLOAT,
 cq_ev_queue_trylock_successes_per_iteration:FLOAT,
-cq_ev_queue_transient_pop_failures_per_iteration:FLOAT
+cq_ev_queue_transient_pop_failures_per_iteration:FLOAT,
+cq_kicks_coalesced_per_iteration:FLOAT,
+cq_kicks_skipped_per_iteration:FLOAT
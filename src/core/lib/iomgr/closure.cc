@@ -21,7 +21,9 @@
 #include <assert.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/useful.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/profiling/timers.h"
 
 #ifndef NDEBUG
@@ -217,3 +219,35 @@ void grpc_closure_list_sched(grpc_exec_ctx *exec_ctx, grpc_closure_list *list) {
   }
   list->head = list->tail = NULL;
 }
+
+#ifdef GRPC_CLOSURE_LATENCY_STATS
+int64_t grpc_closure_latency_now_us(void) {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return (int64_t)now.tv_sec * GPR_US_PER_SEC + now.tv_nsec / GPR_NS_PER_US;
+}
+
+void grpc_closure_latency_invoke(grpc_exec_ctx *exec_ctx, grpc_closure *c,
+                                 grpc_error *error, int delay_histogram,
+                                 int run_histogram) {
+  int64_t start_us = grpc_closure_latency_now_us();
+  int delay_us = (int)GPR_CLAMP(start_us - c->queued_at_us, 0, INT32_MAX);
+#ifndef NDEBUG
+  // c may be freed by its own callback: grab the creation site first
+  const char *file_created = c->file_created;
+  int line_created = c->line_created;
+#endif
+  c->cb(exec_ctx, c->cb_arg, error);
+  int run_us = (int)GPR_CLAMP(grpc_closure_latency_now_us() - start_us, 0,
+                              INT32_MAX);
+  grpc_stats_inc_histogram[delay_histogram](exec_ctx, delay_us);
+  grpc_stats_inc_histogram[run_histogram](exec_ctx, run_us);
+#ifndef NDEBUG
+  if (GRPC_TRACER_ON(grpc_trace_closure)) {
+    gpr_log(GPR_DEBUG, "CLOSURE:%p [created by %s:%d] %s=%d %s=%d", c,
+            file_created, line_created,
+            grpc_stats_histogram_name[delay_histogram], delay_us,
+            grpc_stats_histogram_name[run_histogram], run_us);
+  }
+#endif
+}
+#endif
@@ -105,6 +105,13 @@ struct grpc_closure {
   const char *file_initiated;
   int line_initiated;
 #endif
+
+// time (GPR_CLOCK_MONOTONIC, in microseconds) at which this closure was last
+// queued on a combiner or the executor; only tracked when queueing latency
+// stats are compiled in
+#ifdef GRPC_CLOSURE_LATENCY_STATS
+  int64_t queued_at_us;
+#endif
 };
 
 /** Initializes \a closure with \a cb and \a cb_arg. Returns \a closure. */
@@ -201,6 +208,33 @@ void grpc_closure_list_sched(grpc_exec_ctx *exec_ctx,
   grpc_closure_list_sched(exec_ctx, closure_list)
 #endif
 
+/** Queueing latency instrumentation for closure schedulers that hold work
+ *  before running it (combiners, the executor).
+ *  With GRPC_CLOSURE_LATENCY_STATS defined, GRPC_CLOSURE_LATENCY_MARK_QUEUED
+ *  stamps a closure as it is queued, and GRPC_CLOSURE_LATENCY_INVOKE runs its
+ *  callback, recording the time spent queued into \a delay_histogram and the
+ *  time spent in the callback into \a run_histogram (grpc_stats_histograms
+ *  values). In debug builds the per-closure timings are also logged, keyed by
+ *  the closure's creation site, when the 'closure' tracer is enabled.
+ *  Without GRPC_CLOSURE_LATENCY_STATS the callback is invoked directly. */
+#ifdef GRPC_CLOSURE_LATENCY_STATS
+int64_t grpc_closure_latency_now_us(void);
+void grpc_closure_latency_invoke(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
+                                 grpc_error *error, int delay_histogram,
+                                 int run_histogram);
+#define GRPC_CLOSURE_LATENCY_MARK_QUEUED(closure) \
+  ((closure)->queued_at_us = grpc_closure_latency_now_us())
+#define GRPC_CLOSURE_LATENCY_INVOKE(exec_ctx, closure, error, delay_histogram, \
+                                    run_histogram)                             \
+  grpc_closure_latency_invoke(exec_ctx, closure, error, delay_histogram,       \
+                              run_histogram)
+#else
+#define GRPC_CLOSURE_LATENCY_MARK_QUEUED(closure)
+#define GRPC_CLOSURE_LATENCY_INVOKE(exec_ctx, closure, error, delay_histogram, \
+                                    run_histogram)                             \
+  (closure)->cb(exec_ctx, (closure)->cb_arg, error)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -183,6 +183,7 @@ static void combiner_exec(grpc_exec_ctx *exec_ctx, grpc_closure *cl,
   GPR_ASSERT(last & STATE_UNORPHANED);  // ensure lock has not been destroyed
   assert(cl->cb);
   cl->error_data.error = error;
+  GRPC_CLOSURE_LATENCY_MARK_QUEUED(cl);
   gpr_mpscq_push(&lock->queue, &cl->next_data.atm_next);
   GPR_TIMER_END("combiner.execute", 0);
 }
@@ -232,6 +233,7 @@ bool grpc_combiner_continue_exec_ctx(grpc_exec_ctx *exec_ctx) {
     GPR_TIMER_MARK("offload_from_finished_exec_ctx", 0);
     // this execution context wants to move on: schedule remaining work to be
     // picked up on the executor
+    GRPC_STATS_INC_COMBINER_OFFLOADS_EXEC_CTX_FINISHED(exec_ctx);
     queue_offload(exec_ctx, lock);
     GPR_TIMER_END("combiner.continue_exec_ctx", 0);
     return true;
@@ -248,6 +250,7 @@ bool grpc_combiner_continue_exec_ctx(grpc_exec_ctx *exec_ctx) {
       // queue is in an inconsistent state: use this as a cue that we should
       // go off and do something else for a while (and come back later)
       GPR_TIMER_MARK("delay_busy", 0);
+      GRPC_STATS_INC_COMBINER_OFFLOADS_QUEUE_BUSY(exec_ctx);
       queue_offload(exec_ctx, lock);
       GPR_TIMER_END("combiner.continue_exec_ctx", 0);
       return true;
@@ -258,7 +261,9 @@ bool grpc_combiner_continue_exec_ctx(grpc_exec_ctx *exec_ctx) {
 #ifndef NDEBUG
     cl->scheduled = false;
 #endif
-    cl->cb(exec_ctx, cl->cb_arg, cl_err);
+    GRPC_CLOSURE_LATENCY_INVOKE(exec_ctx, cl, cl_err,
+                                GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DELAY_US,
+                                GRPC_STATS_HISTOGRAM_COMBINER_CLOSURE_RUN_US);
     GRPC_ERROR_UNREF(cl_err);
     GPR_TIMER_END("combiner.exec1", 0);
   } else {
@@ -275,11 +280,15 @@ bool grpc_combiner_continue_exec_ctx(grpc_exec_ctx *exec_ctx) {
 #ifndef NDEBUG
       c->scheduled = false;
 #endif
-      c->cb(exec_ctx, c->cb_arg, error);
+      GRPC_CLOSURE_LATENCY_INVOKE(exec_ctx, c, error,
+                                  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DELAY_US,
+                                  GRPC_STATS_HISTOGRAM_COMBINER_CLOSURE_RUN_US);
       GRPC_ERROR_UNREF(error);
       c = next;
+      loops++;
       GPR_TIMER_END("combiner.exec_1final", 0);
     }
+    GRPC_STATS_INC_COMBINER_FINAL_LIST_LENGTH(exec_ctx, loops);
   }
 
   GPR_TIMER_MARK("unref", 0);
@@ -352,6 +361,7 @@ static void combiner_finally_exec(grpc_exec_ctx *exec_ctx,
   if (grpc_closure_list_empty(lock->final_list)) {
     gpr_atm_full_fetch_add(&lock->state, STATE_ELEM_COUNT_LOW_BIT);
   }
+  GRPC_CLOSURE_LATENCY_MARK_QUEUED(closure);
   grpc_closure_list_append(&lock->final_list, closure, error);
   GPR_TIMER_END("combiner.execute_finally", 0);
 }
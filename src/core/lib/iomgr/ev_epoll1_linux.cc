@@ -46,10 +46,18 @@
 #include "src/core/lib/iomgr/lockfree_event.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/support/env.h"
+#include "src/core/lib/support/obj_cache.h"
+#include "src/core/lib/support/spinlock.h"
 #include "src/core/lib/support/string.h"
 
 static grpc_wakeup_fd global_wakeup_fd;
 
+/* Set while global_wakeup_fd has been written to and the active poller has not
+   consumed the wakeup yet: any further kick of the active poller until then
+   would be a redundant write */
+static gpr_atm g_wakeup_pending;
+
 /*******************************************************************************
  * Singleton epoll set related fields
  */
@@ -114,12 +122,20 @@ struct grpc_fd {
   gpr_atm read_closure;
   gpr_atm write_closure;
 
-  struct grpc_fd *freelist_next;
 
   /* The pollset that last noticed that the fd is readable. The actual type
    * stored in this is (grpc_pollset *) */
   gpr_atm read_notifier_pollset;
 
+  /* Fd affinity mode: index of the neighborhood that last processed the fd's
+   * read readiness, or -1 */
+  gpr_atm home_neighborhood;
+  /* Set while the fd is on a neighborhood's handoff list. Neither is reset
+   * when a freelisted fd is reused: a stale handoff is a spurious read
+   * notification, like a stale epoll event */
+  gpr_atm handoff_queued;
+  struct grpc_fd *handoff_next;
+
   grpc_iomgr_object iomgr_object;
 };
 
@@ -152,6 +168,8 @@ struct grpc_pollset_worker {
   grpc_pollset_worker *prev;
   gpr_cv cv;
   grpc_closure_list schedule_on_end_work;
+  /* Neighborhood whose handoff list this worker was woken up to process */
+  struct pollset_neighborhood *handoff_neighborhood;
 };
 
 #define SET_KICK_STATE(worker, kick_state)   \
@@ -165,6 +183,10 @@ struct grpc_pollset_worker {
 typedef struct pollset_neighborhood {
   gpr_mu mu;
   grpc_pollset *active_root;
+  /* Fds whose read readiness was handed off to this neighborhood (fd
+     affinity mode). Taken after any pollset lock */
+  gpr_spinlock handoff_lock;
+  grpc_fd *handoff_head;
   char pad[GPR_CACHELINE_SIZE];
 } pollset_neighborhood;
 
@@ -226,6 +248,10 @@ static bool append_error(grpc_error **composite, grpc_error *error,
  *
  * If we keep the object freelisted, in the worst case losing this race just
  * becomes a spurious read notification on a reused fd.
+ *
+ * The freelist is a per-cpu object cache, so that connection storms don't
+ * serialize every fd creation and orphan on one lock. It is unbounded:
+ * cached fds are only freed at shutdown.
  */
 
 /* The alarm system needs to be able to wakeup 'some poller' sometimes
@@ -233,42 +259,31 @@ static bool append_error(grpc_error **composite, grpc_error *error,
  * alarm 'epoch'). This wakeup_fd gives us something to alert on when such a
  * case occurs. */
 
-static grpc_fd *fd_freelist = NULL;
-static gpr_mu fd_freelist_mu;
+static gpr_obj_cache *fd_freelist;
 
-static void fd_global_init(void) { gpr_mu_init(&fd_freelist_mu); }
+static void fd_global_init(void) {
+  fd_freelist = gpr_obj_cache_create(GPR_OBJ_CACHE_UNBOUNDED);
+}
 
 static void fd_global_shutdown(void) {
-  gpr_mu_lock(&fd_freelist_mu);
-  gpr_mu_unlock(&fd_freelist_mu);
-  while (fd_freelist != NULL) {
-    grpc_fd *fd = fd_freelist;
-    fd_freelist = fd_freelist->freelist_next;
-    gpr_free(fd);
-  }
-  gpr_mu_destroy(&fd_freelist_mu);
+  gpr_obj_cache_destroy(fd_freelist, gpr_free);
+  fd_freelist = NULL;
 }
 
 static grpc_fd *fd_create(int fd, const char *name) {
-  grpc_fd *new_fd = NULL;
-
-  gpr_mu_lock(&fd_freelist_mu);
-  if (fd_freelist != NULL) {
-    new_fd = fd_freelist;
-    fd_freelist = fd_freelist->freelist_next;
-  }
-  gpr_mu_unlock(&fd_freelist_mu);
+  grpc_fd *new_fd = (grpc_fd *)gpr_obj_cache_get(fd_freelist);
 
   if (new_fd == NULL) {
     new_fd = (grpc_fd *)gpr_malloc(sizeof(grpc_fd));
+    gpr_atm_no_barrier_store(&new_fd->handoff_queued, 0);
+    new_fd->handoff_next = NULL;
   }
 
   new_fd->fd = fd;
   grpc_lfev_init(&new_fd->read_closure);
   grpc_lfev_init(&new_fd->write_closure);
   gpr_atm_no_barrier_store(&new_fd->read_notifier_pollset, (gpr_atm)NULL);
-
-  new_fd->freelist_next = NULL;
+  gpr_atm_no_barrier_store(&new_fd->home_neighborhood, -1);
 
   char *fd_name;
   gpr_asprintf(&fd_name, "%s fd=%d", name, fd);
@@ -327,6 +342,13 @@ static void fd_orphan(grpc_exec_ctx *exec_ctx, grpc_fd *fd,
   /* If release_fd is not NULL, we should be relinquishing control of the file
      descriptor fd->fd (but we still own the grpc_fd structure). */
   if (is_release_fd) {
+    /* Stop delivering its events to this (soon to be reused) grpc_fd: the
+       descriptor may be wrapped in a new grpc_fd */
+    struct epoll_event ev_fd;
+    memset(&ev_fd, 0, sizeof(ev_fd));
+    if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd->fd, &ev_fd) != 0) {
+      gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+    }
     *release_fd = fd->fd;
   } else if (!already_closed) {
     close(fd->fd);
@@ -338,10 +360,7 @@ static void fd_orphan(grpc_exec_ctx *exec_ctx, grpc_fd *fd,
   grpc_lfev_destroy(&fd->read_closure);
   grpc_lfev_destroy(&fd->write_closure);
 
-  gpr_mu_lock(&fd_freelist_mu);
-  fd->freelist_next = fd_freelist;
-  fd_freelist = fd;
-  gpr_mu_unlock(&fd_freelist_mu);
+  GPR_ASSERT(gpr_obj_cache_put(fd_freelist, fd));
 }
 
 static grpc_pollset *fd_get_read_notifier_pollset(grpc_exec_ctx *exec_ctx,
@@ -388,6 +407,16 @@ static gpr_atm g_active_poller;
 static pollset_neighborhood *g_neighborhoods;
 static size_t g_num_neighborhoods;
 
+/* Fd affinity mode (GRPC_EPOLL1_FD_AFFINITY): the read readiness of an fd is
+   processed in the neighborhood that processed it last whenever a worker is
+   idle there, rather than by whichever thread is the designated poller, so
+   that its reads and the transport state they touch stay on one core */
+static bool g_fd_affinity;
+
+/* See grpc_epoll1_set_neighborhoods_for_testing() */
+static size_t g_num_neighborhoods_for_testing;
+static size_t (*g_choose_neighborhood_for_testing)(void);
+
 /* Return true if first in list */
 static bool worker_insert(grpc_pollset *pollset, grpc_pollset_worker *worker) {
   if (pollset->root_worker == NULL) {
@@ -426,13 +455,96 @@ static worker_remove_result worker_remove(grpc_pollset *pollset,
 }
 
 static size_t choose_neighborhood(void) {
+  if (g_choose_neighborhood_for_testing != NULL) {
+    return g_choose_neighborhood_for_testing() % g_num_neighborhoods;
+  }
   return (size_t)gpr_cpu_current_cpu() % g_num_neighborhoods;
 }
 
+/* Fd affinity mode: hands the read readiness of fd over to an idle worker of
+   the neighborhood that processed it last, and wakes that worker up to process
+   it. Returns false if the calling thread should process it instead. Called by
+   the designated poller, with no pollset lock held */
+static bool fd_hand_off_read(grpc_exec_ctx *exec_ctx, grpc_fd *fd) {
+  gpr_atm home = gpr_atm_no_barrier_load(&fd->home_neighborhood);
+  size_t here = choose_neighborhood();
+  if (home < 0 || (size_t)home >= g_num_neighborhoods) {
+    /* first read: it gets processed, and its home set, here */
+    gpr_atm_no_barrier_store(&fd->home_neighborhood, (gpr_atm)here);
+    return false;
+  }
+  if ((size_t)home == here) {
+    GRPC_STATS_INC_FD_AFFINITY_HITS(exec_ctx);
+    return false;
+  }
+  if (gpr_atm_acq_load(&fd->handoff_queued)) {
+    /* the readiness it is already queued for covers this one */
+    GRPC_STATS_INC_FD_AFFINITY_HANDOFFS(exec_ctx);
+    return true;
+  }
+  pollset_neighborhood *neighborhood = &g_neighborhoods[home];
+  bool handed_off = false;
+  /* never wait on a busy neighborhood: processing here is cheaper */
+  if (gpr_mu_trylock(&neighborhood->mu)) {
+    grpc_pollset *inspect = neighborhood->active_root;
+    if (inspect != NULL) {
+      do {
+        gpr_mu_lock(&inspect->mu);
+        grpc_pollset_worker *worker = inspect->root_worker;
+        if (worker != NULL) {
+          do {
+            if (worker->state == UNKICKED && worker->initialized_cv &&
+                gpr_atm_no_barrier_cas(&fd->handoff_queued, 0, 1)) {
+              gpr_spinlock_lock(&neighborhood->handoff_lock);
+              fd->handoff_next = neighborhood->handoff_head;
+              neighborhood->handoff_head = fd;
+              gpr_spinlock_unlock(&neighborhood->handoff_lock);
+              worker->handoff_neighborhood = neighborhood;
+              SET_KICK_STATE(worker, KICKED);
+              gpr_cv_signal(&worker->cv);
+              handed_off = true;
+            }
+            worker = worker->next;
+          } while (!handed_off && worker != inspect->root_worker);
+        }
+        gpr_mu_unlock(&inspect->mu);
+        inspect = inspect->next;
+      } while (!handed_off && inspect != neighborhood->active_root);
+    }
+    gpr_mu_unlock(&neighborhood->mu);
+  }
+  if (handed_off) {
+    GRPC_STATS_INC_FD_AFFINITY_HANDOFFS(exec_ctx);
+  } else {
+    /* no idle worker at home: it moves here */
+    GRPC_STATS_INC_FD_AFFINITY_MISSES(exec_ctx);
+    gpr_atm_no_barrier_store(&fd->home_neighborhood, (gpr_atm)here);
+  }
+  return handed_off;
+}
+
+/* Processes the read readiness handed off to neighborhood, on the calling
+   worker's exec_ctx */
+static void neighborhood_process_handoffs(grpc_exec_ctx *exec_ctx,
+                                          pollset_neighborhood *neighborhood,
+                                          grpc_pollset *notifier) {
+  gpr_spinlock_lock(&neighborhood->handoff_lock);
+  grpc_fd *fd = neighborhood->handoff_head;
+  neighborhood->handoff_head = NULL;
+  gpr_spinlock_unlock(&neighborhood->handoff_lock);
+  while (fd != NULL) {
+    grpc_fd *next = fd->handoff_next;
+    gpr_atm_rel_store(&fd->handoff_queued, 0);
+    fd_become_readable(exec_ctx, fd, notifier);
+    fd = next;
+  }
+}
+
 static grpc_error *pollset_global_init(void) {
   gpr_tls_init(&g_current_thread_pollset);
   gpr_tls_init(&g_current_thread_worker);
   gpr_atm_no_barrier_store(&g_active_poller, 0);
+  gpr_atm_no_barrier_store(&g_wakeup_pending, 0);
   global_wakeup_fd.read_fd = -1;
   grpc_error *err = grpc_wakeup_fd_init(&global_wakeup_fd);
   if (err != GRPC_ERROR_NONE) return err;
@@ -443,11 +555,16 @@ static grpc_error *pollset_global_init(void) {
                 &ev) != 0) {
     return GRPC_OS_ERROR(errno, "epoll_ctl");
   }
-  g_num_neighborhoods = GPR_CLAMP(gpr_cpu_num_cores(), 1, MAX_NEIGHBORHOODS);
+  g_num_neighborhoods =
+      GPR_CLAMP(g_num_neighborhoods_for_testing != 0
+                    ? g_num_neighborhoods_for_testing
+                    : gpr_cpu_num_cores(),
+                1, MAX_NEIGHBORHOODS);
   g_neighborhoods = (pollset_neighborhood *)gpr_zalloc(
       sizeof(*g_neighborhoods) * g_num_neighborhoods);
   for (size_t i = 0; i < g_num_neighborhoods; i++) {
     gpr_mu_init(&g_neighborhoods[i].mu);
+    g_neighborhoods[i].handoff_lock = GPR_SPINLOCK_INITIALIZER;
   }
   return GRPC_ERROR_NONE;
 }
@@ -462,6 +579,24 @@ static void pollset_global_shutdown(void) {
   gpr_free(g_neighborhoods);
 }
 
+/* Wakes up the active poller through global_wakeup_fd, unless a wakeup it has
+   not consumed yet is already pending: the poller is then either about to
+   return from epoll_wait or still processing the events it returned, and will
+   not block before seeing it */
+static grpc_error *kick_active_poller(grpc_exec_ctx *exec_ctx) {
+  if (gpr_atm_no_barrier_load(&g_wakeup_pending) ||
+      !gpr_atm_full_cas(&g_wakeup_pending, 0, 1)) {
+    GRPC_STATS_INC_POLLSET_KICK_COALESCED(exec_ctx);
+    return GRPC_ERROR_NONE;
+  }
+  GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD(exec_ctx);
+  grpc_error *error = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+  if (error != GRPC_ERROR_NONE) {
+    gpr_atm_no_barrier_store(&g_wakeup_pending, 0);
+  }
+  return error;
+}
+
 static void pollset_init(grpc_pollset *pollset, gpr_mu **mu) {
   gpr_mu_init(&pollset->mu);
   *mu = &pollset->mu;
@@ -524,9 +659,8 @@ static grpc_error *pollset_kick_all(grpc_exec_ctx *exec_ctx,
           }
           break;
         case DESIGNATED_POLLER:
-          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD(exec_ctx);
           SET_KICK_STATE(worker, KICKED);
-          append_error(&error, grpc_wakeup_fd_wakeup(&global_wakeup_fd),
+          append_error(&error, kick_active_poller(exec_ctx),
                        "pollset_kick_all");
           break;
       }
@@ -601,13 +735,17 @@ static grpc_error *process_epoll_events(grpc_exec_ctx *exec_ctx,
     if (data_ptr == &global_wakeup_fd) {
       append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
                    err_desc);
+      /* Only the active poller gets here, and it does not block before
+         returning: kicks from now on need a new write */
+      gpr_atm_rel_store(&g_wakeup_pending, 0);
     } else {
       grpc_fd *fd = (grpc_fd *)(data_ptr);
       bool cancel = (ev->events & (EPOLLERR | EPOLLHUP)) != 0;
       bool read_ev = (ev->events & (EPOLLIN | EPOLLPRI)) != 0;
       bool write_ev = (ev->events & EPOLLOUT) != 0;
 
-      if (read_ev || cancel) {
+      if ((read_ev || cancel) &&
+          (cancel || !g_fd_affinity || !fd_hand_off_read(exec_ctx, fd))) {
         fd_become_readable(exec_ctx, fd, pollset);
       }
 
@@ -670,6 +808,7 @@ static bool begin_worker(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
   worker->initialized_cv = false;
   SET_KICK_STATE(worker, UNKICKED);
   worker->schedule_on_end_work = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
+  worker->handoff_neighborhood = NULL;
   pollset->begin_refs++;
 
   if (GRPC_TRACER_ON(grpc_polling_trace)) {
@@ -864,6 +1003,10 @@ static void end_worker(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
   SET_KICK_STATE(worker, KICKED);
   grpc_closure_list_move(&worker->schedule_on_end_work,
                          &exec_ctx->closure_list);
+  if (worker->handoff_neighborhood != NULL) {
+    neighborhood_process_handoffs(exec_ctx, worker->handoff_neighborhood,
+                                  pollset);
+  }
   if (gpr_atm_no_barrier_load(&g_active_poller) == (gpr_atm)worker) {
     if (worker->next != worker && worker->next->state == UNKICKED) {
       if (GRPC_TRACER_ON(grpc_polling_trace)) {
@@ -1050,12 +1193,11 @@ static grpc_error *pollset_kick(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
                                      // there is no next worker
                  root_worker == (grpc_pollset_worker *)gpr_atm_no_barrier_load(
                                     &g_active_poller)) {
-        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD(exec_ctx);
         if (GRPC_TRACER_ON(grpc_polling_trace)) {
           gpr_log(GPR_ERROR, " .. kicked %p", root_worker);
         }
         SET_KICK_STATE(root_worker, KICKED);
-        ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+        ret_err = kick_active_poller(exec_ctx);
         goto done;
       } else if (next_worker->state == UNKICKED) {
         GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV(exec_ctx);
@@ -1081,13 +1223,12 @@ static grpc_error *pollset_kick(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
           }
           goto done;
         } else {
-          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD(exec_ctx);
           if (GRPC_TRACER_ON(grpc_polling_trace)) {
             gpr_log(GPR_ERROR, " .. non-root poller %p (root=%p)", next_worker,
                     root_worker);
           }
           SET_KICK_STATE(next_worker, KICKED);
-          ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+          ret_err = kick_active_poller(exec_ctx);
           goto done;
         }
       } else {
@@ -1122,12 +1263,11 @@ static grpc_error *pollset_kick(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
     goto done;
   } else if (specific_worker ==
              (grpc_pollset_worker *)gpr_atm_no_barrier_load(&g_active_poller)) {
-    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD(exec_ctx);
     if (GRPC_TRACER_ON(grpc_polling_trace)) {
       gpr_log(GPR_ERROR, " .. kick active poller");
     }
     SET_KICK_STATE(specific_worker, KICKED);
-    ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    ret_err = kick_active_poller(exec_ctx);
     goto done;
   } else if (specific_worker->initialized_cv) {
     GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV(exec_ctx);
@@ -1239,6 +1379,10 @@ const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
 
   fd_global_init();
 
+  char *fd_affinity = gpr_getenv("GRPC_EPOLL1_FD_AFFINITY");
+  g_fd_affinity = fd_affinity != NULL && gpr_is_true(fd_affinity);
+  gpr_free(fd_affinity);
+
   if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
     fd_global_shutdown();
     epoll_set_shutdown();
@@ -1248,6 +1392,12 @@ const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
   return &vtable;
 }
 
+void grpc_epoll1_set_neighborhoods_for_testing(
+    size_t num_neighborhoods, size_t (*choose_neighborhood)(void)) {
+  g_num_neighborhoods_for_testing = num_neighborhoods;
+  g_choose_neighborhood_for_testing = choose_neighborhood;
+}
+
 #else /* defined(GRPC_LINUX_EPOLL) */
 #if defined(GRPC_POSIX_SOCKET)
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
@@ -30,6 +30,12 @@ extern "C" {
 
 const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request);
 
+/* Test only: the engine uses num_neighborhoods pollset neighborhoods (instead
+   of one per core), and the calling thread belongs to the one returned by
+   choose_neighborhood (instead of the one of its cpu). Call before grpc_init */
+void grpc_epoll1_set_neighborhoods_for_testing(
+    size_t num_neighborhoods, size_t (*choose_neighborhood)(void));
+
 #ifdef __cplusplus
 }
 #endif
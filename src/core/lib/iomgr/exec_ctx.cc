@@ -24,6 +24,7 @@
 
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/support/time_precise.h"
 
 bool grpc_exec_ctx_ready_to_finish(grpc_exec_ctx *exec_ctx) {
   if ((exec_ctx->flags & GRPC_EXEC_CTX_FLAG_IS_FINISHED) == 0) {
@@ -140,12 +141,17 @@ static gpr_atm timespec_to_atm_round_up(gpr_timespec ts) {
 
 grpc_millis grpc_exec_ctx_now(grpc_exec_ctx *exec_ctx) {
   if (!exec_ctx->now_is_valid) {
-    exec_ctx->now = timespec_to_atm_round_down(gpr_now(GPR_CLOCK_MONOTONIC));
+    exec_ctx->now = timespec_to_atm_round_down(gpr_fast_monotonic_now());
     exec_ctx->now_is_valid = true;
   }
   return exec_ctx->now;
 }
 
+grpc_millis grpc_exec_ctx_now_coarse(grpc_exec_ctx *exec_ctx) {
+  if (exec_ctx->now_is_valid) return exec_ctx->now;
+  return timespec_to_atm_round_down(gpr_coarse_monotonic_now());
+}
+
 void grpc_exec_ctx_invalidate_now(grpc_exec_ctx *exec_ctx) {
   exec_ctx->now_is_valid = false;
 }
@@ -119,6 +119,10 @@ void grpc_exec_ctx_global_init(void);
 void grpc_exec_ctx_global_shutdown(void);
 
 grpc_millis grpc_exec_ctx_now(grpc_exec_ctx *exec_ctx);
+/** The cached now if there is one, otherwise a read of a clock that may lag
+    grpc_exec_ctx_now by a few milliseconds, without caching it. For deadlines
+    of timers where that does not matter. */
+grpc_millis grpc_exec_ctx_now_coarse(grpc_exec_ctx *exec_ctx);
 void grpc_exec_ctx_invalidate_now(grpc_exec_ctx *exec_ctx);
 gpr_timespec grpc_millis_to_timespec(grpc_millis millis, gpr_clock_type clock);
 grpc_millis grpc_timespec_to_millis_round_down(gpr_timespec timespec);
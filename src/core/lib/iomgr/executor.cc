@@ -74,7 +74,9 @@ static size_t run_closures(grpc_exec_ctx *exec_ctx, grpc_closure_list list) {
 #ifndef NDEBUG
     c->scheduled = false;
 #endif
-    c->cb(exec_ctx, c->cb_arg, error);
+    GRPC_CLOSURE_LATENCY_INVOKE(exec_ctx, c, error,
+                                GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_US,
+                                GRPC_STATS_HISTOGRAM_EXECUTOR_CLOSURE_RUN_US);
     GRPC_ERROR_UNREF(error);
     c = next;
     n++;
@@ -214,6 +216,7 @@ static void executor_push(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
       GRPC_STATS_INC_EXECUTOR_SCHEDULED_TO_SELF(exec_ctx);
     }
     thread_state *orig_ts = ts;
+    GRPC_CLOSURE_LATENCY_MARK_QUEUED(closure);
 
     bool try_new_thread;
     for (;;) {
@@ -25,6 +25,7 @@
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/useful.h>
@@ -36,6 +37,16 @@ grpc_tracer_flag grpc_resource_quota_trace =
 
 #define MEMORY_USAGE_ESTIMATION_MAX 65536
 
+/* Bytes granted to a resource user on top of what it asked for, so that its
+   next allocations are satisfied from its own free pool */
+#define RESOURCE_USER_SLAB_SIZE (64 * 1024)
+/* Bytes each per-cpu slab of a quota is topped up to */
+#define CPU_SLAB_SIZE (1024 * 1024)
+/* Slabs are only handed out while the quota has at most 1/16th of its size
+   allocated (slab bytes count as allocated), so that they don't skew the
+   memory pressure estimate */
+#define SLAB_HEADROOM_DIVISOR 16
+
 /* Internal linked list pointers for a resource user */
 typedef struct {
   grpc_resource_user *next;
@@ -49,6 +60,8 @@ typedef enum {
   GRPC_RULIST_AWAITING_ALLOCATION,
   /* Resource users that have free memory available for internal reclamation */
   GRPC_RULIST_NON_EMPTY_FREE_POOL,
+  /* Resource users that have published cache reclaimers */
+  GRPC_RULIST_RECLAIMER_CACHE,
   /* Resource users that have published a benign reclamation is available */
   GRPC_RULIST_RECLAIMER_BENIGN,
   /* Resource users that have published a destructive reclamation is
@@ -75,25 +88,31 @@ struct grpc_resource_user {
      call */
   gpr_atm shutdown;
 
-  gpr_mu mu;
   /* The amount of memory (in bytes) this user has cached for its own use: to
      avoid quota contention, each resource user can keep some memory in
      addition to what it is immediately using (e.g., for caching), and the quota
      can pull it back under memory pressure.
      This value can become negative if more memory has been requested than
      existed in the free pool, at which point the quota is consulted to bring
-     this value non-negative (asynchronously). */
-  int64_t free_pool;
+     this value non-negative (asynchronously).
+     Allocations that fit in a non-negative free pool and all frees update this
+     with atomics only; everything that may take it negative holds mu. */
+  gpr_atm free_pool;
+
+  gpr_mu mu;
   /* A list of closures to call once free_pool becomes non-negative - ie when
      all outstanding allocations have been granted. */
   grpc_closure_list on_allocated;
   /* True if we are currently trying to allocate from the quota, false if not */
   bool allocating;
-  /* How many bytes of allocations are outstanding */
+  /* How many bytes of allocations waiting on a closure are outstanding:
+     these are the ones shutdown aborts. Allocations without a closure (e.g.
+     grpc_resource_user_slice_malloc) were handed out already and are only
+     ever returned with grpc_resource_user_free. */
   int64_t outstanding_allocations;
-  /* True if we are currently trying to add ourselves to the non-free quota
-     list, false otherwise */
-  bool added_to_free_pool;
+  /* Non-zero from when we start adding ourselves to the non-empty free pool
+     list until the quota pops us off it again */
+  gpr_atm added_to_free_pool;
 
   /* Reclaimers: index 0 is the benign reclaimer, 1 is the destructive reclaimer
    */
@@ -105,6 +124,14 @@ struct grpc_resource_user {
      lock */
   grpc_closure post_reclaimer_closure[2];
 
+  /* Cache reclaimers, run in the order they were posted */
+  grpc_closure_list cache_reclaimers;
+  /* Cache reclaimers just posted (guarded by mu): once we're in the combiner
+     lock, we'll move them to the list above */
+  grpc_closure_list new_cache_reclaimers;
+  /* Closure to move new_cache_reclaimers under the combiner lock */
+  grpc_closure post_cache_reclaimers_closure;
+
   /* Closure to execute under the quota combiner to de-register and shutdown the
      resource user */
   grpc_closure destroy_closure;
@@ -116,6 +143,16 @@ struct grpc_resource_user {
   char *name;
 };
 
+/* Quota bytes set aside for allocations made on one cpu: a resource user
+   that runs out of free pool takes what it needs from the slab of the cpu it is
+   running on, without going through the quota combiner. The combiner tops the
+   slabs up after it grants allocations, and takes them back before reclaiming
+   memory from resource users. */
+typedef struct {
+  gpr_atm free_pool;
+  char padding[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+} rq_cpu_slab;
+
 struct grpc_resource_quota {
   /* refcount */
   gpr_refcount refs;
@@ -152,6 +189,10 @@ struct grpc_resource_quota {
   /* Roots of all resource user lists */
   grpc_resource_user *roots[GRPC_RULIST_COUNT];
 
+  /* One slab per cpu */
+  size_t num_cpu_slabs;
+  rq_cpu_slab *cpu_slabs;
+
   char *name;
 };
 
@@ -242,8 +283,12 @@ static void rulist_remove(grpc_resource_user *resource_user, grpc_rulist list) {
 
 static bool rq_alloc(grpc_exec_ctx *exec_ctx,
                      grpc_resource_quota *resource_quota);
+static void rq_refill_cpu_slabs(grpc_resource_quota *resource_quota);
+static bool rq_reclaim_from_cpu_slabs(grpc_resource_quota *resource_quota);
 static bool rq_reclaim_from_per_user_free_pool(
     grpc_exec_ctx *exec_ctx, grpc_resource_quota *resource_quota);
+static bool rq_reclaim_cache(grpc_exec_ctx *exec_ctx,
+                             grpc_resource_quota *resource_quota);
 static bool rq_reclaim(grpc_exec_ctx *exec_ctx,
                        grpc_resource_quota *resource_quota, bool destructive);
 
@@ -251,10 +296,24 @@ static void rq_step(grpc_exec_ctx *exec_ctx, void *rq, grpc_error *error) {
   grpc_resource_quota *resource_quota = (grpc_resource_quota *)rq;
   resource_quota->step_scheduled = false;
   do {
-    if (rq_alloc(exec_ctx, resource_quota)) goto done;
-  } while (rq_reclaim_from_per_user_free_pool(exec_ctx, resource_quota));
+    if (rq_alloc(exec_ctx, resource_quota)) {
+      rq_refill_cpu_slabs(resource_quota);
+      /* nothing is waiting, but if the quota was shrunk below what is already
+         allocated, give back whatever can go without disturbing anyone */
+      while (resource_quota->free_pool < 0 &&
+             (rq_reclaim_from_cpu_slabs(resource_quota) ||
+              rq_reclaim_from_per_user_free_pool(exec_ctx, resource_quota))) {
+      }
+      if (resource_quota->free_pool < 0) {
+        rq_reclaim_cache(exec_ctx, resource_quota);
+      }
+      goto done;
+    }
+  } while (rq_reclaim_from_cpu_slabs(resource_quota) ||
+           rq_reclaim_from_per_user_free_pool(exec_ctx, resource_quota));
 
-  if (!rq_reclaim(exec_ctx, resource_quota, false)) {
+  if (!rq_reclaim_cache(exec_ctx, resource_quota) &&
+      !rq_reclaim(exec_ctx, resource_quota, false)) {
     rq_reclaim(exec_ctx, resource_quota, true);
   }
 
@@ -287,6 +346,25 @@ static void rq_update_estimate(grpc_resource_quota *resource_quota) {
                            memory_usage_estimation);
 }
 
+/* can amount bytes be set aside in slabs without eating into the memory that
+   the quota reports as available? */
+static bool rq_has_slab_headroom(grpc_resource_quota *resource_quota,
+                                 int64_t amount) {
+  return resource_quota->free_pool - amount >=
+         resource_quota->size -
+             resource_quota->size / SLAB_HEADROOM_DIVISOR;
+}
+
+/* called with resource_user->free_pool just made positive: make sure the
+   quota will be able to reclaim it */
+static void ru_publish_free_pool(grpc_exec_ctx *exec_ctx,
+                                 grpc_resource_user *resource_user) {
+  if (gpr_atm_no_barrier_cas(&resource_user->added_to_free_pool, 0, 1)) {
+    GRPC_CLOSURE_SCHED(exec_ctx, &resource_user->add_to_free_pool_closure,
+                       GRPC_ERROR_NONE);
+  }
+}
+
 /* returns true if all allocations are completed */
 static bool rq_alloc(grpc_exec_ctx *exec_ctx,
                      grpc_resource_quota *resource_quota) {
@@ -296,9 +374,9 @@ static bool rq_alloc(grpc_exec_ctx *exec_ctx,
     gpr_mu_lock(&resource_user->mu);
     if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
       gpr_log(GPR_DEBUG, "RQ: check allocation for user %p shutdown=%" PRIdPTR
-                         " free_pool=%" PRId64,
+                         " free_pool=%" PRIdPTR,
               resource_user, gpr_atm_no_barrier_load(&resource_user->shutdown),
-              resource_user->free_pool);
+              gpr_atm_no_barrier_load(&resource_user->free_pool));
     }
     if (gpr_atm_no_barrier_load(&resource_user->shutdown)) {
       resource_user->allocating = false;
@@ -307,30 +385,45 @@ static bool rq_alloc(grpc_exec_ctx *exec_ctx,
           GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource user shutdown"));
       int64_t aborted_allocations = resource_user->outstanding_allocations;
       resource_user->outstanding_allocations = 0;
-      resource_user->free_pool += aborted_allocations;
+      gpr_atm_no_barrier_fetch_add(&resource_user->free_pool,
+                                   (gpr_atm)aborted_allocations);
       GRPC_CLOSURE_LIST_SCHED(exec_ctx, &resource_user->on_allocated);
       gpr_mu_unlock(&resource_user->mu);
-      ru_unref_by(exec_ctx, resource_user, (gpr_atm)aborted_allocations);
+      if (aborted_allocations > 0) {
+        ru_unref_by(exec_ctx, resource_user, (gpr_atm)aborted_allocations);
+      }
       continue;
     }
-    if (resource_user->free_pool < 0 &&
-        -resource_user->free_pool <= resource_quota->free_pool) {
-      int64_t amt = -resource_user->free_pool;
-      resource_user->free_pool = 0;
-      resource_quota->free_pool -= amt;
+    /* frees (and allocations that fit) may race with us, but only ever leave
+       the free pool larger than it was when they found it negative */
+    int64_t free_pool =
+        (int64_t)gpr_atm_no_barrier_load(&resource_user->free_pool);
+    if (free_pool < 0 && -free_pool <= resource_quota->free_pool) {
+      int64_t amt = -free_pool;
+      int64_t slab =
+          rq_has_slab_headroom(resource_quota, amt + RESOURCE_USER_SLAB_SIZE)
+              ? RESOURCE_USER_SLAB_SIZE
+              : 0;
+      free_pool = (int64_t)gpr_atm_no_barrier_fetch_add(
+                      &resource_user->free_pool, (gpr_atm)(amt + slab)) +
+                  amt + slab;
+      resource_quota->free_pool -= amt + slab;
       rq_update_estimate(resource_quota);
       if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
-        gpr_log(GPR_DEBUG, "RQ %s %s: grant alloc %" PRId64
-                           " bytes; rq_free_pool -> %" PRId64,
-                resource_quota->name, resource_user->name, amt,
+        gpr_log(GPR_DEBUG, "RQ %s %s: grant alloc %" PRId64 " bytes (+%" PRId64
+                           " slab); rq_free_pool -> %" PRId64,
+                resource_quota->name, resource_user->name, amt, slab,
                 resource_quota->free_pool);
       }
-    } else if (GRPC_TRACER_ON(grpc_resource_quota_trace) &&
-               resource_user->free_pool >= 0) {
+      if (free_pool > 0 &&
+          gpr_atm_no_barrier_cas(&resource_user->added_to_free_pool, 0, 1)) {
+        rulist_add_tail(resource_user, GRPC_RULIST_NON_EMPTY_FREE_POOL);
+      }
+    } else if (GRPC_TRACER_ON(grpc_resource_quota_trace) && free_pool >= 0) {
       gpr_log(GPR_DEBUG, "RQ %s %s: discard already satisfied alloc request",
               resource_quota->name, resource_user->name);
     }
-    if (resource_user->free_pool >= 0) {
+    if (free_pool >= 0) {
       resource_user->allocating = false;
       resource_user->outstanding_allocations = 0;
       GRPC_CLOSURE_LIST_SCHED(exec_ctx, &resource_user->on_allocated);
@@ -344,6 +437,47 @@ static bool rq_alloc(grpc_exec_ctx *exec_ctx,
   return true;
 }
 
+/* top up every cpu slab, if the quota can spare it */
+static void rq_refill_cpu_slabs(grpc_resource_quota *resource_quota) {
+  for (size_t i = 0; i < resource_quota->num_cpu_slabs; i++) {
+    gpr_atm *slab = &resource_quota->cpu_slabs[i].free_pool;
+    /* allocations only ever take from a slab, so it cannot overflow */
+    int64_t amt = CPU_SLAB_SIZE - (int64_t)gpr_atm_no_barrier_load(slab);
+    if (amt <= 0 || !rq_has_slab_headroom(resource_quota, amt)) continue;
+    gpr_atm_no_barrier_fetch_add(slab, (gpr_atm)amt);
+    resource_quota->free_pool -= amt;
+  }
+  rq_update_estimate(resource_quota);
+}
+
+/* returns true if any memory could be reclaimed from cpu slabs */
+static bool rq_reclaim_from_cpu_slabs(grpc_resource_quota *resource_quota) {
+  int64_t amt = 0;
+  for (size_t i = 0; i < resource_quota->num_cpu_slabs; i++) {
+    amt += (int64_t)gpr_atm_full_xchg(&resource_quota->cpu_slabs[i].free_pool,
+                                      0);
+  }
+  if (amt == 0) return false;
+  resource_quota->free_pool += amt;
+  rq_update_estimate(resource_quota);
+  if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
+    gpr_log(GPR_DEBUG, "RQ %s: reclaim_from_cpu_slabs %" PRId64
+                       " bytes; rq_free_pool -> %" PRId64,
+            resource_quota->name, amt, resource_quota->free_pool);
+  }
+  return true;
+}
+
+/* take all of a non-negative free pool, leaving it at zero */
+static int64_t ru_take_free_pool(grpc_resource_user *resource_user) {
+  gpr_atm free_pool;
+  do {
+    free_pool = gpr_atm_no_barrier_load(&resource_user->free_pool);
+  } while (free_pool > 0 &&
+           !gpr_atm_no_barrier_cas(&resource_user->free_pool, free_pool, 0));
+  return free_pool > 0 ? (int64_t)free_pool : 0;
+}
+
 /* returns true if any memory could be reclaimed from buffers */
 static bool rq_reclaim_from_per_user_free_pool(
     grpc_exec_ctx *exec_ctx, grpc_resource_quota *resource_quota) {
@@ -351,9 +485,11 @@ static bool rq_reclaim_from_per_user_free_pool(
   while ((resource_user = rulist_pop_head(resource_quota,
                                           GRPC_RULIST_NON_EMPTY_FREE_POOL))) {
     gpr_mu_lock(&resource_user->mu);
-    if (resource_user->free_pool > 0) {
-      int64_t amt = resource_user->free_pool;
-      resource_user->free_pool = 0;
+    /* the next free that takes the free pool from empty to non-empty will
+       publish it again */
+    gpr_atm_no_barrier_store(&resource_user->added_to_free_pool, 0);
+    int64_t amt = ru_take_free_pool(resource_user);
+    if (amt > 0) {
       resource_quota->free_pool += amt;
       rq_update_estimate(resource_quota);
       if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
@@ -371,6 +507,41 @@ static bool rq_reclaim_from_per_user_free_pool(
   return false;
 }
 
+static void rq_initiate_reclamation(grpc_exec_ctx *exec_ctx,
+                                    grpc_resource_quota *resource_quota,
+                                    grpc_resource_user *resource_user,
+                                    grpc_closure *c, const char *kind) {
+  if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
+    gpr_log(GPR_DEBUG, "RQ %s %s: initiate %s reclamation",
+            resource_quota->name, resource_user->name, kind);
+  }
+  resource_quota->reclaiming = true;
+  grpc_resource_quota_ref_internal(resource_quota);
+  resource_quota->debug_only_last_reclaimer_resource_user = resource_user;
+  resource_quota->debug_only_last_initiated_reclaimer = c;
+  GRPC_CLOSURE_RUN(exec_ctx, c, GRPC_ERROR_NONE);
+}
+
+/* run one cache reclaimer, taking turns between resource users: returns true
+   if reclamation is proceeding */
+static bool rq_reclaim_cache(grpc_exec_ctx *exec_ctx,
+                             grpc_resource_quota *resource_quota) {
+  if (resource_quota->reclaiming) return true;
+  grpc_resource_user *resource_user =
+      rulist_pop_head(resource_quota, GRPC_RULIST_RECLAIMER_CACHE);
+  if (resource_user == NULL) return false;
+  grpc_closure *c = resource_user->cache_reclaimers.head;
+  GPR_ASSERT(c);
+  resource_user->cache_reclaimers.head = c->next_data.next;
+  if (resource_user->cache_reclaimers.head == NULL) {
+    resource_user->cache_reclaimers.tail = NULL;
+  } else {
+    rulist_add_tail(resource_user, GRPC_RULIST_RECLAIMER_CACHE);
+  }
+  rq_initiate_reclamation(exec_ctx, resource_quota, resource_user, c, "cache");
+  return true;
+}
+
 /* returns true if reclamation is proceeding */
 static bool rq_reclaim(grpc_exec_ctx *exec_ctx,
                        grpc_resource_quota *resource_quota, bool destructive) {
@@ -379,19 +550,11 @@ static bool rq_reclaim(grpc_exec_ctx *exec_ctx,
                                  : GRPC_RULIST_RECLAIMER_BENIGN;
   grpc_resource_user *resource_user = rulist_pop_head(resource_quota, list);
   if (resource_user == NULL) return false;
-  if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
-    gpr_log(GPR_DEBUG, "RQ %s %s: initiate %s reclamation",
-            resource_quota->name, resource_user->name,
-            destructive ? "destructive" : "benign");
-  }
-  resource_quota->reclaiming = true;
-  grpc_resource_quota_ref_internal(resource_quota);
   grpc_closure *c = resource_user->reclaimers[destructive];
   GPR_ASSERT(c);
-  resource_quota->debug_only_last_reclaimer_resource_user = resource_user;
-  resource_quota->debug_only_last_initiated_reclaimer = c;
   resource_user->reclaimers[destructive] = NULL;
-  GRPC_CLOSURE_RUN(exec_ctx, c, GRPC_ERROR_NONE);
+  rq_initiate_reclamation(exec_ctx, resource_quota, resource_user, c,
+                          destructive ? "destructive" : "benign");
   return true;
 }
 
@@ -480,6 +643,34 @@ static bool ru_post_reclaimer(grpc_exec_ctx *exec_ctx,
   return true;
 }
 
+static void ru_post_cache_reclaimers(grpc_exec_ctx *exec_ctx, void *ru,
+                                     grpc_error *error) {
+  grpc_resource_user *resource_user = (grpc_resource_user *)ru;
+  grpc_resource_quota *resource_quota = resource_user->resource_quota;
+  gpr_mu_lock(&resource_user->mu);
+  grpc_closure_list_move(&resource_user->new_cache_reclaimers,
+                         &resource_user->cache_reclaimers);
+  gpr_mu_unlock(&resource_user->mu);
+  if (gpr_atm_acq_load(&resource_user->shutdown) > 0) {
+    grpc_closure_list_fail_all(&resource_user->cache_reclaimers,
+                               GRPC_ERROR_CANCELLED);
+    GRPC_CLOSURE_LIST_SCHED(exec_ctx, &resource_user->cache_reclaimers);
+    return;
+  }
+  if (grpc_closure_list_empty(resource_user->cache_reclaimers) ||
+      resource_user->links[GRPC_RULIST_RECLAIMER_CACHE].next != NULL) {
+    return;
+  }
+  /* an over limit quota runs cache reclaimers even if nobody is waiting */
+  if ((resource_quota->free_pool < 0 ||
+       (!rulist_empty(resource_quota, GRPC_RULIST_AWAITING_ALLOCATION) &&
+        rulist_empty(resource_quota, GRPC_RULIST_NON_EMPTY_FREE_POOL))) &&
+      rulist_empty(resource_quota, GRPC_RULIST_RECLAIMER_CACHE)) {
+    rq_step_sched(exec_ctx, resource_quota);
+  }
+  rulist_add_tail(resource_user, GRPC_RULIST_RECLAIMER_CACHE);
+}
+
 static void ru_post_benign_reclaimer(grpc_exec_ctx *exec_ctx, void *ru,
                                      grpc_error *error) {
   grpc_resource_user *resource_user = (grpc_resource_user *)ru;
@@ -488,6 +679,8 @@ static void ru_post_benign_reclaimer(grpc_exec_ctx *exec_ctx, void *ru,
                     GRPC_RULIST_AWAITING_ALLOCATION) &&
       rulist_empty(resource_user->resource_quota,
                    GRPC_RULIST_NON_EMPTY_FREE_POOL) &&
+      rulist_empty(resource_user->resource_quota,
+                   GRPC_RULIST_RECLAIMER_CACHE) &&
       rulist_empty(resource_user->resource_quota,
                    GRPC_RULIST_RECLAIMER_BENIGN)) {
     rq_step_sched(exec_ctx, resource_user->resource_quota);
@@ -503,6 +696,8 @@ static void ru_post_destructive_reclaimer(grpc_exec_ctx *exec_ctx, void *ru,
                     GRPC_RULIST_AWAITING_ALLOCATION) &&
       rulist_empty(resource_user->resource_quota,
                    GRPC_RULIST_NON_EMPTY_FREE_POOL) &&
+      rulist_empty(resource_user->resource_quota,
+                   GRPC_RULIST_RECLAIMER_CACHE) &&
       rulist_empty(resource_user->resource_quota,
                    GRPC_RULIST_RECLAIMER_BENIGN) &&
       rulist_empty(resource_user->resource_quota,
@@ -523,6 +718,10 @@ static void ru_shutdown(grpc_exec_ctx *exec_ctx, void *ru, grpc_error *error) {
                      GRPC_ERROR_CANCELLED);
   resource_user->reclaimers[0] = NULL;
   resource_user->reclaimers[1] = NULL;
+  grpc_closure_list_fail_all(&resource_user->cache_reclaimers,
+                             GRPC_ERROR_CANCELLED);
+  GRPC_CLOSURE_LIST_SCHED(exec_ctx, &resource_user->cache_reclaimers);
+  rulist_remove(resource_user, GRPC_RULIST_RECLAIMER_CACHE);
   rulist_remove(resource_user, GRPC_RULIST_RECLAIMER_BENIGN);
   rulist_remove(resource_user, GRPC_RULIST_RECLAIMER_DESTRUCTIVE);
   if (resource_user->allocating) {
@@ -540,8 +739,13 @@ static void ru_destroy(grpc_exec_ctx *exec_ctx, void *ru, grpc_error *error) {
                      GRPC_ERROR_CANCELLED);
   GRPC_CLOSURE_SCHED(exec_ctx, resource_user->reclaimers[1],
                      GRPC_ERROR_CANCELLED);
-  if (resource_user->free_pool != 0) {
-    resource_user->resource_quota->free_pool += resource_user->free_pool;
+  grpc_closure_list_fail_all(&resource_user->cache_reclaimers,
+                             GRPC_ERROR_CANCELLED);
+  GRPC_CLOSURE_LIST_SCHED(exec_ctx, &resource_user->cache_reclaimers);
+  int64_t free_pool =
+      (int64_t)gpr_atm_no_barrier_load(&resource_user->free_pool);
+  if (free_pool != 0) {
+    resource_user->resource_quota->free_pool += free_pool;
     rq_step_sched(exec_ctx, resource_user->resource_quota);
   }
   grpc_resource_quota_unref_internal(exec_ctx, resource_user->resource_quota);
@@ -624,6 +828,9 @@ grpc_resource_quota *grpc_resource_quota_create(const char *name) {
   for (int i = 0; i < GRPC_RULIST_COUNT; i++) {
     resource_quota->roots[i] = NULL;
   }
+  resource_quota->num_cpu_slabs = GPR_MAX(1, gpr_cpu_num_cores());
+  resource_quota->cpu_slabs = (rq_cpu_slab *)gpr_zalloc(
+      sizeof(*resource_quota->cpu_slabs) * resource_quota->num_cpu_slabs);
   return resource_quota;
 }
 
@@ -631,6 +838,7 @@ void grpc_resource_quota_unref_internal(grpc_exec_ctx *exec_ctx,
                                         grpc_resource_quota *resource_quota) {
   if (gpr_unref(&resource_quota->refs)) {
     GRPC_COMBINER_UNREF(exec_ctx, resource_quota->combiner, "resource_quota");
+    gpr_free(resource_quota->cpu_slabs);
     gpr_free(resource_quota->name);
     gpr_free(resource_quota);
   }
@@ -736,19 +944,24 @@ grpc_resource_user *grpc_resource_user_create(
   GRPC_CLOSURE_INIT(&resource_user->post_reclaimer_closure[1],
                     &ru_post_destructive_reclaimer, resource_user,
                     grpc_combiner_scheduler(resource_quota->combiner));
+  GRPC_CLOSURE_INIT(&resource_user->post_cache_reclaimers_closure,
+                    &ru_post_cache_reclaimers, resource_user,
+                    grpc_combiner_scheduler(resource_quota->combiner));
   GRPC_CLOSURE_INIT(&resource_user->destroy_closure, &ru_destroy, resource_user,
                     grpc_combiner_scheduler(resource_quota->combiner));
   gpr_mu_init(&resource_user->mu);
   gpr_atm_rel_store(&resource_user->refs, 1);
   gpr_atm_rel_store(&resource_user->shutdown, 0);
-  resource_user->free_pool = 0;
+  gpr_atm_no_barrier_store(&resource_user->free_pool, 0);
   grpc_closure_list_init(&resource_user->on_allocated);
   resource_user->allocating = false;
-  resource_user->added_to_free_pool = false;
+  gpr_atm_no_barrier_store(&resource_user->added_to_free_pool, 0);
   resource_user->reclaimers[0] = NULL;
   resource_user->reclaimers[1] = NULL;
   resource_user->new_reclaimers[0] = NULL;
   resource_user->new_reclaimers[1] = NULL;
+  grpc_closure_list_init(&resource_user->cache_reclaimers);
+  grpc_closure_list_init(&resource_user->new_cache_reclaimers);
   resource_user->outstanding_allocations = 0;
   for (int i = 0; i < GRPC_RULIST_COUNT; i++) {
     resource_user->links[i].next = resource_user->links[i].prev = NULL;
@@ -804,19 +1017,73 @@ void grpc_resource_user_shutdown(grpc_exec_ctx *exec_ctx,
   }
 }
 
+/* take size bytes from the free pool if it has them, without locking */
+static bool ru_alloc_from_free_pool(grpc_resource_user *resource_user,
+                                    int64_t size) {
+  gpr_atm free_pool = gpr_atm_no_barrier_load(&resource_user->free_pool);
+  while (free_pool >= size) {
+    if (gpr_atm_no_barrier_cas(&resource_user->free_pool, free_pool,
+                               free_pool - (gpr_atm)size)) {
+      return true;
+    }
+    free_pool = gpr_atm_no_barrier_load(&resource_user->free_pool);
+  }
+  return false;
+}
+
+/* cover a deficit in the free pool from the current cpu's slab, taking a slab
+   for the resource user too if there's enough: returns the new free pool, which
+   is still negative if the cpu slab couldn't cover the deficit */
+static int64_t ru_alloc_from_cpu_slab(grpc_exec_ctx *exec_ctx,
+                                      grpc_resource_user *resource_user,
+                                      int64_t deficit) {
+  grpc_resource_quota *resource_quota = resource_user->resource_quota;
+  gpr_atm *slab =
+      &resource_quota
+           ->cpu_slabs[exec_ctx->starting_cpu % resource_quota->num_cpu_slabs]
+           .free_pool;
+  gpr_atm available;
+  int64_t amt;
+  do {
+    available = gpr_atm_no_barrier_load(slab);
+    if (available < deficit) return -deficit;
+    amt = GPR_MIN((int64_t)available, deficit + RESOURCE_USER_SLAB_SIZE);
+  } while (!gpr_atm_no_barrier_cas(slab, available, available - (gpr_atm)amt));
+  int64_t free_pool = (int64_t)gpr_atm_no_barrier_fetch_add(
+                          &resource_user->free_pool, (gpr_atm)amt) +
+                      amt;
+  if (free_pool > 0) ru_publish_free_pool(exec_ctx, resource_user);
+  return free_pool;
+}
+
 void grpc_resource_user_alloc(grpc_exec_ctx *exec_ctx,
                               grpc_resource_user *resource_user, size_t size,
                               grpc_closure *optional_on_done) {
-  gpr_mu_lock(&resource_user->mu);
   ru_ref_by(resource_user, (gpr_atm)size);
-  resource_user->free_pool -= (int64_t)size;
-  resource_user->outstanding_allocations += (int64_t)size;
+  if (ru_alloc_from_free_pool(resource_user, (int64_t)size)) {
+    if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
+      gpr_log(GPR_DEBUG, "RQ %s %s: alloc %" PRIdPTR " from free pool",
+              resource_user->resource_quota->name, resource_user->name, size);
+    }
+    GRPC_CLOSURE_SCHED(exec_ctx, optional_on_done, GRPC_ERROR_NONE);
+    return;
+  }
+  gpr_mu_lock(&resource_user->mu);
+  int64_t free_pool = (int64_t)gpr_atm_no_barrier_fetch_add(
+                          &resource_user->free_pool, -(gpr_atm)size) -
+                      (int64_t)size;
+  if (optional_on_done != NULL) {
+    resource_user->outstanding_allocations += (int64_t)size;
+  }
+  if (free_pool < 0 && !resource_user->allocating) {
+    free_pool = ru_alloc_from_cpu_slab(exec_ctx, resource_user, -free_pool);
+  }
   if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
     gpr_log(GPR_DEBUG, "RQ %s %s: alloc %" PRIdPTR "; free_pool -> %" PRId64,
             resource_user->resource_quota->name, resource_user->name, size,
-            resource_user->free_pool);
+            free_pool);
   }
-  if (resource_user->free_pool < 0) {
+  if (free_pool < 0) {
     grpc_closure_list_append(&resource_user->on_allocated, optional_on_done,
                              GRPC_ERROR_NONE);
     if (!resource_user->allocating) {
@@ -825,7 +1092,9 @@ void grpc_resource_user_alloc(grpc_exec_ctx *exec_ctx,
                          GRPC_ERROR_NONE);
     }
   } else {
-    resource_user->outstanding_allocations -= (int64_t)size;
+    if (optional_on_done != NULL) {
+      resource_user->outstanding_allocations -= (int64_t)size;
+    }
     GRPC_CLOSURE_SCHED(exec_ctx, optional_on_done, GRPC_ERROR_NONE);
   }
   gpr_mu_unlock(&resource_user->mu);
@@ -833,22 +1102,17 @@ void grpc_resource_user_alloc(grpc_exec_ctx *exec_ctx,
 
 void grpc_resource_user_free(grpc_exec_ctx *exec_ctx,
                              grpc_resource_user *resource_user, size_t size) {
-  gpr_mu_lock(&resource_user->mu);
-  bool was_zero_or_negative = resource_user->free_pool <= 0;
-  resource_user->free_pool += (int64_t)size;
+  int64_t free_pool = (int64_t)gpr_atm_no_barrier_fetch_add(
+                          &resource_user->free_pool, (gpr_atm)size) +
+                      (int64_t)size;
   if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
     gpr_log(GPR_DEBUG, "RQ %s %s: free %" PRIdPTR "; free_pool -> %" PRId64,
             resource_user->resource_quota->name, resource_user->name, size,
-            resource_user->free_pool);
+            free_pool);
   }
-  bool is_bigger_than_zero = resource_user->free_pool > 0;
-  if (is_bigger_than_zero && was_zero_or_negative &&
-      !resource_user->added_to_free_pool) {
-    resource_user->added_to_free_pool = true;
-    GRPC_CLOSURE_SCHED(exec_ctx, &resource_user->add_to_free_pool_closure,
-                       GRPC_ERROR_NONE);
+  if (free_pool > 0 && free_pool <= (int64_t)size) {
+    ru_publish_free_pool(exec_ctx, resource_user);
   }
-  gpr_mu_unlock(&resource_user->mu);
   ru_unref_by(exec_ctx, resource_user, (gpr_atm)size);
 }
 
@@ -863,6 +1127,20 @@ void grpc_resource_user_post_reclaimer(grpc_exec_ctx *exec_ctx,
                      GRPC_ERROR_NONE);
 }
 
+void grpc_resource_user_post_cache_reclaimer(grpc_exec_ctx *exec_ctx,
+                                             grpc_resource_user *resource_user,
+                                             grpc_closure *closure) {
+  gpr_mu_lock(&resource_user->mu);
+  bool first = grpc_closure_list_empty(resource_user->new_cache_reclaimers);
+  grpc_closure_list_append(&resource_user->new_cache_reclaimers, closure,
+                           GRPC_ERROR_NONE);
+  gpr_mu_unlock(&resource_user->mu);
+  if (first) {
+    GRPC_CLOSURE_SCHED(exec_ctx, &resource_user->post_cache_reclaimers_closure,
+                       GRPC_ERROR_NONE);
+  }
+}
+
 void grpc_resource_user_finish_reclamation(grpc_exec_ctx *exec_ctx,
                                            grpc_resource_user *resource_user) {
   if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
@@ -901,3 +1179,10 @@ grpc_slice grpc_resource_user_slice_malloc(grpc_exec_ctx *exec_ctx,
   grpc_resource_user_alloc(exec_ctx, resource_user, size, NULL);
   return ru_slice_create(resource_user, size);
 }
+
+size_t grpc_resource_user_slice_allocation_size(grpc_slice slice) {
+  if (slice.refcount == NULL || slice.refcount->vtable != &ru_slice_vtable) {
+    return 0;
+  }
+  return ((ru_slice_refcount *)slice.refcount)->size;
+}
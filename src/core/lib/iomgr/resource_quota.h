@@ -39,10 +39,13 @@ extern "C" {
     resource constrained, grpc_resource_user instances are asked (in turn) to
     free up whatever they can so that the system as a whole can make progress.
 
-    There are three kinds of reclamation that take place, in order of increasing
+    There are four kinds of reclamation that take place, in order of increasing
     invasiveness:
     - an internal reclamation, where cached resource at the resource user level
       is returned to the quota
+    - a cache reclamation phase, whereby memory that the owners of resource
+      users keep around only to go faster (idle read buffers, compression
+      tables, ...) is released
     - a benign reclamation phase, whereby resources that are in use but are not
       helping anything make progress are reclaimed
     - a destructive reclamation, whereby resources that are helping something
@@ -52,12 +55,22 @@ extern "C" {
     Only one reclamation will be outstanding for a given quota at a given time.
     On each reclamation attempt, the kinds of reclamation are tried in order of
     increasing invasiveness, stopping at the first one that succeeds. Thus, on a
-    given reclamation attempt, if internal and benign reclamation both fail, it
-    will wind up doing a destructive reclamation. However, the next reclamation
+    given reclamation attempt, if internal, cache and benign reclamation all
+    fail, it will wind up doing a destructive reclamation. However, the next reclamation
     attempt may then be able to get what it needs via internal or benign
     reclamation, due to resources that may have been freed up by the destructive
     reclamation in the previous attempt.
 
+    To keep the quota's combiner off the allocation path, the quota grants
+    memory in slabs: resource users that get memory from the quota are given
+    some extra for their next allocations, and each cpu has a slab that
+    resource users running on it can draw from directly. Slabs are only handed
+    out while the quota is mostly unused, and are the first thing reclaimed.
+
+    A quota that is resized below what it has already granted does internal
+    and cache reclamation (but nothing more invasive) until it is back under
+    its size, even if no allocation is waiting.
+
     Future work will be to expose the current resource pressure so that back
     pressure can be applied to avoid reclamation phases starting.
 
@@ -116,6 +129,16 @@ void grpc_resource_user_free(grpc_exec_ctx *exec_ctx,
 void grpc_resource_user_post_reclaimer(grpc_exec_ctx *exec_ctx,
                                        grpc_resource_user *resource_user,
                                        bool destructive, grpc_closure *closure);
+/* Post a cache reclaimer to the resource user: it should release memory that
+   is only kept to avoid reallocating it, without affecting anything in
+   progress. Any number of cache reclaimers may be posted; each runs at most
+   once, and the reclaimers of a resource user run in the order they were
+   posted, so cheaper ones should be posted first. Like other reclaimers it
+   MUST call grpc_resource_user_finish_reclamation, and is cancelled when the
+   resource user is shut down. */
+void grpc_resource_user_post_cache_reclaimer(grpc_exec_ctx *exec_ctx,
+                                             grpc_resource_user *resource_user,
+                                             grpc_closure *closure);
 /* Finish a reclamation step */
 void grpc_resource_user_finish_reclamation(grpc_exec_ctx *exec_ctx,
                                            grpc_resource_user *resource_user);
@@ -154,6 +177,11 @@ grpc_slice grpc_resource_user_slice_malloc(grpc_exec_ctx *exec_ctx,
                                            grpc_resource_user *resource_user,
                                            size_t size);
 
+/* The size of the resource user allocation that \a slice (or the slice it was
+   taken from) keeps alive, or 0 if it was not allocated from a resource user
+   (grpc_resource_user_alloc_slices, grpc_resource_user_slice_malloc). */
+size_t grpc_resource_user_slice_allocation_size(grpc_slice slice);
+
 #ifdef __cplusplus
 }
 #endif
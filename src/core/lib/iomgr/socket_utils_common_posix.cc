@@ -178,6 +178,49 @@ grpc_error *grpc_set_socket_reuse_port(int fd, int reuse) {
 #endif
 }
 
+/* set TCP_FASTOPEN_CONNECT */
+grpc_error *grpc_set_socket_tcp_fastopen_connect(int fd, int enable) {
+#ifndef TCP_FASTOPEN_CONNECT
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_FASTOPEN_CONNECT unavailable on compiling system");
+#else
+  int val = (enable != 0);
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &val,
+                      sizeof(val))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_FASTOPEN_CONNECT)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
+/* set TCP_FASTOPEN */
+grpc_error *grpc_set_socket_tcp_fastopen(int fd, int queue_length) {
+#ifndef TCP_FASTOPEN
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_FASTOPEN unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &queue_length,
+                      sizeof(queue_length))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_FASTOPEN)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
+/* set TCP_NOTSENT_LOWAT */
+grpc_error *grpc_set_socket_tcp_notsent_lowat(int fd, int lowat) {
+#ifndef TCP_NOTSENT_LOWAT
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_NOTSENT_LOWAT unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &lowat,
+                      sizeof(lowat))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_NOTSENT_LOWAT)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
 /* disable nagle */
 grpc_error *grpc_set_socket_low_latency(int fd, int low_latency) {
   int val = (low_latency != 0);
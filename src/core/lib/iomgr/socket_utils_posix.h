@@ -52,6 +52,18 @@ grpc_error *grpc_set_socket_low_latency(int fd, int low_latency);
 /* set SO_REUSEPORT */
 grpc_error *grpc_set_socket_reuse_port(int fd, int reuse);
 
+/* set TCP_FASTOPEN_CONNECT: connect() completes immediately when the kernel
+   has a fast open cookie for the peer, and the first write goes in the SYN */
+grpc_error *grpc_set_socket_tcp_fastopen_connect(int fd, int enable);
+
+/* set TCP_FASTOPEN on a listening socket, allowing up to queue_length fast
+   open connections that have not completed their handshake */
+grpc_error *grpc_set_socket_tcp_fastopen(int fd, int queue_length);
+
+/* set TCP_NOTSENT_LOWAT: the socket is writable only while fewer than lowat
+   bytes are queued and not yet sent */
+grpc_error *grpc_set_socket_tcp_notsent_lowat(int fd, int lowat);
+
 /* Returns true if this system can create AF_INET6 sockets bound to ::1.
    The value is probed once, and cached for the life of the process.
 
@@ -83,6 +83,20 @@ static grpc_error *prepare_socket(const grpc_resolved_address *addr, int fd,
             (grpc_socket_mutator *)channel_args->args[i].value.pointer.p;
         err = grpc_set_socket_with_mutator(fd, mutator);
         if (err != GRPC_ERROR_NONE) goto error;
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_FASTOPEN_CONNECT)) {
+        if (!grpc_is_unix_socket(addr) &&
+            grpc_channel_arg_get_bool(&channel_args->args[i], false)) {
+          /* only an optimization: without it, connect as usual */
+          grpc_error *fastopen_err =
+              grpc_set_socket_tcp_fastopen_connect(fd, 1);
+          if (fastopen_err != GRPC_ERROR_NONE &&
+              GRPC_TRACER_ON(grpc_tcp_trace)) {
+            gpr_log(GPR_DEBUG, "TCP Fast Open unavailable: %s",
+                    grpc_error_string(fastopen_err));
+          }
+          GRPC_ERROR_UNREF(fastopen_err);
+        }
       }
     }
   }
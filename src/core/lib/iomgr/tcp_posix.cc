@@ -24,6 +24,7 @@
 #include "src/core/lib/iomgr/tcp_posix.h"
 
 #include <errno.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
@@ -44,9 +45,11 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/executor.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
+#include "src/core/lib/support/obj_cache.h"
 #include "src/core/lib/support/string.h"
 
 #ifdef GRPC_HAVE_MSG_NOSIGNAL
@@ -98,6 +101,13 @@ typedef struct {
 
   grpc_resource_user *resource_user;
   grpc_resource_user_slice_allocator slice_allocator;
+
+  /* guards the read buffer while a read waits for the fd to become readable,
+     when the resource quota may take it back */
+  gpr_mu read_mu;
+  bool waiting_for_readable;
+  bool read_reclaimer_posted;
+  grpc_closure read_reclaimer_closure;
 } grpc_tcp;
 
 typedef struct backup_poller {
@@ -110,6 +120,23 @@ typedef struct backup_poller {
 static gpr_atm g_uncovered_notifications_pending;
 static gpr_atm g_backup_poller; /* backup_poller* */
 
+/* Freed grpc_tcp objects, reused by endpoints created later on.
+   The cache outlives grpc_shutdown, since endpoints leaked past iomgr
+   shutdown can still be freed after it: shutdown only frees the objects the
+   cache holds. */
+#define MAX_CACHED_TCPS 1024
+static gpr_obj_cache *g_tcp_cache;
+
+void grpc_tcp_posix_init(void) {
+  if (g_tcp_cache == NULL) {
+    g_tcp_cache = gpr_obj_cache_create(MAX_CACHED_TCPS);
+  }
+}
+
+void grpc_tcp_posix_shutdown(void) {
+  gpr_obj_cache_drain(g_tcp_cache, gpr_free);
+}
+
 static void tcp_handle_read(grpc_exec_ctx *exec_ctx, void *arg /* grpc_tcp */,
                             grpc_error *error);
 static void tcp_handle_write(grpc_exec_ctx *exec_ctx, void *arg /* grpc_tcp */,
@@ -135,7 +162,8 @@ static void run_poller(grpc_exec_ctx *exec_ctx, void *bp,
     gpr_log(GPR_DEBUG, "BACKUP_POLLER:%p run", p);
   }
   gpr_mu_lock(p->pollset_mu);
-  grpc_millis deadline = grpc_exec_ctx_now(exec_ctx) + 13 * GPR_MS_PER_SEC;
+  grpc_millis deadline =
+      grpc_exec_ctx_now_coarse(exec_ctx) + 13 * GPR_MS_PER_SEC;
   GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS(exec_ctx);
   GRPC_LOG_IF_ERROR(
       "backup_poller:pollset_work",
@@ -296,12 +324,18 @@ static void tcp_shutdown(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
 }
 
 static void tcp_free(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
-  grpc_fd_orphan(exec_ctx, tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
-                 false /* already_closed */, "tcp_unref_orphan");
+  grpc_fd *em_fd = tcp->em_fd;
+  grpc_closure *release_fd_cb = tcp->release_fd_cb;
+  int *release_fd = tcp->release_fd;
   grpc_slice_buffer_destroy_internal(exec_ctx, &tcp->last_read_buffer);
   grpc_resource_user_unref(exec_ctx, tcp->resource_user);
+  gpr_mu_destroy(&tcp->read_mu);
   gpr_free(tcp->peer_string);
-  gpr_free(tcp);
+  if (!gpr_obj_cache_put(g_tcp_cache, tcp)) {
+    gpr_free(tcp);
+  }
+  grpc_fd_orphan(exec_ctx, em_fd, release_fd_cb, release_fd,
+                 false /* already_closed */, "tcp_unref_orphan");
 }
 
 #ifndef NDEBUG
@@ -347,6 +381,8 @@ static void tcp_destroy(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep) {
   grpc_network_status_unregister_endpoint(ep);
   grpc_tcp *tcp = (grpc_tcp *)ep;
   grpc_slice_buffer_reset_and_unref_internal(exec_ctx, &tcp->last_read_buffer);
+  /* cancels the read reclaimer, which holds a ref */
+  grpc_resource_user_shutdown(exec_ctx, tcp->resource_user);
   TCP_UNREF(exec_ctx, tcp, "destroy");
 }
 
@@ -373,6 +409,41 @@ static void call_read_cb(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp,
   GRPC_CLOSURE_RUN(exec_ctx, cb, error);
 }
 
+/* Under memory pressure, drop the read buffer of a connection that is waiting
+   for its peer: it is reallocated once the fd is readable again */
+static void tcp_reclaim_read_buffer(grpc_exec_ctx *exec_ctx, void *arg,
+                                    grpc_error *error) {
+  grpc_tcp *tcp = (grpc_tcp *)arg;
+  gpr_mu_lock(&tcp->read_mu);
+  tcp->read_reclaimer_posted = false;
+  if (error == GRPC_ERROR_NONE && tcp->waiting_for_readable) {
+    if (GRPC_TRACER_ON(grpc_tcp_trace)) {
+      gpr_log(GPR_DEBUG, "TCP:%p reclaim %" PRIuPTR " bytes of read buffer",
+              tcp, tcp->incoming_buffer->length);
+    }
+    grpc_slice_buffer_reset_and_unref_internal(exec_ctx, tcp->incoming_buffer);
+  }
+  gpr_mu_unlock(&tcp->read_mu);
+  if (error == GRPC_ERROR_NONE) {
+    grpc_resource_user_finish_reclamation(exec_ctx, tcp->resource_user);
+  }
+  TCP_UNREF(exec_ctx, tcp, "read_reclaimer");
+}
+
+static void wait_for_readable(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
+  gpr_mu_lock(&tcp->read_mu);
+  tcp->waiting_for_readable = true;
+  bool post_reclaimer = !tcp->read_reclaimer_posted;
+  tcp->read_reclaimer_posted = true;
+  gpr_mu_unlock(&tcp->read_mu);
+  if (post_reclaimer) {
+    TCP_REF(tcp, "read_reclaimer");
+    grpc_resource_user_post_cache_reclaimer(exec_ctx, tcp->resource_user,
+                                            &tcp->read_reclaimer_closure);
+  }
+  notify_on_read(exec_ctx, tcp);
+}
+
 #define MAX_READ_IOVEC 4
 static void tcp_do_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
   struct msghdr msg;
@@ -413,7 +484,7 @@ static void tcp_do_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
     if (errno == EAGAIN) {
       finish_estimate(tcp);
       /* We've consumed the edge, request a new one */
-      notify_on_read(exec_ctx, tcp);
+      wait_for_readable(exec_ctx, tcp);
     } else {
       grpc_slice_buffer_reset_and_unref_internal(exec_ctx,
                                                  tcp->incoming_buffer);
@@ -489,6 +560,9 @@ static void tcp_handle_read(grpc_exec_ctx *exec_ctx, void *arg /* grpc_tcp */,
   if (GRPC_TRACER_ON(grpc_tcp_trace)) {
     gpr_log(GPR_DEBUG, "TCP:%p got_read: %s", tcp, grpc_error_string(error));
   }
+  gpr_mu_lock(&tcp->read_mu);
+  tcp->waiting_for_readable = false;
+  gpr_mu_unlock(&tcp->read_mu);
 
   if (error != GRPC_ERROR_NONE) {
     grpc_slice_buffer_reset_and_unref_internal(exec_ctx, tcp->incoming_buffer);
@@ -572,7 +646,9 @@ static bool tcp_flush(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp,
     GPR_TIMER_END("sendmsg", 0);
 
     if (sent_length < 0) {
-      if (errno == EAGAIN) {
+      /* the first write of a TCP Fast Open connect (which sends the SYN)
+         fails with EINPROGRESS if none of its data fit in the SYN */
+      if (errno == EAGAIN || errno == EINPROGRESS) {
         tcp->outgoing_slice_idx = unwind_slice_idx;
         tcp->outgoing_byte_idx = unwind_byte_idx;
         return false;
@@ -732,6 +808,7 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
+  int tcp_notsent_lowat = 0;
   grpc_resource_quota *resource_quota = grpc_resource_quota_create(NULL);
   if (channel_args != NULL) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
@@ -753,6 +830,11 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
                                         MAX_CHUNK_SIZE};
         tcp_max_read_chunk_size =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_NOTSENT_LOWAT)) {
+        grpc_integer_options options = {0, 0, INT_MAX};
+        tcp_notsent_lowat =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
       } else if (0 ==
                  strcmp(channel_args->args[i].key, GRPC_ARG_RESOURCE_QUOTA)) {
         grpc_resource_quota_unref_internal(exec_ctx, resource_quota);
@@ -768,7 +850,22 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
   tcp_read_chunk_size = GPR_CLAMP(tcp_read_chunk_size, tcp_min_read_chunk_size,
                                   tcp_max_read_chunk_size);
 
-  grpc_tcp *tcp = (grpc_tcp *)gpr_malloc(sizeof(grpc_tcp));
+  if (tcp_notsent_lowat > 0) {
+    /* only an optimization: without it, writes just queue deeper in the
+       kernel (and it is unavailable on unix sockets) */
+    grpc_error *lowat_err = grpc_set_socket_tcp_notsent_lowat(
+        grpc_fd_wrapped_fd(em_fd), tcp_notsent_lowat);
+    if (lowat_err != GRPC_ERROR_NONE && GRPC_TRACER_ON(grpc_tcp_trace)) {
+      gpr_log(GPR_DEBUG, "TCP_NOTSENT_LOWAT unavailable: %s",
+              grpc_error_string(lowat_err));
+    }
+    GRPC_ERROR_UNREF(lowat_err);
+  }
+
+  grpc_tcp *tcp = (grpc_tcp *)gpr_obj_cache_get(g_tcp_cache);
+  if (tcp == NULL) {
+    tcp = (grpc_tcp *)gpr_malloc(sizeof(grpc_tcp));
+  }
   tcp->base.vtable = &vtable;
   tcp->peer_string = gpr_strdup(peer_string);
   tcp->fd = grpc_fd_wrapped_fd(em_fd);
@@ -790,6 +887,11 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
   tcp->resource_user = grpc_resource_user_create(resource_quota, peer_string);
   grpc_resource_user_slice_allocator_init(
       &tcp->slice_allocator, tcp->resource_user, tcp_read_allocation_done, tcp);
+  gpr_mu_init(&tcp->read_mu);
+  tcp->waiting_for_readable = false;
+  tcp->read_reclaimer_posted = false;
+  GRPC_CLOSURE_INIT(&tcp->read_reclaimer_closure, tcp_reclaim_read_buffer, tcp,
+                    grpc_schedule_on_exec_ctx);
   /* Tell network status tracker about new endpoint */
   grpc_network_status_register_endpoint(&tcp->base);
   grpc_resource_quota_unref_internal(exec_ctx, resource_quota);
@@ -811,6 +913,7 @@ void grpc_tcp_destroy_and_release_fd(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
   tcp->release_fd = fd;
   tcp->release_fd_cb = done;
   grpc_slice_buffer_reset_and_unref_internal(exec_ctx, &tcp->last_read_buffer);
+  grpc_resource_user_shutdown(exec_ctx, tcp->resource_user);
   TCP_UNREF(exec_ctx, tcp, "destroy");
 }
 
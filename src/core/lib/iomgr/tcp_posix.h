@@ -39,6 +39,9 @@ extern "C" {
 
 extern grpc_tracer_flag grpc_tcp_trace;
 
+void grpc_tcp_posix_init(void);
+void grpc_tcp_posix_shutdown(void);
+
 /* Create a tcp endpoint given a file desciptor and a read slice size.
    Takes ownership of fd. */
 grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *fd,
@@ -72,6 +72,8 @@ struct grpc_tcp_server {
   bool so_reuseport;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs;
+  /* TCP_FASTOPEN queue length for listeners, or 0 to not use fast open */
+  int tcp_fastopen_queue_length;
 
   /* linked list of server ports */
   grpc_tcp_listener *head;
@@ -117,7 +119,9 @@ grpc_error *grpc_tcp_server_add_all_local_addrs(grpc_tcp_server *s,
 /* Prepare a recently-created socket for listening. */
 grpc_error *grpc_tcp_server_prepare_socket(int fd,
                                            const grpc_resolved_address *addr,
-                                           bool so_reuseport, int *port);
+                                           bool so_reuseport,
+                                           int tcp_fastopen_queue_length,
+                                           int *port);
 /* Ruturn true if the platform supports ifaddrs */
 bool grpc_tcp_server_have_ifaddrs(void);
 
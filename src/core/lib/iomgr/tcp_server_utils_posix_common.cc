@@ -84,8 +84,8 @@ static grpc_error *add_socket_to_server(grpc_tcp_server *s, int fd,
   char *addr_str;
   char *name;
 
-  grpc_error *err =
-      grpc_tcp_server_prepare_socket(fd, addr, s->so_reuseport, &port);
+  grpc_error *err = grpc_tcp_server_prepare_socket(
+      fd, addr, s->so_reuseport, s->tcp_fastopen_queue_length, &port);
   if (err == GRPC_ERROR_NONE) {
     GPR_ASSERT(port > 0);
     grpc_sockaddr_to_string(&addr_str, addr, 1);
@@ -144,7 +144,9 @@ grpc_error *grpc_tcp_server_add_addr(grpc_tcp_server *s,
 /* Prepare a recently-created socket for listening. */
 grpc_error *grpc_tcp_server_prepare_socket(int fd,
                                            const grpc_resolved_address *addr,
-                                           bool so_reuseport, int *port) {
+                                           bool so_reuseport,
+                                           int tcp_fastopen_queue_length,
+                                           int *port) {
   grpc_resolved_address sockname_temp;
   grpc_error *err = GRPC_ERROR_NONE;
 
@@ -174,6 +176,13 @@ grpc_error *grpc_tcp_server_prepare_socket(int fd,
     goto error;
   }
 
+  if (tcp_fastopen_queue_length > 0 && !grpc_is_unix_socket(addr)) {
+    /* only an optimization: without it, the listener accepts as usual */
+    GRPC_LOG_IF_ERROR(
+        "tcp_fastopen",
+        grpc_set_socket_tcp_fastopen(fd, tcp_fastopen_queue_length));
+  }
+
   if (listen(fd, get_max_accept_queue_size()) < 0) {
     err = GRPC_OS_ERROR(errno, "listen");
     goto error;
@@ -47,6 +47,21 @@ typedef struct grpc_timer grpc_timer;
 void grpc_timer_init(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
                      grpc_millis deadline, grpc_closure *closure);
 
+/* Like grpc_timer_init, for timers that may fire up to slack milliseconds
+   after deadline. The deadline is moved later, to a multiple of the largest
+   power of two milliseconds within the slack (at most GRPC_TIMER_MAX_SLACK),
+   so that timers armed around the same time fire in one wakeup. */
+void grpc_timer_init_with_slack(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
+                                grpc_millis deadline, grpc_millis slack,
+                                grpc_closure *closure);
+
+/* Largest step deadlines are rounded to for slack */
+#define GRPC_TIMER_MAX_SLACK 1024
+
+/* Slack for periodic housekeeping timers (keepalive, connection age,
+   reconnect backoff) armed interval from now: an eighth of the interval */
+#define GRPC_TIMER_SLACK_FOR_INTERVAL(interval) ((interval) / 8)
+
 /* Initialize *timer without setting it. This can later be passed through
    the regular init or cancel */
 void grpc_timer_init_unset(grpc_timer *timer);
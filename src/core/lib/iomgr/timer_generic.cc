@@ -30,6 +30,7 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/tls.h>
 #include <grpc/support/useful.h>
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/iomgr/time_averaged_stats.h"
 #include "src/core/lib/iomgr/timer_heap.h"
@@ -345,6 +346,7 @@ void grpc_timer_init(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
     return;
   }
 
+  GRPC_STATS_INC_TIMERS_ARMED(exec_ctx);
   gpr_mu_lock(&shard->mu);
   timer->pending = true;
   grpc_millis now = grpc_exec_ctx_now(exec_ctx);
@@ -405,6 +407,21 @@ void grpc_timer_init(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
   }
 }
 
+void grpc_timer_init_with_slack(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
+                                grpc_millis deadline, grpc_millis slack,
+                                grpc_closure *closure) {
+  grpc_millis step = 1;
+  while (step * 2 <= slack && step * 2 <= GRPC_TIMER_MAX_SLACK) step *= 2;
+  if (step > 1 && deadline > 0 && deadline <= GRPC_MILLIS_INF_FUTURE - step) {
+    grpc_millis rounded = (deadline + step - 1) & ~(step - 1);
+    if (rounded != deadline) {
+      GRPC_STATS_INC_TIMERS_SLACK_ROUNDED(exec_ctx);
+      deadline = rounded;
+    }
+  }
+  grpc_timer_init(exec_ctx, timer, deadline, closure);
+}
+
 void grpc_timer_consume_kick(void) {
   /* force re-evaluation of last seeen min */
   gpr_tls_set(&g_last_seen_min_timer, 0);
@@ -425,6 +442,7 @@ void grpc_timer_cancel(grpc_exec_ctx *exec_ctx, grpc_timer *timer) {
 
   if (timer->pending) {
     REMOVE_FROM_HASH_TABLE(timer);
+    GRPC_STATS_INC_TIMERS_CANCELLED(exec_ctx);
 
     GRPC_CLOSURE_SCHED(exec_ctx, timer->closure, GRPC_ERROR_CANCELLED);
     timer->pending = false;
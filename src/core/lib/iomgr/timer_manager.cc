@@ -25,6 +25,7 @@
 
 #include <inttypes.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/iomgr/timer.h"
 
@@ -195,6 +196,7 @@ static bool wait_until(grpc_exec_ctx *exec_ctx, grpc_millis next) {
 
     gpr_cv_wait(&g_cv_wait, &g_mu,
                 grpc_millis_to_timespec(next, GPR_CLOCK_REALTIME));
+    GRPC_STATS_INC_TIMER_MANAGER_WAKEUPS(exec_ctx);
 
     if (GRPC_TRACER_ON(grpc_timer_check_trace)) {
       gpr_log(GPR_DEBUG, "wait ended: was_timed:%d kicked:%d",
@@ -78,6 +78,14 @@ void grpc_timer_init(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
   uv_unref((uv_handle_t *)uv_timer);
 }
 
+/* Every libuv timer is its own handle on the loop, so there is nothing to
+   batch slack timers with */
+void grpc_timer_init_with_slack(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
+                                grpc_millis deadline, grpc_millis slack,
+                                grpc_closure *closure) {
+  grpc_timer_init(exec_ctx, timer, deadline, closure);
+}
+
 void grpc_timer_init_unset(grpc_timer *timer) { timer->pending = 0; }
 
 void grpc_timer_cancel(grpc_exec_ctx *exec_ctx, grpc_timer *timer) {
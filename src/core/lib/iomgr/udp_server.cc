@@ -32,10 +32,12 @@
 #include <limits.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <grpc/grpc.h>
@@ -44,9 +46,11 @@
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
+#include <grpc/support/useful.h>
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/sockaddr.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
@@ -55,6 +59,37 @@
 #include "src/core/lib/iomgr/unix_sockets_posix.h"
 #include "src/core/lib/support/string.h"
 
+#define DEFAULT_BATCH_SIZE 32
+#define MAX_BATCH_SIZE 1024
+/* batches read from a port before giving other fds a turn */
+#define MAX_BATCHES_PER_READ 4
+#define DEFAULT_MAX_DATAGRAM_SIZE 2048
+#define MAX_DATAGRAM_SIZE 65536
+/* room for the pktinfo and GRO control messages of one datagram */
+#define RECV_CONTROL_SIZE 128
+#define SEND_BATCH_SIZE 64
+
+#ifdef GRPC_LINUX_MMSG
+typedef struct mmsghdr udp_msg;
+#else
+typedef struct {
+  struct msghdr msg_hdr;
+  unsigned msg_len;
+} udp_msg;
+#endif
+
+/* receive buffers of a batched port, reused for every batch */
+typedef struct {
+  size_t batch_size;
+  size_t buffer_size;
+  bool gro;
+  uint8_t *buffers;
+  char *control;
+  struct iovec *iovs;
+  udp_msg *msgs;
+  grpc_udp_datagram *datagrams;
+} udp_recv_pool;
+
 /* one listening port */
 typedef struct grpc_udp_listener grpc_udp_listener;
 struct grpc_udp_listener {
@@ -63,6 +98,8 @@ struct grpc_udp_listener {
   grpc_udp_server *server;
   grpc_resolved_address addr;
   grpc_closure read_closure;
+  // Continues reading a busy batched port from the executor.
+  grpc_closure read_more_closure;
   grpc_closure write_closure;
   // To be called when corresponding QuicGrpcServer closes all active
   // connections.
@@ -71,6 +108,9 @@ struct grpc_udp_listener {
   grpc_udp_server_read_cb read_cb;
   grpc_udp_server_write_cb write_cb;
   grpc_udp_server_orphan_cb orphan_cb;
+  // Set instead of read_cb for batched ports.
+  grpc_udp_server_batch_read_cb batch_read_cb;
+  udp_recv_pool *recv_pool;
   // True if orphan_cb is trigered.
   bool orphan_notified;
 
@@ -111,6 +151,11 @@ struct grpc_udp_server {
   size_t pollset_count;
   /* opaque object to pass to callbacks */
   void *user_data;
+
+  /* configuration of batched ports */
+  size_t batch_size;
+  size_t max_datagram_size;
+  bool gro;
 };
 
 static grpc_socket_factory *get_socket_factory(const grpc_channel_args *args) {
@@ -127,6 +172,24 @@ static grpc_socket_factory *get_socket_factory(const grpc_channel_args *args) {
 grpc_udp_server *grpc_udp_server_create(const grpc_channel_args *args) {
   grpc_udp_server *s = (grpc_udp_server *)gpr_malloc(sizeof(grpc_udp_server));
   gpr_mu_init(&s->mu);
+  s->batch_size = DEFAULT_BATCH_SIZE;
+  s->max_datagram_size = DEFAULT_MAX_DATAGRAM_SIZE;
+  s->gro = false;
+  for (size_t i = 0; args != NULL && i < args->num_args; i++) {
+    if (0 == strcmp(args->args[i].key, GRPC_ARG_UDP_BATCH_SIZE)) {
+      grpc_integer_options options = {DEFAULT_BATCH_SIZE, 1, MAX_BATCH_SIZE};
+      s->batch_size =
+          (size_t)grpc_channel_arg_get_integer(&args->args[i], options);
+    } else if (0 ==
+               strcmp(args->args[i].key, GRPC_ARG_UDP_MAX_DATAGRAM_SIZE)) {
+      grpc_integer_options options = {DEFAULT_MAX_DATAGRAM_SIZE, 1,
+                                      MAX_DATAGRAM_SIZE};
+      s->max_datagram_size =
+          (size_t)grpc_channel_arg_get_integer(&args->args[i], options);
+    } else if (0 == strcmp(args->args[i].key, GRPC_ARG_UDP_GRO)) {
+      s->gro = grpc_channel_arg_get_bool(&args->args[i], false);
+    }
+  }
   s->socket_factory = get_socket_factory(args);
   if (s->socket_factory) {
     grpc_socket_factory_ref(s->socket_factory);
@@ -154,6 +217,38 @@ static void dummy_cb(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
   // No-op.
 }
 
+static udp_recv_pool *recv_pool_create(size_t batch_size, size_t buffer_size,
+                                       bool gro) {
+  udp_recv_pool *pool = (udp_recv_pool *)gpr_malloc(sizeof(*pool));
+  pool->batch_size = batch_size;
+  pool->buffer_size = buffer_size;
+  pool->gro = gro;
+  pool->buffers = (uint8_t *)gpr_malloc(batch_size * buffer_size);
+  pool->control =
+      gro ? (char *)gpr_malloc(batch_size * RECV_CONTROL_SIZE) : NULL;
+  pool->iovs = (struct iovec *)gpr_malloc(batch_size * sizeof(*pool->iovs));
+  pool->msgs = (udp_msg *)gpr_zalloc(batch_size * sizeof(*pool->msgs));
+  pool->datagrams = (grpc_udp_datagram *)gpr_malloc(
+      batch_size * sizeof(*pool->datagrams));
+  for (size_t i = 0; i < batch_size; i++) {
+    pool->iovs[i].iov_base = pool->buffers + i * buffer_size;
+    pool->iovs[i].iov_len = buffer_size;
+    pool->msgs[i].msg_hdr.msg_iov = &pool->iovs[i];
+    pool->msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  return pool;
+}
+
+static void recv_pool_destroy(udp_recv_pool *pool) {
+  if (pool == NULL) return;
+  gpr_free(pool->buffers);
+  gpr_free(pool->control);
+  gpr_free(pool->iovs);
+  gpr_free(pool->msgs);
+  gpr_free(pool->datagrams);
+  gpr_free(pool);
+}
+
 static void finish_shutdown(grpc_exec_ctx *exec_ctx, grpc_udp_server *s) {
   if (s->shutdown_complete != NULL) {
     GRPC_CLOSURE_SCHED(exec_ctx, s->shutdown_complete, GRPC_ERROR_NONE);
@@ -164,6 +259,7 @@ static void finish_shutdown(grpc_exec_ctx *exec_ctx, grpc_udp_server *s) {
   while (s->head) {
     grpc_udp_listener *sp = s->head;
     s->head = sp->next;
+    recv_pool_destroy(sp->recv_pool);
     gpr_free(sp);
   }
 
@@ -330,6 +426,93 @@ error:
   return -1;
 }
 
+/* Read up to batch_size datagrams into pool; returns the number read, or -1
+   with errno set */
+static int recv_batch(int fd, udp_recv_pool *pool) {
+  for (size_t i = 0; i < pool->batch_size; i++) {
+    struct msghdr *hdr = &pool->msgs[i].msg_hdr;
+    hdr->msg_name = pool->datagrams[i].addr.addr;
+    hdr->msg_namelen = sizeof(pool->datagrams[i].addr.addr);
+    /* control messages are only looked at for GRO: skip the pktinfo ones */
+    if (pool->gro) {
+      hdr->msg_control = pool->control + i * RECV_CONTROL_SIZE;
+      hdr->msg_controllen = RECV_CONTROL_SIZE;
+    }
+    hdr->msg_flags = 0;
+  }
+  int n;
+#ifdef GRPC_LINUX_MMSG
+  do {
+    n = recvmmsg(fd, pool->msgs, (unsigned)pool->batch_size, 0, NULL);
+  } while (n < 0 && errno == EINTR);
+#else
+  for (n = 0; (size_t)n < pool->batch_size; n++) {
+    ssize_t r;
+    do {
+      r = recvmsg(fd, &pool->msgs[n].msg_hdr, 0);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) {
+      if (n == 0) n = -1;
+      break;
+    }
+    pool->msgs[n].msg_len = (unsigned)r;
+  }
+#endif
+  return n;
+}
+
+static size_t gro_segment_size(struct msghdr *hdr) {
+#if defined(SOL_UDP) && defined(UDP_GRO)
+  for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg != NULL;
+       cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+      int segment_size;
+      memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return (size_t)segment_size;
+    }
+  }
+#endif
+  return 0;
+}
+
+/* Drain the socket of a batched port, one batch per callback */
+/* Returns true if the socket may still hold datagrams after
+   MAX_BATCHES_PER_READ full batches */
+static bool read_batches(grpc_exec_ctx *exec_ctx, grpc_udp_listener *sp) {
+  udp_recv_pool *pool = sp->recv_pool;
+  for (int batches = 0; batches < MAX_BATCHES_PER_READ; batches++) {
+    int n = recv_batch(sp->fd, pool);
+    if (n < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        gpr_log(GPR_ERROR, "recvmmsg: %s", strerror(errno));
+      }
+      return false;
+    }
+    size_t count = 0;
+    for (int i = 0; i < n; i++) {
+      struct msghdr *hdr = &pool->msgs[i].msg_hdr;
+      /* drop datagrams that did not fit the buffer */
+      if (hdr->msg_flags & MSG_TRUNC) continue;
+      grpc_udp_datagram *d = &pool->datagrams[count];
+      if (count != (size_t)i) {
+        memcpy(d->addr.addr, hdr->msg_name, hdr->msg_namelen);
+      }
+      d->addr.len = hdr->msg_namelen;
+      d->data = (uint8_t *)pool->iovs[i].iov_base;
+      d->length = pool->msgs[i].msg_len;
+      d->segment_size = pool->gro ? gro_segment_size(hdr) : 0;
+      count++;
+    }
+    if (count > 0) {
+      sp->batch_read_cb(exec_ctx, sp->emfd, pool->datagrams, count,
+                        sp->server->user_data);
+    }
+    /* a short batch means the socket was drained */
+    if ((size_t)n < pool->batch_size) return false;
+  }
+  return true;
+}
+
 /* event manager callback when reads are ready */
 static void on_read(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
   grpc_udp_listener *sp = (grpc_udp_listener *)arg;
@@ -345,9 +528,25 @@ static void on_read(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
     return;
   }
 
-  /* Tell the registered callback that data is available to read. */
-  GPR_ASSERT(sp->read_cb);
-  sp->read_cb(exec_ctx, sp->emfd, sp->server->user_data);
+  if (sp->batch_read_cb != NULL) {
+    if (read_batches(exec_ctx, sp)) {
+      /* More datagrams may be queued, and an edge triggered poller will not
+         report them again until another one arrives: carry on from the
+         executor, so that this poller can get back to the other fds, and
+         re-arm once the socket is drained. */
+      GRPC_CLOSURE_SCHED(
+          exec_ctx,
+          GRPC_CLOSURE_INIT(&sp->read_more_closure, on_read, sp,
+                            grpc_executor_scheduler(GRPC_EXECUTOR_SHORT)),
+          GRPC_ERROR_NONE);
+      gpr_mu_unlock(&sp->server->mu);
+      return;
+    }
+  } else {
+    /* Tell the registered callback that data is available to read. */
+    GPR_ASSERT(sp->read_cb);
+    sp->read_cb(exec_ctx, sp->emfd, sp->server->user_data);
+  }
 
   /* Re-arm the notification event so we get another chance to read. */
   grpc_fd_notify_on_read(exec_ctx, sp->emfd, &sp->read_closure);
@@ -377,9 +576,26 @@ static void on_write(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
   gpr_mu_unlock(&sp->server->mu);
 }
 
+/* Create the receive buffers of a batched port, enabling GRO if asked to */
+static udp_recv_pool *create_recv_pool(grpc_udp_server *s, int fd) {
+  bool gro = false;
+#if defined(SOL_UDP) && defined(UDP_GRO)
+  if (s->gro) {
+    int one = 1;
+    gro = 0 == setsockopt(fd, SOL_UDP, UDP_GRO, &one, sizeof(one));
+    if (!gro) {
+      gpr_log(GPR_DEBUG, "UDP_GRO not available: %s", strerror(errno));
+    }
+  }
+#endif
+  return recv_pool_create(s->batch_size,
+                          gro ? MAX_DATAGRAM_SIZE : s->max_datagram_size, gro);
+}
+
 static int add_socket_to_server(grpc_udp_server *s, int fd,
                                 const grpc_resolved_address *addr,
                                 grpc_udp_server_read_cb read_cb,
+                                grpc_udp_server_batch_read_cb batch_read_cb,
                                 grpc_udp_server_write_cb write_cb,
                                 grpc_udp_server_orphan_cb orphan_cb) {
   grpc_udp_listener *sp;
@@ -409,6 +625,8 @@ static int add_socket_to_server(grpc_udp_server *s, int fd,
     sp->read_cb = read_cb;
     sp->write_cb = write_cb;
     sp->orphan_cb = orphan_cb;
+    sp->batch_read_cb = batch_read_cb;
+    sp->recv_pool = batch_read_cb != NULL ? create_recv_pool(s, fd) : NULL;
     sp->orphan_notified = false;
     GPR_ASSERT(sp->emfd);
     gpr_mu_unlock(&s->mu);
@@ -418,11 +636,11 @@ static int add_socket_to_server(grpc_udp_server *s, int fd,
   return port;
 }
 
-int grpc_udp_server_add_port(grpc_udp_server *s,
-                             const grpc_resolved_address *addr,
-                             grpc_udp_server_read_cb read_cb,
-                             grpc_udp_server_write_cb write_cb,
-                             grpc_udp_server_orphan_cb orphan_cb) {
+static int add_port(grpc_udp_server *s, const grpc_resolved_address *addr,
+                    grpc_udp_server_read_cb read_cb,
+                    grpc_udp_server_batch_read_cb batch_read_cb,
+                    grpc_udp_server_write_cb write_cb,
+                    grpc_udp_server_orphan_cb orphan_cb) {
   grpc_udp_listener *sp;
   int allocated_port1 = -1;
   int allocated_port2 = -1;
@@ -469,8 +687,8 @@ int grpc_udp_server_add_port(grpc_udp_server *s,
     // TODO(rjshade): Test and propagate the returned grpc_error*:
     GRPC_ERROR_UNREF(grpc_create_dualstack_socket_using_factory(
         s->socket_factory, addr, SOCK_DGRAM, IPPROTO_UDP, &dsmode, &fd));
-    allocated_port1 =
-        add_socket_to_server(s, fd, addr, read_cb, write_cb, orphan_cb);
+    allocated_port1 = add_socket_to_server(s, fd, addr, read_cb, batch_read_cb,
+                                           write_cb, orphan_cb);
     if (fd >= 0 && dsmode == GRPC_DSMODE_DUALSTACK) {
       goto done;
     }
@@ -492,14 +710,101 @@ int grpc_udp_server_add_port(grpc_udp_server *s,
       grpc_sockaddr_is_v4mapped(addr, &addr4_copy)) {
     addr = &addr4_copy;
   }
-  allocated_port2 =
-      add_socket_to_server(s, fd, addr, read_cb, write_cb, orphan_cb);
+  allocated_port2 = add_socket_to_server(s, fd, addr, read_cb, batch_read_cb,
+                                         write_cb, orphan_cb);
 
 done:
   gpr_free(allocated_addr);
   return allocated_port1 >= 0 ? allocated_port1 : allocated_port2;
 }
 
+int grpc_udp_server_add_port(grpc_udp_server *s,
+                             const grpc_resolved_address *addr,
+                             grpc_udp_server_read_cb read_cb,
+                             grpc_udp_server_write_cb write_cb,
+                             grpc_udp_server_orphan_cb orphan_cb) {
+  return add_port(s, addr, read_cb, NULL, write_cb, orphan_cb);
+}
+
+int grpc_udp_server_add_batched_port(grpc_udp_server *s,
+                                     const grpc_resolved_address *addr,
+                                     grpc_udp_server_batch_read_cb read_cb,
+                                     grpc_udp_server_write_cb write_cb,
+                                     grpc_udp_server_orphan_cb orphan_cb) {
+  GPR_ASSERT(read_cb != NULL);
+  return add_port(s, addr, NULL, read_cb, write_cb, orphan_cb);
+}
+
+/* Send up to n datagrams; returns the number sent, or -1 with errno set */
+static int send_msgs(int fd, udp_msg *msgs, size_t n) {
+  int sent;
+#ifdef GRPC_LINUX_MMSG
+  do {
+    sent = sendmmsg(fd, msgs, (unsigned)n, 0);
+  } while (sent < 0 && errno == EINTR);
+#else
+  for (sent = 0; (size_t)sent < n; sent++) {
+    ssize_t r;
+    do {
+      r = sendmsg(fd, &msgs[sent].msg_hdr, 0);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) {
+      if (sent == 0) sent = -1;
+      break;
+    }
+  }
+#endif
+  return sent;
+}
+
+grpc_error *grpc_udp_send_batch(int fd, const grpc_udp_datagram *datagrams,
+                                size_t count, size_t *sent) {
+  udp_msg msgs[SEND_BATCH_SIZE];
+  struct iovec iovs[SEND_BATCH_SIZE];
+#if defined(SOL_UDP) && defined(UDP_SEGMENT)
+  char control[SEND_BATCH_SIZE][CMSG_SPACE(sizeof(uint16_t))];
+#endif
+  *sent = 0;
+  while (*sent < count) {
+    size_t n = GPR_MIN(count - *sent, SEND_BATCH_SIZE);
+    memset(msgs, 0, n * sizeof(*msgs));
+    for (size_t i = 0; i < n; i++) {
+      const grpc_udp_datagram *d = &datagrams[*sent + i];
+      struct msghdr *hdr = &msgs[i].msg_hdr;
+      iovs[i].iov_base = d->data;
+      iovs[i].iov_len = d->length;
+      hdr->msg_iov = &iovs[i];
+      hdr->msg_iovlen = 1;
+      if (d->addr.len > 0) {
+        hdr->msg_name = (void *)d->addr.addr;
+        hdr->msg_namelen = (socklen_t)d->addr.len;
+      }
+      if (d->segment_size > 0 && d->segment_size < d->length) {
+#if defined(SOL_UDP) && defined(UDP_SEGMENT)
+        hdr->msg_control = control[i];
+        hdr->msg_controllen = sizeof(control[i]);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        uint16_t segment_size = (uint16_t)d->segment_size;
+        memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+#else
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "UDP segmentation offload not supported");
+#endif
+      }
+    }
+    int r = send_msgs(fd, msgs, n);
+    if (r < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return GRPC_ERROR_NONE;
+      return GRPC_OS_ERROR(errno, "sendmmsg");
+    }
+    *sent += (size_t)r;
+  }
+  return GRPC_ERROR_NONE;
+}
+
 int grpc_udp_server_get_fd(grpc_udp_server *s, unsigned port_index) {
   grpc_udp_listener *sp;
   if (port_index >= s->nports) {
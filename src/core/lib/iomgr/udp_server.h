@@ -42,12 +42,47 @@ typedef void (*grpc_udp_server_read_cb)(grpc_exec_ctx *exec_ctx, grpc_fd *emfd,
 typedef void (*grpc_udp_server_write_cb)(grpc_exec_ctx *exec_ctx, grpc_fd *emfd,
                                          void *user_data);
 
+/* A datagram, as delivered to grpc_udp_server_batch_read_cb or passed to
+   grpc_udp_send_batch */
+typedef struct {
+  uint8_t *data;
+  size_t length;
+  /* Source address of a received datagram, destination of a sent one */
+  grpc_resolved_address addr;
+  /* If non-zero, data holds several datagrams of segment_size bytes each
+     (the last one may be shorter): set on receive when the kernel coalesced
+     datagrams (GRPC_ARG_UDP_GRO), and requests segmentation offload (GSO) on
+     send */
+  size_t segment_size;
+} grpc_udp_datagram;
+
+/* Called with a batch of datagrams read from the socket. The datagrams point
+   into buffers owned by the server that are reused for the next batch: they
+   are only valid for the duration of the call. */
+typedef void (*grpc_udp_server_batch_read_cb)(grpc_exec_ctx *exec_ctx,
+                                              grpc_fd *emfd,
+                                              grpc_udp_datagram *datagrams,
+                                              size_t count, void *user_data);
+
 /* Called when the grpc_fd is about to be orphaned (and the FD closed). */
 typedef void (*grpc_udp_server_orphan_cb)(grpc_exec_ctx *exec_ctx,
                                           grpc_fd *emfd,
                                           grpc_closure *shutdown_fd_callback,
                                           void *user_data);
 
+/* Channel args configuring ports added with
+   grpc_udp_server_add_batched_port */
+
+/** Maximum number of datagrams read per batch (default 32) */
+#define GRPC_ARG_UDP_BATCH_SIZE "grpc.udp.batch_size"
+/** Size of each pooled receive buffer; longer datagrams are dropped
+    (default 2048) */
+#define GRPC_ARG_UDP_MAX_DATAGRAM_SIZE "grpc.udp.max_datagram_size"
+/** If non-zero, let the kernel coalesce datagrams from the same peer into
+    one receive buffer (UDP_GRO), growing the buffers to 64KiB. Ignored where
+    unsupported. */
+#define GRPC_ARG_UDP_GRO "grpc.udp.gro"
+
 /* Create a server, initially not bound to any ports */
 grpc_udp_server *grpc_udp_server_create(const grpc_channel_args *args);
 
@@ -74,6 +109,22 @@ int grpc_udp_server_add_port(grpc_udp_server *s,
                              grpc_udp_server_write_cb write_cb,
                              grpc_udp_server_orphan_cb orphan_cb);
 
+/* Like grpc_udp_server_add_port, but the port's readable events are
+   consumed by the server, which reads all queued datagrams in batches
+   (recvmmsg where available) and hands each batch to read_cb. */
+int grpc_udp_server_add_batched_port(grpc_udp_server *s,
+                                     const grpc_resolved_address *addr,
+                                     grpc_udp_server_batch_read_cb read_cb,
+                                     grpc_udp_server_write_cb write_cb,
+                                     grpc_udp_server_orphan_cb orphan_cb);
+
+/* Send datagrams on the (non-blocking) socket fd with as few syscalls as
+   possible (sendmmsg where available). *sent is set to the number of
+   datagrams handed to the kernel: stopping short with GRPC_ERROR_NONE
+   means the socket buffer is full. */
+grpc_error *grpc_udp_send_batch(int fd, const grpc_udp_datagram *datagrams,
+                                size_t count, size_t *sent);
+
 void grpc_udp_server_destroy(grpc_exec_ctx *exec_ctx, grpc_udp_server *server,
                              grpc_closure *on_done);
 
@@ -28,6 +28,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/iomgr/resource_quota.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
@@ -52,12 +53,19 @@ typedef struct {
   grpc_slice_buffer source_buffer;
   /* saved handshaker leftover data to unprotect. */
   grpc_slice_buffer leftover_bytes;
-  /* buffers for read and write */
+  /* buffers for read and write: allocated on first use, and freed between
+     reads and writes when the resource quota is under pressure. The mutexes
+     are held while the buffers are in use. */
+  gpr_mu read_staging_mu;
   grpc_slice read_staging_buffer;
 
+  gpr_mu write_staging_mu;
   grpc_slice write_staging_buffer;
   grpc_slice_buffer output_buffer;
 
+  gpr_atm staging_reclaimer_posted;
+  grpc_closure staging_reclaimer;
+
   gpr_refcount ref;
 } secure_endpoint;
 
@@ -75,6 +83,8 @@ static void destroy(grpc_exec_ctx *exec_ctx, secure_endpoint *secure_ep) {
   grpc_slice_buffer_destroy_internal(exec_ctx, &ep->output_buffer);
   grpc_slice_buffer_destroy_internal(exec_ctx, &ep->source_buffer);
   gpr_mu_destroy(&ep->protector_mu);
+  gpr_mu_destroy(&ep->read_staging_mu);
+  gpr_mu_destroy(&ep->write_staging_mu);
   gpr_free(ep);
 }
 
@@ -121,6 +131,53 @@ static void secure_endpoint_unref(grpc_exec_ctx *exec_ctx,
 static void secure_endpoint_ref(secure_endpoint *ep) { gpr_ref(&ep->ref); }
 #endif
 
+static void ensure_staging_buffer(grpc_exec_ctx *exec_ctx,
+                                  grpc_slice *staging_buffer) {
+  if (GRPC_SLICE_LENGTH(*staging_buffer) == 0) {
+    grpc_slice_unref_internal(exec_ctx, *staging_buffer);
+    *staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
+  }
+}
+
+static void reclaim_staging_buffers(grpc_exec_ctx *exec_ctx, void *arg,
+                                    grpc_error *error) {
+  secure_endpoint *ep = (secure_endpoint *)arg;
+  gpr_atm_no_barrier_store(&ep->staging_reclaimer_posted, 0);
+  if (error == GRPC_ERROR_NONE) {
+    if (GRPC_TRACER_ON(grpc_trace_secure_endpoint)) {
+      gpr_log(GPR_DEBUG, "SECENDP %p: reclaim staging buffers", ep);
+    }
+    gpr_mu_lock(&ep->read_staging_mu);
+    grpc_slice_unref_internal(exec_ctx, ep->read_staging_buffer);
+    ep->read_staging_buffer = grpc_empty_slice();
+    gpr_mu_unlock(&ep->read_staging_mu);
+    gpr_mu_lock(&ep->write_staging_mu);
+    grpc_slice_unref_internal(exec_ctx, ep->write_staging_buffer);
+    ep->write_staging_buffer = grpc_empty_slice();
+    gpr_mu_unlock(&ep->write_staging_mu);
+    grpc_resource_user_finish_reclamation(
+        exec_ctx, grpc_endpoint_get_resource_user(ep->wrapped_ep));
+  }
+  SECURE_ENDPOINT_UNREF(exec_ctx, ep, "staging_reclaimer");
+}
+
+/* called after using a staging buffer: let the wrapped endpoint's resource
+   user free them again if memory gets tight */
+static void maybe_post_staging_reclaimer(grpc_exec_ctx *exec_ctx,
+                                         secure_endpoint *ep) {
+  if (gpr_atm_no_barrier_load(&ep->staging_reclaimer_posted) ||
+      !gpr_atm_no_barrier_cas(&ep->staging_reclaimer_posted, 0, 1)) {
+    return;
+  }
+  grpc_resource_user *resource_user =
+      grpc_endpoint_get_resource_user(ep->wrapped_ep);
+  /* without a resource user, leave the flag set and never post */
+  if (resource_user == NULL) return;
+  SECURE_ENDPOINT_REF(ep, "staging_reclaimer");
+  grpc_resource_user_post_cache_reclaimer(exec_ctx, resource_user,
+                                          &ep->staging_reclaimer);
+}
+
 static void flush_read_staging_buffer(secure_endpoint *ep, uint8_t **cur,
                                       uint8_t **end) {
   grpc_slice_buffer_add(ep->read_buffer, ep->read_staging_buffer);
@@ -151,8 +208,6 @@ static void on_read(grpc_exec_ctx *exec_ctx, void *user_data,
   uint8_t keep_looping = 0;
   tsi_result result = TSI_OK;
   secure_endpoint *ep = (secure_endpoint *)user_data;
-  uint8_t *cur = GRPC_SLICE_START_PTR(ep->read_staging_buffer);
-  uint8_t *end = GRPC_SLICE_END_PTR(ep->read_staging_buffer);
 
   if (error != GRPC_ERROR_NONE) {
     grpc_slice_buffer_reset_and_unref_internal(exec_ctx, ep->read_buffer);
@@ -167,6 +222,10 @@ static void on_read(grpc_exec_ctx *exec_ctx, void *user_data,
         exec_ctx, ep->zero_copy_protector, &ep->source_buffer, ep->read_buffer);
   } else {
     // Use frame protector to unprotect.
+    gpr_mu_lock(&ep->read_staging_mu);
+    ensure_staging_buffer(exec_ctx, &ep->read_staging_buffer);
+    uint8_t *cur = GRPC_SLICE_START_PTR(ep->read_staging_buffer);
+    uint8_t *end = GRPC_SLICE_END_PTR(ep->read_staging_buffer);
     /* TODO(yangg) check error, maybe bail out early */
     for (i = 0; i < ep->source_buffer.count; i++) {
       grpc_slice encrypted = ep->source_buffer.slices[i];
@@ -213,6 +272,8 @@ static void on_read(grpc_exec_ctx *exec_ctx, void *user_data,
               &ep->read_staging_buffer,
               (size_t)(cur - GRPC_SLICE_START_PTR(ep->read_staging_buffer))));
     }
+    gpr_mu_unlock(&ep->read_staging_mu);
+    maybe_post_staging_reclaimer(exec_ctx, ep);
   }
 
   /* TODO(yangg) experiment with moving this block after read_cb to see if it
@@ -265,8 +326,6 @@ static void endpoint_write(grpc_exec_ctx *exec_ctx, grpc_endpoint *secure_ep,
   unsigned i;
   tsi_result result = TSI_OK;
   secure_endpoint *ep = (secure_endpoint *)secure_ep;
-  uint8_t *cur = GRPC_SLICE_START_PTR(ep->write_staging_buffer);
-  uint8_t *end = GRPC_SLICE_END_PTR(ep->write_staging_buffer);
 
   grpc_slice_buffer_reset_and_unref_internal(exec_ctx, &ep->output_buffer);
 
@@ -285,6 +344,10 @@ static void endpoint_write(grpc_exec_ctx *exec_ctx, grpc_endpoint *secure_ep,
         exec_ctx, ep->zero_copy_protector, slices, &ep->output_buffer);
   } else {
     // Use frame protector to protect.
+    gpr_mu_lock(&ep->write_staging_mu);
+    ensure_staging_buffer(exec_ctx, &ep->write_staging_buffer);
+    uint8_t *cur = GRPC_SLICE_START_PTR(ep->write_staging_buffer);
+    uint8_t *end = GRPC_SLICE_END_PTR(ep->write_staging_buffer);
     for (i = 0; i < slices->count; i++) {
       grpc_slice plain = slices->slices[i];
       uint8_t *message_bytes = GRPC_SLICE_START_PTR(plain);
@@ -336,6 +399,8 @@ static void endpoint_write(grpc_exec_ctx *exec_ctx, grpc_endpoint *secure_ep,
                          GRPC_SLICE_START_PTR(ep->write_staging_buffer))));
       }
     }
+    gpr_mu_unlock(&ep->write_staging_mu);
+    maybe_post_staging_reclaimer(exec_ctx, ep);
   }
 
   if (result != TSI_OK) {
@@ -362,6 +427,12 @@ static void endpoint_shutdown(grpc_exec_ctx *exec_ctx, grpc_endpoint *secure_ep,
 static void endpoint_destroy(grpc_exec_ctx *exec_ctx,
                              grpc_endpoint *secure_ep) {
   secure_endpoint *ep = (secure_endpoint *)secure_ep;
+  grpc_resource_user *resource_user =
+      grpc_endpoint_get_resource_user(ep->wrapped_ep);
+  /* cancels the staging buffer reclaimer, which holds a ref */
+  if (resource_user != NULL) {
+    grpc_resource_user_shutdown(exec_ctx, resource_user);
+  }
   SECURE_ENDPOINT_UNREF(exec_ctx, ep, "destroy");
 }
 
@@ -421,8 +492,13 @@ grpc_endpoint *grpc_secure_endpoint_create(
     grpc_slice_buffer_add(&ep->leftover_bytes,
                           grpc_slice_ref_internal(leftover_slices[i]));
   }
-  ep->write_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
-  ep->read_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
+  gpr_mu_init(&ep->read_staging_mu);
+  ep->read_staging_buffer = grpc_empty_slice();
+  gpr_mu_init(&ep->write_staging_mu);
+  ep->write_staging_buffer = grpc_empty_slice();
+  gpr_atm_no_barrier_store(&ep->staging_reclaimer_posted, 0);
+  GRPC_CLOSURE_INIT(&ep->staging_reclaimer, reclaim_staging_buffers, ep,
+                    grpc_schedule_on_exec_ctx);
   grpc_slice_buffer_init(&ep->output_buffer);
   grpc_slice_buffer_init(&ep->source_buffer);
   ep->read_buffer = NULL;
@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/support/alloc_tags.h"
 
 char *grpc_slice_to_c_string(grpc_slice slice) {
   char *out = (char *)gpr_malloc(GRPC_SLICE_LENGTH(slice) + 1);
@@ -203,6 +204,8 @@ grpc_slice grpc_slice_from_copied_string(const char *source) {
 typedef struct {
   grpc_slice_refcount base;
   gpr_refcount refs;
+  /* size of the allocation (header + bytes), for memory accounting */
+  size_t alloc_size;
 } malloc_refcount;
 
 static void malloc_ref(void *p) {
@@ -213,7 +216,7 @@ static void malloc_ref(void *p) {
 static void malloc_unref(grpc_exec_ctx *exec_ctx, void *p) {
   malloc_refcount *r = (malloc_refcount *)p;
   if (gpr_unref(&r->refs)) {
-    gpr_free(r);
+    gpr_free_tagged(r, r->alloc_size, GPR_ALLOC_TAG_SLICE);
   }
 }
 
@@ -233,8 +236,10 @@ grpc_slice grpc_slice_malloc_large(size_t length) {
      refcount is a malloc_refcount
      bytes is an array of bytes of the requested length
      Both parts are placed in the same allocation returned from gpr_malloc */
+  size_t alloc_size = sizeof(malloc_refcount) + length;
   malloc_refcount *rc =
-      (malloc_refcount *)gpr_malloc(sizeof(malloc_refcount) + length);
+      (malloc_refcount *)gpr_malloc_tagged(alloc_size, GPR_ALLOC_TAG_SLICE);
+  rc->alloc_size = alloc_size;
 
   /* Initial refcount on rc is 1 - and it's up to the caller to release
      this reference. */
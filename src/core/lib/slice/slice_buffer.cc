@@ -26,6 +26,7 @@
 #include <grpc/support/useful.h>
 
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/support/alloc_tags.h"
 
 /* grow a buffer; requires GRPC_SLICE_BUFFER_INLINE_ELEMENTS > 1 */
 #define GROW(x) (3 * (x) / 2)
@@ -42,15 +43,17 @@ static void maybe_embiggen(grpc_slice_buffer *sb) {
       sb->slices = sb->base_slices;
     } else {
       /* Allocate more memory if no more space is available */
+      size_t old_capacity = sb->capacity;
       sb->capacity = GROW(sb->capacity);
       GPR_ASSERT(sb->capacity > slice_count);
       if (sb->base_slices == sb->inlined) {
-        sb->base_slices =
-            (grpc_slice *)gpr_malloc(sb->capacity * sizeof(grpc_slice));
+        sb->base_slices = (grpc_slice *)gpr_malloc_tagged(
+            sb->capacity * sizeof(grpc_slice), GPR_ALLOC_TAG_SLICE_BUFFER);
         memcpy(sb->base_slices, sb->inlined, slice_count * sizeof(grpc_slice));
       } else {
-        sb->base_slices = (grpc_slice *)gpr_realloc(
-            sb->base_slices, sb->capacity * sizeof(grpc_slice));
+        sb->base_slices = (grpc_slice *)gpr_realloc_tagged(
+            sb->base_slices, old_capacity * sizeof(grpc_slice),
+            sb->capacity * sizeof(grpc_slice), GPR_ALLOC_TAG_SLICE_BUFFER);
       }
 
       sb->slices = sb->base_slices + slice_offset;
@@ -69,7 +72,8 @@ void grpc_slice_buffer_destroy_internal(grpc_exec_ctx *exec_ctx,
                                         grpc_slice_buffer *sb) {
   grpc_slice_buffer_reset_and_unref_internal(exec_ctx, sb);
   if (sb->base_slices != sb->inlined) {
-    gpr_free(sb->base_slices);
+    gpr_free_tagged(sb->base_slices, sb->capacity * sizeof(grpc_slice),
+                    GPR_ALLOC_TAG_SLICE_BUFFER);
   }
 }
 
@@ -0,0 +1,139 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/support/alloc_tags.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/lib/support/string.h"
+
+// Counters are sharded by the CPU the caller is running on; CPUs beyond
+// MAX_SHARDS share shards
+#define MAX_SHARDS 64
+#define CACHELINE_SIZE 64
+
+typedef struct {
+  gpr_atm live_bytes;
+  gpr_atm live_allocations;
+  gpr_atm total_allocations;
+} tag_counters;
+
+typedef union {
+  tag_counters tags[GPR_ALLOC_TAG_COUNT];
+  // keep shards for different CPUs off each other's cache lines
+  char padding[CACHELINE_SIZE *
+               ((sizeof(tag_counters) * GPR_ALLOC_TAG_COUNT +
+                 CACHELINE_SIZE - 1) /
+                CACHELINE_SIZE)];
+} shard;
+
+static shard g_shards[MAX_SHARDS];
+
+static const char *const g_tag_names[GPR_ALLOC_TAG_COUNT] = {
+    "hpack", "slice", "slice_buffer", "arena", "transport"};
+
+static tag_counters *counters_for(gpr_alloc_tag tag) {
+  GPR_ASSERT(tag >= 0 && tag < GPR_ALLOC_TAG_COUNT);
+  return &g_shards[gpr_cpu_current_cpu() % MAX_SHARDS].tags[tag];
+}
+
+static void note_alloc(size_t size, gpr_alloc_tag tag) {
+  tag_counters *c = counters_for(tag);
+  gpr_atm_no_barrier_fetch_add(&c->live_bytes, (gpr_atm)size);
+  gpr_atm_no_barrier_fetch_add(&c->live_allocations, 1);
+  gpr_atm_no_barrier_fetch_add(&c->total_allocations, 1);
+}
+
+static void note_free(size_t size, gpr_alloc_tag tag) {
+  tag_counters *c = counters_for(tag);
+  gpr_atm_no_barrier_fetch_add(&c->live_bytes, -(gpr_atm)size);
+  gpr_atm_no_barrier_fetch_add(&c->live_allocations, -1);
+}
+
+void *gpr_malloc_tagged(size_t size, gpr_alloc_tag tag) {
+  void *p = gpr_malloc(size);
+  if (p != NULL) note_alloc(size, tag);
+  return p;
+}
+
+void *gpr_zalloc_tagged(size_t size, gpr_alloc_tag tag) {
+  void *p = gpr_zalloc(size);
+  if (p != NULL) note_alloc(size, tag);
+  return p;
+}
+
+void *gpr_realloc_tagged(void *p, size_t old_size, size_t new_size,
+                         gpr_alloc_tag tag) {
+  if (p != NULL) note_free(old_size, tag);
+  p = gpr_realloc(p, new_size);
+  if (p != NULL) note_alloc(new_size, tag);
+  return p;
+}
+
+void gpr_free_tagged(void *p, size_t size, gpr_alloc_tag tag) {
+  if (p == NULL) return;
+  note_free(size, tag);
+  gpr_free(p);
+}
+
+const char *gpr_alloc_tag_name(gpr_alloc_tag tag) {
+  GPR_ASSERT(tag >= 0 && tag < GPR_ALLOC_TAG_COUNT);
+  return g_tag_names[tag];
+}
+
+void gpr_alloc_tag_stats_collect(gpr_alloc_tag_stats *stats) {
+  memset(stats, 0, sizeof(*stats) * GPR_ALLOC_TAG_COUNT);
+  for (size_t i = 0; i < MAX_SHARDS; i++) {
+    for (size_t tag = 0; tag < GPR_ALLOC_TAG_COUNT; tag++) {
+      tag_counters *c = &g_shards[i].tags[tag];
+      stats[tag].live_bytes += gpr_atm_no_barrier_load(&c->live_bytes);
+      stats[tag].live_allocations +=
+          gpr_atm_no_barrier_load(&c->live_allocations);
+      stats[tag].total_allocations +=
+          gpr_atm_no_barrier_load(&c->total_allocations);
+    }
+  }
+}
+
+char *gpr_alloc_tag_stats_dump(void) {
+  gpr_alloc_tag_stats stats[GPR_ALLOC_TAG_COUNT];
+  gpr_strvec v;
+  char *line;
+
+  gpr_alloc_tag_stats_collect(stats);
+  gpr_strvec_init(&v);
+  gpr_asprintf(&line, "%-14s %14s %14s %14s\n", "tag", "live_bytes",
+               "live_allocs", "total_allocs");
+  gpr_strvec_add(&v, line);
+  for (size_t tag = 0; tag < GPR_ALLOC_TAG_COUNT; tag++) {
+    gpr_asprintf(&line, "%-14s %14" PRId64 " %14" PRId64 " %14" PRId64 "\n",
+                 g_tag_names[tag], stats[tag].live_bytes,
+                 stats[tag].live_allocations, stats[tag].total_allocations);
+    gpr_strvec_add(&v, line);
+  }
+  char *result = gpr_strvec_flatten(&v, NULL);
+  gpr_strvec_destroy(&v);
+  return result;
+}
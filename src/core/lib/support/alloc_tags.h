@@ -0,0 +1,87 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_SUPPORT_ALLOC_TAGS_H
+#define GRPC_CORE_LIB_SUPPORT_ALLOC_TAGS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Per-subsystem memory accounting.
+//
+// Allocation sites that own a well defined block of memory can allocate it
+// through the tagged variants of gpr_malloc & friends below. Memory still
+// comes from the gpr_malloc allocation functions; the tag only attributes
+// live bytes and allocation counts to a subsystem. Counters are kept per-CPU,
+// so tagging does not add a contended cache line to hot allocation paths.
+//
+// The size of a tagged block is not stored with it: callers pass the size
+// that was allocated back to gpr_free_tagged / gpr_realloc_tagged.
+
+typedef enum {
+  // HPACK encoder and decoder dynamic tables
+  GPR_ALLOC_TAG_HPACK,
+  // refcounted slice payloads created by grpc_slice_malloc
+  GPR_ALLOC_TAG_SLICE,
+  // out of line slice arrays in grpc_slice_buffer
+  GPR_ALLOC_TAG_SLICE_BUFFER,
+  // gpr_arena blocks (call arenas)
+  GPR_ALLOC_TAG_ARENA,
+  // chttp2 transport objects (one per connection)
+  GPR_ALLOC_TAG_TRANSPORT,
+  GPR_ALLOC_TAG_COUNT
+} gpr_alloc_tag;
+
+typedef struct gpr_alloc_tag_stats {
+  // bytes currently allocated against the tag
+  int64_t live_bytes;
+  // number of blocks currently allocated against the tag
+  int64_t live_allocations;
+  // number of blocks ever allocated against the tag
+  int64_t total_allocations;
+} gpr_alloc_tag_stats;
+
+void *gpr_malloc_tagged(size_t size, gpr_alloc_tag tag);
+void *gpr_zalloc_tagged(size_t size, gpr_alloc_tag tag);
+// \a old_size must be the size \a p was last allocated with (0 if p is NULL)
+void *gpr_realloc_tagged(void *p, size_t old_size, size_t new_size,
+                         gpr_alloc_tag tag);
+// \a size must be the size \a p was last allocated with
+void gpr_free_tagged(void *p, size_t size, gpr_alloc_tag tag);
+
+// Short name for \a tag, suitable for logs and reports
+const char *gpr_alloc_tag_name(gpr_alloc_tag tag);
+
+// Sum the per-CPU counters for every tag into \a stats
+void gpr_alloc_tag_stats_collect(gpr_alloc_tag_stats *stats);
+
+// Render the current per-tag statistics as a human readable table.
+// Caller must gpr_free the result.
+char *gpr_alloc_tag_stats_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRPC_CORE_LIB_SUPPORT_ALLOC_TAGS_H */
@@ -22,6 +22,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/useful.h>
 
+#include "src/core/lib/support/alloc_tags.h"
+
 #define ROUND_UP_TO_ALIGNMENT_SIZE(x) \
   (((x) + GPR_MAX_ALIGNMENT - 1u) & ~(GPR_MAX_ALIGNMENT - 1u))
 
@@ -38,7 +40,8 @@ struct gpr_arena {
 
 gpr_arena *gpr_arena_create(size_t initial_size) {
   initial_size = ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  gpr_arena *a = (gpr_arena *)gpr_zalloc(sizeof(gpr_arena) + initial_size);
+  gpr_arena *a = (gpr_arena *)gpr_zalloc_tagged(
+      sizeof(gpr_arena) + initial_size, GPR_ALLOC_TAG_ARENA);
   a->initial_zone.size_end = initial_size;
   return a;
 }
@@ -46,10 +49,12 @@ gpr_arena *gpr_arena_create(size_t initial_size) {
 size_t gpr_arena_destroy(gpr_arena *arena) {
   gpr_atm size = gpr_atm_no_barrier_load(&arena->size_so_far);
   zone *z = (zone *)gpr_atm_no_barrier_load(&arena->initial_zone.next_atm);
-  gpr_free(arena);
+  gpr_free_tagged(arena, sizeof(gpr_arena) + arena->initial_zone.size_end,
+                  GPR_ALLOC_TAG_ARENA);
   while (z) {
     zone *next_z = (zone *)gpr_atm_no_barrier_load(&z->next_atm);
-    gpr_free(z);
+    gpr_free_tagged(z, sizeof(zone) + z->size_end - z->size_begin,
+                    GPR_ALLOC_TAG_ARENA);
     z = next_z;
   }
   return (size_t)size;
@@ -64,11 +69,13 @@ void *gpr_arena_alloc(gpr_arena *arena, size_t size) {
     zone *next_z = (zone *)gpr_atm_acq_load(&z->next_atm);
     if (next_z == NULL) {
       size_t next_z_size = (size_t)gpr_atm_no_barrier_load(&arena->size_so_far);
-      next_z = (zone *)gpr_zalloc(sizeof(zone) + next_z_size);
+      next_z = (zone *)gpr_zalloc_tagged(sizeof(zone) + next_z_size,
+                                         GPR_ALLOC_TAG_ARENA);
       next_z->size_begin = z->size_end;
       next_z->size_end = z->size_end + next_z_size;
       if (!gpr_atm_rel_cas(&z->next_atm, (gpr_atm)NULL, (gpr_atm)next_z)) {
-        gpr_free(next_z);
+        gpr_free_tagged(next_z, sizeof(zone) + next_z_size,
+                        GPR_ALLOC_TAG_ARENA);
         next_z = (zone *)gpr_atm_acq_load(&z->next_atm);
       }
     }
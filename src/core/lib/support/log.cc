@@ -22,6 +22,7 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/support/env.h"
+#include "src/core/lib/support/log_async.h"
 #include "src/core/lib/support/string.h"
 
 #include <stdio.h>
@@ -87,8 +88,20 @@ void gpr_log_verbosity_init() {
     gpr_log(GPR_DEBUG, "Warning: insecure environment read function '%s' used",
             insecure_getenv);
   }
+
+  char *log_async = gpr_getenv("GRPC_LOG_ASYNC");
+  if (log_async != NULL) {
+    if (gpr_is_true(log_async) && !gpr_log_async_start()) {
+      gpr_log(GPR_ERROR, "GRPC_LOG_ASYNC is not supported on this platform");
+    }
+    gpr_free(log_async);
+  }
 }
 
 void gpr_set_log_function(gpr_log_func f) {
   gpr_atm_no_barrier_store(&g_log_func, (gpr_atm)(f ? f : gpr_default_log));
 }
+
+gpr_log_func gpr_log_get_function(void) {
+  return (gpr_log_func)gpr_atm_no_barrier_load(&g_log_func);
+}
@@ -0,0 +1,421 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/support/log_async.h"
+
+#ifdef GPR_LINUX_LOG
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
+#include <grpc/support/time.h>
+#include <grpc/support/useful.h>
+
+extern "C" void gpr_default_log(gpr_log_func_args *args);
+
+/* Bytes of ring buffer per logging thread; a power of two */
+#define RING_SIZE (64 * 1024)
+/* Longer messages are truncated, so that a ring always holds a few */
+#define MAX_RECORD_SIZE (RING_SIZE / 8)
+#define RECORD_ALIGNMENT 8
+/* How long the writer sleeps once all rings are empty */
+#define WRITER_IDLE_MS 5
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+/* A logged message as it sits in a ring: the header is followed by the NUL
+   terminated file name and message, padded to RECORD_ALIGNMENT. */
+typedef struct record {
+  /* ring bytes taken by the record; 0 if the record would not fit before
+     the end of the ring, and the next one starts at the beginning */
+  uint32_t size;
+  uint32_t file_length;
+  int32_t line;
+  gpr_log_severity severity;
+  gpr_timespec time;
+} record;
+
+/* Single producer, single consumer ring of records. Positions only grow;
+   they are taken modulo RING_SIZE to index data. */
+typedef struct log_ring {
+  /* written by the owning thread */
+  gpr_atm tail;
+  gpr_atm dropped;
+  char padding1[GPR_CACHELINE_SIZE];
+  /* written by the writer thread */
+  gpr_atm head;
+  gpr_atm dropped_reported;
+  char padding2[GPR_CACHELINE_SIZE];
+  long tid;
+  /* set when the owning thread exits: the writer frees the ring once it has
+     drained it */
+  gpr_atm abandoned;
+  /* next in g_rings */
+  struct log_ring *next;
+  char data[RING_SIZE];
+} log_ring;
+
+static gpr_once g_once = GPR_ONCE_INIT;
+static pthread_key_t g_ring_key;
+static gpr_mu g_mu;
+/* wakes the writer early, for a flush or to stop */
+static gpr_cv g_writer_cv;
+static gpr_cv g_flushed_cv;
+/* all rings of live threads and of exited threads that still hold messages;
+   rings are only added at the front, and only removed by the writer */
+static log_ring *g_rings;
+static bool g_running;
+static bool g_stopping;
+static uint64_t g_flushes_requested;
+static uint64_t g_flushes_done;
+/* dropped count of rings that have been freed */
+static int64_t g_freed_rings_dropped;
+static gpr_thd_id g_writer;
+/* log function messages are written with; NULL to format them as
+   gpr_default_log does */
+static gpr_log_func g_sink;
+
+static void thread_exited(void *arg) {
+  gpr_atm_rel_store(&((log_ring *)arg)->abandoned, 1);
+}
+
+static void init_once(void) {
+  gpr_mu_init(&g_mu);
+  gpr_cv_init(&g_writer_cv);
+  gpr_cv_init(&g_flushed_cv);
+  GPR_ASSERT(pthread_key_create(&g_ring_key, thread_exited) == 0);
+}
+
+/* Only the first message of a thread takes a lock, to register its ring */
+static log_ring *thread_ring(void) {
+  log_ring *ring = (log_ring *)pthread_getspecific(g_ring_key);
+  if (ring != NULL) return ring;
+  ring = (log_ring *)gpr_zalloc(sizeof(*ring));
+  ring->tid = syscall(__NR_gettid);
+  gpr_mu_lock(&g_mu);
+  ring->next = g_rings;
+  g_rings = ring;
+  gpr_mu_unlock(&g_mu);
+  pthread_setspecific(g_ring_key, ring);
+  return ring;
+}
+
+static void async_log(gpr_log_func_args *args) {
+  log_ring *ring = thread_ring();
+  const char *file = strrchr(args->file, '/');
+  file = file == NULL ? args->file : file + 1;
+  size_t file_length = strlen(file) + 1;
+  size_t message_length = strlen(args->message) + 1;
+  if (sizeof(record) + file_length + message_length > MAX_RECORD_SIZE) {
+    file_length = GPR_MIN(file_length, MAX_RECORD_SIZE / 4);
+    message_length =
+        GPR_MIN(message_length, MAX_RECORD_SIZE - sizeof(record) - file_length);
+  }
+  size_t size = (sizeof(record) + file_length + message_length +
+                 RECORD_ALIGNMENT - 1) &
+                ~(size_t)(RECORD_ALIGNMENT - 1);
+
+  size_t tail = (size_t)gpr_atm_no_barrier_load(&ring->tail);
+  size_t head = (size_t)gpr_atm_acq_load(&ring->head);
+  size_t offset = tail & (RING_SIZE - 1);
+  size_t skip = RING_SIZE - offset < size ? RING_SIZE - offset : 0;
+  if (tail + skip + size - head > RING_SIZE) {
+    gpr_atm_no_barrier_store(&ring->dropped,
+                             gpr_atm_no_barrier_load(&ring->dropped) + 1);
+    return;
+  }
+  if (skip != 0) {
+    ((record *)(ring->data + offset))->size = 0;
+    offset = 0;
+  }
+
+  record *r = (record *)(ring->data + offset);
+  r->size = (uint32_t)size;
+  r->file_length = (uint32_t)file_length;
+  r->line = args->line;
+  r->severity = args->severity;
+  r->time = gpr_now(GPR_CLOCK_REALTIME);
+  char *p = (char *)(r + 1);
+  memcpy(p, file, file_length - 1);
+  p[file_length - 1] = 0;
+  memcpy(p + file_length, args->message, message_length - 1);
+  p[file_length + message_length - 1] = 0;
+  gpr_atm_rel_store(&ring->tail, (gpr_atm)(tail + skip + size));
+}
+
+typedef struct output {
+  char buffer[OUTPUT_BUFFER_SIZE];
+  size_t length;
+  /* localtime of cached_sec, formatted */
+  time_t cached_sec;
+  char time_buffer[64];
+} output;
+
+static void flush_output(output *out) {
+  if (out->length == 0) return;
+  fwrite(out->buffer, 1, out->length, stderr);
+  out->length = 0;
+}
+
+/* Same format as gpr_default_log, with the time and thread id of when the
+   message was logged */
+static void format_record(output *out, long tid, gpr_timespec when,
+                          gpr_log_severity severity, const char *file,
+                          int line, const char *message) {
+  time_t sec = (time_t)when.tv_sec;
+  if (sec != out->cached_sec || out->time_buffer[0] == 0) {
+    struct tm tm;
+    out->cached_sec = sec;
+    if (!localtime_r(&sec, &tm)) {
+      strcpy(out->time_buffer, "error:localtime");
+    } else if (0 == strftime(out->time_buffer, sizeof(out->time_buffer),
+                             "%m%d %H:%M:%S", &tm)) {
+      strcpy(out->time_buffer, "error:strftime");
+    }
+  }
+  char prefix[256];
+  snprintf(prefix, sizeof(prefix), "%s%s.%09" PRId32 " %7ld %s:%d]",
+           gpr_log_severity_string(severity), out->time_buffer, when.tv_nsec,
+           tid, file, line);
+  for (;;) {
+    size_t room = sizeof(out->buffer) - out->length;
+    int n = snprintf(out->buffer + out->length, room, "%-60s %s\n", prefix,
+                     message);
+    if (n < 0) return;
+    if ((size_t)n < room) {
+      out->length += (size_t)n;
+      return;
+    }
+    if (out->length == 0) {
+      /* longer than the whole buffer */
+      fprintf(stderr, "%-60s %s\n", prefix, message);
+      return;
+    }
+    flush_output(out);
+  }
+}
+
+static void write_record(output *out, log_ring *ring, const record *r) {
+  const char *file = (const char *)(r + 1);
+  const char *message = file + r->file_length;
+  if (g_sink == NULL) {
+    format_record(out, ring->tid, r->time, r->severity, file, r->line,
+                  message);
+  } else {
+    gpr_log_func_args args;
+    memset(&args, 0, sizeof(args));
+    args.file = file;
+    args.line = r->line;
+    args.severity = r->severity;
+    args.message = message;
+    g_sink(&args);
+  }
+}
+
+/* Writes out everything in ring. Returns true if there was anything. */
+static bool drain_ring(output *out, log_ring *ring) {
+  size_t head = (size_t)gpr_atm_no_barrier_load(&ring->head);
+  size_t tail = (size_t)gpr_atm_acq_load(&ring->tail);
+  bool drained_any = head != tail;
+  while (head != tail) {
+    size_t offset = head & (RING_SIZE - 1);
+    const record *r = (const record *)(ring->data + offset);
+    if (r->size == 0) {
+      head += RING_SIZE - offset;
+      continue;
+    }
+    write_record(out, ring, r);
+    head += r->size;
+  }
+  gpr_atm_rel_store(&ring->head, (gpr_atm)head);
+
+  gpr_atm dropped = gpr_atm_no_barrier_load(&ring->dropped);
+  gpr_atm reported = gpr_atm_no_barrier_load(&ring->dropped_reported);
+  if (dropped != reported) {
+    char message[128];
+    snprintf(message, sizeof(message),
+             "async logging dropped %" PRIdPTR " messages of thread %ld",
+             dropped - reported, ring->tid);
+    gpr_atm_no_barrier_store(&ring->dropped_reported, dropped);
+    const char *file = strrchr(__FILE__, '/');
+    file = file == NULL ? __FILE__ : file + 1;
+    if (g_sink == NULL) {
+      format_record(out, ring->tid, gpr_now(GPR_CLOCK_REALTIME),
+                    GPR_LOG_SEVERITY_ERROR, file, __LINE__, message);
+    } else {
+      gpr_log_func_args args;
+      memset(&args, 0, sizeof(args));
+      args.file = file;
+      args.line = __LINE__;
+      args.severity = GPR_LOG_SEVERITY_ERROR;
+      args.message = message;
+      g_sink(&args);
+    }
+    drained_any = true;
+  }
+  return drained_any;
+}
+
+/* Frees the rings of exited threads once they are empty */
+static void free_abandoned_rings_locked(void) {
+  log_ring **link = &g_rings;
+  while (*link != NULL) {
+    log_ring *ring = *link;
+    if (gpr_atm_acq_load(&ring->abandoned) &&
+        gpr_atm_no_barrier_load(&ring->head) ==
+            gpr_atm_acq_load(&ring->tail)) {
+      *link = ring->next;
+      g_freed_rings_dropped += gpr_atm_no_barrier_load(&ring->dropped);
+      gpr_free(ring);
+    } else {
+      link = &ring->next;
+    }
+  }
+}
+
+static void writer_thread(void *arg) {
+  output *out = (output *)gpr_zalloc(sizeof(*out));
+  gpr_mu_lock(&g_mu);
+  for (;;) {
+    uint64_t flush_request = g_flushes_requested;
+    bool stopping = g_stopping;
+    log_ring *rings = g_rings;
+    gpr_mu_unlock(&g_mu);
+
+    /* New rings are added in front of the ones seen here, and only this
+       thread removes rings, so the list can be walked without the lock */
+    bool wrote = false;
+    for (log_ring *ring = rings; ring != NULL; ring = ring->next) {
+      wrote |= drain_ring(out, ring);
+    }
+    flush_output(out);
+
+    gpr_mu_lock(&g_mu);
+    free_abandoned_rings_locked();
+    if (flush_request > g_flushes_done) {
+      g_flushes_done = flush_request;
+      gpr_cv_broadcast(&g_flushed_cv);
+    }
+    if (stopping) break;
+    if (!wrote && flush_request == g_flushes_requested && !g_stopping) {
+      gpr_cv_wait(&g_writer_cv, &g_mu,
+                  gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                               gpr_time_from_millis(WRITER_IDLE_MS,
+                                                    GPR_TIMESPAN)));
+    }
+  }
+  gpr_mu_unlock(&g_mu);
+  gpr_free(out);
+}
+
+static void flush_at_exit(void) { gpr_log_async_flush(); }
+
+bool gpr_log_async_start(void) {
+  gpr_once_init(&g_once, init_once);
+  gpr_mu_lock(&g_mu);
+  if (!g_running) {
+    static bool registered_at_exit = false;
+    if (!registered_at_exit) {
+      atexit(flush_at_exit);
+      registered_at_exit = true;
+    }
+    gpr_log_func current = gpr_log_get_function();
+    g_sink = current == gpr_default_log ? NULL : current;
+    g_running = true;
+    g_stopping = false;
+    gpr_thd_options options = gpr_thd_options_default();
+    gpr_thd_options_set_joinable(&options);
+    GPR_ASSERT(gpr_thd_new(&g_writer, writer_thread, NULL, &options));
+    gpr_set_log_function(async_log);
+  }
+  gpr_mu_unlock(&g_mu);
+  return true;
+}
+
+void gpr_log_async_flush(void) {
+  gpr_once_init(&g_once, init_once);
+  gpr_mu_lock(&g_mu);
+  if (g_running) {
+    uint64_t request = ++g_flushes_requested;
+    gpr_cv_signal(&g_writer_cv);
+    while (g_running && g_flushes_done < request) {
+      gpr_cv_wait(&g_flushed_cv, &g_mu, gpr_inf_future(GPR_CLOCK_MONOTONIC));
+    }
+  }
+  gpr_mu_unlock(&g_mu);
+}
+
+void gpr_log_async_stop(void) {
+  gpr_once_init(&g_once, init_once);
+  gpr_mu_lock(&g_mu);
+  if (!g_running || g_stopping) {
+    gpr_mu_unlock(&g_mu);
+    return;
+  }
+  /* later messages are logged synchronously again; the writer's last pass
+     writes out the ones already queued */
+  gpr_set_log_function(g_sink);
+  g_stopping = true;
+  gpr_cv_signal(&g_writer_cv);
+  gpr_mu_unlock(&g_mu);
+  gpr_thd_join(g_writer);
+  gpr_mu_lock(&g_mu);
+  g_running = false;
+  g_stopping = false;
+  gpr_cv_broadcast(&g_flushed_cv);
+  gpr_mu_unlock(&g_mu);
+}
+
+int64_t gpr_log_async_dropped_count(void) {
+  gpr_once_init(&g_once, init_once);
+  gpr_mu_lock(&g_mu);
+  int64_t dropped = g_freed_rings_dropped;
+  for (log_ring *ring = g_rings; ring != NULL; ring = ring->next) {
+    dropped += gpr_atm_no_barrier_load(&ring->dropped);
+  }
+  gpr_mu_unlock(&g_mu);
+  return dropped;
+}
+
+#else /* GPR_LINUX_LOG */
+
+bool gpr_log_async_start(void) { return false; }
+
+void gpr_log_async_flush(void) {}
+
+void gpr_log_async_stop(void) {}
+
+int64_t gpr_log_async_dropped_count(void) { return 0; }
+
+#endif /* GPR_LINUX_LOG */
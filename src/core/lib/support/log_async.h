@@ -0,0 +1,67 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_SUPPORT_LOG_ASYNC_H
+#define GRPC_CORE_LIB_SUPPORT_LOG_ASYNC_H
+
+#include <grpc/support/log.h>
+#include <grpc/support/port_platform.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Asynchronous logging.
+
+   While running, the log function in place when it was started is called
+   from a background writer thread instead of from the thread calling
+   gpr_log. The logging thread only copies the message,
+   file, line, severity, time and its thread id into a single producer ring
+   buffer of its own; it never takes a lock or blocks on stderr. A message that
+   does not fit in its thread's ring is dropped, and the writer reports how
+   many were dropped. The default log line prefix is formatted on the writer
+   thread, from the time and thread id captured when the message was logged.
+
+   Started at init when GRPC_LOG_ASYNC is set, or explicitly. Only available
+   with the Linux log backend. */
+
+/* Starts asynchronous logging. Returns false if it is not available on this
+   platform. Starting when already started is a no-op. */
+bool gpr_log_async_start(void);
+
+/* Waits until every message logged before the call has been written. */
+void gpr_log_async_flush(void);
+
+/* Flushes, stops the writer thread and goes back to logging synchronously
+   through the log function in place when logging was started. */
+void gpr_log_async_stop(void);
+
+/* Number of messages dropped because their thread's ring was full. */
+int64_t gpr_log_async_dropped_count(void);
+
+/* The log function gpr_log currently calls (defined in log.cc). */
+gpr_log_func gpr_log_get_function(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRPC_CORE_LIB_SUPPORT_LOG_ASYNC_H */
@@ -43,17 +43,25 @@ static long gettid(void) { return syscall(__NR_gettid); }
 
 void gpr_log(const char *file, int line, gpr_log_severity severity,
              const char *format, ...) {
-  char *message = NULL;
+  /* most messages fit on the stack; only longer ones are allocated */
+  char buffer[512];
+  char *message = buffer;
   va_list args;
   va_start(args, format);
-  if (vasprintf(&message, format, args) == -1) {
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length < 0) return;
+  if ((size_t)length >= sizeof(buffer)) {
+    va_start(args, format);
+    if (vasprintf(&message, format, args) == -1) {
+      va_end(args);
+      return;
+    }
     va_end(args);
-    return;
   }
-  va_end(args);
   gpr_log_message(file, line, severity, message);
-  /* message has been allocated by vasprintf above, and needs free */
-  free(message);
+  /* message may have been allocated by vasprintf above, and needs free */
+  if (message != buffer) free(message);
 }
 
 extern "C" void gpr_default_log(gpr_log_func_args *args) {
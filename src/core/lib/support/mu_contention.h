@@ -0,0 +1,86 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_SUPPORT_MU_CONTENTION_H
+#define GRPC_CORE_LIB_SUPPORT_MU_CONTENTION_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(GPR_MU_CONTENTION_PROFILING) && !defined(GPR_POSIX_SYNC)
+#error "GPR_MU_CONTENTION_PROFILING requires GPR_POSIX_SYNC"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Mutex contention profiling for gpr_mu.
+//
+// When built with GPR_MU_CONTENTION_PROFILING (CONFIG=mucontention), every
+// gpr_mu acquisition records how long the caller waited for the lock and how
+// long the lock was then held, keyed by the address that called gpr_mu_lock
+// (or gpr_mu_trylock). Samples go into per-thread log2 histograms, so
+// uncontended acquisitions only pay for a trylock, a cycle counter read and a
+// thread local table update; per-thread data is merged when it is read.
+//
+// Without GPR_MU_CONTENTION_PROFILING these functions are no-ops that report
+// no call sites.
+
+// Aggregated statistics for one gpr_mu call site (all times in nanoseconds)
+typedef struct gpr_mu_contention_site {
+  // return address of the gpr_mu_lock call
+  void *call_site;
+  // number of times the lock was taken from this site
+  uint64_t acquisitions;
+  // number of those acquisitions that found the lock already held
+  uint64_t contended;
+  uint64_t total_wait_ns;
+  uint64_t max_wait_ns;
+  uint64_t p99_wait_ns;
+  uint64_t total_hold_ns;
+  uint64_t max_hold_ns;
+  uint64_t p50_hold_ns;
+  uint64_t p99_hold_ns;
+} gpr_mu_contention_site;
+
+// Returns true if gpr_mu contention profiling was compiled in
+int gpr_mu_contention_enabled(void);
+
+// Fill in up to max_sites call sites, ranked by total time spent waiting for
+// the lock (most contended first). Returns the number of sites filled in.
+size_t gpr_mu_contention_top(gpr_mu_contention_site *sites, size_t max_sites);
+
+// Render the top max_sites contended call sites as a human readable table
+// (with symbol names where available). Caller must gpr_free the result.
+char *gpr_mu_contention_report(size_t max_sites);
+
+// gpr_log the output of gpr_mu_contention_report
+void gpr_mu_contention_log(size_t max_sites);
+
+// Discard all samples collected so far. Intended to be called between
+// benchmark phases; samples recorded concurrently with a reset may be lost.
+void gpr_mu_contention_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRPC_CORE_LIB_SUPPORT_MU_CONTENTION_H */
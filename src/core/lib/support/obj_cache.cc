@@ -0,0 +1,150 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/support/obj_cache.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/useful.h>
+
+/* Objects moved between a magazine and the depot at a time: half a
+   magazine, so that a magazine that was just refilled (or spilled) has room
+   both ways */
+#define DEPOT_BATCH (GPR_OBJ_CACHE_MAGAZINE_SIZE / 2)
+
+typedef struct {
+  gpr_mu mu;
+  size_t count;
+  void *objs[GPR_OBJ_CACHE_MAGAZINE_SIZE];
+} cpu_magazine;
+
+/* Magazines are padded to a whole number of cache lines, so that cpus don't
+   share them */
+typedef union {
+  cpu_magazine magazine;
+  char padding[(sizeof(cpu_magazine) + GPR_CACHELINE_SIZE - 1) /
+               GPR_CACHELINE_SIZE * GPR_CACHELINE_SIZE];
+} cpu_magazine_slot;
+
+struct gpr_obj_cache {
+  size_t num_magazines;
+  cpu_magazine_slot *magazines;
+
+  /* Lock order: a magazine's mu, then depot_mu */
+  gpr_mu depot_mu;
+  size_t max_depot;
+  size_t depot_count;
+  size_t depot_capacity;
+  void **depot;
+};
+
+gpr_obj_cache *gpr_obj_cache_create(size_t max_depot) {
+  gpr_obj_cache *cache = (gpr_obj_cache *)gpr_zalloc(sizeof(*cache));
+  cache->num_magazines = GPR_MAX(1, gpr_cpu_num_cores());
+  cache->magazines = (cpu_magazine_slot *)gpr_malloc_aligned(
+      cache->num_magazines * sizeof(*cache->magazines), GPR_CACHELINE_SIZE_LOG);
+  for (size_t i = 0; i < cache->num_magazines; i++) {
+    gpr_mu_init(&cache->magazines[i].magazine.mu);
+    cache->magazines[i].magazine.count = 0;
+  }
+  gpr_mu_init(&cache->depot_mu);
+  cache->max_depot = max_depot;
+  return cache;
+}
+
+void gpr_obj_cache_destroy(gpr_obj_cache *cache, void (*free_obj)(void *obj)) {
+  gpr_obj_cache_drain(cache, free_obj);
+  for (size_t i = 0; i < cache->num_magazines; i++) {
+    gpr_mu_destroy(&cache->magazines[i].magazine.mu);
+  }
+  gpr_free_aligned(cache->magazines);
+  gpr_mu_destroy(&cache->depot_mu);
+  gpr_free(cache->depot);
+  gpr_free(cache);
+}
+
+static cpu_magazine *current_magazine(gpr_obj_cache *cache) {
+  return &cache->magazines[gpr_cpu_current_cpu() % cache->num_magazines]
+              .magazine;
+}
+
+void *gpr_obj_cache_get(gpr_obj_cache *cache) {
+  cpu_magazine *magazine = current_magazine(cache);
+  void *obj = NULL;
+  gpr_mu_lock(&magazine->mu);
+  if (magazine->count == 0) {
+    gpr_mu_lock(&cache->depot_mu);
+    size_t n = GPR_MIN(DEPOT_BATCH, cache->depot_count);
+    cache->depot_count -= n;
+    memcpy(magazine->objs, cache->depot + cache->depot_count,
+           n * sizeof(void *));
+    magazine->count = n;
+    gpr_mu_unlock(&cache->depot_mu);
+  }
+  if (magazine->count > 0) {
+    obj = magazine->objs[--magazine->count];
+  }
+  gpr_mu_unlock(&magazine->mu);
+  return obj;
+}
+
+bool gpr_obj_cache_put(gpr_obj_cache *cache, void *obj) {
+  cpu_magazine *magazine = current_magazine(cache);
+  bool cached = false;
+  gpr_mu_lock(&magazine->mu);
+  if (magazine->count == GPR_OBJ_CACHE_MAGAZINE_SIZE) {
+    gpr_mu_lock(&cache->depot_mu);
+    size_t n = GPR_MIN(DEPOT_BATCH, cache->max_depot - cache->depot_count);
+    if (cache->depot_count + n > cache->depot_capacity) {
+      cache->depot_capacity =
+          GPR_MAX(2 * cache->depot_capacity, cache->depot_count + n);
+      cache->depot = (void **)gpr_realloc(
+          cache->depot, cache->depot_capacity * sizeof(void *));
+    }
+    magazine->count -= n;
+    memcpy(cache->depot + cache->depot_count, magazine->objs + magazine->count,
+           n * sizeof(void *));
+    cache->depot_count += n;
+    gpr_mu_unlock(&cache->depot_mu);
+  }
+  if (magazine->count < GPR_OBJ_CACHE_MAGAZINE_SIZE) {
+    magazine->objs[magazine->count++] = obj;
+    cached = true;
+  }
+  gpr_mu_unlock(&magazine->mu);
+  return cached;
+}
+
+void gpr_obj_cache_drain(gpr_obj_cache *cache, void (*free_obj)(void *obj)) {
+  for (size_t i = 0; i < cache->num_magazines; i++) {
+    cpu_magazine *magazine = &cache->magazines[i].magazine;
+    gpr_mu_lock(&magazine->mu);
+    while (magazine->count > 0) {
+      free_obj(magazine->objs[--magazine->count]);
+    }
+    gpr_mu_unlock(&magazine->mu);
+  }
+  gpr_mu_lock(&cache->depot_mu);
+  while (cache->depot_count > 0) {
+    free_obj(cache->depot[--cache->depot_count]);
+  }
+  gpr_mu_unlock(&cache->depot_mu);
+}
@@ -0,0 +1,74 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_SUPPORT_OBJ_CACHE_H
+#define GRPC_CORE_LIB_SUPPORT_OBJ_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A cache of freed objects of one type, for objects that are created and
+   destroyed at a high rate (one per connection, say).
+
+   Each cpu has a small magazine of cached objects behind its own lock, so
+   getting and putting objects on different cpus doesn't contend. Magazines
+   exchange half their objects with a shared depot when they run empty or
+   full, so objects freed on one cpu can be reused on another. While the
+   depot has objects to give, one lock acquisition on it is amortized over
+   many objects; once the depot is empty too, every get on an empty
+   magazine takes the depot lock only to come back with nothing.
+
+   The cache never allocates or frees objects itself: callers allocate when
+   gpr_obj_cache_get returns NULL, and free objects the cache refuses. Cached
+   objects keep whatever contents they were put with. */
+
+typedef struct gpr_obj_cache gpr_obj_cache;
+
+/* Objects each cpu caches before it spills into the depot */
+#define GPR_OBJ_CACHE_MAGAZINE_SIZE 16
+
+/* Keep every object put into the cache, for objects that must never be
+   returned to the allocator while the cache exists */
+#define GPR_OBJ_CACHE_UNBOUNDED SIZE_MAX
+
+/* Create a cache whose depot holds at most max_depot objects, on top of
+   what the per-cpu magazines hold */
+gpr_obj_cache *gpr_obj_cache_create(size_t max_depot);
+
+/* Call free_obj on every cached object and destroy the cache */
+void gpr_obj_cache_destroy(gpr_obj_cache *cache, void (*free_obj)(void *obj));
+
+/* Returns a cached object, or NULL if the cache is empty */
+void *gpr_obj_cache_get(gpr_obj_cache *cache);
+
+/* Cache obj. Returns false, leaving obj to the caller, if the cache is full */
+bool gpr_obj_cache_put(gpr_obj_cache *cache, void *obj);
+
+/* Call free_obj on every cached object, leaving the cache empty but usable */
+void gpr_obj_cache_drain(gpr_obj_cache *cache, void (*free_obj)(void *obj));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRPC_CORE_LIB_SUPPORT_OBJ_CACHE_H */
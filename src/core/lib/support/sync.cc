@@ -20,10 +20,13 @@
 
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 
 #include <assert.h>
 
+#include "src/core/lib/support/mu_contention.h"
+
 /* Number of mutexes to allocate for events, to avoid lock contention.
    Should be a prime. */
 enum { event_sync_partitions = 31 };
@@ -120,3 +123,21 @@ intptr_t gpr_stats_read(const gpr_stats_counter *c) {
   /* don't need acquire-load, but we have no no-barrier load yet */
   return gpr_atm_acq_load(&c->value);
 }
+
+#ifndef GPR_MU_CONTENTION_PROFILING
+/* Contention profiling is implemented by sync_posix.cc when enabled */
+
+int gpr_mu_contention_enabled(void) { return 0; }
+
+size_t gpr_mu_contention_top(gpr_mu_contention_site *sites, size_t max_sites) {
+  return 0;
+}
+
+char *gpr_mu_contention_report(size_t max_sites) {
+  return gpr_strdup("gpr_mu contention profiling not enabled\n");
+}
+
+void gpr_mu_contention_log(size_t max_sites) {}
+
+void gpr_mu_contention_reset(void) {}
+#endif /* GPR_MU_CONTENTION_PROFILING */
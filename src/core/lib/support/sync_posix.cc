@@ -26,6 +26,24 @@
 #include <grpc/support/time.h>
 #include <time.h>
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/support/mu_contention.h"
+
+#ifdef GPR_MU_CONTENTION_PROFILING
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/tls.h>
+#include <grpc/support/useful.h>
+
+#include "src/core/lib/support/string.h"
+
+#ifdef __GLIBC__
+#include <execinfo.h>
+#endif
+#endif
 
 #ifdef GPR_LOW_LEVEL_COUNTERS
 gpr_atm gpr_mu_locks = 0;
@@ -33,6 +51,187 @@ gpr_atm gpr_counter_atm_cas = 0;
 gpr_atm gpr_counter_atm_add = 0;
 #endif
 
+#ifdef GPR_MU_CONTENTION_PROFILING
+/* Per-thread contention profile: a small open addressed table of call sites
+   (site records are allocated on first use), plus the stack of locks this
+   thread currently holds so that unlock can compute the hold time.
+   Only the owning thread writes to its profile; readers merge all profiles
+   under g_prof_mu and tolerate slightly stale values. */
+
+#define PROF_SITES 256 /* power of two */
+#define PROF_BUCKETS 48
+#define PROF_MAX_HELD 32
+
+typedef struct prof_site {
+  gpr_atm call_site;
+  gpr_atm acquisitions;
+  gpr_atm contended;
+  gpr_atm wait_ticks;
+  gpr_atm max_wait_ticks;
+  gpr_atm hold_ticks;
+  gpr_atm max_hold_ticks;
+  /* bucket i counts samples in [2^(i-1), 2^i) ticks */
+  gpr_atm wait_histogram[PROF_BUCKETS];
+  gpr_atm hold_histogram[PROF_BUCKETS];
+} prof_site;
+
+typedef struct prof_held {
+  gpr_mu* mu;
+  prof_site* site;
+  int64_t acquired_at;
+} prof_held;
+
+typedef struct prof_thread {
+  struct prof_thread* next;
+  gpr_atm sites[PROF_SITES]; /* prof_site* */
+  prof_site overflow;
+  prof_held held[PROF_MAX_HELD];
+  size_t num_held;
+} prof_thread;
+
+static pthread_once_t g_prof_once = PTHREAD_ONCE_INIT;
+/* a raw pthread mutex: gpr_mu would recurse into the profiler */
+static pthread_mutex_t g_prof_mu = PTHREAD_MUTEX_INITIALIZER;
+static prof_thread* g_prof_threads;
+static int64_t g_prof_calibration_ticks;
+static int64_t g_prof_calibration_ns;
+GPR_TLS_DECL(g_prof_self);
+
+static int64_t prof_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * GPR_NS_PER_SEC + ts.tv_nsec;
+}
+
+static int64_t prof_ticks(void) {
+#if defined(__x86_64__) || defined(__amd64__)
+  uint64_t low, high;
+  __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+  return (int64_t)((high << 32) | low);
+#else
+  return prof_now_ns();
+#endif
+}
+
+static void prof_init(void) {
+  gpr_tls_init(&g_prof_self);
+  g_prof_calibration_ticks = prof_ticks();
+  g_prof_calibration_ns = prof_now_ns();
+}
+
+static double prof_ns_per_tick(void) {
+  int64_t ticks = prof_ticks() - g_prof_calibration_ticks;
+  int64_t ns = prof_now_ns() - g_prof_calibration_ns;
+  if (ticks <= 0 || ns <= 0) return 1.0;
+  return (double)ns / (double)ticks;
+}
+
+static prof_thread* prof_self(void) {
+  prof_thread* t;
+  pthread_once(&g_prof_once, prof_init);
+  t = (prof_thread*)gpr_tls_get(&g_prof_self);
+  if (t == NULL) {
+    /* calloc rather than gpr_malloc: custom allocators may take a gpr_mu */
+    t = (prof_thread*)calloc(1, sizeof(*t));
+    GPR_ASSERT(t != NULL);
+    pthread_mutex_lock(&g_prof_mu);
+    t->next = g_prof_threads;
+    g_prof_threads = t;
+    pthread_mutex_unlock(&g_prof_mu);
+    gpr_tls_set(&g_prof_self, (intptr_t)t);
+  }
+  return t;
+}
+
+static prof_site* prof_find_site(prof_thread* t, void* call_site) {
+  size_t h = (size_t)(((uintptr_t)call_site >> 2) * 0x9E3779B1u);
+  for (size_t probe = 0; probe < PROF_SITES; probe++) {
+    gpr_atm* slot = &t->sites[(h + probe) & (PROF_SITES - 1)];
+    prof_site* s = (prof_site*)gpr_atm_no_barrier_load(slot);
+    if (s == NULL) {
+      s = (prof_site*)calloc(1, sizeof(*s));
+      if (s == NULL) break;
+      s->call_site = (gpr_atm)call_site;
+      gpr_atm_rel_store(slot, (gpr_atm)s);
+      return s;
+    }
+    if (s->call_site == (gpr_atm)call_site) return s;
+  }
+  return &t->overflow;
+}
+
+static void prof_add(gpr_atm* value, gpr_atm delta) {
+  gpr_atm_no_barrier_store(value, gpr_atm_no_barrier_load(value) + delta);
+}
+
+static void prof_max(gpr_atm* value, gpr_atm candidate) {
+  if (candidate > gpr_atm_no_barrier_load(value)) {
+    gpr_atm_no_barrier_store(value, candidate);
+  }
+}
+
+static size_t prof_bucket(int64_t ticks) {
+  if (ticks <= 0) return 0;
+  return GPR_MIN(PROF_BUCKETS - 1,
+                 (size_t)(64 - __builtin_clzll((unsigned long long)ticks)));
+}
+
+static void prof_push_held(prof_thread* t, gpr_mu* mu, prof_site* site,
+                           int64_t now) {
+  if (t->num_held == PROF_MAX_HELD) return;
+  t->held[t->num_held].mu = mu;
+  t->held[t->num_held].site = site;
+  t->held[t->num_held].acquired_at = now;
+  t->num_held++;
+}
+
+static void prof_acquired(gpr_mu* mu, void* call_site, int64_t now,
+                          int64_t wait_ticks, bool contended) {
+  prof_thread* t = prof_self();
+  prof_site* s = prof_find_site(t, call_site);
+  prof_add(&s->acquisitions, 1);
+  if (contended) {
+    prof_add(&s->contended, 1);
+    prof_add(&s->wait_ticks, (gpr_atm)wait_ticks);
+    prof_max(&s->max_wait_ticks, (gpr_atm)wait_ticks);
+  }
+  prof_add(&s->wait_histogram[prof_bucket(wait_ticks)], 1);
+  prof_push_held(t, mu, s, now);
+}
+
+/* Pops mu from this thread's held stack, recording its hold time; returns the
+   site it was acquired from (or NULL if it was not being tracked) */
+static prof_site* prof_released(gpr_mu* mu) {
+  prof_thread* t = prof_self();
+  for (size_t i = t->num_held; i > 0; i--) {
+    prof_held* h = &t->held[i - 1];
+    if (h->mu != mu) continue;
+    prof_site* s = h->site;
+    int64_t hold_ticks = prof_ticks() - h->acquired_at;
+    prof_add(&s->hold_ticks, (gpr_atm)hold_ticks);
+    prof_max(&s->max_hold_ticks, (gpr_atm)hold_ticks);
+    prof_add(&s->hold_histogram[prof_bucket(hold_ticks)], 1);
+    memmove(h, h + 1, (t->num_held - i) * sizeof(*h));
+    t->num_held--;
+    return s;
+  }
+  return NULL;
+}
+
+static void prof_lock(gpr_mu* mu, void* call_site) {
+  int err = pthread_mutex_trylock(mu);
+  if (err == 0) {
+    prof_acquired(mu, call_site, prof_ticks(), 0, false);
+    return;
+  }
+  GPR_ASSERT(err == EBUSY);
+  int64_t start = prof_ticks();
+  GPR_ASSERT(pthread_mutex_lock(mu) == 0);
+  int64_t now = prof_ticks();
+  prof_acquired(mu, call_site, now, now - start, true);
+}
+#endif /* GPR_MU_CONTENTION_PROFILING */
+
 void gpr_mu_init(gpr_mu* mu) { GPR_ASSERT(pthread_mutex_init(mu, NULL) == 0); }
 
 void gpr_mu_destroy(gpr_mu* mu) { GPR_ASSERT(pthread_mutex_destroy(mu) == 0); }
@@ -42,12 +241,19 @@ void gpr_mu_lock(gpr_mu* mu) {
   GPR_ATM_INC_COUNTER(gpr_mu_locks);
 #endif
   GPR_TIMER_BEGIN("gpr_mu_lock", 0);
+#ifdef GPR_MU_CONTENTION_PROFILING
+  prof_lock(mu, __builtin_return_address(0));
+#else
   GPR_ASSERT(pthread_mutex_lock(mu) == 0);
+#endif
   GPR_TIMER_END("gpr_mu_lock", 0);
 }
 
 void gpr_mu_unlock(gpr_mu* mu) {
   GPR_TIMER_BEGIN("gpr_mu_unlock", 0);
+#ifdef GPR_MU_CONTENTION_PROFILING
+  prof_released(mu);
+#endif
   GPR_ASSERT(pthread_mutex_unlock(mu) == 0);
   GPR_TIMER_END("gpr_mu_unlock", 0);
 }
@@ -57,6 +263,11 @@ int gpr_mu_trylock(gpr_mu* mu) {
   GPR_TIMER_BEGIN("gpr_mu_trylock", 0);
   err = pthread_mutex_trylock(mu);
   GPR_ASSERT(err == 0 || err == EBUSY);
+#ifdef GPR_MU_CONTENTION_PROFILING
+  if (err == 0) {
+    prof_acquired(mu, __builtin_return_address(0), prof_ticks(), 0, false);
+  }
+#endif
   GPR_TIMER_END("gpr_mu_trylock", 0);
   return err == 0;
 }
@@ -69,6 +280,10 @@ void gpr_cv_destroy(gpr_cv* cv) { GPR_ASSERT(pthread_cond_destroy(cv) == 0); }
 
 int gpr_cv_wait(gpr_cv* cv, gpr_mu* mu, gpr_timespec abs_deadline) {
   int err = 0;
+#ifdef GPR_MU_CONTENTION_PROFILING
+  /* time spent asleep on the condition doesn't count as holding the lock */
+  prof_site* site = prof_released(mu);
+#endif
   if (gpr_time_cmp(abs_deadline, gpr_inf_future(abs_deadline.clock_type)) ==
       0) {
     err = pthread_cond_wait(cv, mu);
@@ -80,6 +295,9 @@ int gpr_cv_wait(gpr_cv* cv, gpr_mu* mu, gpr_timespec abs_deadline) {
     err = pthread_cond_timedwait(cv, mu, &abs_deadline_ts);
   }
   GPR_ASSERT(err == 0 || err == ETIMEDOUT || err == EAGAIN);
+#ifdef GPR_MU_CONTENTION_PROFILING
+  if (site != NULL) prof_push_held(prof_self(), mu, site, prof_ticks());
+#endif
   return err == ETIMEDOUT;
 }
 
@@ -95,4 +313,182 @@ void gpr_once_init(gpr_once* once, void (*init_function)(void)) {
   GPR_ASSERT(pthread_once(once, init_function) == 0);
 }
 
+/*----------------------------------------*/
+
+#ifdef GPR_MU_CONTENTION_PROFILING
+
+int gpr_mu_contention_enabled(void) { return 1; }
+
+static uint64_t prof_percentile(const gpr_atm* histogram, double percentile) {
+  int64_t count = 0;
+  for (size_t i = 0; i < PROF_BUCKETS; i++) {
+    count += gpr_atm_no_barrier_load(&histogram[i]);
+  }
+  if (count == 0) return 0;
+  int64_t target = (int64_t)((double)count * percentile / 100.0);
+  int64_t seen = 0;
+  for (size_t i = 0; i < PROF_BUCKETS; i++) {
+    seen += gpr_atm_no_barrier_load(&histogram[i]);
+    if (seen > target) return i == 0 ? 0 : ((uint64_t)1) << (i - 1);
+  }
+  return ((uint64_t)1) << (PROF_BUCKETS - 2);
+}
+
+static int cmp_call_site(const void* a, const void* b) {
+  const prof_site* x = *(const prof_site* const*)a;
+  const prof_site* y = *(const prof_site* const*)b;
+  return GPR_ICMP(x->call_site, y->call_site);
+}
+
+static int cmp_total_wait(const void* a, const void* b) {
+  const gpr_mu_contention_site* x = (const gpr_mu_contention_site*)a;
+  const gpr_mu_contention_site* y = (const gpr_mu_contention_site*)b;
+  int c = GPR_ICMP(y->total_wait_ns, x->total_wait_ns);
+  if (c != 0) return c;
+  return GPR_ICMP(y->contended, x->contended);
+}
+
+static void prof_merge(prof_site* into, const prof_site* from) {
+  into->acquisitions += gpr_atm_no_barrier_load(&from->acquisitions);
+  into->contended += gpr_atm_no_barrier_load(&from->contended);
+  into->wait_ticks += gpr_atm_no_barrier_load(&from->wait_ticks);
+  into->max_wait_ticks = GPR_MAX(into->max_wait_ticks,
+                                 gpr_atm_no_barrier_load(&from->max_wait_ticks));
+  into->hold_ticks += gpr_atm_no_barrier_load(&from->hold_ticks);
+  into->max_hold_ticks = GPR_MAX(into->max_hold_ticks,
+                                 gpr_atm_no_barrier_load(&from->max_hold_ticks));
+  for (size_t i = 0; i < PROF_BUCKETS; i++) {
+    into->wait_histogram[i] += gpr_atm_no_barrier_load(&from->wait_histogram[i]);
+    into->hold_histogram[i] += gpr_atm_no_barrier_load(&from->hold_histogram[i]);
+  }
+}
+
+static void prof_convert(const prof_site* s, double ns_per_tick,
+                         gpr_mu_contention_site* out) {
+  out->call_site = (void*)s->call_site;
+  out->acquisitions = (uint64_t)s->acquisitions;
+  out->contended = (uint64_t)s->contended;
+  out->total_wait_ns = (uint64_t)((double)s->wait_ticks * ns_per_tick);
+  out->max_wait_ns = (uint64_t)((double)s->max_wait_ticks * ns_per_tick);
+  out->p99_wait_ns =
+      (uint64_t)((double)prof_percentile(s->wait_histogram, 99) * ns_per_tick);
+  out->total_hold_ns = (uint64_t)((double)s->hold_ticks * ns_per_tick);
+  out->max_hold_ns = (uint64_t)((double)s->max_hold_ticks * ns_per_tick);
+  out->p50_hold_ns =
+      (uint64_t)((double)prof_percentile(s->hold_histogram, 50) * ns_per_tick);
+  out->p99_hold_ns =
+      (uint64_t)((double)prof_percentile(s->hold_histogram, 99) * ns_per_tick);
+}
+
+size_t gpr_mu_contention_top(gpr_mu_contention_site* sites, size_t max_sites) {
+  pthread_once(&g_prof_once, prof_init);
+  double ns_per_tick = prof_ns_per_tick();
+  size_t num_raw = 0;
+  size_t cap_raw = 0;
+  prof_site** raw = NULL;
+  pthread_mutex_lock(&g_prof_mu);
+  for (prof_thread* t = g_prof_threads; t != NULL; t = t->next) {
+    for (size_t i = 0; i <= PROF_SITES; i++) {
+      prof_site* s = i == PROF_SITES
+                         ? &t->overflow
+                         : (prof_site*)gpr_atm_acq_load(&t->sites[i]);
+      if (s == NULL || gpr_atm_no_barrier_load(&s->acquisitions) == 0) {
+        continue;
+      }
+      if (num_raw == cap_raw) {
+        cap_raw = GPR_MAX(64, 2 * cap_raw);
+        raw = (prof_site**)realloc(raw, cap_raw * sizeof(*raw));
+        GPR_ASSERT(raw != NULL);
+      }
+      raw[num_raw++] = s;
+    }
+  }
+  pthread_mutex_unlock(&g_prof_mu);
+  /* sort by call site so that each site's per-thread records are adjacent */
+  qsort(raw, num_raw, sizeof(*raw), cmp_call_site);
+  gpr_mu_contention_site* merged =
+      (gpr_mu_contention_site*)calloc(GPR_MAX(1, num_raw), sizeof(*merged));
+  size_t num_merged = 0;
+  for (size_t i = 0; i < num_raw;) {
+    prof_site acc;
+    memset(&acc, 0, sizeof(acc));
+    acc.call_site = raw[i]->call_site;
+    for (; i < num_raw && raw[i]->call_site == acc.call_site; i++) {
+      prof_merge(&acc, raw[i]);
+    }
+    prof_convert(&acc, ns_per_tick, &merged[num_merged++]);
+  }
+  free(raw);
+  qsort(merged, num_merged, sizeof(*merged), cmp_total_wait);
+  size_t n = GPR_MIN(num_merged, max_sites);
+  memcpy(sites, merged, n * sizeof(*sites));
+  free(merged);
+  return n;
+}
+
+char* gpr_mu_contention_report(size_t max_sites) {
+  gpr_mu_contention_site* sites = (gpr_mu_contention_site*)gpr_malloc(
+      GPR_MAX(1, max_sites) * sizeof(*sites));
+  size_t n = gpr_mu_contention_top(sites, max_sites);
+  gpr_strvec v;
+  char* tmp;
+  gpr_strvec_init(&v);
+  gpr_asprintf(&tmp,
+               "gpr_mu contention: top %" PRIuPTR
+               " call sites by total wait\n"
+               "%18s %12s %12s %12s %12s %12s %12s %12s  %s\n",
+               n, "call_site", "acquired", "contended", "wait_ms",
+               "p99_wait_us", "max_wait_us", "hold_ms", "p99_hold_us",
+               "symbol");
+  gpr_strvec_add(&v, tmp);
+  for (size_t i = 0; i < n; i++) {
+    const gpr_mu_contention_site* s = &sites[i];
+    char** symbols = NULL;
+#ifdef __GLIBC__
+    symbols = backtrace_symbols(&s->call_site, 1);
+#endif
+    gpr_asprintf(
+        &tmp,
+        "%18p %12" PRIu64 " %12" PRIu64 " %12.3f %12.3f %12.3f %12.3f %12.3f  "
+        "%s\n",
+        s->call_site, s->acquisitions, s->contended,
+        (double)s->total_wait_ns / 1e6, (double)s->p99_wait_ns / 1e3,
+        (double)s->max_wait_ns / 1e3, (double)s->total_hold_ns / 1e6,
+        (double)s->p99_hold_ns / 1e3,
+        s->call_site == NULL ? "<overflow>"
+                             : symbols != NULL ? symbols[0] : "?");
+    free(symbols);
+    gpr_strvec_add(&v, tmp);
+  }
+  tmp = gpr_strvec_flatten(&v, NULL);
+  gpr_strvec_destroy(&v);
+  gpr_free(sites);
+  return tmp;
+}
+
+void gpr_mu_contention_log(size_t max_sites) {
+  char* report = gpr_mu_contention_report(max_sites);
+  gpr_log(GPR_INFO, "%s", report);
+  gpr_free(report);
+}
+
+void gpr_mu_contention_reset(void) {
+  pthread_once(&g_prof_once, prof_init);
+  pthread_mutex_lock(&g_prof_mu);
+  for (prof_thread* t = g_prof_threads; t != NULL; t = t->next) {
+    for (size_t i = 0; i <= PROF_SITES; i++) {
+      prof_site* s = i == PROF_SITES
+                         ? &t->overflow
+                         : (prof_site*)gpr_atm_acq_load(&t->sites[i]);
+      if (s == NULL) continue;
+      gpr_atm call_site = s->call_site;
+      memset(s, 0, sizeof(*s));
+      s->call_site = call_site;
+    }
+  }
+  pthread_mutex_unlock(&g_prof_mu);
+}
+
+#endif /* GPR_MU_CONTENTION_PROFILING */
+
 #endif /* GRP_POSIX_SYNC */
@@ -133,6 +133,7 @@ gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type) = now_impl;
 
 #ifdef GPR_LOW_LEVEL_COUNTERS
 gpr_atm gpr_now_call_count;
+gpr_atm gpr_fast_now_call_count;
 #endif
 
 gpr_timespec gpr_now(gpr_clock_type clock_type) {
@@ -142,6 +143,31 @@ gpr_timespec gpr_now(gpr_clock_type clock_type) {
   return gpr_now_impl(clock_type);
 }
 
+gpr_timespec gpr_fast_monotonic_now(void) {
+#ifdef GPR_CYCLE_CLOCK_NOW
+  gpr_timespec now;
+  if (gpr_now_impl == now_impl && gpr_cycle_clock_monotonic_now(&now)) {
+#ifdef GPR_LOW_LEVEL_COUNTERS
+    __atomic_fetch_add(&gpr_fast_now_call_count, 1, __ATOMIC_RELAXED);
+#endif
+    return now;
+  }
+#endif
+  return gpr_now(GPR_CLOCK_MONOTONIC);
+}
+
+gpr_timespec gpr_coarse_monotonic_now(void) {
+#if defined(CLOCK_MONOTONIC_COARSE) && \
+    !defined(GPR_BACKWARDS_COMPATIBILITY_MODE)
+  if (gpr_now_impl == now_impl) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    return gpr_from_timespec(now, GPR_CLOCK_MONOTONIC);
+  }
+#endif
+  return gpr_now(GPR_CLOCK_MONOTONIC);
+}
+
 void gpr_sleep_until(gpr_timespec until) {
   gpr_timespec now;
   gpr_timespec delta;
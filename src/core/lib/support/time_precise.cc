@@ -16,8 +16,11 @@
  *
  */
 
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 #include <grpc/support/time.h>
+#include <grpc/support/tls.h>
 #include <stdio.h>
 
 #include "src/core/lib/support/time_precise.h"
@@ -74,3 +77,134 @@ void gpr_precise_clock_now(gpr_timespec *clk) {
   clk->clock_type = GPR_CLOCK_PRECISE;
 }
 #endif /* GRPC_TIMERS_RDTSC */
+
+#if defined(GPR_LINUX) && defined(__x86_64__) && \
+    !defined(GPR_BACKWARDS_COMPATIBILITY_MODE)
+#include <cpuid.h>
+#include <time.h>
+
+/* The rate is first measured over this long; until then the cycle clock
+   reads clock_gettime */
+#define CALIBRATION_NS (10 * GPR_NS_PER_MS)
+/* How long a thread extrapolates from its last clock_gettime */
+#define RESYNC_NS (100 * GPR_NS_PER_MS)
+/* A cycle count is only paired with a clock reading if the two
+   clock_gettime calls around it are at most this far apart */
+#define MAX_SAMPLE_WINDOW_NS (1 * GPR_NS_PER_US)
+#define MAX_SAMPLE_ATTEMPTS 3
+
+static gpr_once g_cycle_clock_once = GPR_ONCE_INIT;
+/* 0 before cycle_clock_init, then 1 if the cycle clock is available and 2 if
+   not */
+static gpr_atm g_cycle_clock_state;
+/* rate measurements span from here to the latest resync of any thread */
+static int64_t g_anchor_cycles;
+static int64_t g_anchor_ns;
+/* nanoseconds per cycle in 32.32 fixed point; 0 until calibrated */
+static gpr_atm g_ns_per_cycle;
+static gpr_atm g_resync_cycles;
+
+/* the cycle count and clock reading this thread extrapolates from */
+GPR_TLS_DECL(g_base_cycles);
+GPR_TLS_DECL(g_base_ns);
+/* keeps the clock monotonic across resyncs */
+GPR_TLS_DECL(g_last_ns);
+
+static int64_t read_cycles(void) {
+  uint64_t low, high;
+  __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+  return (int64_t)((high << 32) | low);
+}
+
+static int64_t monotonic_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (int64_t)now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
+/* Reads the cycle counter between two clock readings.  Returns false if
+   the thread was held up between them (preempted, say), in which case *ns
+   is still a valid clock reading but *cycles must not be used.  Otherwise
+   *ns is the first reading: it is at most one window behind the moment
+   the cycles were read, so the cycle clock errs towards running late. */
+static bool sample(int64_t *ns, int64_t *cycles) {
+  for (int i = 0; i < MAX_SAMPLE_ATTEMPTS; i++) {
+    int64_t before = monotonic_ns();
+    *cycles = read_cycles();
+    *ns = monotonic_ns();
+    if (*ns - before <= MAX_SAMPLE_WINDOW_NS) {
+      *ns = before;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void cycle_clock_init(void) {
+  unsigned eax, ebx, ecx, edx;
+  gpr_tls_init(&g_base_cycles);
+  gpr_tls_init(&g_base_ns);
+  gpr_tls_init(&g_last_ns);
+  /* the invariant tsc ticks at a constant rate in every power state */
+  if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8)) &&
+      sample(&g_anchor_ns, &g_anchor_cycles)) {
+    gpr_atm_rel_store(&g_cycle_clock_state, 1);
+  } else {
+    gpr_atm_rel_store(&g_cycle_clock_state, 2);
+  }
+}
+
+/* Takes a new base for the thread, and refines the rate from the (ever
+   longer) interval since the anchor.  A sample that cannot be trusted
+   leaves both alone, so the next call tries again. */
+static int64_t resync(void) {
+  int64_t ns;
+  int64_t cycles;
+  if (!sample(&ns, &cycles)) return ns;
+  int64_t elapsed_ns = ns - g_anchor_ns;
+  int64_t elapsed_cycles = cycles - g_anchor_cycles;
+  if (elapsed_ns >= CALIBRATION_NS && elapsed_cycles > 0) {
+    double ns_per_cycle = (double)elapsed_ns / (double)elapsed_cycles;
+    gpr_atm_no_barrier_store(&g_ns_per_cycle,
+                             (gpr_atm)(ns_per_cycle * 4294967296.0));
+    gpr_atm_no_barrier_store(&g_resync_cycles,
+                             (gpr_atm)((double)RESYNC_NS / ns_per_cycle));
+  }
+  gpr_tls_set(&g_base_cycles, (intptr_t)cycles);
+  gpr_tls_set(&g_base_ns, (intptr_t)ns);
+  return ns;
+}
+
+bool gpr_cycle_clock_monotonic_now(gpr_timespec *now) {
+  gpr_atm clock_state = gpr_atm_acq_load(&g_cycle_clock_state);
+  if (clock_state == 0) {
+    gpr_once_init(&g_cycle_clock_once, cycle_clock_init);
+    clock_state = gpr_atm_acq_load(&g_cycle_clock_state);
+  }
+  if (clock_state != 1) return false;
+  int64_t base_ns = (int64_t)gpr_tls_get(&g_base_ns);
+  int64_t ns_per_cycle = gpr_atm_no_barrier_load(&g_ns_per_cycle);
+  int64_t delta = read_cycles() - (int64_t)gpr_tls_get(&g_base_cycles);
+  int64_t ns;
+  /* a negative delta means the thread moved to a cpu whose counter is
+     behind */
+  if (ns_per_cycle == 0 || base_ns == 0 || delta < 0 ||
+      delta > gpr_atm_no_barrier_load(&g_resync_cycles)) {
+    ns = resync();
+  } else {
+    ns = base_ns + (int64_t)(((uint64_t)delta * (uint64_t)ns_per_cycle) >> 32);
+  }
+  int64_t last_ns = (int64_t)gpr_tls_get(&g_last_ns);
+  if (ns < last_ns) {
+    ns = last_ns;
+  } else {
+    gpr_tls_set(&g_last_ns, (intptr_t)ns);
+  }
+  now->clock_type = GPR_CLOCK_MONOTONIC;
+  now->tv_sec = ns / GPR_NS_PER_SEC;
+  now->tv_nsec = (int32_t)(ns % GPR_NS_PER_SEC);
+  return true;
+}
+#else
+bool gpr_cycle_clock_monotonic_now(gpr_timespec *now) { return false; }
+#endif
@@ -21,6 +21,8 @@
 
 #include <grpc/support/time.h>
 
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -28,6 +30,23 @@ extern "C" {
 void gpr_precise_clock_init(void);
 void gpr_precise_clock_now(gpr_timespec *clk);
 
+/* Reads GPR_CLOCK_MONOTONIC from the cpu's invariant timestamp counter, scaled
+   by a rate calibrated against clock_gettime. Each thread rereads
+   clock_gettime every 100ms, so the two never drift apart. Returns false
+   where there is no invariant timestamp counter. */
+bool gpr_cycle_clock_monotonic_now(gpr_timespec *now);
+
+/* GPR_CLOCK_MONOTONIC for timestamps taken on hot paths. This is
+   gpr_now(GPR_CLOCK_MONOTONIC) unless built with -DGPR_CYCLE_CLOCK_NOW, in
+   which case it reads the cycle clock where there is one (and gpr_now_impl
+   has not been replaced). Defined in time_{posix,windows}.cc. */
+gpr_timespec gpr_fast_monotonic_now(void);
+
+/* GPR_CLOCK_MONOTONIC at the resolution of the kernel tick (a few
+   milliseconds, lagging behind gpr_now), where that is cheaper to read: for
+   computing deadlines far enough out not to care. */
+gpr_timespec gpr_coarse_monotonic_now(void);
+
 #ifdef __cplusplus
 }
 #endif
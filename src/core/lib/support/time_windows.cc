@@ -76,6 +76,14 @@ gpr_timespec gpr_now(gpr_clock_type clock_type) {
   return gpr_now_impl(clock_type);
 }
 
+gpr_timespec gpr_fast_monotonic_now(void) {
+  return gpr_now(GPR_CLOCK_MONOTONIC);
+}
+
+gpr_timespec gpr_coarse_monotonic_now(void) {
+  return gpr_now(GPR_CLOCK_MONOTONIC);
+}
+
 void gpr_sleep_until(gpr_timespec until) {
   gpr_timespec now;
   gpr_timespec delta;
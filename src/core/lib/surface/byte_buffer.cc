@@ -17,6 +17,7 @@
  */
 
 #include <grpc/byte_buffer.h>
+#include <grpc/byte_buffer_reader.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -44,6 +45,27 @@ grpc_byte_buffer *grpc_raw_compressed_byte_buffer_create(
   return bb;
 }
 
+grpc_byte_buffer *grpc_message_object_byte_buffer_create(
+    const grpc_message_object_vtable *vtable, void *object, size_t length) {
+  grpc_byte_buffer *bb =
+      (grpc_byte_buffer *)gpr_malloc(sizeof(grpc_byte_buffer));
+  bb->type = GRPC_BB_OBJECT;
+  bb->data.object.vtable = vtable;
+  bb->data.object.object = object;
+  bb->data.object.length = length;
+  return bb;
+}
+
+void *grpc_byte_buffer_take_message_object(
+    grpc_byte_buffer *bb, const grpc_message_object_vtable *vtable) {
+  if (bb->type != GRPC_BB_OBJECT || bb->data.object.vtable != vtable) {
+    return NULL;
+  }
+  void *object = bb->data.object.object;
+  bb->data.object.object = NULL;
+  return object;
+}
+
 grpc_byte_buffer *grpc_raw_byte_buffer_from_reader(
     grpc_byte_buffer_reader *reader) {
   grpc_byte_buffer *bb =
@@ -65,6 +87,13 @@ grpc_byte_buffer *grpc_byte_buffer_copy(grpc_byte_buffer *bb) {
       return grpc_raw_compressed_byte_buffer_create(
           bb->data.raw.slice_buffer.slices, bb->data.raw.slice_buffer.count,
           bb->data.raw.compression);
+    case GRPC_BB_OBJECT: {
+      /* initializing a reader serializes the object in place */
+      grpc_byte_buffer_reader reader;
+      if (!grpc_byte_buffer_reader_init(&reader, bb)) return NULL;
+      grpc_byte_buffer_reader_destroy(&reader);
+      return grpc_byte_buffer_copy(bb);
+    }
   }
   GPR_UNREACHABLE_CODE(return NULL);
 }
@@ -76,6 +105,11 @@ void grpc_byte_buffer_destroy(grpc_byte_buffer *bb) {
     case GRPC_BB_RAW:
       grpc_slice_buffer_destroy_internal(&exec_ctx, &bb->data.raw.slice_buffer);
       break;
+    case GRPC_BB_OBJECT:
+      if (bb->data.object.object != NULL) {
+        bb->data.object.vtable->destroy(bb->data.object.object);
+      }
+      break;
   }
   gpr_free(bb);
   grpc_exec_ctx_finish(&exec_ctx);
@@ -85,6 +119,8 @@ size_t grpc_byte_buffer_length(grpc_byte_buffer *bb) {
   switch (bb->type) {
     case GRPC_BB_RAW:
       return bb->data.raw.slice_buffer.length;
+    case GRPC_BB_OBJECT:
+      return bb->data.object.length;
   }
   GPR_UNREACHABLE_CODE(return 0);
 }
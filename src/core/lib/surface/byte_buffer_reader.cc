@@ -36,16 +36,48 @@ static int is_compressed(grpc_byte_buffer *buffer) {
         return 0 /* GPR_FALSE */;
       }
       break;
+    case GRPC_BB_OBJECT:
+      return 0 /* GPR_FALSE */;
   }
   return 1 /* GPR_TRUE */;
 }
 
+/* Turns a GRPC_BB_OBJECT buffer into the RAW buffer of its serialized bytes */
+static int serialize_message_object(grpc_byte_buffer *buffer) {
+  if (buffer->data.object.object == NULL) {
+    gpr_log(GPR_ERROR, "Message object was already taken");
+    return 0;
+  }
+  grpc_byte_buffer *serialized =
+      buffer->data.object.vtable->serialize(buffer->data.object.object);
+  if (serialized == NULL) {
+    gpr_log(GPR_ERROR, "Unexpected error serializing message object");
+    return 0;
+  }
+  GPR_ASSERT(serialized->type == GRPC_BB_RAW);
+  buffer->data.object.vtable->destroy(buffer->data.object.object);
+  buffer->type = GRPC_BB_RAW;
+  buffer->data.raw.compression = serialized->data.raw.compression;
+  grpc_slice_buffer_init(&buffer->data.raw.slice_buffer);
+  grpc_slice_buffer_swap(&buffer->data.raw.slice_buffer,
+                         &serialized->data.raw.slice_buffer);
+  grpc_byte_buffer_destroy(serialized);
+  return 1;
+}
+
 int grpc_byte_buffer_reader_init(grpc_byte_buffer_reader *reader,
                                  grpc_byte_buffer *buffer) {
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
   grpc_slice_buffer decompressed_slices_buffer;
   reader->buffer_in = buffer;
   switch (reader->buffer_in->type) {
+    case GRPC_BB_OBJECT:
+      if (!serialize_message_object(reader->buffer_in)) {
+        memset(reader, 0, sizeof(*reader));
+        grpc_exec_ctx_finish(&exec_ctx);
+        return 0;
+      }
+    /* fallthrough */
     case GRPC_BB_RAW:
       grpc_slice_buffer_init(&decompressed_slices_buffer);
       if (is_compressed(reader->buffer_in)) {
@@ -84,6 +116,9 @@ void grpc_byte_buffer_reader_destroy(grpc_byte_buffer_reader *reader) {
         grpc_byte_buffer_destroy(reader->buffer_out);
       }
       break;
+    case GRPC_BB_OBJECT:
+      /* serialized into a RAW buffer by grpc_byte_buffer_reader_init */
+      GPR_UNREACHABLE_CODE(break);
   }
 }
 
@@ -101,6 +136,9 @@ int grpc_byte_buffer_reader_next(grpc_byte_buffer_reader *reader,
       }
       break;
     }
+    case GRPC_BB_OBJECT:
+      /* serialized into a RAW buffer by grpc_byte_buffer_reader_init */
+      GPR_UNREACHABLE_CODE(break);
   }
   return 0;
 }
@@ -219,6 +219,7 @@ struct grpc_call {
   grpc_millis send_deadline;
 
   grpc_slice_buffer_stream sending_stream;
+  grpc_message_object_stream sending_object_stream;
 
   grpc_byte_stream *receiving_stream;
   grpc_byte_buffer **receiving_buffer;
@@ -408,6 +409,9 @@ grpc_error *grpc_call_create(grpc_exec_ctx *exec_ctx,
       grpc_call_context_set(call, GRPC_CONTEXT_TRACING,
                             args->parent->context[GRPC_CONTEXT_TRACING].value,
                             NULL);
+      grpc_call_context_set(
+          call, GRPC_CONTEXT_CENSUS_TRACE,
+          args->parent->context[GRPC_CONTEXT_CENSUS_TRACE].value, NULL);
     } else if (args->propagation_mask & GRPC_PROPAGATE_CENSUS_STATS_CONTEXT) {
       add_init_error(&error, GRPC_ERROR_CREATE_FROM_STATIC_STRING(
                                  "Census context propagation requested "
@@ -1448,6 +1452,14 @@ static void process_data_after_md(grpc_exec_ctx *exec_ctx,
     *call->receiving_buffer = NULL;
     call->receiving_message = 0;
     finish_batch_step(exec_ctx, bctl);
+  } else if ((*call->receiving_buffer = grpc_byte_stream_take_message_object(
+                  call->receiving_stream)) != NULL) {
+    /* the sender's message object was handed over as is */
+    call->test_only_last_message_flags = call->receiving_stream->flags;
+    call->receiving_message = 0;
+    grpc_byte_stream_destroy(exec_ctx, call->receiving_stream);
+    call->receiving_stream = NULL;
+    finish_batch_step(exec_ctx, bctl);
   } else {
     call->test_only_last_message_flags = call->receiving_stream->flags;
     if ((call->receiving_stream->flags & GRPC_WRITE_INTERNAL_COMPRESS) &&
@@ -1825,6 +1837,14 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
         }
         stream_op->send_message = true;
         call->sending_message = true;
+        if (op->data.send_message.send_message->type == GRPC_BB_OBJECT) {
+          grpc_message_object_stream_init(&call->sending_object_stream,
+                                          op->data.send_message.send_message,
+                                          false, op->flags);
+          stream_op_payload->send_message.send_message =
+              &call->sending_object_stream.base;
+          break;
+        }
         grpc_slice_buffer_stream_init(
             &call->sending_stream,
             &op->data.send_message.send_message->data.raw.slice_buffer,
@@ -2054,7 +2074,8 @@ done_with_error:
   }
   if (stream_op->send_message) {
     call->sending_message = false;
-    grpc_byte_stream_destroy(exec_ctx, &call->sending_stream.base);
+    grpc_byte_stream_destroy(exec_ctx,
+                             stream_op_payload->send_message.send_message);
   }
   if (stream_op->send_trailing_metadata) {
     call->sent_final_op = false;
@@ -2115,6 +2136,10 @@ void *grpc_call_context_get(grpc_call *call, grpc_context_index elem) {
 
 uint8_t grpc_call_is_client(grpc_call *call) { return call->is_client; }
 
+bool grpc_call_passes_message_objects(grpc_call *call) {
+  return grpc_channel_passes_message_objects(call->channel);
+}
+
 grpc_compression_algorithm grpc_call_compression_for_level(
     grpc_call *call, grpc_compression_level level) {
   grpc_compression_algorithm algo =
@@ -107,6 +107,10 @@ void *grpc_call_context_get(grpc_call *call, grpc_context_index elem);
 
 uint8_t grpc_call_is_client(grpc_call *call);
 
+/* Return true if messages on \a call can be passed as GRPC_BB_OBJECT byte
+ * buffers instead of serialized bytes (see GRPC_ARG_INPROC_MESSAGE_OBJECTS) */
+bool grpc_call_passes_message_objects(grpc_call *call);
+
 /* Return an appropriate compression algorithm for the requested compression \a
  * level in the context of \a call. */
 grpc_compression_algorithm grpc_call_compression_for_level(
@@ -52,6 +52,7 @@ typedef struct registered_call {
 
 struct grpc_channel {
   int is_client;
+  bool pass_message_objects;
   grpc_compression_options compression_options;
   grpc_mdelem default_authority;
 
@@ -139,6 +140,9 @@ grpc_channel *grpc_channel_create_with_builder(
                   grpc_slice_from_static_string(args->args[i].value.string)));
         }
       }
+    } else if (0 == strcmp(args->args[i].key, GRPC_ARG_PASS_MESSAGE_OBJECTS)) {
+      channel->pass_message_objects =
+          grpc_channel_arg_get_integer(&args->args[i], {0, 0, 1}) != 0;
     } else if (0 == strcmp(args->args[i].key,
                            GRPC_COMPRESSION_CHANNEL_DEFAULT_LEVEL)) {
       channel->compression_options.default_level.is_set = true;
@@ -435,6 +439,10 @@ grpc_compression_options grpc_channel_compression_options(
   return channel->compression_options;
 }
 
+bool grpc_channel_passes_message_objects(const grpc_channel *channel) {
+  return channel->pass_message_objects;
+}
+
 grpc_mdelem grpc_channel_get_reffed_status_elem(grpc_exec_ctx *exec_ctx,
                                                 grpc_channel *channel, int i) {
   char tmp[GPR_LTOA_MIN_BUFSIZE];
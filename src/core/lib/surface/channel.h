@@ -85,6 +85,14 @@ void grpc_channel_internal_unref(grpc_exec_ctx *exec_ctx,
 grpc_compression_options grpc_channel_compression_options(
     const grpc_channel *channel);
 
+/** Internal channel arg (integer): if non-zero, messages on calls on the
+    channel can be passed as GRPC_BB_OBJECT byte buffers. Set by transports
+    that support GRPC_ARG_INPROC_MESSAGE_OBJECTS. */
+#define GRPC_ARG_PASS_MESSAGE_OBJECTS "grpc.internal.pass_message_objects"
+
+/** Return true if calls on \a channel can pass message objects */
+bool grpc_channel_passes_message_objects(const grpc_channel *channel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,7 +34,15 @@ typedef struct stage_slots {
   size_t cap_slots;
 } stage_slots;
 
+typedef struct filter_activity {
+  const grpc_channel_filter *filter;
+  grpc_channel_filter_is_active_func is_active;
+} filter_activity;
+
 static stage_slots g_slots[GRPC_NUM_CHANNEL_STACK_TYPES];
+static filter_activity *g_activities;
+static size_t g_num_activities;
+static size_t g_cap_activities;
 static bool g_finalized;
 
 void grpc_channel_init_init(void) {
@@ -43,6 +51,9 @@ void grpc_channel_init_init(void) {
     g_slots[i].num_slots = 0;
     g_slots[i].cap_slots = 0;
   }
+  g_activities = NULL;
+  g_num_activities = 0;
+  g_cap_activities = 0;
   g_finalized = false;
 }
 
@@ -64,6 +75,30 @@ void grpc_channel_init_register_stage(grpc_channel_stack_type type,
   s->arg = stage_arg;
 }
 
+void grpc_channel_init_register_filter_activity(
+    const grpc_channel_filter *filter,
+    grpc_channel_filter_is_active_func is_active) {
+  GPR_ASSERT(!g_finalized);
+  if (g_cap_activities == g_num_activities) {
+    g_cap_activities = GPR_MAX(8, 3 * g_cap_activities / 2);
+    g_activities = (filter_activity *)gpr_realloc(
+        g_activities, g_cap_activities * sizeof(*g_activities));
+  }
+  filter_activity *a = &g_activities[g_num_activities++];
+  a->filter = filter;
+  a->is_active = is_active;
+}
+
+bool grpc_channel_init_filter_is_active(const grpc_channel_filter *filter,
+                                        const grpc_channel_args *args) {
+  for (size_t i = 0; i < g_num_activities; i++) {
+    if (g_activities[i].filter == filter) {
+      return g_activities[i].is_active(args);
+    }
+  }
+  return true;
+}
+
 static int compare_slots(const void *a, const void *b) {
   const stage_slot *sa = (const stage_slot *)a;
   const stage_slot *sb = (const stage_slot *)b;
@@ -87,6 +122,9 @@ void grpc_channel_init_shutdown(void) {
     gpr_free(g_slots[i].slots);
     g_slots[i].slots = (stage_slot *)(void *)(uintptr_t)0xdeadbeef;
   }
+  gpr_free(g_activities);
+  g_activities = NULL;
+  g_num_activities = 0;
 }
 
 bool grpc_channel_init_create_stack(grpc_exec_ctx *exec_ctx,
@@ -104,5 +142,8 @@ bool grpc_channel_init_create_stack(grpc_exec_ctx *exec_ctx,
     }
   }
 
+  grpc_channel_stack_builder_remove_inactive_filters(
+      builder, grpc_channel_init_filter_is_active);
+
   return true;
 }
@@ -53,6 +53,22 @@ void grpc_channel_init_register_stage(grpc_channel_stack_type type,
                                       grpc_channel_init_stage stage_fn,
                                       void *stage_arg);
 
+/// Tells whether a filter does any work on a channel created with \a args
+typedef bool (*grpc_channel_filter_is_active_func)(
+    const grpc_channel_args *args);
+
+/// Declare when \a filter is active. Once all stages have run, filters that
+/// are inactive given the channel's arguments are dropped from the stack, so
+/// stages may add such filters unconditionally.
+void grpc_channel_init_register_filter_activity(
+    const grpc_channel_filter *filter,
+    grpc_channel_filter_is_active_func is_active);
+
+/// Would \a filter do any work on a channel created with \a args? Filters
+/// that declared nothing are always active.
+bool grpc_channel_init_filter_is_active(const grpc_channel_filter *filter,
+                                        const grpc_channel_args *args);
+
 /// Finalize registration. No more calls to grpc_channel_init_register_stage are
 /// allowed.
 void grpc_channel_init_finalize(void);
@@ -226,6 +226,13 @@ typedef struct cq_next_data {
 
   /** 0 initially. 1 once we initiated shutdown */
   bool shutdown_called;
+
+  /** The exec_ctx kick_closure is scheduled on, or 0 while it is not */
+  gpr_atm kick_scheduled;
+
+  /** Kicks the pollset once the exec_ctx that completed the first queued
+      event flushes, for all the events it completes until then */
+  grpc_closure kick_closure;
 } cq_next_data;
 
 typedef struct cq_pluck_data {
@@ -440,6 +447,7 @@ static void cq_init_next(void *ptr) {
   gpr_atm_no_barrier_store(&cqd->pending_events, 1);
   cqd->shutdown_called = false;
   gpr_atm_no_barrier_store(&cqd->things_queued_ever, 0);
+  gpr_atm_no_barrier_store(&cqd->kick_scheduled, 0);
   cq_event_queue_init(&cqd->queue);
 }
 
@@ -592,6 +600,62 @@ bool grpc_cq_begin_op(grpc_completion_queue *cq, void *tag) {
   return cq->vtable->begin_op(cq, tag);
 }
 
+static void cq_kick_pollset_next(grpc_exec_ctx *exec_ctx,
+                                 grpc_completion_queue *cq) {
+  gpr_mu_lock(cq->mu);
+  grpc_error *kick_error =
+      cq->poller_vtable->kick(exec_ctx, POLLSET_FROM_CQ(cq), NULL);
+  gpr_mu_unlock(cq->mu);
+
+  if (kick_error != GRPC_ERROR_NONE) {
+    const char *msg = grpc_error_string(kick_error);
+    gpr_log(GPR_ERROR, "Kick failed: %s", msg);
+    GRPC_ERROR_UNREF(kick_error);
+  }
+}
+
+static void cq_kick_next(grpc_exec_ctx *exec_ctx, void *arg,
+                         grpc_error *error) {
+  grpc_completion_queue *cq = (grpc_completion_queue *)arg;
+  cq_next_data *cqd = (cq_next_data *)DATA_FROM_CQ(cq);
+  /* Full barrier: a completion queued after this point schedules a new kick,
+     one queued before is seen below */
+  gpr_atm_full_xchg(&cqd->kick_scheduled, 0);
+  if (cq_event_queue_num_items(&cqd->queue) > 0) {
+    cq_kick_pollset_next(exec_ctx, cq);
+  } else {
+    /* Everything was popped by a thread that was not waiting for the kick */
+    GRPC_STATS_INC_CQ_KICKS_SKIPPED(exec_ctx);
+  }
+  GRPC_CQ_INTERNAL_UNREF(exec_ctx, cq, "kick");
+}
+
+/* The kick for the first event queued is deferred to the end of the current
+   exec_ctx flush: further events completed by the same exec_ctx (e.g. by all
+   the fds one epoll_wait returned) are covered by the same kick, even when
+   the queue was drained in between. An event completed by any other exec_ctx
+   while that kick is pending is kicked for right away, as nothing bounds how
+   long the owning exec_ctx takes to flush. */
+static void cq_schedule_kick_next(grpc_exec_ctx *exec_ctx,
+                                  grpc_completion_queue *cq) {
+  cq_next_data *cqd = (cq_next_data *)DATA_FROM_CQ(cq);
+  if (!gpr_atm_full_cas(&cqd->kick_scheduled, 0, (gpr_atm)exec_ctx)) {
+    /* Only this exec_ctx ever stores itself here, so a stale read can only
+       cause a spurious kick, never a missed one */
+    if (gpr_atm_acq_load(&cqd->kick_scheduled) == (gpr_atm)exec_ctx) {
+      GRPC_STATS_INC_CQ_KICKS_COALESCED(exec_ctx);
+    } else {
+      cq_kick_pollset_next(exec_ctx, cq);
+    }
+    return;
+  }
+  GRPC_CQ_INTERNAL_REF(cq, "kick");
+  GRPC_CLOSURE_SCHED(exec_ctx, GRPC_CLOSURE_INIT(&cqd->kick_closure,
+                                                 cq_kick_next, cq,
+                                                 grpc_schedule_on_exec_ctx),
+                     GRPC_ERROR_NONE);
+}
+
 /* Queue a GRPC_OP_COMPLETED operation to a completion queue (with a
  * completion
  * type of GRPC_CQ_NEXT) */
@@ -641,16 +705,7 @@ static void cq_end_op_for_next(grpc_exec_ctx *exec_ctx,
   if (!will_definitely_shutdown) {
     /* Only kick if this is the first item queued */
     if (is_first) {
-      gpr_mu_lock(cq->mu);
-      grpc_error *kick_error =
-          cq->poller_vtable->kick(exec_ctx, POLLSET_FROM_CQ(cq), NULL);
-      gpr_mu_unlock(cq->mu);
-
-      if (kick_error != GRPC_ERROR_NONE) {
-        const char *msg = grpc_error_string(kick_error);
-        gpr_log(GPR_ERROR, "Kick failed: %s", msg);
-        GRPC_ERROR_UNREF(kick_error);
-      }
+      cq_schedule_kick_next(exec_ctx, cq);
     }
     if (gpr_atm_full_fetch_add(&cqd->pending_events, -1) == 1) {
       GRPC_CQ_INTERNAL_REF(cq, "shutting_down");
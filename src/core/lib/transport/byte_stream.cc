@@ -105,6 +105,114 @@ void grpc_slice_buffer_stream_init(grpc_slice_buffer_stream *stream,
   stream->shutdown_error = GRPC_ERROR_NONE;
 }
 
+// grpc_message_object_stream
+
+static bool message_object_stream_next(grpc_exec_ctx *exec_ctx,
+                                       grpc_byte_stream *byte_stream,
+                                       size_t max_size_hint,
+                                       grpc_closure *on_complete) {
+  grpc_message_object_stream *stream =
+      (grpc_message_object_stream *)byte_stream;
+  if (stream->serialized) return true;
+  stream->serialized = true;
+  if (stream->buffer == NULL || stream->buffer->data.object.object == NULL) {
+    stream->shutdown_error =
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Message object was taken");
+    return true;
+  }
+  grpc_byte_buffer *serialized =
+      stream->buffer->data.object.vtable->serialize(
+          stream->buffer->data.object.object);
+  if (serialized == NULL || serialized->type != GRPC_BB_RAW ||
+      serialized->data.raw.compression != GRPC_COMPRESS_NONE ||
+      serialized->data.raw.slice_buffer.length != stream->base.length) {
+    stream->shutdown_error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Failed to serialize message object");
+  } else {
+    grpc_slice_buffer_move_into(&serialized->data.raw.slice_buffer,
+                                &stream->slices);
+  }
+  grpc_byte_buffer_destroy(serialized);
+  return true;
+}
+
+static grpc_error *message_object_stream_pull(grpc_exec_ctx *exec_ctx,
+                                              grpc_byte_stream *byte_stream,
+                                              grpc_slice *slice) {
+  grpc_message_object_stream *stream =
+      (grpc_message_object_stream *)byte_stream;
+  if (stream->shutdown_error != GRPC_ERROR_NONE) {
+    return GRPC_ERROR_REF(stream->shutdown_error);
+  }
+  GPR_ASSERT(stream->cursor < stream->slices.count);
+  *slice = grpc_slice_ref_internal(stream->slices.slices[stream->cursor]);
+  stream->cursor++;
+  return GRPC_ERROR_NONE;
+}
+
+static void message_object_stream_shutdown(grpc_exec_ctx *exec_ctx,
+                                           grpc_byte_stream *byte_stream,
+                                           grpc_error *error) {
+  grpc_message_object_stream *stream =
+      (grpc_message_object_stream *)byte_stream;
+  GRPC_ERROR_UNREF(stream->shutdown_error);
+  stream->shutdown_error = error;
+}
+
+static void message_object_stream_destroy(grpc_exec_ctx *exec_ctx,
+                                          grpc_byte_stream *byte_stream) {
+  grpc_message_object_stream *stream =
+      (grpc_message_object_stream *)byte_stream;
+  grpc_slice_buffer_destroy_internal(exec_ctx, &stream->slices);
+  GRPC_ERROR_UNREF(stream->shutdown_error);
+  if (stream->owns_buffer) {
+    grpc_byte_buffer_destroy(stream->buffer);
+  }
+}
+
+static const grpc_byte_stream_vtable message_object_stream_vtable = {
+    message_object_stream_next, message_object_stream_pull,
+    message_object_stream_shutdown, message_object_stream_destroy};
+
+void grpc_message_object_stream_init(grpc_message_object_stream *stream,
+                                     grpc_byte_buffer *buffer, bool owns_buffer,
+                                     uint32_t flags) {
+  GPR_ASSERT(buffer->type == GRPC_BB_OBJECT);
+  GPR_ASSERT(buffer->data.object.length <= UINT32_MAX);
+  stream->base.length = (uint32_t)buffer->data.object.length;
+  stream->base.flags = flags;
+  stream->base.vtable = &message_object_stream_vtable;
+  stream->buffer = buffer;
+  stream->owns_buffer = owns_buffer;
+  stream->serialized = false;
+  grpc_slice_buffer_init(&stream->slices);
+  stream->cursor = 0;
+  stream->shutdown_error = GRPC_ERROR_NONE;
+}
+
+grpc_byte_buffer *grpc_byte_stream_take_message_object(
+    grpc_byte_stream *byte_stream) {
+  if (byte_stream->vtable != &message_object_stream_vtable) return NULL;
+  grpc_message_object_stream *stream =
+      (grpc_message_object_stream *)byte_stream;
+  if (stream->serialized || stream->buffer == NULL ||
+      stream->buffer->data.object.object == NULL) {
+    return NULL;
+  }
+  grpc_byte_buffer *taken;
+  if (stream->owns_buffer) {
+    taken = stream->buffer;
+    stream->buffer = NULL;
+  } else {
+    const grpc_message_object_vtable *vtable =
+        stream->buffer->data.object.vtable;
+    taken = grpc_message_object_byte_buffer_create(
+        vtable, grpc_byte_buffer_take_message_object(stream->buffer, vtable),
+        stream->buffer->data.object.length);
+  }
+  return taken;
+}
+
 // grpc_caching_byte_stream
 
 void grpc_byte_stream_cache_init(grpc_byte_stream_cache *cache,
@@ -19,6 +19,7 @@
 #ifndef GRPC_CORE_LIB_TRANSPORT_BYTE_STREAM_H
 #define GRPC_CORE_LIB_TRANSPORT_BYTE_STREAM_H
 
+#include <grpc/byte_buffer.h>
 #include <grpc/slice_buffer.h>
 #include "src/core/lib/iomgr/exec_ctx.h"
 
@@ -100,6 +101,35 @@ void grpc_slice_buffer_stream_init(grpc_slice_buffer_stream *stream,
                                    grpc_slice_buffer *slice_buffer,
                                    uint32_t flags);
 
+// grpc_message_object_stream
+//
+// A grpc_byte_stream over a GRPC_BB_OBJECT byte buffer. Transports that can
+// hand the message object to the other end of the call take it with
+// grpc_byte_stream_take_message_object. Anything reading the stream instead
+// gets the object serialized on the first call to grpc_byte_stream_next.
+
+typedef struct grpc_message_object_stream {
+  grpc_byte_stream base;
+  grpc_byte_buffer *buffer;
+  bool owns_buffer;
+  bool serialized;
+  grpc_slice_buffer slices;
+  size_t cursor;
+  grpc_error *shutdown_error;
+} grpc_message_object_stream;
+
+// If owns_buffer is true, the stream destroys buffer on destruction.
+// Otherwise buffer must outlive the stream.
+void grpc_message_object_stream_init(grpc_message_object_stream *stream,
+                                     grpc_byte_buffer *buffer, bool owns_buffer,
+                                     uint32_t flags);
+
+// If byte_stream is a grpc_message_object_stream that has not been read from,
+// moves its message object into a GRPC_BB_OBJECT byte buffer owned by the
+// caller. Returns NULL otherwise.
+grpc_byte_buffer *grpc_byte_stream_take_message_object(
+    grpc_byte_stream *byte_stream);
+
 // grpc_caching_byte_stream
 //
 // A grpc_byte_stream that that wraps an underlying byte stream but caches
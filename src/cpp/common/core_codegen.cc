@@ -32,6 +32,7 @@
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/surface/call.h"
 
 extern "C" {
 struct grpc_byte_buffer;
@@ -108,6 +109,10 @@ void* CoreCodegen::grpc_call_arena_alloc(grpc_call* call, size_t length) {
   return ::grpc_call_arena_alloc(call, length);
 }
 
+bool CoreCodegen::grpc_call_passes_message_objects(grpc_call* call) {
+  return ::grpc_call_passes_message_objects(call);
+}
+
 int CoreCodegen::grpc_byte_buffer_reader_init(grpc_byte_buffer_reader* reader,
                                               grpc_byte_buffer* buffer) {
   return ::grpc_byte_buffer_reader_init(reader, buffer);
@@ -128,6 +133,16 @@ grpc_byte_buffer* CoreCodegen::grpc_raw_byte_buffer_create(grpc_slice* slice,
   return ::grpc_raw_byte_buffer_create(slice, nslices);
 }
 
+grpc_byte_buffer* CoreCodegen::grpc_message_object_byte_buffer_create(
+    const grpc_message_object_vtable* vtable, void* object, size_t length) {
+  return ::grpc_message_object_byte_buffer_create(vtable, object, length);
+}
+
+void* CoreCodegen::grpc_byte_buffer_take_message_object(
+    grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable) {
+  return ::grpc_byte_buffer_take_message_object(bb, vtable);
+}
+
 grpc_slice CoreCodegen::grpc_slice_new_with_user_data(void* p, size_t len,
                                                       void (*destroy)(void*),
                                                       void* user_data) {
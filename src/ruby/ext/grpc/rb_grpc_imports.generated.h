@@ -461,6 +461,12 @@ extern grpc_raw_byte_buffer_create_type grpc_raw_byte_buffer_create_import;
 typedef grpc_byte_buffer *(*grpc_raw_compressed_byte_buffer_create_type)(grpc_slice *slices, size_t nslices, grpc_compression_algorithm compression);
 extern grpc_raw_compressed_byte_buffer_create_type grpc_raw_compressed_byte_buffer_create_import;
 #define grpc_raw_compressed_byte_buffer_create grpc_raw_compressed_byte_buffer_create_import
+typedef grpc_byte_buffer *(*grpc_message_object_byte_buffer_create_type)(const grpc_message_object_vtable *vtable, void *object, size_t length);
+extern grpc_message_object_byte_buffer_create_type grpc_message_object_byte_buffer_create_import;
+#define grpc_message_object_byte_buffer_create grpc_message_object_byte_buffer_create_import
+typedef void *(*grpc_byte_buffer_take_message_object_type)(grpc_byte_buffer *bb, const grpc_message_object_vtable *vtable);
+extern grpc_byte_buffer_take_message_object_type grpc_byte_buffer_take_message_object_import;
+#define grpc_byte_buffer_take_message_object grpc_byte_buffer_take_message_object_import
 typedef grpc_byte_buffer *(*grpc_byte_buffer_copy_type)(grpc_byte_buffer *bb);
 extern grpc_byte_buffer_copy_type grpc_byte_buffer_copy_import;
 #define grpc_byte_buffer_copy grpc_byte_buffer_copy_import
@@ -23,6 +23,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "src/core/ext/census/base_resources.h"
 #include "src/core/ext/census/resource.h"
 #include "test/core/util/test_config.h"
@@ -200,6 +201,62 @@ static void test_buffer_size() {
   GPR_ASSERT(msg_length == 0);
 }
 
+/* Decodes buffer with both decode_trace_context() and
+decode_trace_context_fast(), checking that they agree. */
+static bool decode_both(uint8_t *buffer, size_t msg_length,
+                        google_trace_TraceContext *ctxt) {
+  google_trace_TraceContext slow = google_trace_TraceContext_init_zero;
+  bool res = decode_trace_context(&slow, buffer, msg_length);
+  GPR_ASSERT(decode_trace_context_fast(ctxt, buffer, msg_length) == res);
+  if (res) {
+    GPR_ASSERT(ctxt->trace_id_hi == slow.trace_id_hi &&
+               ctxt->trace_id_lo == slow.trace_id_lo &&
+               ctxt->span_id == slow.span_id &&
+               ctxt->has_span_options == slow.has_span_options &&
+               ctxt->span_options == slow.span_options);
+  }
+  return res;
+}
+
+static void test_fast_decode() {
+  uint8_t buffer[BUF_SIZE] = {0};
+  google_trace_TraceContext ctxt1 = google_trace_TraceContext_init_zero;
+  google_trace_TraceContext ctxt2 = google_trace_TraceContext_init_zero;
+  size_t msg_length;
+
+  ctxt1.has_trace_id_hi = true;
+  ctxt1.trace_id_hi = 0x0102030405060708;
+  ctxt1.has_trace_id_lo = true;
+  ctxt1.trace_id_lo = 0xf1f2f3f4f5f6f7f8;
+  ctxt1.has_span_id = true;
+  ctxt1.span_id = 3;
+  msg_length = encode_trace_context(&ctxt1, buffer, sizeof(buffer));
+  GPR_ASSERT(decode_both(buffer, msg_length, &ctxt2));
+  GPR_ASSERT(ctxt2.trace_id_hi == ctxt1.trace_id_hi &&
+             !ctxt2.has_span_options);
+
+  ctxt1.has_span_options = true;
+  ctxt1.span_options = SPAN_OPTIONS_IS_SAMPLED;
+  msg_length = encode_trace_context(&ctxt1, buffer, sizeof(buffer));
+  GPR_ASSERT(decode_both(buffer, msg_length, &ctxt2));
+  GPR_ASSERT(ctxt2.has_span_options &&
+             ctxt2.span_options == SPAN_OPTIONS_IS_SAMPLED);
+
+  /* Fields out of order: not the fixed layout, but still a valid context. */
+  uint8_t reordered[BUF_SIZE];
+  memcpy(reordered, buffer + 18, 9);
+  memcpy(reordered + 9, buffer, 18);
+  memcpy(reordered + 27, buffer + 27, msg_length - 27);
+  GPR_ASSERT(decode_both(reordered, msg_length, &ctxt2));
+  GPR_ASSERT(ctxt2.span_id == 3);
+
+  /* Truncated and corrupted contexts fail either way. */
+  GPR_ASSERT(!decode_both(buffer, msg_length - 1, &ctxt2));
+  buffer[0] = 255;
+  GPR_ASSERT(!decode_both(buffer, msg_length, &ctxt2));
+  GPR_ASSERT(!decode_both(buffer, 0, &ctxt2));
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_full();
@@ -210,6 +267,7 @@ int main(int argc, char **argv) {
   test_corrupt();
   test_no_span_options();
   test_buffer_size();
+  test_fast_decode();
 
   return 0;
 }
@@ -143,6 +143,60 @@ static void test_set_socket_mutator(void) {
   }
 }
 
+static void test_preprocessed(void) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_arg args[4];
+  args[0] = grpc_channel_arg_string_create("b", "first b");
+  args[1] = grpc_channel_arg_integer_create("a", 1);
+  args[2] = grpc_channel_arg_string_create("b", "second b");
+  args[3] = grpc_channel_arg_integer_create("c", 3);
+  grpc_channel_args ch_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_preprocessed_channel_args *p =
+      grpc_preprocessed_channel_args_create(&ch_args);
+
+  const grpc_channel_args *normalized = grpc_preprocessed_channel_args_get(p);
+  GPR_ASSERT(normalized->num_args == 4);
+  GPR_ASSERT(strcmp(normalized->args[0].key, "a") == 0);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(args); i++) {
+    GPR_ASSERT(grpc_preprocessed_channel_args_find(p, args[i].key) ==
+               grpc_channel_args_find(normalized, args[i].key));
+  }
+  GPR_ASSERT(strcmp(grpc_preprocessed_channel_args_find(p, "b")->value.string,
+                    "first b") == 0);
+  GPR_ASSERT(grpc_preprocessed_channel_args_find(p, "d") == NULL);
+  GPR_ASSERT(grpc_preprocessed_channel_args_get_integer(
+                 p, "c", (grpc_integer_options){0, 0, 10}) == 3);
+  GPR_ASSERT(grpc_preprocessed_channel_args_get_bool(p, "a", false));
+  GPR_ASSERT(!grpc_preprocessed_channel_args_get_bool(p, "d", false));
+
+  /* The same args in another order (keeping the order of the two 'b' args)
+     compare equal; changing any value does not */
+  grpc_arg reordered_args[4] = {args[3], args[0], args[1], args[2]};
+  grpc_channel_args reordered = {GPR_ARRAY_SIZE(reordered_args),
+                                 reordered_args};
+  grpc_preprocessed_channel_args *q =
+      grpc_preprocessed_channel_args_create(&reordered);
+  GPR_ASSERT(grpc_preprocessed_channel_args_compare(p, q) == 0);
+  grpc_preprocessed_channel_args_unref(&exec_ctx, q);
+  reordered_args[0].value.integer = 4;
+  q = grpc_preprocessed_channel_args_create(&reordered);
+  GPR_ASSERT(grpc_preprocessed_channel_args_compare(p, q) != 0);
+  GPR_ASSERT(grpc_preprocessed_channel_args_compare(p, q) ==
+             -grpc_preprocessed_channel_args_compare(q, p));
+  grpc_preprocessed_channel_args_unref(&exec_ctx, q);
+
+  q = grpc_preprocessed_channel_args_create(NULL);
+  GPR_ASSERT(grpc_preprocessed_channel_args_get(q)->num_args == 0);
+  GPR_ASSERT(grpc_preprocessed_channel_args_find(q, "a") == NULL);
+  GPR_ASSERT(grpc_preprocessed_channel_args_compare(p, q) != 0);
+  grpc_preprocessed_channel_args_unref(&exec_ctx, q);
+
+  GPR_ASSERT(grpc_preprocessed_channel_args_ref(p) == p);
+  grpc_preprocessed_channel_args_unref(&exec_ctx, p);
+  grpc_preprocessed_channel_args_unref(&exec_ctx, p);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   grpc_init();
@@ -150,6 +204,7 @@ int main(int argc, char **argv) {
   test_set_compression_algorithm();
   test_compression_algorithm_states();
   test_set_socket_mutator();
+  test_preprocessed();
   grpc_shutdown();
   return 0;
 }
@@ -61,6 +61,7 @@ static void channel_func(grpc_exec_ctx *exec_ctx, grpc_channel_element *elem,
 
 bool g_replacement_fn_called = false;
 bool g_original_fn_called = false;
+bool g_optional_fn_called = false;
 void set_arg_once_fn(grpc_channel_stack *channel_stack,
                      grpc_channel_element *elem, void *arg) {
   bool *called = arg;
@@ -80,6 +81,27 @@ static void test_channel_stack_builder_filter_replace(void) {
   grpc_channel_destroy(channel);
 }
 
+static void test_channel_stack_builder_drops_inactive_filter(void) {
+  g_replacement_fn_called = false;
+  grpc_channel *channel =
+      grpc_insecure_channel_create("target name isn't used", NULL, NULL);
+  GPR_ASSERT(channel != NULL);
+  // Dropped: its post-init function never runs...
+  GPR_ASSERT(!g_optional_fn_called);
+  // ... while those of its neighbours still do.
+  GPR_ASSERT(g_replacement_fn_called);
+  grpc_channel_destroy(channel);
+
+  g_replacement_fn_called = false;
+  grpc_arg arg = grpc_channel_arg_integer_create("test.optional_filter", 1);
+  grpc_channel_args args = {1, &arg};
+  channel = grpc_insecure_channel_create("target name isn't used", &args, NULL);
+  GPR_ASSERT(channel != NULL);
+  GPR_ASSERT(g_optional_fn_called);
+  GPR_ASSERT(g_replacement_fn_called);
+  grpc_channel_destroy(channel);
+}
+
 const grpc_channel_filter replacement_filter = {
     call_func,
     channel_func,
@@ -117,6 +139,31 @@ static bool add_replacement_filter(grpc_exec_ctx *exec_ctx,
       builder, filter, set_arg_once_fn, &g_replacement_fn_called);
 }
 
+const grpc_channel_filter optional_filter = {
+    call_func,
+    channel_func,
+    0,
+    call_init_func,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    call_destroy_func,
+    0,
+    channel_init_func,
+    channel_destroy_func,
+    grpc_channel_next_get_info,
+    "optional_filter"};
+
+static bool optional_filter_is_active(const grpc_channel_args *args) {
+  return grpc_channel_args_find(args, "test.optional_filter") != NULL;
+}
+
+static bool add_optional_filter(grpc_exec_ctx *exec_ctx,
+                                grpc_channel_stack_builder *builder,
+                                void *arg) {
+  return grpc_channel_stack_builder_prepend_filter(
+      builder, (const grpc_channel_filter *)arg, set_arg_once_fn,
+      &g_optional_fn_called);
+}
+
 static bool add_original_filter(grpc_exec_ctx *exec_ctx,
                                 grpc_channel_stack_builder *builder,
                                 void *arg) {
@@ -132,6 +179,11 @@ static void init_plugin(void) {
   grpc_channel_init_register_stage(GRPC_CLIENT_CHANNEL, INT_MAX,
                                    add_replacement_filter,
                                    (void *)&replacement_filter);
+  grpc_channel_init_register_stage(GRPC_CLIENT_CHANNEL, INT_MAX,
+                                   add_optional_filter,
+                                   (void *)&optional_filter);
+  grpc_channel_init_register_filter_activity(&optional_filter,
+                                             optional_filter_is_active);
 }
 
 static void destroy_plugin(void) {}
@@ -141,6 +193,7 @@ int main(int argc, char **argv) {
   grpc_register_plugin(init_plugin, destroy_plugin);
   grpc_init();
   test_channel_stack_builder_filter_replace();
+  test_channel_stack_builder_drops_inactive_filter();
   grpc_shutdown();
   return 0;
 }
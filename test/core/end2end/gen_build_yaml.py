@@ -52,6 +52,7 @@ END2END_FIXTURES = {
         ci_mac=False, exclude_iomgrs=['uv']),
     'h2_proxy': default_unsecure_fixture_options._replace(
         includes_proxy=True, ci_mac=False, exclude_iomgrs=['uv']),
+    'h2_shm': fd_unsecure_fixture_options._replace(platforms=['linux']),
     'h2_sockpair_1byte': socketpair_unsecure_fixture_options._replace(
         ci_mac=False, exclude_configs=['msan'], large_writes=False,
         exclude_iomgrs=['uv']),
@@ -53,6 +53,8 @@ END2END_FIXTURES = {
     'h2_http_proxy': fixture_options(supports_proxy_auth=True),
     'h2_oauth2': fixture_options(),
     'h2_proxy': fixture_options(includes_proxy=True),
+    'h2_shm': fixture_options(dns_resolver=False, fullstack=False,
+                              platforms=['linux']),
     'h2_sockpair_1byte': fixture_options(fullstack=False, dns_resolver=False),
     'h2_sockpair': fixture_options(fullstack=False, dns_resolver=False),
     'h2_sockpair+trace': fixture_options(fullstack=False, dns_resolver=False,
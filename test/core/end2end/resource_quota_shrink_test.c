@@ -0,0 +1,439 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Shrink the resource quota of a server with idle connections that have just
+   received large messages, and that each buffer a small message the
+   application has not read yet: the memory they keep for their next reads, and
+   the read buffers the small messages were sliced from, should be handed back
+   without any connection being dropped. */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <grpc/byte_buffer_reader.h>
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/host_port.h>
+#include <grpc/support/log.h>
+#include <grpc/support/useful.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/resource_quota.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#define NUM_CHANNELS 16
+#define LARGE_MESSAGE_SIZE (1024 * 1024)
+#define SMALL_MESSAGE_SIZE 1024
+#define INITIAL_QUOTA_SIZE (256 * 1024 * 1024)
+#define SHRUNK_QUOTA_SIZE (2 * 1024 * 1024)
+/* the server reads into buffers at least this large, so that every buffered
+   small message pins one: together more than the shrunk quota */
+#define MIN_READ_CHUNK_SIZE (256 * 1024)
+
+static grpc_completion_queue *g_cq;
+static cq_verifier *g_cqv;
+static grpc_server *g_server;
+
+static void *tag(intptr_t i) { return (void *)i; }
+
+/* resident set size, or 0 where /proc is not available */
+static size_t rss_bytes(void) {
+  FILE *f = fopen("/proc/self/statm", "r");
+  if (f == NULL) return 0;
+  unsigned long size = 0;
+  unsigned long resident = 0;
+  int n = fscanf(f, "%lu %lu", &size, &resident);
+  fclose(f);
+  return n == 2 ? (size_t)resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+}
+
+static size_t quota_usage(grpc_resource_quota *quota, size_t size) {
+  return (size_t)(grpc_resource_quota_get_memory_pressure(quota) *
+                  (double)size);
+}
+
+static void unary_call(grpc_channel *channel, size_t request_size) {
+  grpc_slice request_payload = grpc_slice_malloc(request_size);
+  memset(GRPC_SLICE_START_PTR(request_payload), 'a', request_size);
+  grpc_byte_buffer *request = grpc_raw_byte_buffer_create(&request_payload, 1);
+  grpc_slice response_payload = grpc_slice_from_static_string("ok");
+  grpc_byte_buffer *response =
+      grpc_raw_byte_buffer_create(&response_payload, 1);
+  grpc_byte_buffer *request_recv = NULL;
+  grpc_byte_buffer *response_recv = NULL;
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_metadata_array request_metadata_recv;
+  grpc_call_details call_details;
+  grpc_status_code status;
+  grpc_slice details;
+  int was_cancelled = 2;
+  grpc_op ops[6];
+  grpc_op *op;
+
+  grpc_metadata_array_init(&initial_metadata_recv);
+  grpc_metadata_array_init(&trailing_metadata_recv);
+  grpc_metadata_array_init(&request_metadata_recv);
+  grpc_call_details_init(&call_details);
+
+  grpc_call *c = grpc_channel_create_call(
+      channel, NULL, GRPC_PROPAGATE_DEFAULTS, g_cq,
+      grpc_slice_from_static_string("/foo"), NULL,
+      grpc_timeout_seconds_to_deadline(30), NULL);
+  GPR_ASSERT(c);
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op++;
+  op->op = GRPC_OP_SEND_MESSAGE;
+  op->data.send_message.send_message = request;
+  op++;
+  op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  op++;
+  op->op = GRPC_OP_RECV_INITIAL_METADATA;
+  op->data.recv_initial_metadata.recv_initial_metadata = &initial_metadata_recv;
+  op++;
+  op->op = GRPC_OP_RECV_MESSAGE;
+  op->data.recv_message.recv_message = &response_recv;
+  op++;
+  op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  op->data.recv_status_on_client.trailing_metadata = &trailing_metadata_recv;
+  op->data.recv_status_on_client.status = &status;
+  op->data.recv_status_on_client.status_details = &details;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_call_start_batch(c, ops, (size_t)(op - ops), tag(1), NULL));
+
+  grpc_call *s;
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_server_request_call(g_server, &s, &call_details,
+                                      &request_metadata_recv, g_cq, g_cq,
+                                      tag(101)));
+  CQ_EXPECT_COMPLETION(g_cqv, tag(101), 1);
+  cq_verify(g_cqv);
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op++;
+  op->op = GRPC_OP_RECV_MESSAGE;
+  op->data.recv_message.recv_message = &request_recv;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_call_start_batch(s, ops, (size_t)(op - ops), tag(102), NULL));
+  CQ_EXPECT_COMPLETION(g_cqv, tag(102), 1);
+  cq_verify(g_cqv);
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op->data.recv_close_on_server.cancelled = &was_cancelled;
+  op++;
+  op->op = GRPC_OP_SEND_MESSAGE;
+  op->data.send_message.send_message = response;
+  op++;
+  op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  op->data.send_status_from_server.trailing_metadata_count = 0;
+  op->data.send_status_from_server.status = GRPC_STATUS_OK;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_call_start_batch(s, ops, (size_t)(op - ops), tag(103), NULL));
+  CQ_EXPECT_COMPLETION(g_cqv, tag(103), 1);
+  CQ_EXPECT_COMPLETION(g_cqv, tag(1), 1);
+  cq_verify(g_cqv);
+
+  GPR_ASSERT(status == GRPC_STATUS_OK);
+  GPR_ASSERT(was_cancelled == 0);
+  GPR_ASSERT(grpc_byte_buffer_length(request_recv) == request_size);
+
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&initial_metadata_recv);
+  grpc_metadata_array_destroy(&trailing_metadata_recv);
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_details_destroy(&call_details);
+  grpc_call_unref(c);
+  grpc_call_unref(s);
+  grpc_byte_buffer_destroy(request);
+  grpc_byte_buffer_destroy(response);
+  grpc_byte_buffer_destroy(request_recv);
+  grpc_byte_buffer_destroy(response_recv);
+  grpc_slice_unref(request_payload);
+}
+
+/* A call whose request the server has accepted but not read */
+typedef struct {
+  grpc_call *client;
+  grpc_call *server;
+  grpc_byte_buffer *request;
+  grpc_byte_buffer *request_recv;
+  grpc_byte_buffer *response;
+  grpc_byte_buffer *response_recv;
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_metadata_array request_metadata_recv;
+  grpc_call_details call_details;
+  grpc_status_code status;
+  grpc_slice details;
+  int was_cancelled;
+} buffered_call;
+
+static void *buffered_tag(size_t i, intptr_t step) {
+  return tag(2000 + 10 * (intptr_t)i + step);
+}
+
+static void start_buffered_call(grpc_channel *channel, buffered_call *call,
+                                size_t i) {
+  memset(call, 0, sizeof(*call));
+  grpc_slice request_payload = grpc_slice_malloc(SMALL_MESSAGE_SIZE);
+  memset(GRPC_SLICE_START_PTR(request_payload), 'b', SMALL_MESSAGE_SIZE);
+  call->request = grpc_raw_byte_buffer_create(&request_payload, 1);
+  grpc_slice_unref(request_payload);
+  grpc_metadata_array_init(&call->initial_metadata_recv);
+  grpc_metadata_array_init(&call->trailing_metadata_recv);
+  grpc_metadata_array_init(&call->request_metadata_recv);
+  grpc_call_details_init(&call->call_details);
+  call->was_cancelled = 2;
+
+  /* headers the server receives as unindexed literals (a grpc-timeout, or
+     the path of an unregistered call) keep referencing the read buffer they
+     arrived in, the same one as the message: avoid them so that only the
+     message pins it */
+  call->client = grpc_channel_create_registered_call(
+      channel, NULL, GRPC_PROPAGATE_DEFAULTS, g_cq,
+      grpc_channel_register_call(channel, "/foo", NULL, NULL),
+      gpr_inf_future(GPR_CLOCK_REALTIME), NULL);
+  GPR_ASSERT(call->client);
+
+  grpc_op ops[6];
+  grpc_op *op;
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op++;
+  op->op = GRPC_OP_SEND_MESSAGE;
+  op->data.send_message.send_message = call->request;
+  op++;
+  op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  op++;
+  op->op = GRPC_OP_RECV_INITIAL_METADATA;
+  op->data.recv_initial_metadata.recv_initial_metadata =
+      &call->initial_metadata_recv;
+  op++;
+  op->op = GRPC_OP_RECV_MESSAGE;
+  op->data.recv_message.recv_message = &call->response_recv;
+  op++;
+  op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  op->data.recv_status_on_client.trailing_metadata =
+      &call->trailing_metadata_recv;
+  op->data.recv_status_on_client.status = &call->status;
+  op->data.recv_status_on_client.status_details = &call->details;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(call->client, ops,
+                                                   (size_t)(op - ops),
+                                                   buffered_tag(i, 1), NULL));
+
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_server_request_call(g_server, &call->server,
+                                      &call->call_details,
+                                      &call->request_metadata_recv, g_cq, g_cq,
+                                      buffered_tag(i, 2)));
+  CQ_EXPECT_COMPLETION(g_cqv, buffered_tag(i, 2), 1);
+  cq_verify(g_cqv);
+}
+
+static void finish_buffered_call(buffered_call *call, size_t i) {
+  grpc_op ops[4];
+  grpc_op *op;
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op++;
+  op->op = GRPC_OP_RECV_MESSAGE;
+  op->data.recv_message.recv_message = &call->request_recv;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(call->server, ops,
+                                                   (size_t)(op - ops),
+                                                   buffered_tag(i, 3), NULL));
+  CQ_EXPECT_COMPLETION(g_cqv, buffered_tag(i, 3), 1);
+  cq_verify(g_cqv);
+
+  /* compacting must not have changed what was buffered */
+  grpc_byte_buffer_reader reader;
+  GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, call->request_recv));
+  grpc_slice received = grpc_byte_buffer_reader_readall(&reader);
+  grpc_byte_buffer_reader_destroy(&reader);
+  GPR_ASSERT(GRPC_SLICE_LENGTH(received) == SMALL_MESSAGE_SIZE);
+  for (size_t j = 0; j < SMALL_MESSAGE_SIZE; j++) {
+    GPR_ASSERT(GRPC_SLICE_START_PTR(received)[j] == 'b');
+  }
+  grpc_slice_unref(received);
+
+  grpc_slice response_payload = grpc_slice_from_static_string("ok");
+  call->response = grpc_raw_byte_buffer_create(&response_payload, 1);
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op->data.recv_close_on_server.cancelled = &call->was_cancelled;
+  op++;
+  op->op = GRPC_OP_SEND_MESSAGE;
+  op->data.send_message.send_message = call->response;
+  op++;
+  op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  op->data.send_status_from_server.trailing_metadata_count = 0;
+  op->data.send_status_from_server.status = GRPC_STATUS_OK;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(call->server, ops,
+                                                   (size_t)(op - ops),
+                                                   buffered_tag(i, 4), NULL));
+  CQ_EXPECT_COMPLETION(g_cqv, buffered_tag(i, 4), 1);
+  CQ_EXPECT_COMPLETION(g_cqv, buffered_tag(i, 1), 1);
+  cq_verify(g_cqv);
+
+  GPR_ASSERT(call->status == GRPC_STATUS_OK);
+  GPR_ASSERT(call->was_cancelled == 0);
+
+  grpc_slice_unref(call->details);
+  grpc_metadata_array_destroy(&call->initial_metadata_recv);
+  grpc_metadata_array_destroy(&call->trailing_metadata_recv);
+  grpc_metadata_array_destroy(&call->request_metadata_recv);
+  grpc_call_details_destroy(&call->call_details);
+  grpc_call_unref(call->client);
+  grpc_call_unref(call->server);
+  grpc_byte_buffer_destroy(call->request);
+  grpc_byte_buffer_destroy(call->request_recv);
+  grpc_byte_buffer_destroy(call->response);
+  grpc_byte_buffer_destroy(call->response_recv);
+}
+
+static void check_all_ready(grpc_channel **channels) {
+  for (size_t i = 0; i < NUM_CHANNELS; i++) {
+    GPR_ASSERT(grpc_channel_check_connectivity_state(channels[i], 0) ==
+               GRPC_CHANNEL_READY);
+  }
+}
+
+static void test_shrink_with_idle_connections(void) {
+  gpr_log(GPR_INFO, "** test_shrink_with_idle_connections **");
+  grpc_resource_quota *quota = grpc_resource_quota_create("server");
+  grpc_resource_quota_resize(quota, INITIAL_QUOTA_SIZE);
+
+  grpc_arg server_arg[] = {
+      grpc_channel_arg_pointer_create(GRPC_ARG_RESOURCE_QUOTA, quota,
+                                      grpc_resource_quota_arg_vtable()),
+      grpc_channel_arg_integer_create(GRPC_ARG_TCP_MIN_READ_CHUNK_SIZE,
+                                      MIN_READ_CHUNK_SIZE)};
+  grpc_channel_args server_args = {GPR_ARRAY_SIZE(server_arg), server_arg};
+  g_server = grpc_server_create(&server_args, NULL);
+  grpc_server_register_completion_queue(g_server, g_cq, NULL);
+  char *addr;
+  gpr_join_host_port(&addr, "localhost", grpc_pick_unused_port_or_die());
+  GPR_ASSERT(grpc_server_add_insecure_http2_port(g_server, addr));
+  grpc_server_start(g_server);
+
+  grpc_channel *channels[NUM_CHANNELS];
+  for (size_t i = 0; i < NUM_CHANNELS; i++) {
+    /* keep the channels on separate connections */
+    grpc_arg arg = grpc_channel_arg_integer_create("grpc.testing.channel_id",
+                                                   (int)i);
+    grpc_channel_args args = {1, &arg};
+    channels[i] = grpc_insecure_channel_create(addr, &args, NULL);
+    unary_call(channels[i], LARGE_MESSAGE_SIZE);
+  }
+  buffered_call buffered[NUM_CHANNELS];
+  for (size_t i = 0; i < NUM_CHANNELS; i++) {
+    start_buffered_call(channels[i], &buffered[i], i);
+  }
+  check_all_ready(channels);
+  /* let the server's reads go idle, and the small messages arrive */
+  cq_verify_empty_timeout(g_cqv, 1);
+
+  size_t rss_before = rss_bytes();
+  size_t usage_before = quota_usage(quota, INITIAL_QUOTA_SIZE);
+  gpr_log(GPR_INFO, "before shrinking: quota usage %" PRIuPTR
+                    " KiB, rss %" PRIuPTR " KiB",
+          usage_before / 1024, rss_before / 1024);
+  GPR_ASSERT(usage_before > SHRUNK_QUOTA_SIZE);
+  /* the buffered messages alone pin that much */
+  GPR_ASSERT(usage_before >= NUM_CHANNELS * MIN_READ_CHUNK_SIZE);
+
+  grpc_resource_quota_resize(quota, SHRUNK_QUOTA_SIZE);
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (grpc_resource_quota_get_memory_pressure(quota) >= 1.0) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    cq_verify_empty_timeout(g_cqv, 1);
+  }
+  size_t rss_after = rss_bytes();
+  size_t usage_after = quota_usage(quota, SHRUNK_QUOTA_SIZE);
+  /* freed memory may stay with the allocator, so rss is only reported */
+  gpr_log(GPR_INFO, "after shrinking: quota usage %" PRIuPTR
+                    " KiB, rss %" PRIuPTR " KiB (%" PRIdPTR " KiB recovered)",
+          usage_after / 1024, rss_after / 1024,
+          ((intptr_t)rss_before - (intptr_t)rss_after) / 1024);
+
+  /* the read buffers the buffered messages pinned would not fit: the messages
+     were compacted into slices of their own size */
+  GPR_ASSERT(NUM_CHANNELS * MIN_READ_CHUNK_SIZE > SHRUNK_QUOTA_SIZE);
+  GPR_ASSERT(usage_after < SHRUNK_QUOTA_SIZE);
+
+  /* nothing was disconnected to get there, and the connections still work */
+  check_all_ready(channels);
+  for (size_t i = 0; i < NUM_CHANNELS; i++) {
+    finish_buffered_call(&buffered[i], i);
+  }
+  for (size_t i = 0; i < NUM_CHANNELS; i++) {
+    unary_call(channels[i], SMALL_MESSAGE_SIZE);
+  }
+  check_all_ready(channels);
+
+  for (size_t i = 0; i < NUM_CHANNELS; i++) {
+    grpc_channel_destroy(channels[i]);
+  }
+  grpc_server_shutdown_and_notify(g_server, g_cq, tag(1000));
+  CQ_EXPECT_COMPLETION(g_cqv, tag(1000), 1);
+  cq_verify(g_cqv);
+  grpc_server_destroy(g_server);
+  grpc_resource_quota_unref(quota);
+  gpr_free(addr);
+}
+
+int main(int argc, char **argv) {
+  grpc_test_init(argc, argv);
+  grpc_init();
+  g_cq = grpc_completion_queue_create_for_next(NULL);
+  g_cqv = cq_verifier_create(g_cq);
+
+  test_shrink_with_idle_connections();
+
+  cq_verifier_destroy(g_cqv);
+  grpc_completion_queue_shutdown(g_cq);
+  while (grpc_completion_queue_next(g_cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    NULL)
+             .type != GRPC_QUEUE_SHUTDOWN)
+    ;
+  grpc_completion_queue_destroy(g_cq);
+  grpc_shutdown();
+  return 0;
+}
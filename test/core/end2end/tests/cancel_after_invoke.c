@@ -23,7 +23,9 @@
 
 #include <grpc/byte_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
 #include <grpc/support/useful.h>
 #include "test/core/end2end/cq_verifier.h"
@@ -88,14 +90,41 @@ static void end_test(grpc_end2end_test_fixture *f) {
   grpc_completion_queue_destroy(f->shutdown_cq);
 }
 
+/* Message objects that are still alive */
+static gpr_atm g_live_objects;
+
+static grpc_byte_buffer *serialize_string(void *object) {
+  grpc_slice slice = grpc_slice_from_copied_string((const char *)object);
+  grpc_byte_buffer *buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_slice_unref(slice);
+  return buffer;
+}
+
+static void destroy_string(void *object) {
+  gpr_free(object);
+  gpr_atm_no_barrier_fetch_add(&g_live_objects, -1);
+}
+
+static const grpc_message_object_vtable string_vtable = {serialize_string,
+                                                         destroy_string};
+
+static grpc_byte_buffer *string_object_buffer(const char *str) {
+  gpr_atm_no_barrier_fetch_add(&g_live_objects, 1);
+  return grpc_message_object_byte_buffer_create(&string_vtable, gpr_strdup(str),
+                                                strlen(str));
+}
+
 /* Cancel after invoke, no payload */
 static void test_cancel_after_invoke(grpc_end2end_test_config config,
-                                     cancellation_mode mode, size_t test_ops) {
+                                     const char *test_name,
+                                     cancellation_mode mode, size_t test_ops,
+                                     grpc_channel_args *args,
+                                     bool message_object) {
   grpc_op ops[6];
   grpc_op *op;
   grpc_call *c;
-  grpc_end2end_test_fixture f = begin_test(config, "test_cancel_after_invoke",
-                                           mode, test_ops, NULL, NULL);
+  grpc_end2end_test_fixture f =
+      begin_test(config, test_name, mode, test_ops, args, args);
   cq_verifier *cqv = cq_verifier_create(f.cq);
   grpc_metadata_array initial_metadata_recv;
   grpc_metadata_array trailing_metadata_recv;
@@ -108,7 +137,8 @@ static void test_cancel_after_invoke(grpc_end2end_test_config config,
   grpc_slice request_payload_slice =
       grpc_slice_from_copied_string("hello world");
   grpc_byte_buffer *request_payload =
-      grpc_raw_byte_buffer_create(&request_payload_slice, 1);
+      message_object ? string_object_buffer("hello world")
+                     : grpc_raw_byte_buffer_create(&request_payload_slice, 1);
 
   gpr_timespec deadline = five_seconds_from_now();
   c = grpc_channel_create_call(
@@ -174,12 +204,15 @@ static void test_cancel_after_invoke(grpc_end2end_test_config config,
   grpc_byte_buffer_destroy(request_payload);
   grpc_byte_buffer_destroy(response_payload_recv);
   grpc_slice_unref(details);
+  grpc_slice_unref(request_payload_slice);
 
   grpc_call_unref(c);
 
   cq_verifier_destroy(cqv);
   end_test(&f);
   config.tear_down_data(&f);
+
+  GPR_ASSERT(gpr_atm_no_barrier_load(&g_live_objects) == 0);
 }
 
 void cancel_after_invoke(grpc_end2end_test_config config) {
@@ -187,9 +220,36 @@ void cancel_after_invoke(grpc_end2end_test_config config) {
 
   for (j = 3; j < 6; j++) {
     for (i = 0; i < GPR_ARRAY_SIZE(cancellation_modes); i++) {
-      test_cancel_after_invoke(config, cancellation_modes[i], j);
+      test_cancel_after_invoke(config, "test_cancel_after_invoke",
+                               cancellation_modes[i], j, NULL, false);
     }
   }
+
+  /* With a one second horizon the five second deadline is kept off the
+     timers until shortly before it expires */
+  grpc_arg arg;
+  arg.type = GRPC_ARG_INTEGER;
+  arg.key = (char *)GRPC_ARG_DEADLINE_TIMER_HORIZON_MS;
+  arg.value.integer = 1000;
+  grpc_channel_args args = {1, &arg};
+  for (i = 0; i < GPR_ARRAY_SIZE(cancellation_modes); i++) {
+    test_cancel_after_invoke(config,
+                             "test_cancel_after_invoke_with_deferred_deadline",
+                             cancellation_modes[i], 6, &args, false);
+  }
+
+  /* The message object is never read by the server: whatever owns it when
+     the call is cancelled must free it */
+  grpc_arg objects_arg;
+  objects_arg.type = GRPC_ARG_INTEGER;
+  objects_arg.key = (char *)GRPC_ARG_INPROC_MESSAGE_OBJECTS;
+  objects_arg.value.integer = 1;
+  grpc_channel_args objects_args = {1, &objects_arg};
+  for (i = 0; i < GPR_ARRAY_SIZE(cancellation_modes); i++) {
+    test_cancel_after_invoke(config,
+                             "test_cancel_after_invoke_with_message_object",
+                             cancellation_modes[i], 6, &objects_args, true);
+  }
 }
 
 void cancel_after_invoke_pre_init(void) {}
@@ -0,0 +1,221 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/lib/iomgr/port.h"
+
+/* This test only relevant on linux systems where epoll() is available */
+#ifdef GRPC_LINUX_EPOLL
+#include "src/core/lib/iomgr/ev_epoll1_linux.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/thd.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/iomgr/iomgr.h"
+#include "src/core/lib/support/env.h"
+#include "test/core/util/test_config.h"
+
+/* Threads pick their neighborhood here instead of from their cpu, so that
+   handoffs between neighborhoods happen even on a single core */
+static __thread size_t thread_neighborhood = 0;
+
+static size_t choose_thread_neighborhood(void) { return thread_neighborhood; }
+
+typedef struct {
+  int pipe_fds[2];
+  grpc_fd *fd;
+  grpc_closure on_read;
+  /* reads processed so far, and the thread that processed the last one */
+  gpr_atm reads;
+  gpr_thd_id reader;
+  /* polled from neighborhood 1 by the poller thread until done is set */
+  grpc_pollset *away;
+  gpr_mu *away_mu;
+  gpr_atm done;
+} handoff_shared;
+
+static void destroy_pollset(grpc_exec_ctx *exec_ctx, void *p,
+                            grpc_error *error) {
+  grpc_pollset_destroy(exec_ctx, p);
+}
+
+static void on_read(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
+  handoff_shared *shared = arg;
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  char c;
+  GPR_ASSERT(read(shared->pipe_fds[0], &c, 1) == 1);
+  shared->reader = gpr_thd_currentid();
+  gpr_atm_rel_store(&shared->reads,
+                    gpr_atm_no_barrier_load(&shared->reads) + 1);
+}
+
+static void write_byte(handoff_shared *shared) {
+  GPR_ASSERT(write(shared->pipe_fds[1], "x", 1) == 1);
+}
+
+static void work_until_reads(handoff_shared *shared, grpc_pollset *pollset,
+                             gpr_mu *mu, gpr_atm reads) {
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  gpr_mu_lock(mu);
+  while (gpr_atm_acq_load(&shared->reads) < reads) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_pollset_worker *worker = NULL;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(&exec_ctx, pollset, &worker,
+                          grpc_exec_ctx_now(&exec_ctx) + 1000)));
+    gpr_mu_unlock(mu);
+    grpc_exec_ctx_finish(&exec_ctx);
+    gpr_mu_lock(mu);
+  }
+  gpr_mu_unlock(mu);
+}
+
+static void away_poller_loop(void *arg) {
+  handoff_shared *shared = arg;
+  thread_neighborhood = 1;
+  gpr_mu_lock(shared->away_mu);
+  while (!gpr_atm_acq_load(&shared->done)) {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_pollset_worker *worker = NULL;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(&exec_ctx, shared->away, &worker,
+                                          GRPC_MILLIS_INF_FUTURE)));
+    gpr_mu_unlock(shared->away_mu);
+    grpc_exec_ctx_finish(&exec_ctx);
+    gpr_mu_lock(shared->away_mu);
+  }
+  gpr_mu_unlock(shared->away_mu);
+}
+
+static void delayed_write(void *arg) {
+  /* by then the main thread waits in its pollset behind the away poller */
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(300));
+  write_byte(arg);
+}
+
+/* The fd's first read is processed by the main thread (neighborhood 0), which
+   makes that its home. Its next readiness is seen by a designated poller in
+   neighborhood 1, which must hand it over to the main thread, idle at home */
+static void test_handoff_to_home_neighborhood(void) {
+  gpr_log(GPR_INFO, "** test_handoff_to_home_neighborhood **");
+  handoff_shared shared;
+  memset(&shared, 0, sizeof(shared));
+  GPR_ASSERT(pipe(shared.pipe_fds) == 0);
+  shared.fd = grpc_fd_create(shared.pipe_fds[0], "handoff");
+  GRPC_CLOSURE_INIT(&shared.on_read, on_read, &shared,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset *home = gpr_zalloc(grpc_pollset_size());
+  gpr_mu *home_mu;
+  grpc_pollset_init(home, &home_mu);
+  shared.away = gpr_zalloc(grpc_pollset_size());
+  grpc_pollset_init(shared.away, &shared.away_mu);
+
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_pollset_add_fd(&exec_ctx, home, shared.fd);
+    grpc_fd_notify_on_read(&exec_ctx, shared.fd, &shared.on_read);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  write_byte(&shared);
+  work_until_reads(&shared, home, home_mu, 1);
+  GPR_ASSERT(shared.reader == gpr_thd_currentid());
+
+  gpr_thd_options opt = gpr_thd_options_default();
+  gpr_thd_options_set_joinable(&opt);
+  gpr_thd_id away_poller;
+  GPR_ASSERT(gpr_thd_new(&away_poller, away_poller_loop, &shared, &opt));
+  /* let the away thread become the designated poller first */
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100));
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_fd_notify_on_read(&exec_ctx, shared.fd, &shared.on_read);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  gpr_thd_id writer;
+  GPR_ASSERT(gpr_thd_new(&writer, delayed_write, &shared, &opt));
+  work_until_reads(&shared, home, home_mu, 2);
+  GPR_ASSERT(shared.reader == gpr_thd_currentid());
+  gpr_thd_join(writer);
+
+  grpc_stats_data after;
+  grpc_stats_collect(&after);
+  GPR_ASSERT(after.counters[GRPC_STATS_COUNTER_FD_AFFINITY_HANDOFFS] >
+             before.counters[GRPC_STATS_COUNTER_FD_AFFINITY_HANDOFFS]);
+
+  gpr_atm_rel_store(&shared.done, 1);
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    gpr_mu_lock(shared.away_mu);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_kick", grpc_pollset_kick(&exec_ctx, shared.away, NULL)));
+    gpr_mu_unlock(shared.away_mu);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  gpr_thd_join(away_poller);
+
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_fd_shutdown(&exec_ctx, shared.fd, GRPC_ERROR_CANCELLED);
+    grpc_fd_orphan(&exec_ctx, shared.fd, NULL, NULL,
+                   false /* already_closed */, "done");
+    close(shared.pipe_fds[1]);
+    grpc_pollset_shutdown(&exec_ctx, home,
+                          GRPC_CLOSURE_CREATE(destroy_pollset, home,
+                                              grpc_schedule_on_exec_ctx));
+    grpc_pollset_shutdown(&exec_ctx, shared.away,
+                          GRPC_CLOSURE_CREATE(destroy_pollset, shared.away,
+                                              grpc_schedule_on_exec_ctx));
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  gpr_free(home);
+  gpr_free(shared.away);
+}
+
+int main(int argc, char **argv) {
+  const char *poll_strategy = NULL;
+  grpc_test_init(argc, argv);
+  gpr_setenv("GRPC_EPOLL1_FD_AFFINITY", "1");
+  grpc_epoll1_set_neighborhoods_for_testing(2, choose_thread_neighborhood);
+  grpc_init();
+
+  poll_strategy = grpc_get_poll_strategy_name();
+  if (poll_strategy != NULL && strcmp(poll_strategy, "epoll1") == 0) {
+    test_handoff_to_home_neighborhood();
+  } else {
+    gpr_log(GPR_INFO,
+            "Skipping the test. The test is only relevant for 'epoll1' "
+            "strategy. and the current strategy is: '%s'",
+            poll_strategy);
+  }
+
+  grpc_shutdown();
+  return 0;
+}
+#else /* defined(GRPC_LINUX_EPOLL) */
+int main(int argc, char **argv) { return 0; }
+#endif /* !defined(GRPC_LINUX_EPOLL) */
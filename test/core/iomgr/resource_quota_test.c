@@ -20,6 +20,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/useful.h>
 
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/test_config.h"
@@ -733,6 +734,15 @@ static void test_one_slice(void) {
     assert_counter_becomes(&num_allocs, start_allocs + 1);
   }
 
+  /* the allocation is found from the slice and from any part of it */
+  GPR_ASSERT(grpc_resource_user_slice_allocation_size(buffer.slices[0]) ==
+             1024);
+  grpc_slice part = grpc_slice_sub_no_ref(buffer.slices[0], 10, 20);
+  GPR_ASSERT(grpc_resource_user_slice_allocation_size(part) == 1024);
+  grpc_slice other = grpc_slice_malloc(1024);
+  GPR_ASSERT(grpc_resource_user_slice_allocation_size(other) == 0);
+  grpc_slice_unref(other);
+
   {
     grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
     grpc_slice_buffer_destroy_internal(&exec_ctx, &buffer);
@@ -780,6 +790,33 @@ static void test_one_slice_deleted_late(void) {
   }
 }
 
+static void test_slice_malloc_outlives_shutdown(void) {
+  gpr_log(GPR_INFO, "** test_slice_malloc_outlives_shutdown **");
+
+  grpc_resource_quota *q =
+      grpc_resource_quota_create("test_slice_malloc_outlives_shutdown");
+  grpc_resource_quota_resize(q, 1024);
+
+  grpc_resource_user *usr = grpc_resource_user_create(q, "usr");
+
+  /* more than the quota: the allocation is still pending when the user shuts
+     down, but the slice was handed out already and must keep its memory */
+  grpc_slice slice;
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    slice = grpc_resource_user_slice_malloc(&exec_ctx, usr, 2048);
+    grpc_resource_user_shutdown(&exec_ctx, usr);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_slice_unref_internal(&exec_ctx, slice);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  destroy_user(usr);
+  grpc_resource_quota_unref(q);
+}
+
 static void test_resize_to_zero(void) {
   gpr_log(GPR_INFO, "** test_resize_to_zero **");
   grpc_resource_quota *q = grpc_resource_quota_create("test_resize_to_zero");
@@ -830,6 +867,177 @@ static void test_negative_rq_free_pool(void) {
   }
 }
 
+/* Users allocating from a mostly unused quota get slabs: check that those
+   (and the per-cpu slabs) are given back when someone needs the whole quota */
+static void test_scavenge_slabs(void) {
+  gpr_log(GPR_INFO, "** test_scavenge_slabs **");
+  const size_t quota_size = 16 * 1024 * 1024;
+  grpc_resource_quota *q = grpc_resource_quota_create("test_scavenge_slabs");
+  grpc_resource_quota_resize(q, quota_size);
+  grpc_resource_user *usrs[8];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(usrs); i++) {
+    usrs[i] = grpc_resource_user_create(q, "usr");
+    {
+      gpr_event ev;
+      gpr_event_init(&ev);
+      grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+      grpc_resource_user_alloc(&exec_ctx, usrs[i], 1024, set_event(&ev));
+      grpc_exec_ctx_finish(&exec_ctx);
+      GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+                 NULL);
+    }
+    {
+      grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+      grpc_resource_user_free(&exec_ctx, usrs[i], 1024);
+      grpc_exec_ctx_finish(&exec_ctx);
+    }
+  }
+  grpc_resource_user *big = grpc_resource_user_create(q, "big");
+  {
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_alloc(&exec_ctx, big, quota_size, set_event(&ev));
+    grpc_exec_ctx_finish(&exec_ctx);
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               NULL);
+  }
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_free(&exec_ctx, big, quota_size);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  grpc_resource_quota_unref(q);
+  destroy_user(big);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(usrs); i++) {
+    destroy_user(usrs[i]);
+  }
+}
+
+static void test_cache_reclaim_is_preferred(void) {
+  gpr_log(GPR_INFO, "** test_cache_reclaim_is_preferred **");
+  grpc_resource_quota *q =
+      grpc_resource_quota_create("test_cache_reclaim_is_preferred");
+  grpc_resource_quota_resize(q, 1024);
+  grpc_resource_user *usr = grpc_resource_user_create(q, "usr");
+  gpr_event cache_done[2];
+  gpr_event_init(&cache_done[0]);
+  gpr_event_init(&cache_done[1]);
+  gpr_event benign_done;
+  gpr_event_init(&benign_done);
+  {
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_alloc(&exec_ctx, usr, 1024, set_event(&ev));
+    grpc_exec_ctx_finish(&exec_ctx);
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               NULL);
+  }
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_post_reclaimer(
+        &exec_ctx, usr, false, make_unused_reclaimer(set_event(&benign_done)));
+    grpc_resource_user_post_cache_reclaimer(
+        &exec_ctx, usr, make_reclaimer(usr, 512, set_event(&cache_done[0])));
+    grpc_resource_user_post_cache_reclaimer(
+        &exec_ctx, usr, make_reclaimer(usr, 512, set_event(&cache_done[1])));
+    grpc_exec_ctx_finish(&exec_ctx);
+    GPR_ASSERT(gpr_event_wait(&cache_done[0],
+                              grpc_timeout_milliseconds_to_deadline(100)) ==
+               NULL);
+  }
+  {
+    /* needs both cache reclaimers to run, but not the benign one */
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_alloc(&exec_ctx, usr, 1024, set_event(&ev));
+    grpc_exec_ctx_finish(&exec_ctx);
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               NULL);
+    GPR_ASSERT(gpr_event_wait(&cache_done[0],
+                              grpc_timeout_seconds_to_deadline(5)) != NULL);
+    GPR_ASSERT(gpr_event_wait(&cache_done[1],
+                              grpc_timeout_seconds_to_deadline(5)) != NULL);
+    GPR_ASSERT(gpr_event_wait(&benign_done,
+                              grpc_timeout_milliseconds_to_deadline(100)) ==
+               NULL);
+  }
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_free(&exec_ctx, usr, 1024);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  grpc_resource_quota_unref(q);
+  destroy_user(usr);
+  GPR_ASSERT(gpr_event_wait(&benign_done,
+                            grpc_timeout_seconds_to_deadline(5)) != NULL);
+}
+
+/* Shrinking a quota below what is allocated runs cache reclaimers (only) even
+   though nothing is waiting for memory */
+static void test_shrink_runs_cache_reclaimers(void) {
+  gpr_log(GPR_INFO, "** test_shrink_runs_cache_reclaimers **");
+  grpc_resource_quota *q =
+      grpc_resource_quota_create("test_shrink_runs_cache_reclaimers");
+  grpc_resource_quota_resize(q, 2048);
+  grpc_resource_user *usr = grpc_resource_user_create(q, "usr");
+  gpr_event cache_done;
+  gpr_event_init(&cache_done);
+  gpr_event cache_cancelled;
+  gpr_event_init(&cache_cancelled);
+  gpr_event benign_done;
+  gpr_event_init(&benign_done);
+  {
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_alloc(&exec_ctx, usr, 2048, set_event(&ev));
+    grpc_exec_ctx_finish(&exec_ctx);
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               NULL);
+  }
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_post_reclaimer(
+        &exec_ctx, usr, false, make_unused_reclaimer(set_event(&benign_done)));
+    grpc_resource_user_post_cache_reclaimer(
+        &exec_ctx, usr, make_reclaimer(usr, 1024, set_event(&cache_done)));
+    grpc_exec_ctx_finish(&exec_ctx);
+    GPR_ASSERT(gpr_event_wait(&cache_done,
+                              grpc_timeout_milliseconds_to_deadline(100)) ==
+               NULL);
+  }
+  grpc_resource_quota_resize(q, 1024);
+  GPR_ASSERT(gpr_event_wait(&cache_done, grpc_timeout_seconds_to_deadline(5)) !=
+             NULL);
+  {
+    /* back under the limit: further cache reclaimers wait for pressure */
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_post_cache_reclaimer(
+        &exec_ctx, usr, make_unused_reclaimer(set_event(&cache_cancelled)));
+    grpc_exec_ctx_finish(&exec_ctx);
+    GPR_ASSERT(gpr_event_wait(&cache_cancelled,
+                              grpc_timeout_milliseconds_to_deadline(100)) ==
+               NULL);
+    GPR_ASSERT(gpr_event_wait(&benign_done,
+                              grpc_timeout_milliseconds_to_deadline(100)) ==
+               NULL);
+  }
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_resource_user_free(&exec_ctx, usr, 1024);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  grpc_resource_quota_unref(q);
+  destroy_user(usr);
+  GPR_ASSERT(gpr_event_wait(&cache_cancelled,
+                            grpc_timeout_seconds_to_deadline(5)) != NULL);
+  GPR_ASSERT(gpr_event_wait(&benign_done,
+                            grpc_timeout_seconds_to_deadline(5)) != NULL);
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   grpc_init();
@@ -855,8 +1063,12 @@ int main(int argc, char **argv) {
   test_reclaimers_can_be_posted_repeatedly();
   test_one_slice();
   test_one_slice_deleted_late();
+  test_slice_malloc_outlives_shutdown();
   test_resize_to_zero();
   test_negative_rq_free_pool();
+  test_scavenge_slabs();
+  test_cache_reclaim_is_preferred();
+  test_shrink_runs_cache_reclaimers();
   gpr_mu_destroy(&g_mu);
   gpr_cv_destroy(&g_cv);
   grpc_shutdown();
@@ -25,6 +25,8 @@
 
 #include <errno.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -34,6 +36,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
@@ -188,6 +191,224 @@ void test_fails(void) {
   grpc_exec_ctx_finish(&exec_ctx);
 }
 
+static void keep_connection(grpc_exec_ctx *exec_ctx, void *arg,
+                            grpc_error *error) {
+  GPR_ASSERT(g_connecting != NULL);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  finish_connection();
+}
+
+static void write_done(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  *(bool *)arg = true;
+}
+
+#ifdef TCPI_OPT_SYN_DATA
+/* Both TCP Fast Open bits are set: client connects may send data in the SYN,
+   and listeners accept it */
+static bool fastopen_enabled(void) {
+  FILE *f = fopen("/proc/sys/net/ipv4/tcp_fastopen", "r");
+  int mode = 0;
+  if (f == NULL) return false;
+  if (fscanf(f, "%d", &mode) != 1) mode = 0;
+  fclose(f);
+  return (mode & 3) == 3;
+}
+#endif
+
+/* Connect with GRPC_ARG_TCP_FASTOPEN_CONNECT and check the first write
+   arrives. The first connect only fetches a cookie; when the kernel allows
+   it, the second carries its write in the SYN. */
+void test_fastopen(void) {
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in *addr = (struct sockaddr_in *)resolved_addr.addr;
+  grpc_arg arg = {
+      GRPC_ARG_INTEGER, GRPC_ARG_TCP_FASTOPEN_CONNECT, {.integer = 1}};
+  grpc_channel_args args = {1, &arg};
+  int svr_fd;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+
+  gpr_log(GPR_DEBUG, "test_fastopen");
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = sizeof(struct sockaddr_in);
+  addr->sin_family = AF_INET;
+
+  /* create a dummy server that accepts fast open connections */
+  svr_fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(svr_fd >= 0);
+  GPR_ASSERT(
+      0 == bind(svr_fd, (struct sockaddr *)addr, (socklen_t)resolved_addr.len));
+  GRPC_LOG_IF_ERROR("tcp_fastopen", grpc_set_socket_tcp_fastopen(svr_fd, 16));
+  GPR_ASSERT(0 == listen(svr_fd, 2));
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("set_nonblocking",
+                               grpc_set_socket_nonblocking(svr_fd, 1)));
+  GPR_ASSERT(getsockname(svr_fd, (struct sockaddr *)addr,
+                         (socklen_t *)&resolved_addr.len) == 0);
+
+  for (int i = 0; i < 2; i++) {
+    grpc_closure done;
+    grpc_closure written;
+    grpc_slice_buffer outgoing;
+    int connections_complete_before;
+    int conn_fd = -1;
+    char buf[5];
+    ssize_t received = 0;
+    bool write_finished = false;
+
+    gpr_mu_lock(g_mu);
+    connections_complete_before = g_connections_complete;
+    gpr_mu_unlock(g_mu);
+
+    GRPC_CLOSURE_INIT(&done, keep_connection, NULL,
+                      grpc_schedule_on_exec_ctx);
+    grpc_tcp_client_connect(&exec_ctx, &done, &g_connecting, g_pollset_set,
+                            &args, &resolved_addr, GRPC_MILLIS_INF_FUTURE);
+
+    /* the connect may be deferred to the first write, so start the write
+       before accepting */
+    gpr_mu_lock(g_mu);
+    while (g_connections_complete == connections_complete_before) {
+      grpc_pollset_worker *worker = NULL;
+      conn_fd = conn_fd >= 0 ? conn_fd : accept(svr_fd, NULL, NULL);
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(&exec_ctx, g_pollset, &worker,
+                            grpc_exec_ctx_now(&exec_ctx) + 10)));
+      gpr_mu_unlock(g_mu);
+      grpc_exec_ctx_flush(&exec_ctx);
+      gpr_mu_lock(g_mu);
+    }
+    gpr_mu_unlock(g_mu);
+
+    grpc_slice_buffer_init(&outgoing);
+    grpc_slice_buffer_add(&outgoing, grpc_slice_from_static_string("hello"));
+    GRPC_CLOSURE_INIT(&written, write_done, &write_finished,
+                      grpc_schedule_on_exec_ctx);
+    grpc_endpoint_write(&exec_ctx, g_connecting, &outgoing, &written);
+    grpc_exec_ctx_flush(&exec_ctx);
+
+    /* await the data */
+    gpr_mu_lock(g_mu);
+    while (received < (ssize_t)sizeof(buf) || !write_finished) {
+      grpc_pollset_worker *worker = NULL;
+      if (conn_fd < 0) conn_fd = accept(svr_fd, NULL, NULL);
+      if (conn_fd >= 0) {
+        ssize_t r = recv(conn_fd, buf + received,
+                         sizeof(buf) - (size_t)received, MSG_DONTWAIT);
+        GPR_ASSERT(r != 0);
+        if (r > 0) received += r;
+      }
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(&exec_ctx, g_pollset, &worker,
+                            grpc_exec_ctx_now(&exec_ctx) + 10)));
+      gpr_mu_unlock(g_mu);
+      grpc_exec_ctx_flush(&exec_ctx);
+      gpr_mu_lock(g_mu);
+    }
+    gpr_mu_unlock(g_mu);
+    GPR_ASSERT(0 == memcmp(buf, "hello", sizeof(buf)));
+
+#ifdef TCPI_OPT_SYN_DATA
+    if (i == 1 && fastopen_enabled()) {
+      struct tcp_info info;
+      socklen_t len = sizeof(info);
+      GPR_ASSERT(0 == getsockopt(grpc_endpoint_get_fd(g_connecting),
+                                 IPPROTO_TCP, TCP_INFO, &info, &len));
+      GPR_ASSERT(info.tcpi_options & TCPI_OPT_SYN_DATA);
+    }
+#endif
+
+    close(conn_fd);
+    grpc_endpoint_shutdown(
+        &exec_ctx, g_connecting,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("test_fastopen done"));
+    grpc_endpoint_destroy(&exec_ctx, g_connecting);
+    g_connecting = NULL;
+    grpc_slice_buffer_destroy(&outgoing);
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+
+  close(svr_fd);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+/* Connections get TCP_NOTSENT_LOWAT from GRPC_ARG_TCP_NOTSENT_LOWAT */
+void test_notsent_lowat(void) {
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in *addr = (struct sockaddr_in *)resolved_addr.addr;
+  grpc_arg arg = {
+      GRPC_ARG_INTEGER, GRPC_ARG_TCP_NOTSENT_LOWAT, {.integer = 16384}};
+  grpc_channel_args args = {1, &arg};
+  int svr_fd;
+  int r;
+  int connections_complete_before;
+  grpc_closure done;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+
+  gpr_log(GPR_DEBUG, "test_notsent_lowat");
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = sizeof(struct sockaddr_in);
+  addr->sin_family = AF_INET;
+
+  /* create a dummy server */
+  svr_fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(svr_fd >= 0);
+  GPR_ASSERT(
+      0 == bind(svr_fd, (struct sockaddr *)addr, (socklen_t)resolved_addr.len));
+  GPR_ASSERT(0 == listen(svr_fd, 1));
+
+  gpr_mu_lock(g_mu);
+  connections_complete_before = g_connections_complete;
+  gpr_mu_unlock(g_mu);
+
+  /* connect to it */
+  GPR_ASSERT(getsockname(svr_fd, (struct sockaddr *)addr,
+                         (socklen_t *)&resolved_addr.len) == 0);
+  GRPC_CLOSURE_INIT(&done, keep_connection, NULL, grpc_schedule_on_exec_ctx);
+  grpc_tcp_client_connect(&exec_ctx, &done, &g_connecting, g_pollset_set,
+                          &args, &resolved_addr, GRPC_MILLIS_INF_FUTURE);
+
+  /* await the connection */
+  do {
+    r = accept(svr_fd, NULL, NULL);
+  } while (r == -1 && errno == EINTR);
+  GPR_ASSERT(r >= 0);
+
+  gpr_mu_lock(g_mu);
+  while (g_connections_complete == connections_complete_before) {
+    grpc_pollset_worker *worker = NULL;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(&exec_ctx, g_pollset, &worker,
+                          grpc_timespec_to_millis_round_up(
+                              grpc_timeout_seconds_to_deadline(5)))));
+    gpr_mu_unlock(g_mu);
+    grpc_exec_ctx_flush(&exec_ctx);
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+
+#if defined(GPR_LINUX) && defined(TCP_NOTSENT_LOWAT)
+  int lowat = 0;
+  socklen_t len = sizeof(lowat);
+  GPR_ASSERT(0 == getsockopt(grpc_endpoint_get_fd(g_connecting), IPPROTO_TCP,
+                             TCP_NOTSENT_LOWAT, &lowat, &len));
+  GPR_ASSERT(lowat == 16384);
+#endif
+
+  close(r);
+  close(svr_fd);
+  grpc_endpoint_shutdown(
+      &exec_ctx, g_connecting,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("test_notsent_lowat done"));
+  grpc_endpoint_destroy(&exec_ctx, g_connecting);
+  g_connecting = NULL;
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
 static void destroy_pollset(grpc_exec_ctx *exec_ctx, void *p,
                             grpc_error *error) {
   grpc_pollset_destroy(exec_ctx, p);
@@ -206,6 +427,8 @@ int main(int argc, char **argv) {
   test_succeeds();
   gpr_log(GPR_ERROR, "End of first test");
   test_fails();
+  test_fastopen();
+  test_notsent_lowat();
   grpc_pollset_set_destroy(&exec_ctx, g_pollset_set);
   GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
                     grpc_schedule_on_exec_ctx);
@@ -26,6 +26,7 @@
 #include <errno.h>
 #include <ifaddrs.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/socket.h>
@@ -205,6 +206,38 @@ static void test_no_op_with_port(void) {
   grpc_exec_ctx_finish(&exec_ctx);
 }
 
+/* Listeners get TCP_FASTOPEN with the queue length from the channel args */
+static void test_fastopen_listener(void) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in *addr = (struct sockaddr_in *)resolved_addr.addr;
+  grpc_arg arg = {
+      GRPC_ARG_INTEGER, GRPC_ARG_TCP_FASTOPEN_QUEUE_LENGTH, {.integer = 16}};
+  const grpc_channel_args args = {1, &arg};
+  grpc_tcp_server *s;
+  GPR_ASSERT(GRPC_ERROR_NONE ==
+             grpc_tcp_server_create(&exec_ctx, NULL, &args, &s));
+  LOG_TEST("test_fastopen_listener");
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = sizeof(struct sockaddr_in);
+  addr->sin_family = AF_INET;
+  int port = -1;
+  GPR_ASSERT(grpc_tcp_server_add_port(s, &resolved_addr, &port) ==
+                 GRPC_ERROR_NONE &&
+             port > 0);
+#if defined(GPR_LINUX) && defined(TCP_FASTOPEN)
+  int queue_length = 0;
+  socklen_t len = sizeof(queue_length);
+  GPR_ASSERT(0 == getsockopt(grpc_tcp_server_port_fd(s, 0, 0), IPPROTO_TCP,
+                             TCP_FASTOPEN, &queue_length, &len));
+  GPR_ASSERT(queue_length == 16);
+#endif
+
+  grpc_tcp_server_unref(&exec_ctx, s);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
 static void test_no_op_with_port_and_start(void) {
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
   grpc_resolved_address resolved_addr;
@@ -450,6 +483,7 @@ int main(int argc, char **argv) {
   test_no_op();
   test_no_op_with_start();
   test_no_op_with_port();
+  test_fastopen_listener();
   test_no_op_with_port_and_start();
 
   if (getifaddrs(&ifa) != 0 || ifa == NULL) {
@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include <grpc/support/log.h>
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "test/core/util/test_config.h"
 
@@ -152,11 +153,72 @@ void destruction_test(void) {
   GPR_ASSERT(1 == cb_called[2][0]);
 }
 
+/* Timers with slack never fire early, fire within their slack, and those
+   armed close together fire at the same time. */
+void slack_test(void) {
+  grpc_timer timers[4];
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+
+  gpr_log(GPR_INFO, "slack_test");
+
+  exec_ctx.now_is_valid = true;
+  exec_ctx.now = 0;
+  grpc_timer_list_init(&exec_ctx);
+  memset(cb_called, 0, sizeof(cb_called));
+
+  /* rounded to 1024 and 1024 + 256 */
+  grpc_timer_init_with_slack(
+      &exec_ctx, &timers[0], 1001, 200,
+      GRPC_CLOSURE_CREATE(cb, (void *)(intptr_t)0, grpc_schedule_on_exec_ctx));
+  grpc_timer_init_with_slack(
+      &exec_ctx, &timers[1], 1020, 200,
+      GRPC_CLOSURE_CREATE(cb, (void *)(intptr_t)1, grpc_schedule_on_exec_ctx));
+  grpc_timer_init_with_slack(
+      &exec_ctx, &timers[2], 1030, 300,
+      GRPC_CLOSURE_CREATE(cb, (void *)(intptr_t)2, grpc_schedule_on_exec_ctx));
+  /* no slack: exactly on time */
+  grpc_timer_init_with_slack(
+      &exec_ctx, &timers[3], 1001, 1,
+      GRPC_CLOSURE_CREATE(cb, (void *)(intptr_t)3, grpc_schedule_on_exec_ctx));
+
+  exec_ctx.now = 1001;
+  GPR_ASSERT(grpc_timer_check(&exec_ctx, NULL) == GRPC_TIMERS_FIRED);
+  grpc_exec_ctx_finish(&exec_ctx);
+  GPR_ASSERT(cb_called[3][1] == 1);
+  GPR_ASSERT(cb_called[0][1] == 0);
+  GPR_ASSERT(cb_called[1][1] == 0);
+
+  exec_ctx.now = 1023;
+  GPR_ASSERT(grpc_timer_check(&exec_ctx, NULL) ==
+             GRPC_TIMERS_CHECKED_AND_EMPTY);
+  exec_ctx.now = 1024;
+  GPR_ASSERT(grpc_timer_check(&exec_ctx, NULL) == GRPC_TIMERS_FIRED);
+  grpc_exec_ctx_finish(&exec_ctx);
+  GPR_ASSERT(cb_called[0][1] == 1);
+  GPR_ASSERT(cb_called[1][1] == 1);
+  GPR_ASSERT(cb_called[2][1] == 0);
+
+  exec_ctx.now = 1279;
+  GPR_ASSERT(grpc_timer_check(&exec_ctx, NULL) ==
+             GRPC_TIMERS_CHECKED_AND_EMPTY);
+  exec_ctx.now = 1280;
+  GPR_ASSERT(grpc_timer_check(&exec_ctx, NULL) == GRPC_TIMERS_FIRED);
+  grpc_exec_ctx_finish(&exec_ctx);
+  GPR_ASSERT(cb_called[2][1] == 1);
+
+  grpc_timer_list_shutdown(&exec_ctx);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
+  /* the timer list counts armed timers */
+  grpc_stats_init();
   gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
   add_test();
   destruction_test();
+  slack_test();
+  grpc_stats_shutdown();
   return 0;
 }
 
@@ -75,6 +75,28 @@ static void on_write(grpc_exec_ctx *exec_ctx, grpc_fd *emfd, void *user_data) {
   gpr_mu_unlock(g_mu);
 }
 
+static int g_number_of_datagrams = 0;
+static int g_number_of_segments = 0;
+
+static void on_read_batch(grpc_exec_ctx *exec_ctx, grpc_fd *emfd,
+                          grpc_udp_datagram *datagrams, size_t count,
+                          void *user_data) {
+  gpr_mu_lock(g_mu);
+  for (size_t i = 0; i < count; i++) {
+    GPR_ASSERT(datagrams[i].addr.len > 0);
+    g_number_of_datagrams++;
+    g_number_of_bytes_read += (int)datagrams[i].length;
+    g_number_of_segments +=
+        datagrams[i].segment_size == 0
+            ? 1
+            : (int)((datagrams[i].length + datagrams[i].segment_size - 1) /
+                    datagrams[i].segment_size);
+  }
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("pollset_kick",
+                               grpc_pollset_kick(exec_ctx, g_pollset, NULL)));
+  gpr_mu_unlock(g_mu);
+}
+
 static void on_fd_orphaned(grpc_exec_ctx *exec_ctx, grpc_fd *emfd,
                            grpc_closure *closure, void *user_data) {
   gpr_log(GPR_INFO, "gRPC FD about to be orphaned: %d",
@@ -290,6 +312,103 @@ static void test_receive(int number_of_clients) {
   GPR_ASSERT(g_number_of_writes > 0);
 }
 
+/* Send datagrams to a batched port (with gro, a single datagram that the
+   kernel segments) and wait until the server has read them all */
+static void test_receive_batched(bool gro, size_t number_of_datagrams) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_storage *addr = (struct sockaddr_storage *)resolved_addr.addr;
+  grpc_arg args[2] = {
+      grpc_channel_arg_integer_create(GRPC_ARG_UDP_BATCH_SIZE, 4),
+      grpc_channel_arg_integer_create(GRPC_ARG_UDP_GRO, gro)};
+  grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_udp_server *s = grpc_udp_server_create(&channel_args);
+  grpc_pollset *pollsets[1];
+  uint8_t payload[100];
+  grpc_udp_datagram datagrams[20];
+  size_t sent;
+  LOG_TEST("test_receive_batched");
+  gpr_log(GPR_INFO, "gro=%d datagrams=%d", gro, (int)number_of_datagrams);
+  GPR_ASSERT(number_of_datagrams <= GPR_ARRAY_SIZE(datagrams));
+
+  g_number_of_datagrams = 0;
+  g_number_of_segments = 0;
+  g_number_of_bytes_read = 0;
+  g_number_of_orphan_calls = 0;
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = sizeof(struct sockaddr_storage);
+  addr->ss_family = AF_INET;
+  GPR_ASSERT(grpc_udp_server_add_batched_port(s, &resolved_addr, on_read_batch,
+                                              on_write, on_fd_orphaned));
+  int svrfd = grpc_udp_server_get_fd(s, 0);
+  GPR_ASSERT(svrfd >= 0);
+  GPR_ASSERT(getsockname(svrfd, (struct sockaddr *)addr,
+                         (socklen_t *)&resolved_addr.len) == 0);
+  pollsets[0] = g_pollset;
+  grpc_udp_server_start(&exec_ctx, s, pollsets, 1, NULL);
+
+  int clifd = socket(addr->ss_family, SOCK_DGRAM, 0);
+  GPR_ASSERT(clifd >= 0);
+  GPR_ASSERT(connect(clifd, (struct sockaddr *)addr,
+                     (socklen_t)resolved_addr.len) == 0);
+  memset(payload, 'x', sizeof(payload));
+  memset(datagrams, 0, sizeof(datagrams));
+  for (size_t i = 0; i < number_of_datagrams; i++) {
+    datagrams[i].data = payload;
+    datagrams[i].length = 10 + i;
+  }
+  size_t expected_datagrams = number_of_datagrams;
+  int expected_bytes = 0;
+  for (size_t i = 0; i < number_of_datagrams; i++) {
+    expected_bytes += (int)datagrams[i].length;
+  }
+  if (gro) {
+    /* one datagram, split by the kernel into four */
+    datagrams[0].length = 4 * 25;
+    datagrams[0].segment_size = 25;
+    expected_datagrams = 4;
+    expected_bytes = 100;
+    number_of_datagrams = 1;
+  }
+  grpc_error *error =
+      grpc_udp_send_batch(clifd, datagrams, number_of_datagrams, &sent);
+  if (gro && error != GRPC_ERROR_NONE) {
+    /* no segmentation offload on this system */
+    GRPC_LOG_IF_ERROR("grpc_udp_send_batch", error);
+    gpr_log(GPR_INFO, "skipping gro test: UDP_SEGMENT is not supported");
+    close(clifd);
+    grpc_udp_server_destroy(&exec_ctx, s, NULL);
+    grpc_exec_ctx_finish(&exec_ctx);
+    return;
+  }
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_udp_send_batch", error));
+  GPR_ASSERT(sent == number_of_datagrams);
+
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(10));
+  gpr_mu_lock(g_mu);
+  while (g_number_of_segments < (int)expected_datagrams &&
+         deadline > grpc_exec_ctx_now(&exec_ctx)) {
+    grpc_pollset_worker *worker = NULL;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(&exec_ctx, g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_exec_ctx_flush(&exec_ctx);
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(g_number_of_segments == (int)expected_datagrams);
+  GPR_ASSERT(g_number_of_bytes_read == expected_bytes);
+  gpr_log(GPR_INFO, "received %d datagrams", g_number_of_datagrams);
+  gpr_mu_unlock(g_mu);
+  close(clifd);
+
+  grpc_udp_server_destroy(&exec_ctx, s, NULL);
+  grpc_exec_ctx_finish(&exec_ctx);
+  GPR_ASSERT(g_number_of_orphan_calls == 1);
+}
+
 static void destroy_pollset(grpc_exec_ctx *exec_ctx, void *p,
                             grpc_error *error) {
   grpc_pollset_destroy(exec_ctx, p);
@@ -310,6 +429,11 @@ int main(int argc, char **argv) {
   test_no_op_with_port_and_start();
   test_receive(1);
   test_receive(10);
+  test_receive_batched(false, 1);
+  test_receive_batched(false, 10);
+  /* more than one wakeup reads: continued from the executor */
+  test_receive_batched(false, 20);
+  test_receive_batched(true, 1);
 
   GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
                     grpc_schedule_on_exec_ctx);
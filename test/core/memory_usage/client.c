@@ -152,18 +152,8 @@ static struct grpc_memory_counters send_snapshot_request(int call_idx,
   grpc_slice response = grpc_byte_buffer_reader_readall(&reader);
 
   struct grpc_memory_counters snapshot;
-  snapshot.total_size_absolute =
-      ((struct grpc_memory_counters *)GRPC_SLICE_START_PTR(response))
-          ->total_size_absolute;
-  snapshot.total_allocs_absolute =
-      ((struct grpc_memory_counters *)GRPC_SLICE_START_PTR(response))
-          ->total_allocs_absolute;
-  snapshot.total_size_relative =
-      ((struct grpc_memory_counters *)GRPC_SLICE_START_PTR(response))
-          ->total_size_relative;
-  snapshot.total_allocs_relative =
-      ((struct grpc_memory_counters *)GRPC_SLICE_START_PTR(response))
-          ->total_allocs_relative;
+  GPR_ASSERT(GRPC_SLICE_LENGTH(response) == sizeof(snapshot));
+  memcpy(&snapshot, GRPC_SLICE_START_PTR(response), sizeof(snapshot));
 
   grpc_metadata_array_destroy(&calls[call_idx].initial_metadata_recv);
   grpc_metadata_array_destroy(&calls[call_idx].trailing_metadata_recv);
@@ -178,6 +168,19 @@ static struct grpc_memory_counters send_snapshot_request(int call_idx,
   return snapshot;
 }
 
+/* log the per-subsystem breakdown of the memory allocated between \a start
+   and \a end, divided by \a divisor (e.g. the number of calls) */
+static void log_tagged_usage(const char *what,
+                             const struct grpc_memory_counters *start,
+                             const struct grpc_memory_counters *end,
+                             int divisor) {
+  for (size_t i = 0; i < GPR_ALLOC_TAG_COUNT; i++) {
+    gpr_log(GPR_INFO, "  %s %s: %f bytes", what,
+            gpr_alloc_tag_name((gpr_alloc_tag)i),
+            (double)(end->tagged_size[i] - start->tagged_size[i]) / divisor);
+  }
+}
+
 int main(int argc, char **argv) {
   grpc_memory_counters_init();
   grpc_slice slice = grpc_slice_from_copied_string("x");
@@ -285,9 +288,13 @@ int main(int argc, char **argv) {
           (double)(client_calls_inflight.total_size_relative -
                    client_benchmark_calls_start.total_size_relative) /
               benchmark_iterations);
+  log_tagged_usage("per call", &client_benchmark_calls_start,
+                   &client_calls_inflight, benchmark_iterations);
   gpr_log(GPR_INFO, "client channel memory usage %zi bytes",
           client_channel_end.total_size_relative -
               client_channel_start.total_size_relative);
+  log_tagged_usage("per channel", &client_channel_start, &client_channel_end,
+                   1);
 
   gpr_log(GPR_INFO, "---------server stats--------");
   gpr_log(GPR_INFO, "server create: %zi bytes",
@@ -297,9 +304,12 @@ int main(int argc, char **argv) {
           (double)(server_calls_inflight.total_size_relative -
                    server_benchmark_calls_start.total_size_relative) /
               benchmark_iterations);
+  log_tagged_usage("per call", &server_benchmark_calls_start,
+                   &server_calls_inflight, benchmark_iterations);
   gpr_log(GPR_INFO, "server channel memory usage %zi bytes",
           server_calls_end.total_size_relative -
               after_server_create.total_size_relative);
+  log_tagged_usage("per channel", &after_server_create, &server_calls_end, 1);
 
   const char *csv_file = "memory_usage.csv";
   FILE *csv = fopen(csv_file, "w");
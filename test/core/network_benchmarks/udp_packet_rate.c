@@ -0,0 +1,265 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+   Loopback UDP packet rate benchmark.
+
+   Bursts of datagrams are sent over loopback to a grpc_udp_server port and
+   then read back by polling the server, and the send and receive rates are
+   reported separately. Per datagram reads (grpc_udp_server_add_port with a
+   recv() loop) are compared with batched reads
+   (grpc_udp_server_add_batched_port), and send() with grpc_udp_send_batch.
+ */
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/cmdline.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+#include <grpc/support/useful.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/iomgr/udp_server.h"
+
+static grpc_pollset *g_pollset;
+static gpr_mu *g_mu;
+static int64_t g_datagrams_received;
+
+/* What a server that reads a datagram at a time does: it needs the peer
+   address too */
+static void on_read(grpc_exec_ctx *exec_ctx, grpc_fd *emfd, void *user_data) {
+  char buf[65536];
+  struct sockaddr_storage peer;
+  socklen_t peer_len = sizeof(peer);
+  while (recvfrom(grpc_fd_wrapped_fd(emfd), buf, sizeof(buf), 0,
+                  (struct sockaddr *)&peer, &peer_len) >= 0) {
+    g_datagrams_received++;
+    peer_len = sizeof(peer);
+  }
+}
+
+static void on_read_batch(grpc_exec_ctx *exec_ctx, grpc_fd *emfd,
+                          grpc_udp_datagram *datagrams, size_t count,
+                          void *user_data) {
+  for (size_t i = 0; i < count; i++) {
+    g_datagrams_received +=
+        datagrams[i].segment_size == 0
+            ? 1
+            : (int64_t)((datagrams[i].length + datagrams[i].segment_size - 1) /
+                        datagrams[i].segment_size);
+  }
+}
+
+static void on_write(grpc_exec_ctx *exec_ctx, grpc_fd *emfd, void *user_data) {
+}
+
+static void on_fd_orphaned(grpc_exec_ctx *exec_ctx, grpc_fd *emfd,
+                           grpc_closure *closure, void *user_data) {}
+
+/* Send up to burst datagrams, returning how many the socket accepted */
+static size_t send_burst(int fd, bool batched, grpc_udp_datagram *datagrams,
+                         size_t burst, size_t batch_size) {
+  size_t total = 0;
+  while (total < burst) {
+    size_t n = GPR_MIN(batch_size, burst - total);
+    size_t sent = 0;
+    if (batched) {
+      grpc_error *error = grpc_udp_send_batch(fd, datagrams, n, &sent);
+      GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_udp_send_batch", error));
+    } else {
+      while (sent < n &&
+             send(fd, datagrams[0].data, datagrams[0].length, 0) >= 0) {
+        sent++;
+      }
+    }
+    total += sent;
+    if (sent < n) break;
+  }
+  return total;
+}
+
+static double seconds_since(gpr_timespec start) {
+  return gpr_timespec_to_micros(
+             gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)) /
+         1e6;
+}
+
+static void run_benchmark(bool batched_recv, bool batched_send,
+                          size_t batch_size, size_t datagram_size,
+                          size_t burst, bool gro, int seconds) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in *addr = (struct sockaddr_in *)resolved_addr.addr;
+  grpc_arg args[2] = {
+      grpc_channel_arg_integer_create(GRPC_ARG_UDP_BATCH_SIZE,
+                                      (int)batch_size),
+      grpc_channel_arg_integer_create(GRPC_ARG_UDP_GRO, gro)};
+  grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_udp_server *s = grpc_udp_server_create(&channel_args);
+  grpc_pollset *pollsets[1] = {g_pollset};
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = sizeof(struct sockaddr_in);
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int port = batched_recv ? grpc_udp_server_add_batched_port(
+                                s, &resolved_addr, on_read_batch, on_write,
+                                on_fd_orphaned)
+                          : grpc_udp_server_add_port(s, &resolved_addr, on_read,
+                                                     on_write, on_fd_orphaned);
+  GPR_ASSERT(port > 0);
+  addr->sin_port = htons((uint16_t)port);
+  grpc_udp_server_start(&exec_ctx, s, pollsets, 1, NULL);
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  GPR_ASSERT(fd >= 0);
+  GPR_ASSERT(connect(fd, (struct sockaddr *)addr,
+                     (socklen_t)resolved_addr.len) == 0);
+  GPR_ASSERT(grpc_set_socket_nonblocking(fd, 1) == GRPC_ERROR_NONE);
+  uint8_t *payload = (uint8_t *)gpr_zalloc(datagram_size);
+  grpc_udp_datagram *datagrams =
+      (grpc_udp_datagram *)gpr_zalloc(batch_size * sizeof(grpc_udp_datagram));
+  for (size_t i = 0; i < batch_size; i++) {
+    datagrams[i].data = payload;
+    datagrams[i].length = datagram_size;
+  }
+
+  /* Alternate between filling the server's socket buffer with a burst and
+     letting the server drain it, timing the two phases separately */
+  int64_t sent = 0;
+  double send_time = 0;
+  double recv_time = 0;
+  g_datagrams_received = 0;
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  while (seconds_since(start) < seconds) {
+    gpr_timespec phase_start = gpr_now(GPR_CLOCK_MONOTONIC);
+    sent += (int64_t)send_burst(fd, batched_send, datagrams, burst,
+                                batch_size);
+    send_time += seconds_since(phase_start);
+    phase_start = gpr_now(GPR_CLOCK_MONOTONIC);
+    grpc_millis deadline = grpc_exec_ctx_now(&exec_ctx) + GPR_MS_PER_SEC;
+    gpr_mu_lock(g_mu);
+    while (g_datagrams_received < sent &&
+           grpc_exec_ctx_now(&exec_ctx) < deadline) {
+      grpc_pollset_worker *worker = NULL;
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(&exec_ctx, g_pollset, &worker, deadline)));
+      gpr_mu_unlock(g_mu);
+      grpc_exec_ctx_flush(&exec_ctx);
+      gpr_mu_lock(g_mu);
+    }
+    gpr_mu_unlock(g_mu);
+    recv_time += seconds_since(phase_start);
+    /* loopback should not drop, but if it did, don't wait on it again */
+    sent = g_datagrams_received;
+  }
+
+  gpr_free(datagrams);
+  gpr_free(payload);
+  close(fd);
+  grpc_udp_server_destroy(&exec_ctx, s, NULL);
+  grpc_exec_ctx_finish(&exec_ctx);
+
+  printf("%-8s -> %-8s datagram_size=%-5d send %9.0f/s  recv %9.0f/s\n",
+         batched_send ? "sendmmsg" : "send",
+         batched_recv ? "recvmmsg" : "recv", (int)datagram_size,
+         (double)sent / send_time, (double)g_datagrams_received / recv_time);
+}
+
+static void destroy_pollset(grpc_exec_ctx *exec_ctx, void *p,
+                            grpc_error *error) {
+  grpc_pollset_destroy(exec_ctx, p);
+}
+
+int main(int argc, char **argv) {
+  int batch_size = 32;
+  int datagram_size = 64;
+  int burst = 256;
+  int seconds = 2;
+  int gro = 0;
+  char *mode = NULL;
+
+  gpr_cmdline *cmdline =
+      gpr_cmdline_create("udp_packet_rate network benchmarking tool");
+  gpr_cmdline_add_int(cmdline, "batch_size",
+                      "Datagrams per recvmmsg/sendmmsg call", &batch_size);
+  gpr_cmdline_add_int(cmdline, "datagram_size", "Size of sent datagrams",
+                      &datagram_size);
+  gpr_cmdline_add_int(cmdline, "burst",
+                      "Datagrams sent before letting the server read them",
+                      &burst);
+  gpr_cmdline_add_int(cmdline, "seconds", "Duration of each run", &seconds);
+  gpr_cmdline_add_flag(cmdline, "gro", "Enable UDP_GRO on batched ports",
+                       &gro);
+  gpr_cmdline_add_string(
+      cmdline, "mode",
+      "Only run one of: recv_send, recv_sendmmsg, recvmmsg_send, "
+      "recvmmsg_sendmmsg",
+      &mode);
+  gpr_cmdline_parse(cmdline, argc, argv);
+  if (batch_size <= 0 || datagram_size <= 0 || datagram_size > 65507 ||
+      burst <= 0 || seconds <= 0) {
+    fprintf(stderr, "invalid arguments\n");
+    return 1;
+  }
+
+  grpc_init();
+  g_pollset = (grpc_pollset *)gpr_zalloc(grpc_pollset_size());
+  grpc_pollset_init(g_pollset, &g_mu);
+
+  static const char *modes[] = {"recv_send", "recv_sendmmsg", "recvmmsg_send",
+                                "recvmmsg_sendmmsg"};
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(modes); i++) {
+    if (mode != NULL && strcmp(mode, modes[i]) != 0) continue;
+    run_benchmark(i >= 2, i % 2 == 1, (size_t)batch_size, (size_t)datagram_size,
+                  (size_t)burst, gro != 0, seconds);
+  }
+
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_closure destroyed;
+  GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(&exec_ctx, g_pollset, &destroyed);
+  grpc_exec_ctx_finish(&exec_ctx);
+  gpr_free(g_pollset);
+  grpc_shutdown();
+  gpr_cmdline_destroy(cmdline);
+  return 0;
+}
+
+#else /* GRPC_POSIX_SOCKET */
+
+int main(int argc, char **argv) { return 1; }
+
+#endif /* GRPC_POSIX_SOCKET */
@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Measures how fast rpc stats can be recorded by an increasing number of
+   threads at once, all recording against the same few methods. */
+
+#include <stdio.h>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/thd.h>
+#include <grpc/support/time.h>
+#include "src/core/ext/census/census_interface.h"
+#include "src/core/ext/census/census_rpc_stats.h"
+#include "src/core/ext/census/census_tracing.h"
+#include "test/core/util/test_config.h"
+
+#define MAX_THREADS 64
+#define NUM_METHODS 4
+#define NUM_RECORDS_PER_THREAD 200000
+
+static census_op_id g_ids[NUM_METHODS];
+
+static void record_thread(void *arg) {
+  census_rpc_stats stats = {1, 0, 0, 1.5, 100, 120, 200, 220};
+  int i;
+  for (i = 0; i < NUM_RECORDS_PER_THREAD; i++) {
+    census_record_rpc_server_stats(g_ids[i % NUM_METHODS], &stats);
+  }
+}
+
+static void test_performance(int num_threads) {
+  gpr_thd_id threads[MAX_THREADS];
+  gpr_thd_options options = gpr_thd_options_default();
+  census_aggregated_rpc_stats agg_stats = {0, NULL};
+  gpr_timespec start_time;
+  gpr_timespec record_time;
+  double record_time_micro;
+  uint64_t total = 0;
+  int i;
+
+  gpr_thd_options_set_joinable(&options);
+  start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  for (i = 0; i < num_threads; i++) {
+    GPR_ASSERT(gpr_thd_new(&threads[i], record_thread, NULL, &options));
+  }
+  for (i = 0; i < num_threads; i++) {
+    gpr_thd_join(threads[i]);
+  }
+  record_time = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time);
+  record_time_micro =
+      record_time.tv_sec * 1000000.0 + record_time.tv_nsec / 1000.0;
+
+  census_get_server_stats(&agg_stats);
+  for (i = 0; i < agg_stats.num_entries; i++) {
+    total += agg_stats.stats[i].total_stats.cnt;
+  }
+  census_aggregated_rpc_stats_set_empty(&agg_stats);
+  GPR_ASSERT(total == (uint64_t)num_threads * NUM_RECORDS_PER_THREAD);
+  printf(
+      "%d threads recorded %d rpc stats in %.3g microseconds: %g records/us "
+      "(%g ns/record)\n",
+      num_threads, num_threads * NUM_RECORDS_PER_THREAD, record_time_micro,
+      num_threads * NUM_RECORDS_PER_THREAD / record_time_micro,
+      1000 * record_time_micro / (num_threads * NUM_RECORDS_PER_THREAD));
+}
+
+int main(int argc, char **argv) {
+  static const char *methods[NUM_METHODS] = {"/s/m1", "/s/m2", "/s/m3",
+                                             "/s/m4"};
+  int max_threads = 2 * (int)gpr_cpu_num_cores();
+  int num_threads;
+  int i;
+
+  grpc_test_init(argc, argv);
+  if (max_threads > MAX_THREADS) max_threads = MAX_THREADS;
+  for (num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    census_init();
+    for (i = 0; i < NUM_METHODS; i++) {
+      g_ids[i] = census_tracing_start_op();
+      census_add_method_tag(g_ids[i], methods[i]);
+    }
+    test_performance(num_threads);
+    for (i = 0; i < NUM_METHODS; i++) {
+      census_tracing_end_op(g_ids[i]);
+    }
+    census_shutdown();
+  }
+  return 0;
+}
@@ -21,7 +21,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
-#include <grpc/support/string.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/thd.h>
 #include <grpc/support/time.h>
 #include "src/core/ext/census/census_interface.h"
@@ -154,6 +154,58 @@ static void test_record_stats_on_unknown_op_id(void) {
   census_shutdown();
 }
 
+#define NUM_RECORDING_THREADS 8
+#define NUM_RECORDS_PER_THREAD 1000
+
+static void record_client_stats_thread(void *arg) {
+  census_op_id *ids = (census_op_id *)arg;
+  census_rpc_stats stats = {1, 0, 0, 2.0, 0, 0, 0, 0};
+  int i;
+  for (i = 0; i < NUM_RECORDS_PER_THREAD; i++) {
+    census_record_rpc_client_stats(ids[i % 2], &stats);
+  }
+}
+
+/* Stats recorded concurrently (and so possibly into different shards) add
+   up when read back. */
+static void test_record_stats_from_many_threads(void) {
+  census_op_id ids[2];
+  gpr_thd_id threads[NUM_RECORDING_THREADS];
+  gpr_thd_options options = gpr_thd_options_default();
+  census_aggregated_rpc_stats agg_stats = {0, NULL};
+  int i;
+
+  census_init();
+  ids[0] = census_tracing_start_op();
+  census_add_method_tag(ids[0], "m1");
+  ids[1] = census_tracing_start_op();
+  census_add_method_tag(ids[1], "m2");
+  gpr_thd_options_set_joinable(&options);
+  for (i = 0; i < NUM_RECORDING_THREADS; i++) {
+    GPR_ASSERT(gpr_thd_new(&threads[i], record_client_stats_thread, ids,
+                           &options));
+  }
+  for (i = 0; i < NUM_RECORDING_THREADS; i++) {
+    gpr_thd_join(threads[i]);
+  }
+  census_tracing_end_op(ids[0]);
+  census_tracing_end_op(ids[1]);
+
+  census_get_client_stats(&agg_stats);
+  GPR_ASSERT(agg_stats.num_entries == 2);
+  for (i = 0; i < 2; i++) {
+    const uint64_t expected_cnt =
+        NUM_RECORDING_THREADS * NUM_RECORDS_PER_THREAD / 2;
+    GPR_ASSERT(agg_stats.stats[i].minute_stats.cnt == expected_cnt &&
+               agg_stats.stats[i].hour_stats.cnt == expected_cnt &&
+               agg_stats.stats[i].total_stats.cnt == expected_cnt);
+    ASSERT_NEAR(agg_stats.stats[i].total_stats.elapsed_time_ms,
+                2.0 * expected_cnt);
+  }
+  census_aggregated_rpc_stats_set_empty(&agg_stats);
+  census_shutdown();
+}
+
 /* Test that record stats is noop when trace store is uninitialized. */
 static void test_record_stats_with_trace_store_uninitialized(void) {
   census_rpc_stats stats = {1, 2, 3, 4, 5.1, 6.2, 7.3, 8.4};
@@ -178,6 +230,7 @@ int main(int argc, char **argv) {
   test_create_and_destroy();
   test_record_and_get_stats();
   test_record_stats_on_unknown_op_id();
+  test_record_stats_from_many_threads();
   test_record_stats_with_trace_store_uninitialized();
   return 0;
 }
@@ -0,0 +1,119 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/support/alloc_tags.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/thd.h>
+#include "test/core/util/test_config.h"
+
+#define NUM_THREADS 4
+#define NUM_BLOCKS 1000
+
+static void test_accounting(void) {
+  gpr_alloc_tag_stats before[GPR_ALLOC_TAG_COUNT];
+  gpr_alloc_tag_stats after[GPR_ALLOC_TAG_COUNT];
+
+  gpr_log(GPR_INFO, "test_accounting");
+  gpr_alloc_tag_stats_collect(before);
+
+  char *a = (char *)gpr_malloc_tagged(100, GPR_ALLOC_TAG_HPACK);
+  char *b = (char *)gpr_zalloc_tagged(50, GPR_ALLOC_TAG_HPACK);
+  for (size_t i = 0; i < 50; i++) GPR_ASSERT(b[i] == 0);
+  b = (char *)gpr_realloc_tagged(b, 50, 200, GPR_ALLOC_TAG_HPACK);
+  char *c = (char *)gpr_malloc_tagged(10, GPR_ALLOC_TAG_ARENA);
+
+  gpr_alloc_tag_stats_collect(after);
+  GPR_ASSERT(after[GPR_ALLOC_TAG_HPACK].live_bytes -
+                 before[GPR_ALLOC_TAG_HPACK].live_bytes ==
+             300);
+  GPR_ASSERT(after[GPR_ALLOC_TAG_HPACK].live_allocations -
+                 before[GPR_ALLOC_TAG_HPACK].live_allocations ==
+             2);
+  GPR_ASSERT(after[GPR_ALLOC_TAG_HPACK].total_allocations -
+                 before[GPR_ALLOC_TAG_HPACK].total_allocations ==
+             3);
+  GPR_ASSERT(after[GPR_ALLOC_TAG_ARENA].live_bytes -
+                 before[GPR_ALLOC_TAG_ARENA].live_bytes ==
+             10);
+
+  gpr_free_tagged(a, 100, GPR_ALLOC_TAG_HPACK);
+  gpr_free_tagged(b, 200, GPR_ALLOC_TAG_HPACK);
+  gpr_free_tagged(c, 10, GPR_ALLOC_TAG_ARENA);
+  gpr_free_tagged(NULL, 0, GPR_ALLOC_TAG_ARENA);
+
+  gpr_alloc_tag_stats_collect(after);
+  for (size_t tag = 0; tag < GPR_ALLOC_TAG_COUNT; tag++) {
+    GPR_ASSERT(after[tag].live_bytes == before[tag].live_bytes);
+    GPR_ASSERT(after[tag].live_allocations == before[tag].live_allocations);
+  }
+}
+
+static void alloc_and_free(void *arg) {
+  void *blocks[NUM_BLOCKS];
+  for (size_t i = 0; i < NUM_BLOCKS; i++) {
+    blocks[i] = gpr_malloc_tagged(i + 1, GPR_ALLOC_TAG_SLICE);
+  }
+  for (size_t i = 0; i < NUM_BLOCKS; i++) {
+    gpr_free_tagged(blocks[i], i + 1, GPR_ALLOC_TAG_SLICE);
+  }
+}
+
+static void test_threads(void) {
+  gpr_alloc_tag_stats before[GPR_ALLOC_TAG_COUNT];
+  gpr_alloc_tag_stats after[GPR_ALLOC_TAG_COUNT];
+  gpr_thd_id threads[NUM_THREADS];
+
+  gpr_log(GPR_INFO, "test_threads");
+  gpr_alloc_tag_stats_collect(before);
+  for (size_t i = 0; i < NUM_THREADS; i++) {
+    gpr_thd_options opt = gpr_thd_options_default();
+    gpr_thd_options_set_joinable(&opt);
+    GPR_ASSERT(gpr_thd_new(&threads[i], alloc_and_free, NULL, &opt));
+  }
+  for (size_t i = 0; i < NUM_THREADS; i++) {
+    gpr_thd_join(threads[i]);
+  }
+  gpr_alloc_tag_stats_collect(after);
+  GPR_ASSERT(after[GPR_ALLOC_TAG_SLICE].live_bytes ==
+             before[GPR_ALLOC_TAG_SLICE].live_bytes);
+  GPR_ASSERT(after[GPR_ALLOC_TAG_SLICE].total_allocations -
+                 before[GPR_ALLOC_TAG_SLICE].total_allocations ==
+             NUM_THREADS * NUM_BLOCKS);
+}
+
+static void test_dump(void) {
+  gpr_log(GPR_INFO, "test_dump");
+  char *dump = gpr_alloc_tag_stats_dump();
+  for (size_t tag = 0; tag < GPR_ALLOC_TAG_COUNT; tag++) {
+    GPR_ASSERT(strstr(dump, gpr_alloc_tag_name((gpr_alloc_tag)tag)) != NULL);
+  }
+  gpr_log(GPR_INFO, "%s", dump);
+  gpr_free(dump);
+}
+
+int main(int argc, char **argv) {
+  grpc_test_init(argc, argv);
+  test_accounting();
+  test_threads();
+  test_dump();
+  return 0;
+}
@@ -19,9 +19,13 @@
 #include <grpc/support/log.h>
 
 #include <stdbool.h>
+#include <stdio.h>
 #include <string.h>
 
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
 #include "src/core/lib/support/env.h"
+#include "src/core/lib/support/log_async.h"
 #include "test/core/util/test_config.h"
 
 static bool log_func_reached = false;
@@ -52,6 +56,109 @@ static void test_should_not_log(gpr_log_func_args *args) { GPR_ASSERT(false); }
   gpr_log_message(SEVERITY, "hello 1 2 3");   \
   gpr_log(SEVERITY, "hello %d %d %d", 1, 2, 3);
 
+#define NUM_ASYNC_MESSAGES 1000
+#define NUM_FLOOD_MESSAGES 20000
+#define NUM_LONG_FILE_MESSAGES 20
+
+static int g_async_received;
+static gpr_event g_sink_released;
+
+static void async_sink(gpr_log_func_args *args) {
+  char expected[64];
+  snprintf(expected, sizeof(expected), "async %d", g_async_received);
+  GPR_ASSERT(0 == strcmp(args->file, "log_test.c"));
+  GPR_ASSERT(args->severity == GPR_LOG_SEVERITY_ERROR);
+  GPR_ASSERT(0 == strcmp(args->message, expected));
+  g_async_received++;
+}
+
+static void long_message_sink(gpr_log_func_args *args) {
+  GPR_ASSERT(strlen(args->message) == 2000);
+  g_async_received++;
+}
+
+static void long_file_sink(gpr_log_func_args *args) {
+  gpr_event_wait(&g_sink_released, gpr_inf_future(GPR_CLOCK_REALTIME));
+  GPR_ASSERT(strlen(args->file) < 9000);
+  GPR_ASSERT(0 == strcmp(args->message, "short"));
+  g_async_received++;
+}
+
+static void blocking_sink(gpr_log_func_args *args) {
+  gpr_event_wait(&g_sink_released, gpr_inf_future(GPR_CLOCK_REALTIME));
+  g_async_received++;
+}
+
+static void test_async(void) {
+  int i;
+  gpr_set_log_verbosity(GPR_LOG_SEVERITY_ERROR);
+  gpr_set_log_function(async_sink);
+  if (!gpr_log_async_start()) {
+    gpr_set_log_function(NULL);
+    return;
+  }
+  /* messages are passed on in order, and all written once flushed */
+  g_async_received = 0;
+  for (i = 0; i < NUM_ASYNC_MESSAGES; i++) {
+    gpr_log(GPR_ERROR, "async %d", i);
+  }
+  gpr_log_async_flush();
+  GPR_ASSERT(g_async_received == NUM_ASYNC_MESSAGES);
+  gpr_log_async_stop();
+  GPR_ASSERT(gpr_log_async_dropped_count() == 0);
+
+  /* stopping goes back to logging synchronously */
+  GPR_ASSERT(gpr_log_get_function() == async_sink);
+
+  /* messages longer than the gpr_log stack buffer */
+  char long_message[2001];
+  memset(long_message, 'x', 2000);
+  long_message[2000] = 0;
+  gpr_set_log_function(long_message_sink);
+  GPR_ASSERT(gpr_log_async_start());
+  g_async_received = 0;
+  gpr_log(GPR_ERROR, "%s", long_message);
+  gpr_log_async_stop();
+  GPR_ASSERT(g_async_received == 1);
+
+  /* a file name too long for a record truncates it, and the record only
+     takes the space its short message needs: enough of them fit in the
+     ring while the sink is held up */
+  static char long_file[9001];
+  memset(long_file, 'f', 9000);
+  long_file[9000] = 0;
+  gpr_event_init(&g_sink_released);
+  gpr_set_log_function(long_file_sink);
+  GPR_ASSERT(gpr_log_async_start());
+  g_async_received = 0;
+  int64_t dropped_before = gpr_log_async_dropped_count();
+  for (i = 0; i < NUM_LONG_FILE_MESSAGES; i++) {
+    gpr_log_message(long_file, __LINE__, GPR_LOG_SEVERITY_ERROR, "short");
+  }
+  GPR_ASSERT(gpr_log_async_dropped_count() == dropped_before);
+  gpr_event_set(&g_sink_released, (void *)1);
+  gpr_log_async_stop();
+  GPR_ASSERT(g_async_received == NUM_LONG_FILE_MESSAGES);
+
+  /* a stuck sink makes messages be dropped and counted, never blocks */
+  gpr_event_init(&g_sink_released);
+  gpr_set_log_function(blocking_sink);
+  GPR_ASSERT(gpr_log_async_start());
+  g_async_received = 0;
+  dropped_before = gpr_log_async_dropped_count();
+  for (i = 0; i < NUM_FLOOD_MESSAGES; i++) {
+    gpr_log(GPR_ERROR, "flood %d", i);
+  }
+  int64_t dropped = gpr_log_async_dropped_count() - dropped_before;
+  GPR_ASSERT(dropped > 0);
+  gpr_event_set(&g_sink_released, (void *)1);
+  gpr_log_async_flush();
+  /* plus one message reporting the drops */
+  GPR_ASSERT(g_async_received + dropped == NUM_FLOOD_MESSAGES + 1);
+  gpr_log_async_stop();
+  gpr_set_log_function(NULL);
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   /* test logging at various verbosity levels */
@@ -103,6 +210,8 @@ int main(int argc, char **argv) {
   test_log_function_unreached(GPR_INFO);
   test_log_function_unreached(GPR_DEBUG);
 
+  test_async();
+
   /* TODO(ctiller): should we add a GPR_ASSERT failure test here */
   return 0;
 }
@@ -0,0 +1,108 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Test of gpr_mu contention profiling. */
+
+#include "src/core/lib/support/mu_contention.h"
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
+#include "test/core/util/test_config.h"
+
+#define NUM_THREADS 4
+#define NUM_ITERATIONS 20000
+#define MAX_SITES 64
+
+static gpr_mu g_mu;
+static int64_t g_counter;
+
+static void contend(void *arg) {
+  for (int i = 0; i < NUM_ITERATIONS; i++) {
+    gpr_mu_lock(&g_mu);
+    g_counter++;
+    gpr_mu_unlock(&g_mu);
+  }
+}
+
+static void run_contending_threads(void) {
+  gpr_thd_id threads[NUM_THREADS];
+  for (int i = 0; i < NUM_THREADS; i++) {
+    gpr_thd_options opt = gpr_thd_options_default();
+    gpr_thd_options_set_joinable(&opt);
+    GPR_ASSERT(gpr_thd_new(&threads[i], contend, NULL, &opt));
+  }
+  for (int i = 0; i < NUM_THREADS; i++) {
+    gpr_thd_join(threads[i]);
+  }
+  GPR_ASSERT(g_counter == NUM_THREADS * NUM_ITERATIONS);
+}
+
+static void test_profile(void) {
+  gpr_mu_contention_site sites[MAX_SITES];
+  size_t n;
+  size_t i;
+  char *report;
+
+  gpr_log(GPR_INFO, "test_profile");
+  gpr_mu_init(&g_mu);
+  gpr_mu_contention_reset();
+  run_contending_threads();
+
+  n = gpr_mu_contention_top(sites, MAX_SITES);
+  report = gpr_mu_contention_report(5);
+  GPR_ASSERT(report != NULL);
+  gpr_log(GPR_INFO, "%s", report);
+  gpr_free(report);
+
+  if (!gpr_mu_contention_enabled()) {
+    GPR_ASSERT(n == 0);
+    gpr_mu_destroy(&g_mu);
+    return;
+  }
+
+  /* all the locking in contend() comes from one call site */
+  GPR_ASSERT(n > 0);
+  for (i = 0; i < n; i++) {
+    if (sites[i].acquisitions == NUM_THREADS * NUM_ITERATIONS) break;
+  }
+  GPR_ASSERT(i < n);
+  GPR_ASSERT(sites[i].contended <= sites[i].acquisitions);
+  /* total and max wait are converted from ticks separately, each truncated to
+     whole nanoseconds: allow up to 1ns of slack per contended acquisition */
+  GPR_ASSERT(sites[i].max_wait_ns * sites[i].contended + sites[i].contended >=
+             sites[i].total_wait_ns);
+  GPR_ASSERT(sites[i].p50_hold_ns <= sites[i].p99_hold_ns);
+  /* ranking is by total wait time */
+  for (i = 1; i < n; i++) {
+    GPR_ASSERT(sites[i - 1].total_wait_ns >= sites[i].total_wait_ns);
+  }
+
+  gpr_mu_contention_reset();
+  n = gpr_mu_contention_top(sites, MAX_SITES);
+  for (i = 0; i < n; i++) {
+    GPR_ASSERT(sites[i].acquisitions < NUM_THREADS * NUM_ITERATIONS);
+  }
+  gpr_mu_destroy(&g_mu);
+}
+
+int main(int argc, char **argv) {
+  grpc_test_init(argc, argv);
+  test_profile();
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/support/obj_cache.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
+#include "test/core/util/test_config.h"
+
+#define NUM_THREADS 8
+#define OBJS_PER_THREAD 64
+#define ITERATIONS 10000
+
+static gpr_atm g_freed;
+
+static void free_obj(void *obj) {
+  gpr_atm_no_barrier_fetch_add(&g_freed, 1);
+  gpr_free(obj);
+}
+
+static void test_empty(void) {
+  gpr_log(GPR_INFO, "test_empty");
+  gpr_obj_cache *cache = gpr_obj_cache_create(GPR_OBJ_CACHE_UNBOUNDED);
+  GPR_ASSERT(gpr_obj_cache_get(cache) == NULL);
+  gpr_atm_no_barrier_store(&g_freed, 0);
+  gpr_obj_cache_destroy(cache, free_obj);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&g_freed) == 0);
+}
+
+static void test_reuse(void) {
+  gpr_log(GPR_INFO, "test_reuse");
+  gpr_obj_cache *cache = gpr_obj_cache_create(GPR_OBJ_CACHE_UNBOUNDED);
+  void *obj = gpr_malloc(1);
+  GPR_ASSERT(gpr_obj_cache_put(cache, obj));
+  GPR_ASSERT(gpr_obj_cache_get(cache) == obj);
+  GPR_ASSERT(gpr_obj_cache_get(cache) == NULL);
+  gpr_free(obj);
+  gpr_obj_cache_destroy(cache, free_obj);
+}
+
+/* Objects beyond the magazines spill into the depot and come back out of
+   it, and everything still cached is freed on destroy */
+static void test_depot(void) {
+  gpr_log(GPR_INFO, "test_depot");
+  const size_t n = 10 * GPR_OBJ_CACHE_MAGAZINE_SIZE;
+  void **objs = (void **)gpr_malloc(n * sizeof(void *));
+  gpr_obj_cache *cache = gpr_obj_cache_create(GPR_OBJ_CACHE_UNBOUNDED);
+  for (size_t i = 0; i < n; i++) {
+    objs[i] = gpr_malloc(1);
+    GPR_ASSERT(gpr_obj_cache_put(cache, objs[i]));
+  }
+  for (size_t i = 0; i < n; i++) {
+    objs[i] = gpr_obj_cache_get(cache);
+    GPR_ASSERT(objs[i] != NULL);
+  }
+  GPR_ASSERT(gpr_obj_cache_get(cache) == NULL);
+  for (size_t i = 0; i < n; i++) {
+    GPR_ASSERT(gpr_obj_cache_put(cache, objs[i]));
+  }
+  gpr_free(objs);
+  gpr_atm_no_barrier_store(&g_freed, 0);
+  gpr_obj_cache_drain(cache, free_obj);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&g_freed) == (gpr_atm)n);
+  GPR_ASSERT(gpr_obj_cache_get(cache) == NULL);
+  gpr_obj_cache_destroy(cache, free_obj);
+}
+
+/* Run on one thread, so that (barring migrations) one magazine is used */
+static void test_bounded(void) {
+  gpr_log(GPR_INFO, "test_bounded");
+  const size_t max_depot = GPR_OBJ_CACHE_MAGAZINE_SIZE;
+  gpr_obj_cache *cache = gpr_obj_cache_create(max_depot);
+  size_t cached = 0;
+  size_t refused = 0;
+  for (size_t i = 0; i < 4 * GPR_OBJ_CACHE_MAGAZINE_SIZE; i++) {
+    void *obj = gpr_malloc(1);
+    if (gpr_obj_cache_put(cache, obj)) {
+      cached++;
+    } else {
+      refused++;
+      gpr_free(obj);
+    }
+  }
+  GPR_ASSERT(refused > 0);
+  GPR_ASSERT(cached >= GPR_OBJ_CACHE_MAGAZINE_SIZE);
+  gpr_atm_no_barrier_store(&g_freed, 0);
+  gpr_obj_cache_destroy(cache, free_obj);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&g_freed) == (gpr_atm)cached);
+}
+
+typedef struct {
+  gpr_obj_cache *cache;
+  gpr_atm *allocated;
+} thd_args;
+
+/* Threads churn objects through a bounded cache; no object may be handed
+   out twice, which the owner stamp in each object checks */
+static void churn(void *arg) {
+  thd_args *args = (thd_args *)arg;
+  void **held[OBJS_PER_THREAD];
+  for (int i = 0; i < ITERATIONS; i++) {
+    int n = i % OBJS_PER_THREAD + 1;
+    for (int j = 0; j < n; j++) {
+      held[j] = (void **)gpr_obj_cache_get(args->cache);
+      if (held[j] == NULL) {
+        held[j] = (void **)gpr_malloc(sizeof(void *));
+        gpr_atm_no_barrier_fetch_add(args->allocated, 1);
+      } else {
+        GPR_ASSERT(*held[j] == NULL);
+      }
+      *held[j] = held;
+    }
+    for (int j = 0; j < n; j++) {
+      GPR_ASSERT(*held[j] == held);
+      *held[j] = NULL;
+      if (!gpr_obj_cache_put(args->cache, held[j])) {
+        gpr_free(held[j]);
+        gpr_atm_no_barrier_fetch_add(args->allocated, -1);
+      }
+    }
+  }
+}
+
+static void test_threads(void) {
+  gpr_log(GPR_INFO, "test_threads");
+  gpr_obj_cache *cache = gpr_obj_cache_create(4 * OBJS_PER_THREAD);
+  gpr_atm allocated = 0;
+  thd_args args = {cache, &allocated};
+  gpr_thd_id thds[NUM_THREADS];
+  gpr_thd_options opt = gpr_thd_options_default();
+  gpr_thd_options_set_joinable(&opt);
+  for (int i = 0; i < NUM_THREADS; i++) {
+    GPR_ASSERT(gpr_thd_new(&thds[i], churn, &args, &opt));
+  }
+  for (int i = 0; i < NUM_THREADS; i++) {
+    gpr_thd_join(thds[i]);
+  }
+  /* every object still allocated is in the cache */
+  gpr_atm_no_barrier_store(&g_freed, 0);
+  gpr_obj_cache_destroy(cache, free_obj);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&g_freed) ==
+             gpr_atm_no_barrier_load(&allocated));
+}
+
+int main(int argc, char **argv) {
+  grpc_test_init(argc, argv);
+  test_empty();
+  test_reuse();
+  test_depot();
+  test_bounded();
+  test_threads();
+  return 0;
+}
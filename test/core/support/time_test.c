@@ -22,10 +22,12 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/thd.h>
 #include <grpc/support/time.h>
+#include <grpc/support/useful.h>
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "src/core/lib/support/time_precise.h"
 #include "test/core/util/test_config.h"
 
 static void to_fp(void *arg, const char *buf, size_t len) {
@@ -241,6 +243,64 @@ static void test_cmp_extreme(void) {
   GPR_ASSERT(gpr_time_cmp(t1, t2) == 0);
 }
 
+/* The cycle clock is only behind gpr_fast_monotonic_now when built with
+   GPR_CYCLE_CLOCK_NOW: exercise it either way */
+static gpr_timespec fast_now(void) {
+  gpr_timespec now;
+  if (gpr_cycle_clock_monotonic_now(&now)) return now;
+  return gpr_fast_monotonic_now();
+}
+
+/* The fast clock reads between two gpr_now reads around it, give or take
+   the cycle clock's calibration error, and never goes backwards: both while
+   it calibrates and after, across resyncs.  Every thread takes its own
+   samples, so it runs on several at once. */
+static void fast_monotonic_body(void *arg) {
+  gpr_timespec tolerance = gpr_time_from_micros(500, GPR_TIMESPAN);
+  gpr_timespec last = fast_now();
+  for (int i = 0; i < 3000; i++) {
+    gpr_timespec before = gpr_now(GPR_CLOCK_MONOTONIC);
+    gpr_timespec fast = fast_now();
+    gpr_timespec after = gpr_now(GPR_CLOCK_MONOTONIC);
+    GPR_ASSERT(fast.clock_type == GPR_CLOCK_MONOTONIC);
+    GPR_ASSERT(gpr_time_cmp(fast, last) >= 0);
+    GPR_ASSERT(gpr_time_cmp(gpr_time_add(fast, tolerance), before) >= 0);
+    GPR_ASSERT(gpr_time_cmp(gpr_time_sub(fast, tolerance), after) <= 0);
+    last = fast;
+    if (i % 100 == 0) {
+      gpr_sleep_until(gpr_time_add(after, gpr_time_from_millis(
+                                              15, GPR_TIMESPAN)));
+    }
+  }
+}
+
+static void test_fast_monotonic(void) {
+  gpr_thd_id thds[4];
+  gpr_thd_options opt = gpr_thd_options_default();
+  gpr_timespec cycles;
+  gpr_log(GPR_INFO, "cycle clock %savailable",
+          gpr_cycle_clock_monotonic_now(&cycles) ? "" : "not ");
+  gpr_thd_options_set_joinable(&opt);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    GPR_ASSERT(gpr_thd_new(&thds[i], fast_monotonic_body, NULL, &opt));
+  }
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    gpr_thd_join(thds[i]);
+  }
+}
+
+static void test_coarse_monotonic(void) {
+  gpr_timespec before = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec coarse = gpr_coarse_monotonic_now();
+  gpr_timespec after = gpr_now(GPR_CLOCK_MONOTONIC);
+  GPR_ASSERT(coarse.clock_type == GPR_CLOCK_MONOTONIC);
+  GPR_ASSERT(gpr_time_cmp(coarse, after) <= 0);
+  /* lags by no more than a few kernel ticks */
+  GPR_ASSERT(gpr_time_cmp(gpr_time_add(coarse, gpr_time_from_millis(
+                                                   50, GPR_TIMESPAN)),
+                          before) >= 0);
+}
+
 int main(int argc, char *argv[]) {
   grpc_test_init(argc, argv);
 
@@ -251,5 +311,7 @@ int main(int argc, char *argv[]) {
   test_similar();
   test_convert_extreme();
   test_cmp_extreme();
+  test_fast_monotonic();
+  test_coarse_monotonic();
   return 0;
 }
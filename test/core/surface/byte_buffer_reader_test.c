@@ -23,6 +23,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/thd.h>
 #include <grpc/support/time.h>
 
@@ -265,6 +266,88 @@ static void test_byte_buffer_copy(void) {
   grpc_byte_buffer_destroy(copied_buffer);
 }
 
+/* message objects in these tests are gpr_strdup'ed strings */
+static int g_objects_serialized;
+static int g_objects_destroyed;
+
+static grpc_byte_buffer *serialize_string(void *object) {
+  grpc_slice slice = grpc_slice_from_copied_string((const char *)object);
+  grpc_byte_buffer *buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_slice_unref(slice);
+  g_objects_serialized++;
+  return buffer;
+}
+
+static void destroy_string(void *object) {
+  gpr_free(object);
+  g_objects_destroyed++;
+}
+
+static const grpc_message_object_vtable string_vtable = {serialize_string,
+                                                         destroy_string};
+static const grpc_message_object_vtable other_vtable = {serialize_string,
+                                                        destroy_string};
+
+static grpc_byte_buffer *string_object_buffer(const char *str) {
+  return grpc_message_object_byte_buffer_create(&string_vtable, gpr_strdup(str),
+                                                strlen(str));
+}
+
+static void test_message_object(void) {
+  grpc_byte_buffer *buffer;
+  grpc_byte_buffer *copied_buffer;
+  grpc_byte_buffer_reader reader;
+  grpc_slice slice_out;
+  char *object;
+
+  LOG_TEST("test_message_object");
+  g_objects_serialized = 0;
+  g_objects_destroyed = 0;
+
+  /* the object can only be taken back out by its own type */
+  buffer = string_object_buffer("hello");
+  GPR_ASSERT(buffer->type == GRPC_BB_OBJECT);
+  GPR_ASSERT(grpc_byte_buffer_length(buffer) == 5);
+  GPR_ASSERT(grpc_byte_buffer_take_message_object(buffer, &other_vtable) ==
+             NULL);
+  object = (char *)grpc_byte_buffer_take_message_object(buffer, &string_vtable);
+  GPR_ASSERT(object != NULL && strcmp(object, "hello") == 0);
+  GPR_ASSERT(grpc_byte_buffer_take_message_object(buffer, &string_vtable) ==
+             NULL);
+  grpc_byte_buffer_destroy(buffer);
+  GPR_ASSERT(g_objects_destroyed == 0);
+  gpr_free(object);
+
+  /* readers serialize the object in place */
+  buffer = string_object_buffer("hello");
+  GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer) &&
+             "Couldn't init byte buffer reader");
+  GPR_ASSERT(buffer->type == GRPC_BB_RAW);
+  GPR_ASSERT(g_objects_serialized == 1 && g_objects_destroyed == 1);
+  slice_out = grpc_byte_buffer_reader_readall(&reader);
+  GPR_ASSERT(grpc_slice_str_cmp(slice_out, "hello") == 0);
+  grpc_slice_unref(slice_out);
+  grpc_byte_buffer_reader_destroy(&reader);
+  GPR_ASSERT(grpc_byte_buffer_take_message_object(buffer, &string_vtable) ==
+             NULL);
+  grpc_byte_buffer_destroy(buffer);
+
+  /* so does copying, and the copy holds the serialized bytes */
+  buffer = string_object_buffer("world");
+  copied_buffer = grpc_byte_buffer_copy(buffer);
+  GPR_ASSERT(buffer->type == GRPC_BB_RAW);
+  GPR_ASSERT(copied_buffer->type == GRPC_BB_RAW);
+  GPR_ASSERT(grpc_byte_buffer_length(copied_buffer) == 5);
+  GPR_ASSERT(g_objects_serialized == 2 && g_objects_destroyed == 2);
+  grpc_byte_buffer_destroy(buffer);
+  grpc_byte_buffer_destroy(copied_buffer);
+
+  /* destroying a buffer destroys an object that was never taken */
+  buffer = string_object_buffer("unused");
+  grpc_byte_buffer_destroy(buffer);
+  GPR_ASSERT(g_objects_serialized == 2 && g_objects_destroyed == 3);
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_read_one_slice();
@@ -276,5 +359,6 @@ int main(int argc, char **argv) {
   test_byte_buffer_from_reader();
   test_byte_buffer_copy();
   test_readall();
+  test_message_object();
   return 0;
 }
@@ -258,6 +258,19 @@ static void test_interned_key_indexed(grpc_exec_ctx *exec_ctx) {
   }
 }
 
+static void test_forget_entries(grpc_exec_ctx *exec_ctx) {
+  verify_params params = {
+      .eof = false, .use_true_binary_metadata = false, .only_intern_key = false,
+  };
+  verify(exec_ctx, params, "000005 0104 deadbeef 40 0161 0161", 1, "a", "a");
+  verify(exec_ctx, params, "000001 0104 deadbeef be", 1, "a", "a");
+  grpc_chttp2_hpack_compressor_forget_entries(exec_ctx, &g_compressor);
+  /* re-added: the peer's copy is older, and will be evicted first */
+  verify(exec_ctx, params, "000005 0104 deadbeef 40 0161 0161", 1, "a", "a");
+  verify(exec_ctx, params, "000005 0104 deadbeef 40 0162 0163", 1, "b", "c");
+  verify(exec_ctx, params, "000002 0104 deadbeef bf be", 2, "a", "a", "b", "c");
+}
+
 static void run_test(void (*test)(grpc_exec_ctx *exec_ctx), const char *name) {
   gpr_log(GPR_INFO, "RUN TEST: %s", name);
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
@@ -276,6 +289,7 @@ int main(int argc, char **argv) {
   TEST(test_decode_table_overflow);
   TEST(test_encode_header_size);
   TEST(test_interned_key_indexed);
+  TEST(test_forget_entries);
   grpc_shutdown();
   for (i = 0; i < num_to_delete; i++) {
     gpr_free(to_delete[i]);
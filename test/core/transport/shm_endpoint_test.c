@@ -0,0 +1,233 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EVENTFD
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/useful.h>
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "test/core/iomgr/endpoint_tests.h"
+#include "test/core/util/test_config.h"
+
+static gpr_mu *g_mu;
+static grpc_pollset *g_pollset;
+
+static void clean_up(void) {}
+
+static grpc_endpoint_test_fixture create_fixture(int ring_size) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_endpoint_test_fixture f;
+  grpc_arg a[] = {{.key = GRPC_ARG_SHM_RING_SIZE,
+                   .type = GRPC_ARG_INTEGER,
+                   .value.integer = ring_size}};
+  grpc_channel_args args = {.num_args = GPR_ARRAY_SIZE(a), .args = a};
+  grpc_endpoint_pair p;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_shm_endpoint_pair_create",
+                               grpc_shm_endpoint_pair_create("test", &args,
+                                                             &p)));
+
+  f.client_ep = p.client;
+  f.server_ep = p.server;
+  grpc_endpoint_add_to_pollset(&exec_ctx, f.client_ep, g_pollset);
+  grpc_endpoint_add_to_pollset(&exec_ctx, f.server_ep, g_pollset);
+  grpc_exec_ctx_finish(&exec_ctx);
+
+  return f;
+}
+
+/* a ring smaller than most writes exercises wrap around and writers waiting
+   for the reader */
+static grpc_endpoint_test_fixture create_fixture_small_ring(
+    size_t slice_size) {
+  return create_fixture(4096);
+}
+
+static grpc_endpoint_test_fixture create_fixture_default_ring(
+    size_t slice_size) {
+  return create_fixture(GRPC_SHM_DEFAULT_RING_SIZE);
+}
+
+static grpc_endpoint_test_config configs[] = {
+    {"shm/small_ring", create_fixture_small_ring, clean_up},
+    {"shm/default_ring", create_fixture_default_ring, clean_up},
+};
+
+#ifdef GRPC_LINUX_EVENTFD
+
+#define TEST_RING_SIZE 4096
+/* offset of ring i's head in the shared region (see shm_header); its tail
+   follows one cache line later */
+#define RING_HEAD_OFFSET(i) (3 * 64 + (i)*128)
+
+static void expect_error(grpc_exec_ctx *exec_ctx, void *arg,
+                         grpc_error *error) {
+  GPR_ASSERT(error != GRPC_ERROR_NONE);
+  *(bool *)arg = true;
+}
+
+/* The server side of a connection, with the test playing the client by
+   writing to the shared region directly */
+typedef struct {
+  grpc_endpoint *ep;
+  uint8_t *region;
+  size_t region_size;
+  int peer_control_fd;
+} server_side;
+
+static server_side create_server_side(grpc_exec_ctx *exec_ctx) {
+  server_side s;
+  grpc_shm_fds fds;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_shm_fds_create",
+                               grpc_shm_fds_create(TEST_RING_SIZE, &fds)));
+  s.region_size = RING_HEAD_OFFSET(2) + 2 * TEST_RING_SIZE;
+  s.region = mmap(NULL, s.region_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                  fds.memfd, 0);
+  GPR_ASSERT(s.region != MAP_FAILED);
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  s.peer_control_fd = sv[1];
+  grpc_channel_args args = {0, NULL};
+  grpc_error *error;
+  s.ep = grpc_shm_endpoint_create(exec_ctx, &fds, GRPC_SHM_SERVER,
+                                  grpc_fd_create(sv[0], "control"), &args,
+                                  "test", &error);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_shm_endpoint_create", error));
+  return s;
+}
+
+static void destroy_server_side(grpc_exec_ctx *exec_ctx, server_side *s) {
+  grpc_endpoint_destroy(exec_ctx, s->ep);
+  munmap(s->region, s->region_size);
+  close(s->peer_control_fd);
+}
+
+/* The ring indices are writable by the peer: out of range values must shut
+   the endpoint down rather than size allocations and copies */
+static void test_corrupted_rx_tail(void) {
+  gpr_log(GPR_INFO, "test_corrupted_rx_tail");
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  server_side s = create_server_side(&exec_ctx);
+  /* the client claims to have written three rings worth of bytes */
+  gpr_atm *tail = (gpr_atm *)(s.region + RING_HEAD_OFFSET(0) + 64);
+  gpr_atm_rel_store(tail, 3 * TEST_RING_SIZE);
+  grpc_slice_buffer read_buffer;
+  grpc_slice_buffer_init(&read_buffer);
+  bool read_failed = false;
+  grpc_endpoint_read(&exec_ctx, s.ep, &read_buffer,
+                     GRPC_CLOSURE_CREATE(expect_error, &read_failed,
+                                         grpc_schedule_on_exec_ctx));
+  grpc_exec_ctx_flush(&exec_ctx);
+  GPR_ASSERT(read_failed);
+  GPR_ASSERT(read_buffer.length == 0);
+  destroy_server_side(&exec_ctx, &s);
+  grpc_exec_ctx_finish(&exec_ctx);
+  grpc_slice_buffer_destroy(&read_buffer);
+}
+
+static void test_corrupted_tx_head(void) {
+  gpr_log(GPR_INFO, "test_corrupted_tx_head");
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  server_side s = create_server_side(&exec_ctx);
+  /* the client claims to have read past what the server wrote */
+  gpr_atm *head = (gpr_atm *)(s.region + RING_HEAD_OFFSET(1));
+  gpr_atm_rel_store(head, 10 * TEST_RING_SIZE);
+  grpc_slice_buffer write_buffer;
+  grpc_slice_buffer_init(&write_buffer);
+  grpc_slice_buffer_add(&write_buffer, grpc_slice_from_static_string("x"));
+  bool write_failed = false;
+  grpc_endpoint_write(&exec_ctx, s.ep, &write_buffer,
+                      GRPC_CLOSURE_CREATE(expect_error, &write_failed,
+                                          grpc_schedule_on_exec_ctx));
+  grpc_exec_ctx_flush(&exec_ctx);
+  GPR_ASSERT(write_failed);
+  destroy_server_side(&exec_ctx, &s);
+  grpc_exec_ctx_finish(&exec_ctx);
+  grpc_slice_buffer_destroy(&write_buffer);
+}
+
+/* A region the peer could still resize (and so fault our mapping) must be
+   rejected */
+static void test_unsealed_memfd(void) {
+  gpr_log(GPR_INFO, "test_unsealed_memfd");
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_shm_fds fds;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_shm_fds_create",
+                               grpc_shm_fds_create(TEST_RING_SIZE, &fds)));
+  /* ours is sealed against resizing */
+  GPR_ASSERT(ftruncate(fds.memfd, 0) != 0);
+  close(fds.memfd);
+  fds.memfd = (int)syscall(SYS_memfd_create, "test", 0);
+  GPR_ASSERT(fds.memfd >= 0);
+  GPR_ASSERT(ftruncate(fds.memfd, RING_HEAD_OFFSET(2) + 2 * TEST_RING_SIZE) ==
+             0);
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  grpc_channel_args args = {0, NULL};
+  grpc_error *error;
+  grpc_endpoint *ep = grpc_shm_endpoint_create(
+      &exec_ctx, &fds, GRPC_SHM_SERVER, grpc_fd_create(sv[0], "control"),
+      &args, "test", &error);
+  GPR_ASSERT(ep == NULL);
+  GPR_ASSERT(error != GRPC_ERROR_NONE);
+  GRPC_ERROR_UNREF(error);
+  grpc_exec_ctx_finish(&exec_ctx);
+  close(sv[1]);
+}
+
+#endif /* GRPC_LINUX_EVENTFD */
+
+static void destroy_pollset(grpc_exec_ctx *exec_ctx, void *p,
+                            grpc_error *error) {
+  grpc_pollset_destroy(exec_ctx, p);
+}
+
+int main(int argc, char **argv) {
+  grpc_closure destroyed;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_test_init(argc, argv);
+  grpc_init();
+  g_pollset = gpr_zalloc(grpc_pollset_size());
+  grpc_pollset_init(g_pollset, &g_mu);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(configs); i++) {
+    grpc_endpoint_tests(configs[i], g_pollset, g_mu);
+  }
+#ifdef GRPC_LINUX_EVENTFD
+  test_corrupted_rx_tail();
+  test_corrupted_tx_head();
+  test_unsealed_memfd();
+#endif
+  GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(&exec_ctx, g_pollset, &destroyed);
+  grpc_exec_ctx_finish(&exec_ctx);
+  grpc_shutdown();
+  gpr_free(g_pollset);
+
+  return 0;
+}
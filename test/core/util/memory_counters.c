@@ -96,6 +96,7 @@ void grpc_memory_counters_destroy() {
 
 struct grpc_memory_counters grpc_memory_counters_snapshot() {
   struct grpc_memory_counters counters;
+  gpr_alloc_tag_stats tag_stats[GPR_ALLOC_TAG_COUNT];
   counters.total_size_relative =
       NO_BARRIER_LOAD(&g_memory_counters.total_size_relative);
   counters.total_size_absolute =
@@ -104,5 +105,9 @@ struct grpc_memory_counters grpc_memory_counters_snapshot() {
       NO_BARRIER_LOAD(&g_memory_counters.total_allocs_relative);
   counters.total_allocs_absolute =
       NO_BARRIER_LOAD(&g_memory_counters.total_allocs_absolute);
+  gpr_alloc_tag_stats_collect(tag_stats);
+  for (size_t i = 0; i < GPR_ALLOC_TAG_COUNT; i++) {
+    counters.tagged_size[i] = (gpr_atm)tag_stats[i].live_bytes;
+  }
   return counters;
 }
@@ -21,11 +21,15 @@
 
 #include <grpc/support/atm.h>
 
+#include "src/core/lib/support/alloc_tags.h"
+
 struct grpc_memory_counters {
   gpr_atm total_size_relative;
   gpr_atm total_size_absolute;
   gpr_atm total_allocs_relative;
   gpr_atm total_allocs_absolute;
+  /* live bytes per gpr_alloc_tag, see grpc_memory_counters_snapshot */
+  gpr_atm tagged_size[GPR_ALLOC_TAG_COUNT];
 };
 
 void grpc_memory_counters_init();
@@ -30,6 +30,7 @@
 #include <grpc/support/string_util.h>
 
 extern "C" {
+#include "src/core/ext/census/grpc_filter.h"
 #include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 #include "src/core/ext/filters/http/client/http_client_filter.h"
@@ -42,6 +43,7 @@ extern "C" {
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/surface/channel.h"
+#include "src/core/lib/surface/channel_init.h"
 #include "src/core/lib/transport/transport_impl.h"
 }
 
@@ -358,6 +360,7 @@ static grpc_arg StringArg(const char *key, const char *value) {
 enum FixtureFlags : uint32_t {
   CHECKS_NOT_LAST = 1,
   REQUIRES_TRANSPORT = 2,
+  MINIMAL_STACK = 4,
 };
 
 template <const grpc_channel_filter *kFilter, uint32_t kFlags>
@@ -526,12 +529,22 @@ static void BM_IsolatedFilter(benchmark::State &state) {
   args.push_back(grpc_client_channel_factory_create_channel_arg(
       &fake_client_channel_factory));
   args.push_back(StringArg(GRPC_ARG_SERVER_URI, "localhost"));
+  if (fixture.flags & MINIMAL_STACK) {
+    args.push_back(
+        grpc_channel_arg_integer_create((char *)GRPC_ARG_MINIMAL_STACK, 1));
+    label << " #minimal_stack";
+  }
 
   grpc_channel_args channel_args = {args.size(), &args[0]};
 
   std::vector<const grpc_channel_filter *> filters;
   if (fixture.filter != nullptr) {
-    filters.push_back(fixture.filter);
+    // drop the filter just as the channel stack builder would
+    if (grpc_channel_init_filter_is_active(fixture.filter, &channel_args)) {
+      filters.push_back(fixture.filter);
+    } else {
+      label << " #filter_inactive";
+    }
   }
   if (fixture.flags & CHECKS_NOT_LAST) {
     filters.push_back(&dummy_filter::dummy_filter);
@@ -606,10 +619,20 @@ typedef Fixture<&grpc_client_deadline_filter, CHECKS_NOT_LAST>
     ClientDeadlineFilter;
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, ClientDeadlineFilter, NoOp);
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, ClientDeadlineFilter, SendEmptyMetadata);
+typedef Fixture<&grpc_client_deadline_filter, CHECKS_NOT_LAST | MINIMAL_STACK>
+    MinStackClientDeadlineFilter;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, MinStackClientDeadlineFilter, NoOp);
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, MinStackClientDeadlineFilter,
+                   SendEmptyMetadata);
 typedef Fixture<&grpc_server_deadline_filter, CHECKS_NOT_LAST>
     ServerDeadlineFilter;
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, ServerDeadlineFilter, NoOp);
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, ServerDeadlineFilter, SendEmptyMetadata);
+typedef Fixture<&grpc_server_deadline_filter, CHECKS_NOT_LAST | MINIMAL_STACK>
+    MinStackServerDeadlineFilter;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, MinStackServerDeadlineFilter, NoOp);
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, MinStackServerDeadlineFilter,
+                   SendEmptyMetadata);
 typedef Fixture<&grpc_http_client_filter, CHECKS_NOT_LAST | REQUIRES_TRANSPORT>
     HttpClientFilter;
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, HttpClientFilter, NoOp);
@@ -620,10 +643,24 @@ BENCHMARK_TEMPLATE(BM_IsolatedFilter, HttpServerFilter, SendEmptyMetadata);
 typedef Fixture<&grpc_message_size_filter, CHECKS_NOT_LAST> MessageSizeFilter;
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, MessageSizeFilter, NoOp);
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, MessageSizeFilter, SendEmptyMetadata);
+typedef Fixture<&grpc_message_size_filter, CHECKS_NOT_LAST | MINIMAL_STACK>
+    MinStackMessageSizeFilter;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, MinStackMessageSizeFilter, NoOp);
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, MinStackMessageSizeFilter,
+                   SendEmptyMetadata);
 typedef Fixture<&grpc_server_load_reporting_filter, CHECKS_NOT_LAST>
     LoadReportingFilter;
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, LoadReportingFilter, NoOp);
 BENCHMARK_TEMPLATE(BM_IsolatedFilter, LoadReportingFilter, SendEmptyMetadata);
+// Per call cost of census, against NoFilter and DummyFilter above
+typedef Fixture<&grpc_client_census_filter, CHECKS_NOT_LAST>
+    ClientCensusFilter;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, ClientCensusFilter, NoOp);
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, ClientCensusFilter, SendEmptyMetadata);
+typedef Fixture<&grpc_server_census_filter, CHECKS_NOT_LAST>
+    ServerCensusFilter;
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, ServerCensusFilter, NoOp);
+BENCHMARK_TEMPLATE(BM_IsolatedFilter, ServerCensusFilter, SendEmptyMetadata);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Benchmarks isolating grpc_call
@@ -0,0 +1,145 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark channel args lookup, and channel and subchannel creation */
+
+#include <string.h>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+
+extern "C" {
+#include "src/core/ext/filters/client_channel/subchannel_index.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+}
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+
+auto& force_library_initialization = Library::get();
+
+// A set of n args in reverse key order, alternating integer and string values
+class TestArgs {
+ public:
+  explicit TestArgs(int n) {
+    for (int i = n - 1; i >= 0; i--) {
+      char* key;
+      gpr_asprintf(&key, "grpc.test.arg_%d", i);
+      keys_.push_back(key);
+      if (i % 2 == 0) {
+        args_.push_back(grpc_channel_arg_integer_create(key, i));
+      } else {
+        args_.push_back(grpc_channel_arg_string_create(key, key));
+      }
+    }
+    channel_args_.num_args = args_.size();
+    channel_args_.args = args_.data();
+  }
+  ~TestArgs() {
+    for (char* key : keys_) gpr_free(key);
+  }
+
+  const grpc_channel_args* get() const { return &channel_args_; }
+  // The key of the last arg: the worst case for a linear scan
+  const char* last_key() const { return keys_.back(); }
+
+ private:
+  std::vector<char*> keys_;
+  std::vector<grpc_arg> args_;
+  grpc_channel_args channel_args_;
+};
+
+static void BM_ChannelArgsFind(benchmark::State& state) {
+  TrackCounters track_counters;
+  TestArgs args(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        grpc_channel_args_find(args.get(), args.last_key()));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ChannelArgsFind)->Range(1, 256);
+
+static void BM_PreprocessedChannelArgsFind(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  TestArgs args(state.range(0));
+  grpc_preprocessed_channel_args* p =
+      grpc_preprocessed_channel_args_create(args.get());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        grpc_preprocessed_channel_args_find(p, args.last_key()));
+  }
+  grpc_preprocessed_channel_args_unref(&exec_ctx, p);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_PreprocessedChannelArgsFind)->Range(1, 256);
+
+// What looking up a subchannel used to cost per key comparison
+static void BM_ChannelArgsNormalizeCompare(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  TestArgs args(state.range(0));
+  grpc_channel_args* existing = grpc_channel_args_normalize(args.get());
+  while (state.KeepRunning()) {
+    grpc_channel_args* normalized = grpc_channel_args_normalize(args.get());
+    GPR_ASSERT(grpc_channel_args_compare(normalized, existing) == 0);
+    grpc_channel_args_destroy(&exec_ctx, normalized);
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+  grpc_channel_args_destroy(&exec_ctx, existing);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ChannelArgsNormalizeCompare)->Range(1, 256);
+
+static void BM_SubchannelKeyCreateCompare(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  TestArgs args(state.range(0));
+  grpc_subchannel_args sc_args;
+  memset(&sc_args, 0, sizeof(sc_args));
+  sc_args.args = args.get();
+  grpc_subchannel_key* existing = grpc_subchannel_key_create(&sc_args);
+  while (state.KeepRunning()) {
+    grpc_subchannel_key* key = grpc_subchannel_key_create(&sc_args);
+    GPR_ASSERT(grpc_subchannel_key_compare(key, existing) == 0);
+    grpc_subchannel_key_destroy(&exec_ctx, key);
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+  grpc_subchannel_key_destroy(&exec_ctx, existing);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SubchannelKeyCreateCompare)->Range(1, 256);
+
+static void BM_InsecureChannelCreateDestroy(benchmark::State& state) {
+  TrackCounters track_counters;
+  TestArgs args(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_channel_destroy(
+        grpc_insecure_channel_create("localhost:1234", args.get(), NULL));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_InsecureChannelCreateDestroy)->Range(1, 256);
+
+BENCHMARK_MAIN();
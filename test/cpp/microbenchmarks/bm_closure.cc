@@ -20,9 +20,11 @@
 
 #include <benchmark/benchmark.h>
 #include <grpc/grpc.h>
+#include <string.h>
 #include <sstream>
 
 extern "C" {
+#include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -415,4 +417,51 @@ static void BM_ClosureReschedOnCombinerFinally(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureReschedOnCombinerFinally);
 
+static void BM_CallCombinerStartStop(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_call_combiner call_combiner;
+  memset(&call_combiner, 0, sizeof(call_combiner));
+  grpc_call_combiner_init(&call_combiner);
+  grpc_closure c;
+  GRPC_CLOSURE_INIT(&c, DoNothing, NULL, grpc_schedule_on_exec_ctx);
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  while (state.KeepRunning()) {
+    GRPC_CALL_COMBINER_START(&exec_ctx, &call_combiner, &c, GRPC_ERROR_NONE,
+                             "bm");
+    grpc_exec_ctx_flush(&exec_ctx);
+    GRPC_CALL_COMBINER_STOP(&exec_ctx, &call_combiner, "bm");
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  grpc_call_combiner_destroy(&call_combiner);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CallCombinerStartStop);
+
+// Two closures per iteration, the second queued behind the first
+static void BM_CallCombinerStartStopQueued(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_call_combiner call_combiner;
+  memset(&call_combiner, 0, sizeof(call_combiner));
+  grpc_call_combiner_init(&call_combiner);
+  grpc_closure c1;
+  grpc_closure c2;
+  GRPC_CLOSURE_INIT(&c1, DoNothing, NULL, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&c2, DoNothing, NULL, grpc_schedule_on_exec_ctx);
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  while (state.KeepRunning()) {
+    GRPC_CALL_COMBINER_START(&exec_ctx, &call_combiner, &c1, GRPC_ERROR_NONE,
+                             "bm");
+    GRPC_CALL_COMBINER_START(&exec_ctx, &call_combiner, &c2, GRPC_ERROR_NONE,
+                             "bm");
+    grpc_exec_ctx_flush(&exec_ctx);
+    GRPC_CALL_COMBINER_STOP(&exec_ctx, &call_combiner, "bm");
+    grpc_exec_ctx_flush(&exec_ctx);
+    GRPC_CALL_COMBINER_STOP(&exec_ctx, &call_combiner, "bm");
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  grpc_call_combiner_destroy(&call_combiner);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CallCombinerStartStopQueued);
+
 BENCHMARK_MAIN();
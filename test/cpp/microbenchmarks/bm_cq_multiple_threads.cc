@@ -28,6 +28,7 @@
 extern "C" {
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/port.h"
+#include "src/core/lib/support/mu_contention.h"
 #include "src/core/lib/surface/completion_queue.h"
 }
 
@@ -150,6 +151,7 @@ static void BM_Cq_Throughput(benchmark::State& state) {
 
   if (state.thread_index == 0) {
     setup();
+    gpr_mu_contention_reset();
   }
 
   while (state.KeepRunning()) {
@@ -161,6 +163,10 @@ static void BM_Cq_Throughput(benchmark::State& state) {
 
   if (state.thread_index == 0) {
     teardown();
+    /* With CONFIG=mucontention, show which locks the cq threads fought over */
+    if (gpr_mu_contention_enabled()) {
+      gpr_mu_contention_log(5);
+    }
   }
 
   track_counters.Finish(state);
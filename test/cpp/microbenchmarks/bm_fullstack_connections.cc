@@ -0,0 +1,311 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark gRPC end2end with large numbers of mostly idle connections, and
+   with connections that are opened and closed at a high rate */
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+#include <grpc/support/histogram.h>
+#include <fstream>
+#include <sstream>
+#include "src/core/lib/profiling/timers.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+DEFINE_int32(idle_seconds, 1,
+             "Number of seconds to measure idle CPU usage for once all "
+             "connections are established");
+DEFINE_int32(connect_timeout_seconds, 120,
+             "Maximum number of seconds to wait for all connections to be "
+             "established");
+
+namespace grpc {
+namespace testing {
+
+// force library initialization
+auto& force_library_initialization = Library::get();
+
+// Connections to one listening port are bounded by the loopback ephemeral
+// port range, so larger sets are spread over several listening ports
+static const int kConnectionsPerPort = 8192;
+
+class EchoServiceImpl final : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+static double NowSeconds() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec + 1e-9 * now.tv_nsec;
+}
+
+static double CpuSeconds() {
+  struct rusage usage;
+  GPR_ASSERT(getrusage(RUSAGE_SELF, &usage) == 0);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+         1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+static double ResidentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  long total_pages = 0;
+  long resident_pages = 0;
+  statm >> total_pages >> resident_pages;
+  return (double)resident_pages * sysconf(_SC_PAGESIZE);
+}
+
+// Both ends of every connection live in this process
+static bool EnoughFileDescriptors(int connections) {
+  struct rlimit limit;
+  GPR_ASSERT(getrlimit(RLIMIT_NOFILE, &limit) == 0);
+  return limit.rlim_cur == RLIM_INFINITY ||
+         limit.rlim_cur >= (rlim_t)(2 * connections + 1024);
+}
+
+// A server and a set of client channels, each with its own connection to
+// the server. Establishing the connections dominates the cost of a run, so
+// the most recently used set is kept across runs of the same size.
+class ConnectionSet {
+ public:
+  explicit ConnectionSet(int connections) {
+    const double rss_at_start = ResidentBytes();
+
+    ServerBuilder b;
+    for (int i = 0; i < connections; i += kConnectionsPerPort) {
+      ports_.push_back(grpc_pick_unused_port_or_die());
+      b.AddListeningPort(Address(ports_.back()), InsecureServerCredentials());
+    }
+    b.RegisterService(&service_);
+    server_ = b.BuildAndStart();
+
+    const double connect_start = NowSeconds();
+    for (int i = 0; i < connections; i++) {
+      ChannelArguments args;
+      // distinct args keep channels from sharing a subchannel (connection)
+      args.SetInt("shard_to_ensure_no_subchannel_merges", i);
+      std::shared_ptr<Channel> channel =
+          CreateCustomChannel(Address(ports_[i / kConnectionsPerPort]),
+                              InsecureChannelCredentials(), args);
+      channel->GetState(true /* try_to_connect */);
+      stubs_.emplace_back(EchoTestService::NewStub(channel));
+      channels_.emplace_back(std::move(channel));
+    }
+    const gpr_timespec deadline =
+        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                     gpr_time_from_seconds(FLAGS_connect_timeout_seconds,
+                                           GPR_TIMESPAN));
+    for (auto& channel : channels_) {
+      GPR_ASSERT(channel->WaitForConnected(deadline));
+    }
+    us_per_accept_ = 1e6 * (NowSeconds() - connect_start) / connections;
+
+    const double idle_start = NowSeconds();
+    const double idle_cpu_start = CpuSeconds();
+    gpr_sleep_until(gpr_time_add(
+        gpr_now(GPR_CLOCK_MONOTONIC),
+        gpr_time_from_seconds(FLAGS_idle_seconds, GPR_TIMESPAN)));
+    idle_cpu_percent_ = 100.0 * (CpuSeconds() - idle_cpu_start) /
+                        (NowSeconds() - idle_start);
+
+    rss_bytes_per_connection_ =
+        (ResidentBytes() - rss_at_start) / connections;
+  }
+
+  ~ConnectionSet() {
+    stubs_.clear();
+    channels_.clear();
+    server_->Shutdown(gpr_inf_past(GPR_CLOCK_MONOTONIC));
+    for (int port : ports_) {
+      grpc_recycle_unused_port(port);
+    }
+  }
+
+  size_t size() const { return stubs_.size(); }
+  EchoTestService::Stub* stub(size_t i) { return stubs_[i].get(); }
+
+  void AddLabels(TrackCounters* track_counters) {
+    std::ostringstream out;
+    out << "rss_kb_per_connection:" << rss_bytes_per_connection_ / 1024
+        << " idle_cpu_percent:" << idle_cpu_percent_
+        << " us_per_accept:" << us_per_accept_;
+    track_counters->AddLabel(out.str());
+  }
+
+ private:
+  static grpc::string Address(int port) {
+    std::ostringstream addr;
+    addr << "localhost:" << port;
+    return addr.str();
+  }
+
+  EchoServiceImpl service_;
+  std::unique_ptr<Server> server_;
+  std::vector<int> ports_;
+  std::vector<std::shared_ptr<Channel>> channels_;
+  std::vector<std::unique_ptr<EchoTestService::Stub>> stubs_;
+  double us_per_accept_;
+  double idle_cpu_percent_;
+  double rss_bytes_per_connection_;
+};
+
+static std::unique_ptr<ConnectionSet> g_connections;
+
+// A server that connections are opened to and closed again, shared by all
+// the threads of a churn run
+class ChurnServer {
+ public:
+  ChurnServer() : port_(grpc_pick_unused_port_or_die()) {
+    std::ostringstream addr;
+    addr << "localhost:" << port_;
+    address_ = addr.str();
+    ServerBuilder b;
+    b.AddListeningPort(address_, InsecureServerCredentials());
+    b.RegisterService(&service_);
+    server_ = b.BuildAndStart();
+  }
+
+  ~ChurnServer() {
+    server_->Shutdown(gpr_inf_past(GPR_CLOCK_MONOTONIC));
+    grpc_recycle_unused_port(port_);
+  }
+
+  const grpc::string& address() const { return address_; }
+
+ private:
+  int port_;
+  grpc::string address_;
+  EchoServiceImpl service_;
+  std::unique_ptr<Server> server_;
+};
+
+static std::unique_ptr<ChurnServer> g_churn_server;
+static gpr_atm g_churn_channel_id;
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+// Unary calls round robin over state.range(0) connections, so each
+// connection sees a small fraction of the request rate
+static void BM_ManyConnections(benchmark::State& state) {
+  const int connections = state.range(0);
+  if (!EnoughFileDescriptors(connections)) {
+    state.SkipWithError("RLIMIT_NOFILE is too low for this many connections");
+    while (state.KeepRunning()) {
+    }
+    return;
+  }
+  if (!g_connections || g_connections->size() != (size_t)connections) {
+    g_connections.reset();
+    g_connections.reset(new ConnectionSet(connections));
+  }
+  TrackCounters track_counters;
+  gpr_histogram* latencies = gpr_histogram_create(0.01, 60e9);
+  EchoRequest request;
+  EchoResponse response;
+  size_t next = 0;
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    ClientContext context;
+    const double start = NowSeconds();
+    GPR_ASSERT(
+        g_connections->stub(next)->Echo(&context, request, &response).ok());
+    gpr_histogram_add(latencies, (NowSeconds() - start) * 1e9);
+    next = (next + 1) % g_connections->size();
+  }
+  g_connections->AddLabels(&track_counters);
+  std::ostringstream out;
+  out << "latency_50_us:" << gpr_histogram_percentile(latencies, 50) / 1000
+      << " latency_99_us:" << gpr_histogram_percentile(latencies, 99) / 1000
+      << " latency_999_us:"
+      << gpr_histogram_percentile(latencies, 99.9) / 1000;
+  track_counters.AddLabel(out.str());
+  track_counters.Finish(state);
+  gpr_histogram_destroy(latencies);
+}
+
+// Each iteration opens a connection, waits for it to be established and
+// closes it again. Besides connects per second, reports connects per second
+// of process CPU time (both ends of every connection live in this process),
+// which stays comparable across thread counts and core counts.
+static void BM_ConnectionChurn(benchmark::State& state) {
+  if (state.thread_index == 0) {
+    g_churn_server.reset(new ChurnServer());
+  }
+  TrackCounters track_counters;
+  const double cpu_start = CpuSeconds();
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    ChannelArguments args;
+    // distinct args keep channels from sharing a subchannel (connection)
+    args.SetInt("shard_to_ensure_no_subchannel_merges",
+                (int)gpr_atm_no_barrier_fetch_add(&g_churn_channel_id, 1));
+    std::shared_ptr<Channel> channel = CreateCustomChannel(
+        g_churn_server->address(), InsecureChannelCredentials(), args);
+    GPR_ASSERT(channel->WaitForConnected(gpr_time_add(
+        gpr_now(GPR_CLOCK_MONOTONIC),
+        gpr_time_from_seconds(FLAGS_connect_timeout_seconds, GPR_TIMESPAN))));
+  }
+  // connects per second are reported as items per second
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index == 0) {
+    std::ostringstream out;
+    out << "connects_per_cpu_second:"
+        << state.iterations() * state.threads / (CpuSeconds() - cpu_start);
+    track_counters.AddLabel(out.str());
+    g_churn_server.reset();
+  }
+  track_counters.Finish(state);
+}
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+// The larger sets need RLIMIT_NOFILE raised well past its usual default, and
+// are skipped otherwise
+static void ConnectionCountArgs(benchmark::internal::Benchmark* b) {
+  b->Arg(1000)->Arg(10000)->Arg(50000)->Arg(100000)->Arg(200000);
+}
+
+BENCHMARK(BM_ManyConnections)->Apply(ConnectionCountArgs);
+BENCHMARK(BM_ConnectionChurn)->ThreadRange(1, 8)->UseRealTime();
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  // allow as many connections as the hard limit permits
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::grpc::testing::g_connections.reset();
+}
@@ -0,0 +1,179 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the latency of small unary calls sharing a TCP connection with
+   a bulk server streaming call, with and without TCP_NOTSENT_LOWAT */
+
+#include <atomic>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+#include <grpc/support/histogram.h>
+#include <sstream>
+#include "src/core/lib/profiling/timers.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+DEFINE_int32(bulk_message_bytes, 1024 * 1024,
+             "Size of the messages of the bulk server streaming call");
+DEFINE_int32(warmup_ms, 500,
+             "Milliseconds the bulk call runs before unary calls are timed, "
+             "so that it has filled the connection");
+
+namespace grpc {
+namespace testing {
+
+// force library initialization
+auto& force_library_initialization = Library::get();
+
+class MixedTrafficServiceImpl final : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+  // Streams bulk messages until the client cancels the call
+  Status ResponseStream(ServerContext* context, const EchoRequest* request,
+                        ServerWriter<EchoResponse>* writer) override {
+    EchoResponse response;
+    response.set_message(std::string(FLAGS_bulk_message_bytes, 'a'));
+    while (!context->IsCancelled() && writer->Write(response)) {
+    }
+    return Status::OK;
+  }
+};
+
+// Sets TCP_NOTSENT_LOWAT on both ends of the connection, when non-zero
+class NotsentLowatConfiguration : public FixtureConfiguration {
+ public:
+  explicit NotsentLowatConfiguration(int notsent_lowat)
+      : notsent_lowat_(notsent_lowat) {}
+
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    if (notsent_lowat_ > 0) {
+      c->SetInt(GRPC_ARG_TCP_NOTSENT_LOWAT, notsent_lowat_);
+    }
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    if (notsent_lowat_ > 0) {
+      b->AddChannelArgument(GRPC_ARG_TCP_NOTSENT_LOWAT, notsent_lowat_);
+    }
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+
+ private:
+  const int notsent_lowat_;
+};
+
+static double NowSeconds() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec + 1e-9 * now.tv_nsec;
+}
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+// Each iteration is a unary call made while a bulk server streaming call
+// keeps the same connection busy. state.range(0) is the TCP_NOTSENT_LOWAT
+// of both ends (0 for the default write path). On loopback the kernel
+// drains socket buffers almost immediately; the difference shows on
+// bandwidth-limited links, which can be emulated with tc (e.g. a tbf qdisc
+// on lo in a network namespace).
+static void BM_UnaryLatencyUnderBulkLoad(benchmark::State& state) {
+  MixedTrafficServiceImpl service;
+  std::unique_ptr<TCP> fixture(
+      new TCP(&service, NotsentLowatConfiguration(state.range(0))));
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  {
+    EchoRequest request;
+    EchoResponse response;
+    ClientContext context;
+    GPR_ASSERT(stub->Echo(&context, request, &response).ok());
+  }
+
+  ClientContext bulk_context;
+  std::atomic<int64_t> bulk_bytes(0);
+  std::thread bulk([&]() {
+    EchoRequest request;
+    EchoResponse response;
+    std::unique_ptr<ClientReader<EchoResponse>> reader(
+        stub->ResponseStream(&bulk_context, request));
+    while (reader->Read(&response)) {
+      bulk_bytes += response.message().size();
+    }
+    reader->Finish();
+  });
+  gpr_sleep_until(gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                               gpr_time_from_millis(FLAGS_warmup_ms,
+                                                    GPR_TIMESPAN)));
+
+  gpr_histogram* latencies = gpr_histogram_create(0.01, 60e9);
+  EchoRequest request;
+  EchoResponse response;
+  const int64_t bulk_bytes_start = bulk_bytes;
+  const double start = NowSeconds();
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    ClientContext context;
+    const double call_start = NowSeconds();
+    GPR_ASSERT(stub->Echo(&context, request, &response).ok());
+    gpr_histogram_add(latencies, (NowSeconds() - call_start) * 1e9);
+  }
+  const double bulk_mbps =
+      (bulk_bytes - bulk_bytes_start) / (NowSeconds() - start) / 1e6;
+
+  bulk_context.TryCancel();
+  bulk.join();
+
+  std::ostringstream out;
+  out << "latency_50_us:" << gpr_histogram_percentile(latencies, 50) / 1000
+      << " latency_99_us:" << gpr_histogram_percentile(latencies, 99) / 1000
+      << " latency_999_us:"
+      << gpr_histogram_percentile(latencies, 99.9) / 1000
+      << " bulk_mbps:" << bulk_mbps;
+  fixture->AddLabel(out.str());
+  fixture->Finish(state);
+  fixture.reset();
+  gpr_histogram_destroy(latencies);
+}
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+BENCHMARK(BM_UnaryLatencyUnderBulkLoad)
+    ->Arg(0)
+    ->Arg(16 * 1024)
+    ->Arg(64 * 1024)
+    ->UseRealTime();
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  ::benchmark::RunSpecifiedBenchmarks();
+}
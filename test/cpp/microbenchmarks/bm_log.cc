@@ -0,0 +1,95 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark trace logging, written out synchronously by the logging thread
+   and asynchronously by the background writer */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <unistd.h>
+
+#include <grpc/support/log.h>
+
+extern "C" {
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/support/log_async.h"
+}
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+
+auto& force_library_initialization = Library::get();
+
+static grpc_tracer_flag bm_trace = GRPC_TRACER_INITIALIZER(true, "bm_log");
+
+static int g_saved_stderr = -1;
+
+/* Logs go to /dev/null while measuring: the cost of a terminal is not what
+   is being compared */
+static void RedirectStderr(bool to_null) {
+  fflush(stderr);
+  if (to_null) {
+    g_saved_stderr = dup(STDERR_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    dup2(null_fd, STDERR_FILENO);
+    close(null_fd);
+  } else {
+    dup2(g_saved_stderr, STDERR_FILENO);
+    close(g_saved_stderr);
+  }
+}
+
+/* About what a chttp2 tracer logs for every frame */
+static void TracedLog(benchmark::State& state, bool async) {
+  TrackCounters track_counters;
+  if (state.thread_index == 0) {
+    RedirectStderr(true);
+    gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
+    if (async) GPR_ASSERT(gpr_log_async_start());
+  }
+  int64_t dropped = gpr_log_async_dropped_count();
+  while (state.KeepRunning()) {
+    if (GRPC_TRACER_ON(bm_trace)) {
+      gpr_log(GPR_DEBUG,
+              "W:%p SERVER [ipv4:127.0.0.1:%d] state WRITING -> IDLE [%s]",
+              &state, 1000 + state.thread_index, "finish writing");
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index == 0) {
+    if (async) gpr_log_async_stop();
+    gpr_set_log_verbosity(GPR_LOG_SEVERITY_ERROR);
+    RedirectStderr(false);
+    dropped = gpr_log_async_dropped_count() - dropped;
+    if (dropped != 0) {
+      gpr_log(GPR_ERROR, "%" PRId64 " messages were dropped", dropped);
+    }
+  }
+  track_counters.Finish(state);
+}
+
+static void BM_TracedLogSync(benchmark::State& state) {
+  TracedLog(state, false);
+}
+BENCHMARK(BM_TracedLogSync)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_TracedLogAsync(benchmark::State& state) {
+  TracedLog(state, true);
+}
+BENCHMARK(BM_TracedLogAsync)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,109 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark resource quota allocations, alone and with many resource users
+   allocating from one quota at once */
+
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+extern "C" {
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/resource_quota.h"
+}
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+
+auto& force_library_initialization = Library::get();
+
+// About what a tcp read allocates
+static const size_t kAllocSize = 8192;
+
+static void BM_ResourceUserAllocFree(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_resource_quota* rq = grpc_resource_quota_create("bm");
+  grpc_resource_user* ru = grpc_resource_user_create(rq, "bm");
+  while (state.KeepRunning()) {
+    grpc_resource_user_alloc(&exec_ctx, ru, kAllocSize, NULL);
+    grpc_resource_user_free(&exec_ctx, ru, kAllocSize);
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+  grpc_resource_user_unref(&exec_ctx, ru);
+  grpc_resource_quota_unref_internal(&exec_ctx, rq);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ResourceUserAllocFree);
+
+static grpc_resource_quota* g_quota;
+static std::vector<grpc_resource_user*> g_users;
+
+/* Every thread walks over all of the resource users, allocating two read
+   buffers from each and freeing them again: like many connections reading at
+   once. range(0) is the number of resource users, range(1) the quota size in
+   KiB (0 for unlimited): a quota smaller than what the users allocate keeps
+   the quota reclaiming memory from the users' free pools. */
+static void BM_ResourceUsersContended(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t num_users = static_cast<size_t>(state.range(0));
+  if (state.thread_index == 0) {
+    g_quota = grpc_resource_quota_create("bm");
+    if (state.range(1) != 0) {
+      grpc_resource_quota_resize(g_quota,
+                                 static_cast<size_t>(state.range(1)) * 1024);
+    }
+    for (size_t i = 0; i < num_users; i++) {
+      g_users.push_back(grpc_resource_user_create(g_quota, "bm"));
+    }
+  }
+
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  size_t next = static_cast<size_t>(state.thread_index);
+  while (state.KeepRunning()) {
+    grpc_resource_user* ru = g_users[next];
+    grpc_resource_user_alloc(&exec_ctx, ru, kAllocSize, NULL);
+    grpc_resource_user_alloc(&exec_ctx, ru, kAllocSize, NULL);
+    grpc_resource_user_free(&exec_ctx, ru, kAllocSize);
+    grpc_resource_user_free(&exec_ctx, ru, kAllocSize);
+    grpc_exec_ctx_flush(&exec_ctx);
+    if (++next == num_users) next = 0;
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index == 0) {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    for (grpc_resource_user* ru : g_users) {
+      grpc_resource_user_unref(&exec_ctx, ru);
+    }
+    g_users.clear();
+    grpc_resource_quota_unref_internal(&exec_ctx, g_quota);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ResourceUsersContended)
+    ->Args({1000, 0})
+    ->Args({1000, 4 * 1024})
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
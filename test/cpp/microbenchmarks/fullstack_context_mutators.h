@@ -27,6 +27,7 @@
 #include <grpc++/server_builder.h>
 #include <grpc++/server_context.h>
 #include <grpc/support/log.h>
+#include <chrono>
 
 #include "test/cpp/microbenchmarks/helpers.h"
 
@@ -121,6 +122,15 @@ class Server_AddInitialMetadata : public NoOpMutator {
   }
 };
 
+template <int kSeconds>
+class Client_SetDeadline : public NoOpMutator {
+ public:
+  Client_SetDeadline(ClientContext* context) : NoOpMutator(context) {
+    context->set_deadline(std::chrono::system_clock::now() +
+                          std::chrono::seconds(kSeconds));
+  }
+};
+
 // static initialization
 
 template <int length>
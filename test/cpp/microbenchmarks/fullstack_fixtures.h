@@ -29,6 +29,7 @@
 
 extern "C" {
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/shm/shm_endpoint.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/endpoint_pair.h"
@@ -249,6 +250,24 @@ class SockPair : public EndpointPairFixture {
                             fixture_configuration) {}
 };
 
+// chttp2 over the shared memory transport's endpoint, to compare against
+// SockPair (same framing over a socketpair) and InProcess
+class Shm : public EndpointPairFixture {
+ public:
+  Shm(Service* service, const FixtureConfiguration& fixture_configuration =
+                            FixtureConfiguration())
+      : EndpointPairFixture(service, MakeEndpoints(), fixture_configuration) {}
+
+ private:
+  static grpc_endpoint_pair MakeEndpoints() {
+    grpc_endpoint_pair p;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "grpc_shm_endpoint_pair_create",
+        grpc_shm_endpoint_pair_create("test", NULL, &p)));
+    return p;
+  }
+};
+
 class InProcessCHTTP2 : public EndpointPairFixture {
  public:
   InProcessCHTTP2(Service* service,
@@ -298,6 +317,7 @@ typedef MinStackize<TCP> MinTCP;
 typedef MinStackize<UDS> MinUDS;
 typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
+typedef MinStackize<Shm> MinShm;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
 }  // namespace testing
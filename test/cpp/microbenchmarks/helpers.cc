@@ -67,6 +67,10 @@ void TrackCounters::AddToLabel(std::ostream &out, benchmark::State &state) {
       << ((double)(gpr_atm_no_barrier_load(&gpr_now_call_count) -
                    now_calls_at_start_) /
           (double)state.iterations())
+      << " fast_nows/iter:"
+      << ((double)(gpr_atm_no_barrier_load(&gpr_fast_now_call_count) -
+                   fast_now_calls_at_start_) /
+          (double)state.iterations())
       << " allocs/iter:"
       << ((double)(counters_at_end.total_allocs_absolute -
                    counters_at_start_.total_allocs_absolute) /
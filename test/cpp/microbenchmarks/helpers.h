@@ -60,6 +60,7 @@ extern "C" gpr_atm gpr_mu_locks;
 extern "C" gpr_atm gpr_counter_atm_cas;
 extern "C" gpr_atm gpr_counter_atm_add;
 extern "C" gpr_atm gpr_now_call_count;
+extern "C" gpr_atm gpr_fast_now_call_count;
 #endif
 
 class TrackCounters {
@@ -80,6 +81,8 @@ class TrackCounters {
       gpr_atm_no_barrier_load(&gpr_counter_atm_add);
   const size_t now_calls_at_start_ =
       gpr_atm_no_barrier_load(&gpr_now_call_count);
+  const size_t fast_now_calls_at_start_ =
+      gpr_atm_no_barrier_load(&gpr_fast_now_call_count);
   grpc_memory_counters counters_at_start_ = grpc_memory_counters_snapshot();
 #endif
 };
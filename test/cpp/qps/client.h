@@ -35,6 +35,7 @@
 #include "src/proto/grpc/testing/services.grpc.pb.h"
 
 #include "src/cpp/util/core_stats.h"
+#include "test/cpp/qps/hdr_histogram.h"
 #include "test/cpp/qps/histogram.h"
 #include "test/cpp/qps/interarrival.h"
 #include "test/cpp/qps/qps_worker.h"
@@ -103,13 +104,18 @@ class ClientRequestCreator<ByteBuffer> {
 
 class HistogramEntry final {
  public:
-  HistogramEntry() : value_used_(false), status_used_(false) {}
+  HistogramEntry()
+      : value_used_(false), schedule_lag_(0), status_used_(false) {}
   bool value_used() const { return value_used_; }
   double value() const { return value_; }
   void set_value(double v) {
     value_used_ = true;
     value_ = v;
   }
+  // How late (in nanoseconds) the measured request was issued relative to
+  // the open-loop schedule; added to value() for the HDR histogram
+  double schedule_lag() const { return schedule_lag_; }
+  void set_schedule_lag(double lag) { schedule_lag_ = lag; }
   bool status_used() const { return status_used_; }
   int status() const { return status_; }
   void set_status(int status) {
@@ -120,10 +126,21 @@ class HistogramEntry final {
  private:
   bool value_used_;
   double value_;
+  double schedule_lag_;
   bool status_used_;
   int status_;
 };
 
+// Nanoseconds by which an open-loop request scheduled for \a issue_time (see
+// Client::NextIssueTime) is late if issued now. Measuring latency from the
+// schedule rather than from the actual issue time corrects for coordinated
+// omission: requests stuck behind a slow one still count their wait.
+inline double ScheduleLag(gpr_timespec issue_time) {
+  const gpr_timespec lag =
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), issue_time);
+  return std::max(0.0, lag.tv_sec * 1e9 + lag.tv_nsec);
+}
+
 typedef std::unordered_map<int, int64_t> StatusHistogram;
 
 inline void MergeStatusHistogram(const StatusHistogram& from,
@@ -147,6 +164,7 @@ class Client {
 
   ClientStats Mark(bool reset) {
     Histogram latencies;
+    HdrHistogram hdr_latencies;
     StatusHistogram statuses;
     UsageTimer::Result timer_result;
 
@@ -156,15 +174,18 @@ class Client {
     int poll_count = cur_poll_count - last_reset_poll_count_;
     if (reset) {
       std::vector<Histogram> to_merge(threads_.size());
+      std::vector<HdrHistogram> to_merge_hdr(threads_.size());
       std::vector<StatusHistogram> to_merge_status(threads_.size());
 
       for (size_t i = 0; i < threads_.size(); i++) {
-        threads_[i]->BeginSwap(&to_merge[i], &to_merge_status[i]);
+        threads_[i]->BeginSwap(&to_merge[i], &to_merge_hdr[i],
+                               &to_merge_status[i]);
       }
       std::unique_ptr<UsageTimer> timer(new UsageTimer);
       timer_.swap(timer);
       for (size_t i = 0; i < threads_.size(); i++) {
         latencies.Merge(to_merge[i]);
+        hdr_latencies.Merge(to_merge_hdr[i]);
         MergeStatusHistogram(to_merge_status[i], &statuses);
       }
       timer_result = timer->Mark();
@@ -172,7 +193,7 @@ class Client {
     } else {
       // merge snapshots of each thread histogram
       for (size_t i = 0; i < threads_.size(); i++) {
-        threads_[i]->MergeStatsInto(&latencies, &statuses);
+        threads_[i]->MergeStatsInto(&latencies, &hdr_latencies, &statuses);
       }
       timer_result = timer_->Mark();
     }
@@ -182,6 +203,7 @@ class Client {
 
     ClientStats stats;
     latencies.FillProto(stats.mutable_latencies());
+    hdr_latencies.FillProto(stats.mutable_hdr_latencies());
     for (StatusHistogram::const_iterator it = statuses.begin();
          it != statuses.end(); ++it) {
       RequestResultCount* rrc = stats.add_request_results();
@@ -287,15 +309,18 @@ class Client {
 
     ~Thread() { impl_.join(); }
 
-    void BeginSwap(Histogram* n, StatusHistogram* s) {
+    void BeginSwap(Histogram* n, HdrHistogram* hdr, StatusHistogram* s) {
       std::lock_guard<std::mutex> g(mu_);
       n->Swap(&histogram_);
+      hdr->Swap(&hdr_histogram_);
       s->swap(statuses_);
     }
 
-    void MergeStatsInto(Histogram* hist, StatusHistogram* s) {
+    void MergeStatsInto(Histogram* hist, HdrHistogram* hdr,
+                        StatusHistogram* s) {
       std::unique_lock<std::mutex> g(mu_);
       hist->Merge(histogram_);
+      hdr->Merge(hdr_histogram_);
       MergeStatusHistogram(statuses_, s);
     }
 
@@ -324,6 +349,8 @@ class Client {
         std::lock_guard<std::mutex> g(mu_);
         if (entry.value_used()) {
           histogram_.Add(entry.value());
+          hdr_histogram_.Add(
+              static_cast<int64_t>(entry.value() + entry.schedule_lag()));
         }
         if (entry.status_used()) {
           statuses_[entry.status()]++;
@@ -341,6 +368,7 @@ class Client {
 
     std::mutex mu_;
     Histogram histogram_;
+    HdrHistogram hdr_histogram_;
     StatusHistogram statuses_;
     Client* client_;
     const size_t idx_;
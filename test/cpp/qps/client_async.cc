@@ -88,6 +88,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
     switch (next_state_) {
       case State::READY:
         start_ = UsageTimer::Now();
+        schedule_lag_ = next_issue_ ? ScheduleLag(issue_time_) : 0;
         response_reader_ = prepare_req_(stub_, &context_, req_, cq_);
         response_reader_->StartCall();
         next_state_ = State::RESP_DONE;
@@ -97,6 +98,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       case State::RESP_DONE:
         if (status_.ok()) {
           entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          entry->set_schedule_lag(schedule_lag_);
         }
         callback_(status_, &response_, entry);
         next_state_ = State::INVALID;
@@ -130,6 +132,8 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  gpr_timespec issue_time_;
+  double schedule_lag_;
   std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>
       response_reader_;
 
@@ -139,7 +143,8 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       RunNextState(true, nullptr);
     } else {  // wait for the issue time
       alarm_.reset(new Alarm);
-      alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+      issue_time_ = next_issue_();
+      alarm_->Set(cq_, issue_time_, ClientRpcContext::tag(this));
     }
   }
 };
@@ -342,13 +347,15 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          issue_time_ = next_issue_();
+          alarm_->Set(cq_, issue_time_, ClientRpcContext::tag(this));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
           start_ = UsageTimer::Now();
+          schedule_lag_ = next_issue_ ? ScheduleLag(issue_time_) : 0;
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -362,6 +369,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
           break;
         case State::READ_DONE:
           entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          entry->set_schedule_lag(schedule_lag_);
           callback_(status_, &response_);
           if ((messages_per_stream_ != 0) &&
               (++messages_issued_ >= messages_per_stream_)) {
@@ -418,6 +426,8 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  gpr_timespec issue_time_;
+  double schedule_lag_;
   std::unique_ptr<grpc::ClientAsyncReaderWriter<RequestType, ResponseType>>
       stream_;
 
@@ -501,7 +511,8 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
           break;  // loop around, don't return
         case State::WAIT:
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          issue_time_ = next_issue_();
+          alarm_->Set(cq_, issue_time_, ClientRpcContext::tag(this));
           next_state_ = State::READY_TO_WRITE;
           return true;
         case State::READY_TO_WRITE:
@@ -509,6 +520,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
             return false;
           }
           start_ = UsageTimer::Now();
+          schedule_lag_ = next_issue_ ? ScheduleLag(issue_time_) : 0;
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -517,6 +529,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
             return false;
           }
           entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          entry->set_schedule_lag(schedule_lag_);
           next_state_ = State::STREAM_IDLE;
           break;  // loop around
         default:
@@ -555,6 +568,8 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  gpr_timespec issue_time_;
+  double schedule_lag_;
   std::unique_ptr<grpc::ClientAsyncWriter<RequestType>> stream_;
 
   void StartInternal(CompletionQueue* cq) {
@@ -743,13 +758,15 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          issue_time_ = next_issue_();
+          alarm_->Set(cq_, issue_time_, ClientRpcContext::tag(this));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
           start_ = UsageTimer::Now();
+          schedule_lag_ = next_issue_ ? ScheduleLag(issue_time_) : 0;
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -763,6 +780,7 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
           break;
         case State::READ_DONE:
           entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          entry->set_schedule_lag(schedule_lag_);
           callback_(status_, &response_);
           if ((messages_per_stream_ != 0) &&
               (++messages_issued_ >= messages_per_stream_)) {
@@ -819,6 +837,8 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  gpr_timespec issue_time_;
+  double schedule_lag_;
   std::unique_ptr<grpc::GenericClientAsyncReaderWriter> stream_;
 
   // Allow a limit on number of messages in a stream
@@ -57,6 +57,7 @@ class SynchronousClient
     num_threads_ =
         config.outstanding_rpcs_per_channel() * config.client_channels();
     responses_.resize(num_threads_);
+    schedule_lag_.resize(num_threads_);
     SetupLoadTest(config, num_threads_);
   }
 
@@ -76,6 +77,7 @@ class SynchronousClient
                          gpr_time_from_seconds(1, GPR_TIMESPAN));
         if (gpr_time_cmp(next_issue_time, one_sec_delay) <= 0) {
           gpr_sleep_until(next_issue_time);
+          schedule_lag_[thread_idx] = ScheduleLag(next_issue_time);
           return true;
         } else {
           gpr_sleep_until(one_sec_delay);
@@ -90,6 +92,8 @@ class SynchronousClient
 
   size_t num_threads_;
   std::vector<SimpleResponse> responses_;
+  // per thread lag behind the open-loop schedule, set by WaitToIssue
+  std::vector<double> schedule_lag_;
 
  private:
   void DestroyMultithreading() override final { EndThreads(); }
@@ -117,6 +121,7 @@ class SynchronousUnaryClient final : public SynchronousClient {
         stub->UnaryCall(&context, request_, &responses_[thread_idx]);
     if (s.ok()) {
       entry->set_value((UsageTimer::Now() - start) * 1e9);
+      entry->set_schedule_lag(schedule_lag_[thread_idx]);
     }
     entry->set_status(s.error_code());
     return true;
@@ -207,6 +212,7 @@ class SynchronousStreamingPingPongClient final
     if (stream_[thread_idx]->Write(request_) &&
         stream_[thread_idx]->Read(&responses_[thread_idx])) {
       entry->set_value((UsageTimer::Now() - start) * 1e9);
+      entry->set_schedule_lag(schedule_lag_[thread_idx]);
       // don't set the status since there isn't one yet
       if ((messages_per_stream_ != 0) &&
           (++messages_issued_[thread_idx] < messages_per_stream_)) {
@@ -38,6 +38,7 @@
 #include "test/core/util/test_config.h"
 #include "test/cpp/qps/client.h"
 #include "test/cpp/qps/driver.h"
+#include "test/cpp/qps/hdr_histogram.h"
 #include "test/cpp/qps/histogram.h"
 #include "test/cpp/qps/qps_worker.h"
 #include "test/cpp/qps/stats.h"
@@ -119,11 +120,28 @@ static void postprocess_scenario_result(ScenarioResult* result) {
 
   result->mutable_summary()->set_qps(qps);
   result->mutable_summary()->set_qps_per_server_core(qps_per_server_core);
-  result->mutable_summary()->set_latency_50(histogram.Percentile(50));
-  result->mutable_summary()->set_latency_90(histogram.Percentile(90));
-  result->mutable_summary()->set_latency_95(histogram.Percentile(95));
-  result->mutable_summary()->set_latency_99(histogram.Percentile(99));
-  result->mutable_summary()->set_latency_999(histogram.Percentile(99.9));
+  // Prefer the HDR histogram for percentiles: it is precise in the tail and
+  // corrected for coordinated omission under open-loop load. Workers that
+  // don't report one only get the coarse histogram.
+  HdrHistogram hdr_histogram;
+  hdr_histogram.MergeProto(result->hdr_latencies());
+  if (hdr_histogram.Count() > 0) {
+    result->mutable_summary()->set_latency_50(hdr_histogram.Percentile(50));
+    result->mutable_summary()->set_latency_90(hdr_histogram.Percentile(90));
+    result->mutable_summary()->set_latency_95(hdr_histogram.Percentile(95));
+    result->mutable_summary()->set_latency_99(hdr_histogram.Percentile(99));
+    result->mutable_summary()->set_latency_999(
+        hdr_histogram.Percentile(99.9));
+    result->mutable_summary()->set_latency_9999(
+        hdr_histogram.Percentile(99.99));
+  } else {
+    result->mutable_summary()->set_latency_50(histogram.Percentile(50));
+    result->mutable_summary()->set_latency_90(histogram.Percentile(90));
+    result->mutable_summary()->set_latency_95(histogram.Percentile(95));
+    result->mutable_summary()->set_latency_99(histogram.Percentile(99));
+    result->mutable_summary()->set_latency_999(histogram.Percentile(99.9));
+    result->mutable_summary()->set_latency_9999(histogram.Percentile(99.99));
+  }
 
   auto server_system_time = 100.0 *
                             sum(result->server_stats(), ServerSystemTime) /
@@ -435,6 +453,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
   // Finish a run
   std::unique_ptr<ScenarioResult> result(new ScenarioResult);
   Histogram merged_latencies;
+  HdrHistogram merged_hdr_latencies;
   std::unordered_map<int, int64_t> merged_statuses;
 
   gpr_log(GPR_INFO, "Finishing clients");
@@ -454,6 +473,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
       gpr_log(GPR_INFO, "Received final status from client %zu", i);
       const auto& stats = client_status.stats();
       merged_latencies.MergeProto(stats.latencies());
+      merged_hdr_latencies.MergeProto(stats.hdr_latencies());
       for (int i = 0; i < stats.request_results_size(); i++) {
         merged_statuses[stats.request_results(i).status_code()] +=
             stats.request_results(i).count();
@@ -476,6 +496,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
   }
 
   merged_latencies.FillProto(result->mutable_latencies());
+  merged_hdr_latencies.FillProto(result->mutable_hdr_latencies());
   for (std::unordered_map<int, int64_t>::iterator it = merged_statuses.begin();
        it != merged_statuses.end(); ++it) {
     RequestResultCount* rrc = result->add_request_results();
@@ -0,0 +1,207 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef TEST_QPS_HDR_HISTOGRAM_H
+#define TEST_QPS_HDR_HISTOGRAM_H
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <grpc/support/log.h>
+#include "src/proto/grpc/testing/stats.pb.h"
+
+namespace grpc {
+namespace testing {
+
+// High dynamic range histogram of non-negative integer values (nanoseconds in
+// the qps benchmarks). Buckets are log-linear: every power of two range is
+// split into enough linear sub-buckets to resolve any recorded value to
+// significant_digits decimal digits, so tail percentiles (99.9, 99.99) stay
+// precise where the geometric buckets of Histogram become very wide.
+class HdrHistogram {
+ public:
+  HdrHistogram()
+      : HdrHistogram(default_significant_digits(),
+                     default_highest_trackable_value()) {}
+  HdrHistogram(int significant_digits, int64_t highest_trackable_value)
+      : significant_digits_(significant_digits),
+        highest_trackable_value_(highest_trackable_value),
+        min_seen_(INT64_MAX),
+        max_seen_(0),
+        sum_(0),
+        count_(0) {
+    GPR_ASSERT(significant_digits >= 1 && significant_digits <= 5);
+    GPR_ASSERT(highest_trackable_value >= 2);
+    // one unit resolution is needed up to 2 * 10^significant_digits
+    const int64_t largest_single_unit_value =
+        2 * static_cast<int64_t>(std::pow(10, significant_digits));
+    sub_bucket_count_magnitude_ = 0;
+    while ((int64_t(1) << sub_bucket_count_magnitude_) <
+           largest_single_unit_value) {
+      sub_bucket_count_magnitude_++;
+    }
+    sub_bucket_count_ = int64_t(1) << sub_bucket_count_magnitude_;
+    sub_bucket_half_count_ = sub_bucket_count_ / 2;
+    int bucket_count = 1;
+    for (int64_t range = sub_bucket_count_; range <= highest_trackable_value;
+         range <<= 1) {
+      bucket_count++;
+    }
+    counts_.resize((bucket_count + 1) * sub_bucket_half_count_);
+  }
+  HdrHistogram(HdrHistogram&& other) = default;
+  HdrHistogram& operator=(HdrHistogram&& other) = default;
+
+  void Add(int64_t value) {
+    if (value < 0) value = 0;
+    if (value > highest_trackable_value_) value = highest_trackable_value_;
+    counts_[CountsIndex(value)]++;
+    min_seen_ = std::min(min_seen_, value);
+    max_seen_ = std::max(max_seen_, value);
+    sum_ += value;
+    count_++;
+  }
+  void Merge(const HdrHistogram& h) {
+    GPR_ASSERT(SameLayout(h.significant_digits_, h.highest_trackable_value_));
+    for (size_t i = 0; i < counts_.size(); i++) {
+      counts_[i] += h.counts_[i];
+    }
+    MergeSummary(h.min_seen_, h.max_seen_, h.sum_, h.count_);
+  }
+  // Smallest recorded value (to the histogram's precision) that at least
+  // pctile percent of the recorded values do not exceed
+  double Percentile(double pctile) const {
+    if (count_ == 0) return 0;
+    int64_t rank = static_cast<int64_t>(std::ceil(pctile / 100.0 * count_));
+    rank = std::max(int64_t(1), std::min(rank, count_));
+    int64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); i++) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        return static_cast<double>(
+            std::min(HighestEquivalentValue(ValueAtIndex(i)), max_seen_));
+      }
+    }
+    return static_cast<double>(max_seen_);
+  }
+  double Count() const { return static_cast<double>(count_); }
+  void Swap(HdrHistogram* other) { std::swap(*this, *other); }
+  void FillProto(HdrHistogramData* p) const {
+    p->set_significant_digits(significant_digits_);
+    p->set_highest_trackable_value(highest_trackable_value_);
+    for (size_t i = 0; i < counts_.size(); i++) {
+      if (counts_[i] != 0) {
+        p->add_bucket_index(static_cast<int32_t>(i));
+        p->add_bucket_count(counts_[i]);
+      }
+    }
+    p->set_min_seen(count_ == 0 ? 0 : min_seen_);
+    p->set_max_seen(max_seen_);
+    p->set_sum(sum_);
+    p->set_count(count_);
+  }
+  void MergeProto(const HdrHistogramData& p) {
+    if (p.count() == 0) return;
+    GPR_ASSERT(SameLayout(p.significant_digits(), p.highest_trackable_value()));
+    GPR_ASSERT(p.bucket_index_size() == p.bucket_count_size());
+    for (int i = 0; i < p.bucket_index_size(); i++) {
+      GPR_ASSERT(p.bucket_index(i) >= 0 &&
+                 static_cast<size_t>(p.bucket_index(i)) < counts_.size());
+      counts_[p.bucket_index(i)] += p.bucket_count(i);
+    }
+    MergeSummary(p.min_seen(), p.max_seen(), p.sum(), p.count());
+  }
+
+  static int default_significant_digits() { return 3; }
+  static int64_t default_highest_trackable_value() {
+    return static_cast<int64_t>(60e9);
+  }
+
+ private:
+  HdrHistogram(const HdrHistogram&);
+  HdrHistogram& operator=(const HdrHistogram&);
+
+  bool SameLayout(int significant_digits,
+                  int64_t highest_trackable_value) const {
+    return significant_digits == significant_digits_ &&
+           highest_trackable_value == highest_trackable_value_;
+  }
+
+  void MergeSummary(int64_t min_seen, int64_t max_seen, double sum,
+                    int64_t count) {
+    if (count == 0) return;
+    min_seen_ = std::min(min_seen_, min_seen);
+    max_seen_ = std::max(max_seen_, max_seen);
+    sum_ += sum;
+    count_ += count;
+  }
+
+  // bucket b covers [sub_bucket_half_count_ << b, sub_bucket_count_ << b) in
+  // steps of 1 << b (bucket 0 also covers [0, sub_bucket_half_count_))
+  int BucketIndex(int64_t value) const {
+    int bits = 0;
+    for (uint64_t v = static_cast<uint64_t>(value | (sub_bucket_count_ - 1));
+         v != 0; v >>= 1) {
+      bits++;
+    }
+    return bits - sub_bucket_count_magnitude_;
+  }
+
+  size_t CountsIndex(int64_t value) const {
+    const int bucket_index = BucketIndex(value);
+    const int64_t sub_bucket_index = value >> bucket_index;
+    return static_cast<size_t>(
+        (int64_t(bucket_index + 1) << (sub_bucket_count_magnitude_ - 1)) +
+        sub_bucket_index - sub_bucket_half_count_);
+  }
+
+  int64_t ValueAtIndex(size_t index) const {
+    int bucket_index =
+        static_cast<int>(index >> (sub_bucket_count_magnitude_ - 1)) - 1;
+    int64_t sub_bucket_index =
+        (index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+    if (bucket_index < 0) {
+      sub_bucket_index -= sub_bucket_half_count_;
+      bucket_index = 0;
+    }
+    return sub_bucket_index << bucket_index;
+  }
+
+  int64_t HighestEquivalentValue(int64_t value) const {
+    const int64_t step = int64_t(1) << BucketIndex(value);
+    return (value & ~(step - 1)) + step - 1;
+  }
+
+  int significant_digits_;
+  int64_t highest_trackable_value_;
+  int sub_bucket_count_magnitude_;
+  int64_t sub_bucket_count_;
+  int64_t sub_bucket_half_count_;
+  std::vector<int64_t> counts_;
+  int64_t min_seen_;
+  int64_t max_seen_;
+  double sum_;
+  int64_t count_;
+};
+}
+}
+
+#endif /* TEST_QPS_HDR_HISTOGRAM_H */
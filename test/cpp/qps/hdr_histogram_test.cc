@@ -0,0 +1,142 @@
+/*
+ *
+ * Copyright 2017 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/time.h>
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/qps/client.h"
+#include "test/cpp/qps/hdr_histogram.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// Every recorded value is reported back no lower than itself and within one
+// part in 10^significant_digits above it
+TEST(HdrHistogramTest, BucketPrecision) {
+  const int64_t highest = HdrHistogram::default_highest_trackable_value();
+  for (int64_t value = 1; value < highest; value = value * 3 + 7) {
+    HdrHistogram h;
+    h.Add(value);
+    // a larger value keeps the max_seen clamp out of the way
+    h.Add(highest);
+    const double reported = h.Percentile(50);
+    EXPECT_GE(reported, value);
+    EXPECT_LE(reported - value, value * 1e-3) << value;
+  }
+}
+
+// Values below 2 * 10^significant_digits are tracked exactly
+TEST(HdrHistogramTest, SmallValuesAreExact) {
+  HdrHistogram h;
+  for (int64_t value = 0; value < 2000; value++) {
+    h.Add(value);
+  }
+  for (int64_t value = 0; value < 2000; value++) {
+    EXPECT_EQ(value, h.Percentile(100.0 * (value + 0.5) / 2000));
+  }
+}
+
+TEST(HdrHistogramTest, Percentiles) {
+  HdrHistogram h;
+  EXPECT_EQ(0, h.Percentile(99));
+  for (int64_t value = 1; value <= 100000; value++) {
+    h.Add(value * 1000);
+  }
+  EXPECT_EQ(100000, h.Count());
+  const double pctiles[] = {0, 50, 90, 99, 99.9, 99.99, 100};
+  for (double pctile : pctiles) {
+    const double expected = std::max(1.0, pctile * 1000) * 1000;
+    const double reported = h.Percentile(pctile);
+    EXPECT_GE(reported, expected) << pctile;
+    EXPECT_LE(reported - expected, expected * 1e-3) << pctile;
+  }
+  // the top percentile is never above the largest recorded value
+  EXPECT_EQ(100000 * 1000, h.Percentile(100));
+}
+
+TEST(HdrHistogramTest, ValuesOutOfRangeAreClamped) {
+  HdrHistogram h(3, 1000000);
+  h.Add(-5);
+  h.Add(5000000);
+  EXPECT_EQ(0, h.Percentile(50));
+  EXPECT_EQ(1000000, h.Percentile(100));
+}
+
+TEST(HdrHistogramTest, MergeProto) {
+  HdrHistogram a;
+  HdrHistogram b;
+  for (int64_t value = 1; value <= 1000; value++) {
+    a.Add(value * 997);
+    b.Add(value * 997 + 500000000);
+  }
+  HdrHistogramData data;
+  b.FillProto(&data);
+  a.MergeProto(data);
+  EXPECT_EQ(2000, a.Count());
+  EXPECT_NEAR(1000 * 997, a.Percentile(50), 1000 * 997 * 1e-3);
+  EXPECT_EQ(1000 * 997 + 500000000, a.Percentile(100));
+}
+
+TEST(HdrHistogramTest, ScheduleLag) {
+  const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  EXPECT_GE(ScheduleLag(gpr_time_sub(
+                now, gpr_time_from_millis(50, GPR_TIMESPAN))),
+            50e6);
+  EXPECT_EQ(0, ScheduleLag(gpr_time_add(
+                   now, gpr_time_from_seconds(10, GPR_TIMESPAN))));
+}
+
+// An open-loop client with one request outstanding, as the qps client threads
+// record it: one slow response delays the requests scheduled behind it, which
+// only the schedule lag (see ScheduleLag) brings back into the tail
+TEST(HdrHistogramTest, CoordinatedOmissionCorrection) {
+  const int64_t kInterval = 1000000;     // 1ms between scheduled requests
+  const int64_t kServiceTime = 100000;   // 100us per response...
+  const int64_t kStallTime = 200000000;  // ...but one takes 200ms
+  const int kRequests = 1000;
+  HdrHistogram uncorrected;
+  HdrHistogram corrected;
+  int64_t free_at = 0;
+  for (int i = 0; i < kRequests; i++) {
+    const int64_t scheduled = i * kInterval;
+    const int64_t issued = std::max(scheduled, free_at);
+    const int64_t latency = i == kRequests / 2 ? kStallTime : kServiceTime;
+    free_at = issued + latency;
+    uncorrected.Add(latency);
+    corrected.Add(latency + (issued - scheduled));
+  }
+  EXPECT_NEAR(kServiceTime, uncorrected.Percentile(99), kServiceTime * 1e-3);
+  EXPECT_EQ(kStallTime, corrected.Percentile(100));
+  // ~200 requests were stuck behind the stall, so it shows up well below the
+  // 99th percentile once corrected
+  EXPECT_GT(corrected.Percentile(99), kStallTime * 9 / 10);
+  EXPECT_GT(corrected.Percentile(90), kStallTime / 2);
+  EXPECT_NEAR(kServiceTime, corrected.Percentile(50), kServiceTime * 1e-3);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc_test_init(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
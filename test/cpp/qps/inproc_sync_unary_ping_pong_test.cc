@@ -18,6 +18,7 @@
 
 #include <set>
 
+#include <grpc/grpc.h>
 #include <grpc/support/log.h>
 
 #include "test/cpp/qps/benchmark_config.h"
@@ -33,8 +34,9 @@ namespace testing {
 static const int WARMUP = 5;
 static const int BENCHMARK = 5;
 
-static void RunSynchronousUnaryPingPong() {
-  gpr_log(GPR_INFO, "Running Synchronous Unary Ping Pong");
+static void RunSynchronousUnaryPingPong(bool message_objects) {
+  gpr_log(GPR_INFO, "Running Synchronous Unary Ping Pong%s",
+          message_objects ? " (message objects)" : "");
 
   ClientConfig client_config;
   client_config.set_client_type(SYNC_CLIENT);
@@ -46,6 +48,14 @@ static void RunSynchronousUnaryPingPong() {
   ServerConfig server_config;
   server_config.set_server_type(SYNC_SERVER);
 
+  if (message_objects) {
+    // both ends must opt in to skip serialization
+    ChannelArg* arg = client_config.add_channel_args();
+    arg->set_name(GRPC_ARG_INPROC_MESSAGE_OBJECTS);
+    arg->set_int_value(1);
+    *server_config.add_channel_args() = *arg;
+  }
+
   const auto result =
       RunScenario(client_config, 1, server_config, 1, WARMUP, BENCHMARK, -2, "",
                   kInsecureCredentialsType, true);
@@ -60,7 +70,8 @@ static void RunSynchronousUnaryPingPong() {
 int main(int argc, char** argv) {
   grpc::testing::InitTest(&argc, &argv, true);
 
-  grpc::testing::RunSynchronousUnaryPingPong();
+  grpc::testing::RunSynchronousUnaryPingPong(false);
+  grpc::testing::RunSynchronousUnaryPingPong(true);
 
   return 0;
 }
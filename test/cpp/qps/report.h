@@ -52,7 +52,8 @@ class Reporter {
   /** Reports QPS per core as (YYY/server core). */
   virtual void ReportQPSPerCore(const ScenarioResult& result) = 0;
 
-  /** Reports latencies for the 50, 90, 95, 99 and 99.9 percentiles, in ms. */
+  /** Reports latencies for the 50, 90, 95, 99, 99.9 and 99.99 percentiles,
+   * in ms. */
   virtual void ReportLatency(const ScenarioResult& result) = 0;
 
   /** Reports system and user time for client and server systems. */
@@ -20,12 +20,17 @@ _AVAILABLE_BENCHMARK_TESTS = [
   'bm_fullstack_unary_ping_pong', 'bm_fullstack_streaming_ping_pong',
   'bm_fullstack_streaming_pump', 'bm_closure', 'bm_cq', 'bm_call_create',
   'bm_error', 'bm_chttp2_hpack', 'bm_chttp2_transport', 'bm_pollset',
-  'bm_metadata', 'bm_fullstack_trickle'
+  'bm_metadata', 'bm_fullstack_trickle', 'bm_fullstack_connections',
+  'bm_fullstack_mixed_traffic'
 ]
 
 _INTERESTING = ('cpu_time', 'real_time', 'locks_per_iteration',
         'allocs_per_iteration', 'writes_per_iteration',
         'atm_cas_per_iteration', 'atm_add_per_iteration',
-        'nows_per_iteration', 'cli_transport_stalls_per_iteration', 
+        'nows_per_iteration', 'fast_nows_per_iteration',
+        'cli_transport_stalls_per_iteration', 
         'cli_stream_stalls_per_iteration', 'svr_transport_stalls_per_iteration',
-        'svr_stream_stalls_per_iteration', 'http2_pings_sent_per_iteration')
+        'svr_stream_stalls_per_iteration', 'http2_pings_sent_per_iteration',
+        'rss_kb_per_connection', 'idle_cpu_percent', 'us_per_accept',
+        'latency_50_us', 'latency_99_us', 'latency_999_us',
+        'connects_per_cpu_second', 'bulk_mbps')
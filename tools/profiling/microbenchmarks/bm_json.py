@@ -43,6 +43,18 @@ _BM_SPECS = {
     'tpl': [],
     'dyn': ['cli_req_size', 'svr_req_size', 'bandwidth_kilobits'],
   },
+  'BM_ManyConnections': {
+    'tpl': [],
+    'dyn': ['connections'],
+  },
+  'BM_ConnectionChurn': {
+    'tpl': [],
+    'dyn': [],
+  },
+  'BM_UnaryLatencyUnderBulkLoad': {
+    'tpl': [],
+    'dyn': ['notsent_lowat'],
+  },
   'BM_ErrorStringOnNewError': {
     'tpl': ['fixture'],
     'dyn': [],
@@ -156,6 +168,14 @@ def parse_name(name):
     s = rest.split('/')
     rest = s[0]
     dyn_args = s[1:]
+  # suffixes added by the benchmark library for UseRealTime and ThreadRange
+  if 'real_time' in dyn_args:
+    dyn_args.remove('real_time')
+  for arg in dyn_args:
+    if arg.startswith('threads:'):
+      out['threads'] = numericalize(arg[len('threads:'):])
+      dyn_args.remove(arg)
+      break
   name = rest
   assert name in _BM_SPECS, '_BM_SPECS needs to be expanded for %s' % name
   assert len(dyn_args) == len(_BM_SPECS[name]['dyn'])
@@ -103,6 +103,7 @@ def _flatten_result_inplace(scenario_result):
   scenario_result['scenario']['clientConfig'] = json.dumps(scenario_result['scenario']['clientConfig'])
   scenario_result['scenario']['serverConfig'] = json.dumps(scenario_result['scenario']['serverConfig'])
   scenario_result['latencies'] = json.dumps(scenario_result['latencies'])
+  scenario_result['hdrLatencies'] = json.dumps(scenario_result.get('hdrLatencies', {}))
   scenario_result['serverCpuStats'] = []
   for stats in scenario_result['serverStats']:
     scenario_result['serverCpuStats'].append(dict())
@@ -110,6 +111,7 @@ def _flatten_result_inplace(scenario_result):
     scenario_result['serverCpuStats'][-1]['idleCpuTime'] = stats.pop('idleCpuTime', None)
   for stats in scenario_result['clientStats']:
     stats['latencies'] = json.dumps(stats['latencies'])
+    stats['hdrLatencies'] = json.dumps(stats.get('hdrLatencies', {}))
     stats.pop('requestResults', None)
   scenario_result['serverCores'] = json.dumps(scenario_result['serverCores'])
   scenario_result['clientSuccess'] = json.dumps(scenario_result['clientSuccess'])
@@ -34,6 +34,10 @@ def massage_qps_stats(scenario_result):
     stats["core_pollset_kick_wakeup_fd"] = massage_qps_stats_helpers.counter(core_stats, "pollset_kick_wakeup_fd")
     stats["core_pollset_kick_wakeup_cv"] = massage_qps_stats_helpers.counter(core_stats, "pollset_kick_wakeup_cv")
     stats["core_pollset_kick_own_thread"] = massage_qps_stats_helpers.counter(core_stats, "pollset_kick_own_thread")
+    stats["core_pollset_kick_coalesced"] = massage_qps_stats_helpers.counter(core_stats, "pollset_kick_coalesced")
+    stats["core_fd_affinity_hits"] = massage_qps_stats_helpers.counter(core_stats, "fd_affinity_hits")
+    stats["core_fd_affinity_handoffs"] = massage_qps_stats_helpers.counter(core_stats, "fd_affinity_handoffs")
+    stats["core_fd_affinity_misses"] = massage_qps_stats_helpers.counter(core_stats, "fd_affinity_misses")
     stats["core_histogram_slow_lookups"] = massage_qps_stats_helpers.counter(core_stats, "histogram_slow_lookups")
     stats["core_syscall_write"] = massage_qps_stats_helpers.counter(core_stats, "syscall_write")
     stats["core_syscall_read"] = massage_qps_stats_helpers.counter(core_stats, "syscall_read")
@@ -97,10 +101,18 @@ def massage_qps_stats(scenario_result):
     stats["core_hpack_send_huffman"] = massage_qps_stats_helpers.counter(core_stats, "hpack_send_huffman")
     stats["core_hpack_send_binary"] = massage_qps_stats_helpers.counter(core_stats, "hpack_send_binary")
     stats["core_hpack_send_binary_base64"] = massage_qps_stats_helpers.counter(core_stats, "hpack_send_binary_base64")
+    stats["core_timers_armed"] = massage_qps_stats_helpers.counter(core_stats, "timers_armed")
+    stats["core_timers_cancelled"] = massage_qps_stats_helpers.counter(core_stats, "timers_cancelled")
+    stats["core_timers_slack_rounded"] = massage_qps_stats_helpers.counter(core_stats, "timers_slack_rounded")
+    stats["core_timer_manager_wakeups"] = massage_qps_stats_helpers.counter(core_stats, "timer_manager_wakeups")
+    stats["core_deadlines_deferred"] = massage_qps_stats_helpers.counter(core_stats, "deadlines_deferred")
+    stats["core_deadlines_promoted"] = massage_qps_stats_helpers.counter(core_stats, "deadlines_promoted")
     stats["core_combiner_locks_initiated"] = massage_qps_stats_helpers.counter(core_stats, "combiner_locks_initiated")
     stats["core_combiner_locks_scheduled_items"] = massage_qps_stats_helpers.counter(core_stats, "combiner_locks_scheduled_items")
     stats["core_combiner_locks_scheduled_final_items"] = massage_qps_stats_helpers.counter(core_stats, "combiner_locks_scheduled_final_items")
     stats["core_combiner_locks_offloaded"] = massage_qps_stats_helpers.counter(core_stats, "combiner_locks_offloaded")
+    stats["core_combiner_offloads_exec_ctx_finished"] = massage_qps_stats_helpers.counter(core_stats, "combiner_offloads_exec_ctx_finished")
+    stats["core_combiner_offloads_queue_busy"] = massage_qps_stats_helpers.counter(core_stats, "combiner_offloads_queue_busy")
     stats["core_call_combiner_locks_initiated"] = massage_qps_stats_helpers.counter(core_stats, "call_combiner_locks_initiated")
     stats["core_call_combiner_locks_scheduled_items"] = massage_qps_stats_helpers.counter(core_stats, "call_combiner_locks_scheduled_items")
     stats["core_call_combiner_set_notify_on_cancel"] = massage_qps_stats_helpers.counter(core_stats, "call_combiner_set_notify_on_cancel")
@@ -116,6 +128,8 @@ def massage_qps_stats(scenario_result):
     stats["core_cq_ev_queue_trylock_failures"] = massage_qps_stats_helpers.counter(core_stats, "cq_ev_queue_trylock_failures")
     stats["core_cq_ev_queue_trylock_successes"] = massage_qps_stats_helpers.counter(core_stats, "cq_ev_queue_trylock_successes")
     stats["core_cq_ev_queue_transient_pop_failures"] = massage_qps_stats_helpers.counter(core_stats, "cq_ev_queue_transient_pop_failures")
+    stats["core_cq_kicks_coalesced"] = massage_qps_stats_helpers.counter(core_stats, "cq_kicks_coalesced")
+    stats["core_cq_kicks_skipped"] = massage_qps_stats_helpers.counter(core_stats, "cq_kicks_skipped")
     h = massage_qps_stats_helpers.histogram(core_stats, "call_initial_size")
     stats["core_call_initial_size"] = ",".join("%f" % x for x in h.buckets)
     stats["core_call_initial_size_bkts"] = ",".join("%f" % x for x in h.boundaries)
@@ -188,6 +202,36 @@ def massage_qps_stats(scenario_result):
     stats["core_http2_send_flowctl_per_write_50p"] = massage_qps_stats_helpers.percentile(h.buckets, 50, h.boundaries)
     stats["core_http2_send_flowctl_per_write_95p"] = massage_qps_stats_helpers.percentile(h.buckets, 95, h.boundaries)
     stats["core_http2_send_flowctl_per_write_99p"] = massage_qps_stats_helpers.percentile(h.buckets, 99, h.boundaries)
+    h = massage_qps_stats_helpers.histogram(core_stats, "combiner_final_list_length")
+    stats["core_combiner_final_list_length"] = ",".join("%f" % x for x in h.buckets)
+    stats["core_combiner_final_list_length_bkts"] = ",".join("%f" % x for x in h.boundaries)
+    stats["core_combiner_final_list_length_50p"] = massage_qps_stats_helpers.percentile(h.buckets, 50, h.boundaries)
+    stats["core_combiner_final_list_length_95p"] = massage_qps_stats_helpers.percentile(h.buckets, 95, h.boundaries)
+    stats["core_combiner_final_list_length_99p"] = massage_qps_stats_helpers.percentile(h.buckets, 99, h.boundaries)
+    h = massage_qps_stats_helpers.histogram(core_stats, "combiner_queue_delay_us")
+    stats["core_combiner_queue_delay_us"] = ",".join("%f" % x for x in h.buckets)
+    stats["core_combiner_queue_delay_us_bkts"] = ",".join("%f" % x for x in h.boundaries)
+    stats["core_combiner_queue_delay_us_50p"] = massage_qps_stats_helpers.percentile(h.buckets, 50, h.boundaries)
+    stats["core_combiner_queue_delay_us_95p"] = massage_qps_stats_helpers.percentile(h.buckets, 95, h.boundaries)
+    stats["core_combiner_queue_delay_us_99p"] = massage_qps_stats_helpers.percentile(h.buckets, 99, h.boundaries)
+    h = massage_qps_stats_helpers.histogram(core_stats, "combiner_closure_run_us")
+    stats["core_combiner_closure_run_us"] = ",".join("%f" % x for x in h.buckets)
+    stats["core_combiner_closure_run_us_bkts"] = ",".join("%f" % x for x in h.boundaries)
+    stats["core_combiner_closure_run_us_50p"] = massage_qps_stats_helpers.percentile(h.buckets, 50, h.boundaries)
+    stats["core_combiner_closure_run_us_95p"] = massage_qps_stats_helpers.percentile(h.buckets, 95, h.boundaries)
+    stats["core_combiner_closure_run_us_99p"] = massage_qps_stats_helpers.percentile(h.buckets, 99, h.boundaries)
+    h = massage_qps_stats_helpers.histogram(core_stats, "executor_queue_delay_us")
+    stats["core_executor_queue_delay_us"] = ",".join("%f" % x for x in h.buckets)
+    stats["core_executor_queue_delay_us_bkts"] = ",".join("%f" % x for x in h.boundaries)
+    stats["core_executor_queue_delay_us_50p"] = massage_qps_stats_helpers.percentile(h.buckets, 50, h.boundaries)
+    stats["core_executor_queue_delay_us_95p"] = massage_qps_stats_helpers.percentile(h.buckets, 95, h.boundaries)
+    stats["core_executor_queue_delay_us_99p"] = massage_qps_stats_helpers.percentile(h.buckets, 99, h.boundaries)
+    h = massage_qps_stats_helpers.histogram(core_stats, "executor_closure_run_us")
+    stats["core_executor_closure_run_us"] = ",".join("%f" % x for x in h.buckets)
+    stats["core_executor_closure_run_us_bkts"] = ",".join("%f" % x for x in h.boundaries)
+    stats["core_executor_closure_run_us_50p"] = massage_qps_stats_helpers.percentile(h.buckets, 50, h.boundaries)
+    stats["core_executor_closure_run_us_95p"] = massage_qps_stats_helpers.percentile(h.buckets, 95, h.boundaries)
+    stats["core_executor_closure_run_us_99p"] = massage_qps_stats_helpers.percentile(h.buckets, 99, h.boundaries)
     h = massage_qps_stats_helpers.histogram(core_stats, "server_cqs_checked")
     stats["core_server_cqs_checked"] = ",".join("%f" % x for x in h.buckets)
     stats["core_server_cqs_checked_bkts"] = ",".join("%f" % x for x in h.boundaries)